@@ -0,0 +1,608 @@
+/*
+ * esmini - Environment Simulator Minimalistic
+ * https://github.com/esmini/esmini
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) partners of Simulation Scenarios
+ * https://sites.google.com/view/simulationscenarios
+ */
+
+/*
+ * This application measures simulation throughput, e.g. to find out how esmini scales with the number of entities.
+ *
+ * A scenario is generated from the given settings: vehicles spread evenly over the driving lanes of a road network, driven
+ * by the default controller, ACC or NaturalDriver, storyboard events waiting for entity conditions that are evaluated every
+ * step but never met, and optionally swarm traffic. It is run headless with a fixed timestep, optionally with collision
+ * detection and OSI output. After some warmup steps the following is measured:
+ *   - steps per second, wall clock
+ *   - ns per entity-step, i.e. wall time divided by the sum of number of entities over all steps
+ *   - memory high-water mark of the process
+ *   - time per phase of the frame, see SE_Profiler
+ *
+ * Example scaling curve: for n in 10 100 1000 5000; do ./esmini-bench --entities $n --csv scaling.csv; done
+ */
+
+#include <chrono>
+#include <fstream>
+#include <sstream>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#include "playerbase.hpp"
+#include "CommonMini.hpp"
+#include "RoadManager.hpp"
+#include "pugixml.hpp"
+
+using namespace roadmanager;
+using namespace scenarioengine;
+
+#define DEFAULT_ODR_FILE "../resources/xodr/e6mini.xodr"
+
+struct BenchSettings
+{
+    std::string  odr_file;
+    unsigned int n_entities   = 100;
+    unsigned int n_conditions = 0;
+    unsigned int n_swarm      = 0;
+    std::string  controller   = "default";
+    double       speed        = 20.0;
+    double       spacing      = 25.0;
+};
+
+struct LaneSlot
+{
+    id_t   road_id;
+    int    lane_id;
+    double s;
+};
+
+// Peak resident memory of the process, in kB
+static long long PeakMemoryKB()
+{
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+    {
+        return static_cast<long long>(counters.PeakWorkingSetSize / 1024);
+    }
+    return -1;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0)
+    {
+#ifdef __APPLE__
+        return usage.ru_maxrss / 1024;  // bytes on macOS
+#else
+        return usage.ru_maxrss;
+#endif
+    }
+    return -1;
+#endif
+}
+
+// Start positions in driving lanes outside junctions, at least spacing apart
+static std::vector<LaneSlot> FindLaneSlots(OpenDrive* odr, double spacing)
+{
+    std::vector<LaneSlot> slots;
+
+    for (unsigned int i = 0; i < odr->GetNumOfRoads(); i++)
+    {
+        Road* road = odr->GetRoadByIdx(i);
+        if (road->GetJunction() != ID_UNDEFINED)
+        {
+            continue;
+        }
+
+        for (unsigned int j = 0; j < road->GetNumberOfLaneSections(); j++)
+        {
+            LaneSection* lsec  = road->GetLaneSectionByIdx(j);
+            double       s_end = MIN(lsec->GetS() + lsec->GetLength(), road->GetLength());
+
+            for (unsigned int k = 0; k < lsec->GetNumberOfLanes(); k++)
+            {
+                Lane* lane = lsec->GetLaneByIdx(k);
+                if (!lane->IsDriving())
+                {
+                    continue;
+                }
+                for (double s = lsec->GetS() + spacing / 2; s < s_end - spacing / 2; s += spacing)
+                {
+                    slots.push_back({road->GetId(), lane->GetId(), s});
+                }
+            }
+        }
+    }
+
+    return slots;
+}
+
+static void AddLanePosition(pugi::xml_node parent, const LaneSlot& slot)
+{
+    pugi::xml_node pos                   = parent.append_child("Position").append_child("LanePosition");
+    pos.append_attribute("roadId")       = std::to_string(slot.road_id).c_str();
+    pos.append_attribute("laneId")       = slot.lane_id;
+    pos.append_attribute("offset")       = 0.0;
+    pos.append_attribute("s")            = slot.s;
+    pugi::xml_node orientation           = pos.append_child("Orientation");
+    orientation.append_attribute("type") = "relative";
+    orientation.append_attribute("h")    = 0.0;
+}
+
+static void AddVehicle(pugi::xml_node entities, const std::string& name, const std::string& controller, const LaneSlot& slot, double speed)
+{
+    pugi::xml_node object           = entities.append_child("ScenarioObject");
+    object.append_attribute("name") = name.c_str();
+
+    pugi::xml_node vehicle                      = object.append_child("Vehicle");
+    vehicle.append_attribute("name")            = "car";
+    vehicle.append_attribute("vehicleCategory") = "car";
+
+    pugi::xml_node bb              = vehicle.append_child("BoundingBox");
+    pugi::xml_node center          = bb.append_child("Center");
+    center.append_attribute("x")   = 1.4;
+    center.append_attribute("y")   = 0.0;
+    center.append_attribute("z")   = 0.75;
+    pugi::xml_node dim             = bb.append_child("Dimensions");
+    dim.append_attribute("width")  = 2.0;
+    dim.append_attribute("length") = 5.04;
+    dim.append_attribute("height") = 1.5;
+
+    pugi::xml_node performance                      = vehicle.append_child("Performance");
+    performance.append_attribute("maxSpeed")        = 70.0;
+    performance.append_attribute("maxDeceleration") = 10.0;
+    performance.append_attribute("maxAcceleration") = 5.0;
+
+    pugi::xml_node axles        = vehicle.append_child("Axles");
+    const char*    axle_names[] = {"FrontAxle", "RearAxle"};
+    for (int i = 0; i < 2; i++)
+    {
+        pugi::xml_node axle                    = axles.append_child(axle_names[i]);
+        axle.append_attribute("maxSteering")   = 0.5236;
+        axle.append_attribute("wheelDiameter") = 0.8;
+        axle.append_attribute("trackWidth")    = 1.68;
+        axle.append_attribute("positionX")     = i == 0 ? 2.98 : 0.0;
+        axle.append_attribute("positionZ")     = 0.4;
+    }
+    vehicle.append_child("Properties");
+
+    if (controller == "default")
+    {
+        return;
+    }
+
+    pugi::xml_node ctrl  = object.append_child("ObjectController").append_child("Controller");
+    pugi::xml_node props = ctrl.append_child("Properties");
+
+    std::vector<std::pair<std::string, std::string>> properties;
+    std::string                                      speed_str = std::to_string(speed);
+
+    if (controller == "acc")
+    {
+        ctrl.append_attribute("name") = "ACCController";
+        properties                    = {{"timeGap", "1.5"}, {"mode", "override"}, {"setSpeed", speed_str}};
+    }
+    else
+    {
+        ctrl.append_attribute("name") = "NaturalDriver";
+        properties                    = {{"desiredSpeed", speed_str}, {"lookAheadDistance", "60"}, {"route", std::to_string(slot.lane_id)}};
+    }
+    properties.insert(properties.begin(), {"esminiController", ctrl.attribute("name").as_string()});
+
+    for (auto& property : properties)
+    {
+        pugi::xml_node node            = props.append_child("Property");
+        node.append_attribute("name")  = property.first.c_str();
+        node.append_attribute("value") = property.second.c_str();
+    }
+}
+
+static void AddSimulationTimeTrigger(pugi::xml_node parent, const char* trigger_name, double time)
+{
+    pugi::xml_node condition                    = parent.append_child(trigger_name).append_child("ConditionGroup").append_child("Condition");
+    condition.append_attribute("name")          = "time";
+    condition.append_attribute("delay")         = 0;
+    condition.append_attribute("conditionEdge") = "none";
+    pugi::xml_node sim_time                     = condition.append_child("ByValueCondition").append_child("SimulationTimeCondition");
+    sim_time.append_attribute("value")          = time;
+    sim_time.append_attribute("rule")           = "greaterThan";
+}
+
+// Condition on one or two entities, evaluated every step and never fulfilled
+static void AddEntityCondition(pugi::xml_node parent, unsigned int index, unsigned int n_entities)
+{
+    std::string entity = "car" + std::to_string(index % n_entities);
+    std::string other  = "car" + std::to_string((index + 1) % n_entities);
+
+    pugi::xml_node condition                    = parent.append_child("ConditionGroup").append_child("Condition");
+    condition.append_attribute("name")          = ("condition" + std::to_string(index)).c_str();
+    condition.append_attribute("delay")         = 0;
+    condition.append_attribute("conditionEdge") = "none";
+
+    pugi::xml_node by_entity                                           = condition.append_child("ByEntityCondition");
+    pugi::xml_node triggering                                          = by_entity.append_child("TriggeringEntities");
+    triggering.append_attribute("triggeringEntitiesRule")              = "any";
+    triggering.append_child("EntityRef").append_attribute("entityRef") = entity.c_str();
+    pugi::xml_node entity_condition                                    = by_entity.append_child("EntityCondition");
+
+    pugi::xml_node node;
+    switch (index % 3)
+    {
+        case 0:
+            node                           = entity_condition.append_child("SpeedCondition");
+            node.append_attribute("value") = 1000.0;
+            node.append_attribute("rule")  = "greaterThan";
+            break;
+        case 1:
+            node                                          = entity_condition.append_child("RelativeDistanceCondition");
+            node.append_attribute("entityRef")            = other.c_str();
+            node.append_attribute("relativeDistanceType") = "euclidianDistance";
+            node.append_attribute("coordinateSystem")     = "entity";
+            node.append_attribute("freespace")            = "false";
+            node.append_attribute("value")                = -1.0;
+            node.append_attribute("rule")                 = "lessThan";
+            break;
+        default:
+        {
+            node                                          = entity_condition.append_child("DistanceCondition");
+            node.append_attribute("relativeDistanceType") = "euclidianDistance";
+            node.append_attribute("coordinateSystem")     = "entity";
+            node.append_attribute("freespace")            = "false";
+            node.append_attribute("value")                = 1.0;
+            node.append_attribute("rule")                 = "lessThan";
+            pugi::xml_node world                          = node.append_child("Position").append_child("WorldPosition");
+            world.append_attribute("x")                   = 1e6;
+            world.append_attribute("y")                   = 1e6;
+        }
+    }
+}
+
+static int GenerateScenario(const BenchSettings& settings, pugi::xml_document& doc)
+{
+    if (!Position::LoadOpenDrive(settings.odr_file.c_str()))
+    {
+        printf("Failed to load OpenDRIVE file %s\n", settings.odr_file.c_str());
+        return -1;
+    }
+
+    std::vector<LaneSlot> slots = FindLaneSlots(Position::GetOpenDrive(), settings.spacing);
+    if (slots.size() < settings.n_entities)
+    {
+        printf("Room for only %d vehicles %.1f m apart on %s. Use a larger road network or smaller spacing.\n",
+               static_cast<int>(slots.size()),
+               settings.spacing,
+               settings.odr_file.c_str());
+        return -1;
+    }
+
+    pugi::xml_node root                    = doc.append_child("OpenSCENARIO");
+    pugi::xml_node header                  = root.append_child("FileHeader");
+    header.append_attribute("revMajor")    = 1;
+    header.append_attribute("revMinor")    = 3;
+    header.append_attribute("date")        = "2024-01-01T00:00:00";
+    header.append_attribute("description") = "Generated by esmini-bench";
+    header.append_attribute("author")      = "esmini-bench";
+
+    root.append_child("ParameterDeclarations");
+    root.append_child("CatalogLocations");
+    root.append_child("RoadNetwork").append_child("LogicFile").append_attribute("filepath") = settings.odr_file.c_str();
+
+    pugi::xml_node entities   = root.append_child("Entities");
+    pugi::xml_node storyboard = root.append_child("Storyboard");
+    pugi::xml_node actions    = storyboard.append_child("Init").append_child("Actions");
+
+    static const char* mix[] = {"default", "acc", "natural"};
+
+    for (unsigned int i = 0; i < settings.n_entities; i++)
+    {
+        // spread evenly over all slots
+        const LaneSlot& slot       = slots[static_cast<size_t>(i) * slots.size() / settings.n_entities];
+        std::string     name       = "car" + std::to_string(i);
+        std::string     controller = settings.controller == "mix" ? mix[i % 3] : settings.controller;
+
+        AddVehicle(entities, name, controller, slot, settings.speed);
+
+        pugi::xml_node priv                = actions.append_child("Private");
+        priv.append_attribute("entityRef") = name.c_str();
+
+        AddLanePosition(priv.append_child("PrivateAction").append_child("TeleportAction"), slot);
+
+        pugi::xml_node longitudinal                    = priv.append_child("PrivateAction").append_child("LongitudinalAction");
+        pugi::xml_node speed_action                    = longitudinal.append_child("SpeedAction");
+        pugi::xml_node dynamics                        = speed_action.append_child("SpeedActionDynamics");
+        dynamics.append_attribute("dynamicsShape")     = "step";
+        dynamics.append_attribute("dynamicsDimension") = "time";
+        dynamics.append_attribute("value")             = 0.0;
+        pugi::xml_node target                          = speed_action.append_child("SpeedActionTarget").append_child("AbsoluteTargetSpeed");
+        target.append_attribute("value")               = settings.speed;
+
+        if (controller != "default")
+        {
+            pugi::xml_node activate                   = priv.append_child("PrivateAction").append_child("ActivateControllerAction");
+            activate.append_attribute("longitudinal") = "true";
+            activate.append_attribute("lateral")      = "false";
+        }
+    }
+
+    if (settings.n_swarm > 0)
+    {
+        pugi::xml_node traffic                     = actions.prepend_child("GlobalAction").append_child("TrafficAction");
+        pugi::xml_node swarm                       = traffic.append_child("TrafficSwarmAction");
+        swarm.append_attribute("innerRadius")      = 50.0;
+        swarm.append_attribute("semiMajorAxis")    = 300.0;
+        swarm.append_attribute("semiMinorAxis")    = 500.0;
+        swarm.append_attribute("numberOfVehicles") = settings.n_swarm;
+        swarm.append_attribute("velocity")         = settings.speed;
+        swarm.append_attribute("offset")           = 0.0;
+
+        swarm.append_child("CentralObject").append_attribute("entityRef") = "car0";
+    }
+
+    if (settings.n_conditions > 0)
+    {
+        pugi::xml_node story           = storyboard.append_child("Story");
+        story.append_attribute("name") = "ConditionStory";
+        pugi::xml_node act             = story.append_child("Act");
+        act.append_attribute("name")   = "ConditionAct";
+
+        pugi::xml_node group                                           = act.append_child("ManeuverGroup");
+        group.append_attribute("name")                                 = "ConditionGroup";
+        group.append_attribute("maximumExecutionCount")                = 1;
+        pugi::xml_node actors                                          = group.append_child("Actors");
+        actors.append_attribute("selectTriggeringEntities")            = "false";
+        actors.append_child("EntityRef").append_attribute("entityRef") = "car0";
+
+        pugi::xml_node maneuver           = group.append_child("Maneuver");
+        maneuver.append_attribute("name") = "ConditionManeuver";
+
+        for (unsigned int i = 0; i < settings.n_conditions; i++)
+        {
+            pugi::xml_node event                           = maneuver.append_child("Event");
+            event.append_attribute("name")                 = ("event" + std::to_string(i)).c_str();
+            event.append_attribute("priority")             = "parallel";
+            pugi::xml_node action                          = event.append_child("Action");
+            action.append_attribute("name")                = ("action" + std::to_string(i)).c_str();
+            pugi::xml_node longitudinal                    = action.append_child("PrivateAction").append_child("LongitudinalAction");
+            pugi::xml_node speed_action                    = longitudinal.append_child("SpeedAction");
+            pugi::xml_node dynamics                        = speed_action.append_child("SpeedActionDynamics");
+            dynamics.append_attribute("dynamicsShape")     = "step";
+            dynamics.append_attribute("dynamicsDimension") = "time";
+            dynamics.append_attribute("value")             = 0.0;
+            pugi::xml_node target                          = speed_action.append_child("SpeedActionTarget").append_child("AbsoluteTargetSpeed");
+            target.append_attribute("value")               = 0.0;
+
+            AddEntityCondition(event.append_child("StartTrigger"), i, settings.n_entities);
+        }
+
+        AddSimulationTimeTrigger(act, "StartTrigger", -1.0);
+    }
+
+    storyboard.append_child("StopTrigger");
+
+    return 0;
+}
+
+int main(int argc, char* argv[])
+{
+    SE_Options  opt;
+    std::string arg_str;
+
+    opt.AddOption("collision", "Enable global collision detection");
+    opt.AddOption("conditions", "Number of storyboard events, each waiting for an entity condition never met", "number", "0", true);
+    opt.AddOption("controller", "Controller of the vehicles: default, acc, natural or mix (all three in turn)", "type", "default", true);
+    opt.AddOption("csv", "Append results to a CSV file, e.g. to collect a scaling curve", "filename");
+    opt.AddOption("entities", "Number of vehicles", "number", "100", true);
+    opt.AddOption("help", "Show this help message");
+    opt.AddOption("odr", "OpenDRIVE road network", "filename", DEFAULT_ODR_FILE, true);
+#ifdef _USE_OSI
+    opt.AddOption("osi_file", "Save OSI groundtruth data to file", "filename", DEFAULT_OSI_TRACE_FILENAME);
+#endif  // _USE_OSI
+    opt.AddOption("save_xosc", "Save the generated scenario", "filename");
+    opt.AddOption("spacing", "Minimum distance between vehicles at start [m]", "distance", "25", true);
+    opt.AddOption("speed", "Initial and desired speed of vehicles [m/s]", "speed", "20", true);
+    opt.AddOption("steps", "Number of measured steps", "number", "1000", true);
+    opt.AddOption("swarm", "Add swarm traffic with given number of vehicles around the first vehicle", "number");
+    opt.AddOption("timestep", "Fixed timestep [s]", "timestep", "0.05", true);
+    opt.AddOption("verbose", "Log from esmini to console");
+    opt.AddOption("warmup", "Number of steps before measurement starts", "number", "20", true);
+
+    // arguments after "--" are passed on to the scenario player, e.g. --step_threads 4
+    int bench_argc = argc;
+    for (int i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "--"))
+        {
+            bench_argc = i;
+            break;
+        }
+    }
+
+    if (opt.ParseArgs(bench_argc, argv) != 0 || opt.GetOptionSet("help"))
+    {
+        opt.PrintUsage();
+        printf("Additional arguments after -- are passed to the scenario player, e.g. -- --step_threads 4\n");
+        return opt.GetOptionSet("help") ? 0 : -1;
+    }
+
+    BenchSettings settings;
+    settings.odr_file     = opt.GetOptionArg("odr");
+    settings.n_entities   = static_cast<unsigned int>(strtoi(opt.GetOptionArg("entities")));
+    settings.n_conditions = static_cast<unsigned int>(strtoi(opt.GetOptionArg("conditions")));
+    settings.controller   = opt.GetOptionArg("controller");
+    settings.speed        = strtod(opt.GetOptionArg("speed"));
+    settings.spacing      = strtod(opt.GetOptionArg("spacing"));
+    if (opt.GetOptionSet("swarm"))
+    {
+        settings.n_swarm = static_cast<unsigned int>(strtoi(opt.GetOptionArg("swarm")));
+    }
+
+    int    n_steps  = strtoi(opt.GetOptionArg("steps"));
+    int    n_warmup = strtoi(opt.GetOptionArg("warmup"));
+    double timestep = strtod(opt.GetOptionArg("timestep"));
+
+    if (settings.n_entities < 1 || n_steps < 1 || timestep < SMALL_NUMBER || settings.spacing < SMALL_NUMBER)
+    {
+        printf("Number of entities and steps, timestep and spacing must be > 0\n");
+        return -1;
+    }
+    if (settings.controller != "default" && settings.controller != "acc" && settings.controller != "natural" && settings.controller != "mix")
+    {
+        printf("Unknown controller type %s\n", settings.controller.c_str());
+        return -1;
+    }
+
+    if (!opt.GetOptionSet("verbose"))
+    {
+        // also silence the road network loading below, before the player parses its arguments
+        SE_Env::Inst().GetOptions().SetOptionValue("disable_stdout", "", false, true);
+    }
+
+    pugi::xml_document doc;
+    if (GenerateScenario(settings, doc) != 0)
+    {
+        return -1;
+    }
+
+    std::ostringstream xml;
+    doc.save(xml, "  ");
+
+    if ((arg_str = opt.GetOptionArg("save_xosc")) != "")
+    {
+        doc.save_file(arg_str.c_str());
+    }
+
+    std::vector<std::string> player_args = {argv[0], "--osc_str", xml.str(), "--headless", "--disable_log"};
+    player_args.insert(player_args.end(), {"--fixed_timestep", std::to_string(timestep)});
+    if (!opt.GetOptionSet("verbose"))
+    {
+        player_args.push_back("--disable_stdout");
+    }
+    if (opt.GetOptionSet("collision"))
+    {
+        player_args.push_back("--collision");
+    }
+#ifdef _USE_OSI
+    if (opt.GetOptionSet("osi_file"))
+    {
+        player_args.insert(player_args.end(), {"--osi_file", opt.GetOptionArg("osi_file")});
+    }
+#endif  // _USE_OSI
+    for (int i = bench_argc + 1; i < argc; i++)
+    {
+        player_args.push_back(argv[i]);
+    }
+
+    std::vector<char*> player_argv;
+    for (auto& arg : player_args)
+    {
+        player_argv.push_back(&arg[0]);
+    }
+
+    std::unique_ptr<ScenarioPlayer> player;
+    try
+    {
+        player = std::make_unique<ScenarioPlayer>(static_cast<int>(player_argv.size()), player_argv.data());
+        if (player->Init() != 0)
+        {
+            printf("Failed to initialize generated scenario, rerun with --verbose for details\n");
+            return -1;
+        }
+    }
+    catch (const std::exception& e)
+    {
+        printf("Exception: %s\n", e.what());
+        return -1;
+    }
+
+    for (int i = 0; i < n_warmup && !player->IsQuitRequested(); i++)
+    {
+        player->Frame(timestep);
+    }
+
+    SE_Profiler::Inst().Reset();
+    SE_Profiler::Inst().Enable(true);
+
+    unsigned long long entity_steps = 0;
+    int                steps        = 0;
+    auto               start        = std::chrono::steady_clock::now();
+
+    for (; steps < n_steps && !player->IsQuitRequested(); steps++)
+    {
+        if (player->Frame(timestep) < 0)
+        {
+            break;
+        }
+        entity_steps += player->scenarioEngine->entities_.object_.size();
+    }
+
+    auto   end     = std::chrono::steady_clock::now();
+    double wall_s  = std::chrono::duration<double>(end - start).count();
+    size_t n_final = player->scenarioEngine->entities_.object_.size();
+
+    SE_Profiler::Inst().Enable(false);
+
+    if (steps == 0)
+    {
+        printf("Simulation ended before measurement\n");
+        return -1;
+    }
+
+    double    steps_per_s    = steps / wall_s;
+    double    ns_per_entity  = 1e9 * wall_s / static_cast<double>(entity_steps);
+    long long peak_memory_kb = PeakMemoryKB();
+
+    printf("Road network:      %s\n", settings.odr_file.c_str());
+    printf("Entities:          %u (%d at end, incl. swarm)\n", settings.n_entities, static_cast<int>(n_final));
+    printf("Controller:        %s\n", settings.controller.c_str());
+    printf("Conditions:        %u\n", settings.n_conditions);
+    printf("Collision:         %s\n", opt.GetOptionSet("collision") ? "on" : "off");
+    printf("OSI:               %s\n", opt.GetOptionSet("osi_file") ? "on" : "off");
+    printf("Steps:             %d x %.3f s\n", steps, timestep);
+    printf("Wall time:         %.3f s\n", wall_s);
+    printf("Steps/s:           %.1f\n", steps_per_s);
+    printf("ns/entity-step:    %.1f\n", ns_per_entity);
+    printf("Peak memory:       %.1f MB\n", static_cast<double>(peak_memory_kb) / 1024.0);
+
+    std::vector<SE_Profiler::Phase> phases = SE_Profiler::Inst().GetPhases();
+    printf("\n%-32s %10s %12s %12s %8s\n", "Phase", "Count", "Total [ms]", "Mean [us]", "Share");
+    for (const auto& phase : phases)
+    {
+        if (phase.count > 0)
+        {
+            printf("%-32s %10llu %12.2f %12.2f %7.1f%%\n",
+                   phase.name.c_str(),
+                   phase.count,
+                   phase.total_us * 1e-3,
+                   phase.total_us / static_cast<double>(phase.count),
+                   100.0 * phase.total_us * 1e-6 / wall_s);
+        }
+    }
+
+    if ((arg_str = opt.GetOptionArg("csv")) != "")
+    {
+        bool          exists = FileExists(arg_str.c_str());
+        std::ofstream file(arg_str, std::ios::app);
+        if (!file.good())
+        {
+            printf("Failed to open %s\n", arg_str.c_str());
+            return -1;
+        }
+        if (!exists)
+        {
+            file << "odr,entities,entities_end,controller,conditions,swarm,collision,osi,steps,timestep,wall_s,steps_per_s,ns_per_entity_step,"
+                    "peak_memory_kb\n";
+        }
+        file << settings.odr_file << "," << settings.n_entities << "," << n_final << "," << settings.controller << "," << settings.n_conditions << ","
+             << settings.n_swarm << "," << opt.GetOptionSet("collision") << "," << opt.GetOptionSet("osi_file") << "," << steps << "," << timestep
+             << "," << wall_s << "," << steps_per_s << "," << ns_per_entity << "," << peak_memory_kb << "\n";
+    }
+
+    return 0;
+}
@@ -11,10 +11,15 @@
  */
 
 #include <signal.h>
+#include <atomic>
+#include <fstream>
+#include <set>
+#include <thread>
 
 #include "playerbase.hpp"
 #include "CommonMini.hpp"
 #include "OSCParameterDistribution.hpp"
+#include "RoadManager.hpp"
 
 #ifdef _USE_IMPLOT
 #include "Plot.hpp"
@@ -26,8 +31,9 @@
 
 #define MIN_TIME_STEP 0.01
 #define MAX_TIME_STEP 0.1
+#define PARALLEL_DEFAULT_TIME_STEP 0.05  // used by parallel permutation runs unless fixed_timestep is specified
 
-static bool quit = false;
+static std::atomic<bool> quit{false};
 
 static void signal_handler(int s)
 {
@@ -122,11 +128,271 @@ static int execute_scenario(int argc, char* argv[])
     return (retval < 0 ? -1 : 0);
 }
 
+// Outcome of one permutation in a parallel run
+struct PermutationResult
+{
+    struct ObjectResult
+    {
+        int         id;
+        std::string name;
+        double      x;
+        double      y;
+        double      h;
+        double      speed;
+        bool        collision;  // collided at any time during the run
+    };
+
+    int                       status    = -1;  // 0 = ok, -1 = failed or not executed
+    double                    sim_time  = 0.0;
+    double                    wall_time = 0.0;
+    std::string               parameters;
+    std::vector<ObjectResult> objects;
+};
+
+// Arguments for worker runs, i.e. original ones except those not applicable to parallel headless runs
+static std::vector<std::string> worker_arguments(int argc, char* argv[])
+{
+    static const std::set<std::string> skip = {"--borderless-window",
+                                               "--param_dist_parallel",
+                                               "--param_dist_summary",
+                                               "--player_server",
+                                               "--plot",
+                                               "--server",
+                                               "--step_threads",
+                                               "--threads",
+                                               "--window"};
+    std::vector<std::string> args;
+
+    for (int i = 0; i < argc; i++)
+    {
+        if (i > 0 && skip.find(argv[i]) != skip.end())
+        {
+            // skip also any option values
+            while (i + 1 < argc && strncmp(argv[i + 1], "--", 2) != 0)
+            {
+                i++;
+            }
+            continue;
+        }
+        args.push_back(argv[i]);
+    }
+    args.insert(args.end(), {"--headless", "--disable_stdout", "--disable_log", "--collision"});
+
+    return args;
+}
+
+static void run_permutation(std::vector<std::string> args, unsigned int index, PermutationResult& result)
+{
+    SE_SystemTime      timer;
+    std::set<int>      collided;
+    std::vector<char*> argv;
+
+    args.push_back("--param_permutation");
+    args.push_back(std::to_string(index));
+    for (auto& arg : args)
+    {
+        argv.push_back(&arg[0]);
+    }
+
+    try
+    {
+        ScenarioPlayer player(static_cast<int>(argv.size()), argv.data());
+        if (player.Init() != 0)
+        {
+            return;
+        }
+
+        double dt     = player.GetFixedTimestep() > SMALL_NUMBER ? player.GetFixedTimestep() : PARALLEL_DEFAULT_TIME_STEP;
+        int    retval = 0;
+        while (!player.IsQuitRequested() && !quit && retval == 0)
+        {
+            retval = player.Frame(dt);
+
+            for (auto obj : player.scenarioEngine->entities_.object_)
+            {
+                if (!obj->collisions_.empty())
+                {
+                    collided.insert(obj->GetId());
+                }
+            }
+        }
+
+        OSCParameterDistribution& dist = OSCParameterDistribution::Inst();
+        for (unsigned int i = 0; i < dist.GetNumParameters(); i++)
+        {
+            result.parameters += (i > 0 ? " " : "") + dist.GetParamName(i) + "=" + dist.GetParamValue(i);
+        }
+
+        for (auto obj : player.scenarioEngine->entities_.object_)
+        {
+            result.objects.push_back({obj->GetId(),
+                                      obj->GetName(),
+                                      obj->pos_.GetX(),
+                                      obj->pos_.GetY(),
+                                      obj->pos_.GetH(),
+                                      obj->GetSpeed(),
+                                      collided.find(obj->GetId()) != collided.end()});
+        }
+
+        result.sim_time = player.scenarioEngine->getSimulationTime();
+        result.status   = retval < 0 ? -1 : 0;
+    }
+    catch (const std::exception&)
+    {
+        result.status = -1;
+    }
+
+    result.wall_time = timer.GetS();
+}
+
+// Format field according to RFC 4180, i.e. enclose in double quotes if it contains separator, quote or line break,
+// with any quotes doubled
+static std::string csv_field(const std::string& value)
+{
+    if (value.find_first_of(",\"\r\n") == std::string::npos)
+    {
+        return value;
+    }
+
+    std::string field = "\"";
+    for (char c : value)
+    {
+        field += c == '"' ? "\"\"" : std::string(1, c);
+    }
+    return field + "\"";
+}
+
+static int write_summary(const std::string& filename, const std::vector<PermutationResult>& results)
+{
+    // binary mode, since records are terminated by CRLF explicitly
+    std::ofstream file(filename, std::ios::binary);
+
+    if (!file.is_open())
+    {
+        LOG_ERROR("Failed to create summary file {}", filename);
+        return -1;
+    }
+
+    file << "permutation,status,sim_time,wall_time,parameters,object_id,object_name,x,y,h,speed,collision\r\n";
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        const PermutationResult& r           = results[i];
+        std::string              permutation = fmt::format("{},{},{:.3f},{:.3f},{}", i, r.status, r.sim_time, r.wall_time, csv_field(r.parameters));
+
+        if (r.objects.empty())
+        {
+            file << permutation << ",,,,,,,\r\n";
+        }
+        for (const auto& o : r.objects)
+        {
+            file << fmt::format("{},{},{},{:.3f},{:.3f},{:.3f},{:.3f},{}\r\n", permutation, o.id, csv_field(o.name), o.x, o.y, o.h, o.speed, o.collision);
+        }
+    }
+
+    return 0;
+}
+
+// Run all permutations of the parameter distribution in parallel worker threads, each one having its own
+// environment, parameter distribution and road network. Results are summarized into one file.
+static int execute_parallel(int argc, char* argv[])
+{
+    // Load distribution and parse arguments, then check number of permutations
+    std::vector<std::string> args = {argv, argv + argc};
+    std::vector<char*>       args_c;
+
+    args.push_back("--return_nr_permutations");
+    for (auto& arg : args)
+    {
+        args_c.push_back(&arg[0]);
+    }
+
+    int n_permutations = execute_scenario(static_cast<int>(args_c.size()), args_c.data());
+    if (n_permutations < 1)
+    {
+        LOG_ERROR("No parameter distribution permutations to run");
+        return -1;
+    }
+
+    // options were reset when the player quit, parse again to get the parallel run settings
+    SE_Options& opt = SE_Env::Inst().GetOptions();
+    opt.ParseArgs(argc, argv);
+
+    unsigned int n_threads = static_cast<unsigned int>(MAX(0, strtoi(opt.GetOptionArg("param_dist_parallel"))));
+    if (n_threads == 0)
+    {
+        n_threads = MAX(1U, std::thread::hardware_concurrency());
+    }
+    n_threads = MIN(n_threads, static_cast<unsigned int>(n_permutations));
+
+    // Workers log neither to console nor file, since a shared log would mix output of all permutations
+    LOG_INFO("Running {} permutations in {} threads", n_permutations, n_threads);
+    opt.SetOptionValue("disable_log", "");
+
+    std::vector<std::string>       w_args = worker_arguments(argc, argv);
+    std::vector<PermutationResult> results(static_cast<unsigned int>(n_permutations));
+    std::atomic<unsigned int>      next_index{0};
+    std::vector<std::thread>       threads;
+    SE_SystemTime                  timer;
+
+    for (unsigned int i = 0; i < n_threads; i++)
+    {
+        threads.emplace_back(
+            [&]()
+            {
+                SE_Env                   env;
+                OSCParameterDistribution dist;
+                roadmanager::OpenDrive   odr;
+
+                SE_Env::SetThreadInst(&env);
+                OSCParameterDistribution::SetThreadInst(&dist);
+                roadmanager::Position::SetThreadOpenDrive(&odr);
+
+                for (unsigned int index = next_index++; index < results.size() && !quit; index = next_index++)
+                {
+                    run_permutation(w_args, index, results[index]);
+                }
+
+                roadmanager::Position::SetThreadOpenDrive(nullptr);
+                OSCParameterDistribution::SetThreadInst(nullptr);
+                SE_Env::SetThreadInst(nullptr);
+            });
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    int n_failed = 0;
+    for (const auto& r : results)
+    {
+        n_failed += r.status != 0 ? 1 : 0;
+    }
+
+    std::string filename = opt.GetOptionArg("param_dist_summary");
+    LOG_INFO("Ran {} permutations in {:.2f} s, {} failed. Summary in {}", n_permutations, timer.GetS(), n_failed, filename);
+
+    if (write_summary(filename, results) != 0)
+    {
+        return -1;
+    }
+
+    return n_failed > 0 ? -1 : 0;
+}
+
 int main(int argc, char* argv[])
 {
     OSCParameterDistribution& dist   = OSCParameterDistribution::Inst();
     int                       retval = 0;
 
+    for (int i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "--param_dist_parallel"))
+        {
+            return execute_parallel(argc, argv);
+        }
+    }
+
     do
     {
         retval = execute_scenario(argc, argv);
@@ -0,0 +1,62 @@
+/*
+ * esmini - Environment Simulator Minimalistic
+ * https://github.com/esmini/esmini
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) partners of Simulation Scenarios
+ * https://sites.google.com/view/simulationscenarios
+ */
+
+/*
+ * This application precompiles OpenDRIVE road networks for faster loading.
+ *
+ * Generating OSI points of roads, lanes and road marks is the major part of the load time of a road network. This module
+ * loads each given OpenDRIVE file and saves the generated points into a binary file next to it, same name but with
+ * extension .odrbin. The file is picked up automatically whenever the road network is loaded, e.g. by esmini or
+ * esminiRMLib. It is ignored if the OpenDRIVE file has been changed since, or if other OSI tolerances are used.
+ */
+
+#include "RoadManager.hpp"
+#include "CommonMini.hpp"
+
+using namespace roadmanager;
+
+int main(int argc, char *argv[])
+{
+    if (argc < 2)
+    {
+        printf("Usage: odr2bin openDriveFile.xodr [more OpenDRIVE files...]\n");
+        printf("Creates a precompiled file <name>.odrbin next to each OpenDRIVE file\n");
+        return -1;
+    }
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string bin_file = OpenDrive::GetPrecompiledFilename(argv[i]);
+
+        // make sure points are generated from scratch
+        std::remove(bin_file.c_str());
+
+        if (Position::LoadOpenDrive(argv[i]) == false)
+        {
+            printf("Failed to open OpenDRIVE file %s\n", argv[i]);
+            return -1;
+        }
+
+        OpenDrive *od  = Position::GetOpenDrive();
+        uint64_t   key = od->GetOSIPointsCacheKey();
+
+        if (key == 0 || od->SaveOSIPoints(bin_file, key) != 0)
+        {
+            printf("Failed to create %s\n", bin_file.c_str());
+            return -1;
+        }
+
+        printf("Created %s\n", bin_file.c_str());
+    }
+
+    return 0;
+}
@@ -452,6 +452,7 @@ int main(int argc, char **argv)
     opt.AddOption("save_generated_model", "Save generated 3D model (n/a when a scenegraph is loaded)");
     opt.AddOption("seed", "Specify seed number for random generator", "number");
     opt.AddOption("speed_factor", "speed_factor <number>", "speed_factor", std::to_string(global_speed_factor));
+    opt.AddOption("spiral_exact", "Evaluate OpenDRIVE spirals (clothoids) by Fresnel integrals instead of precomputed lookup tables");
     opt.AddOption("stop_at_end_of_road", "Instead of respawning elsewhere, stop when no connection exists");
     opt.AddOption("text_scale", "Scale screen overlay text", "size factor", "1.0", true);
     opt.AddOption("traffic_rule", "Enforce left or right hand traffic, regardless OpenDRIVE rule attribute (default: right)", "rule (right/left)");
@@ -10,6 +10,10 @@
  * https://sites.google.com/view/simulationscenarios
  */
 
+#include <algorithm>
+#include <cstring>
+#include <sys/stat.h>
+
 #include "Replay.hpp"
 #include "ScenarioGateway.hpp"
 #include "CommonMini.hpp"
@@ -17,66 +21,34 @@
 
 using namespace scenarioengine;
 
-Replay::Replay(std::string filename, bool clean) : time_(0.0), index_(0), repeat_(false), clean_(clean)
+// Header of the index sidecar file (<recording>.idx), followed by segments and per segment odometer states
+struct ReplayIndexHeader
 {
-    file_.open(filename, std::ofstream::binary);
-    if (file_.fail())
-    {
-        LOG_ERROR("Cannot open file: {}", filename);
-        throw std::invalid_argument(std::string("Cannot open file: ") + filename);
-    }
-
-    file_.read(reinterpret_cast<char*>(&header_), sizeof(header_));
-    LOG_INFO("Recording {} opened. dat version: {} odr: {} model: {}",
-             FileNameOf(filename),
-             header_.version,
-             FileNameOf(header_.odr_filename),
-             FileNameOf(header_.model_filename));
-
-    if (header_.version != DAT_FILE_FORMAT_VERSION)
-    {
-        LOG_ERROR_AND_QUIT("Version mismatch. {} is version {} while supported version is {}. Please re-create dat file.",
-                           filename,
-                           header_.version,
-                           DAT_FILE_FORMAT_VERSION);
-    }
-
-    if (header_.version != DAT_FILE_FORMAT_VERSION)
-    {
-        LOG_ERROR_AND_QUIT("Version mismatch. {} is version {} while supported version is {}. Please re-create dat file.",
-                           filename,
-                           header_.version,
-                           DAT_FILE_FORMAT_VERSION);
-    }
-
-    while (!file_.eof())
+    int                version;
+    int                needs_clean;
+    int                sorted;
+    unsigned int       n_entries;
+    unsigned int       n_segments;
+    unsigned int       entry_size;  // sizeof(ObjectStateStructDat), to detect incompatible builds
+    unsigned long long dat_size;
+    long long          dat_mtime;
+};
+
+Replay::Replay(std::string filename, bool clean, LoadMode mode) : time_(0.0), index_(0), repeat_(false), clean_(clean)
+{
+    if (mode != LoadMode::STREAMING || OpenStreaming(filename) != 0)
     {
-        ReplayEntry data;
+        ReadFile(filename, data_);
 
-        file_.read(reinterpret_cast<char*>(&data.state), sizeof(data.state));
-
-        if (!file_.eof())
+        if (clean_)
         {
-            data_.push_back(data);
+            CleanEntries(data_);
         }
-    }
 
-    if (clean_)
-    {
-        CleanEntries(data_);
+        UpdateOdometers();
     }
 
-    if (data_.size() > 0)
-    {
-        // Register first entry timestamp as starting time
-        time_       = data_[0].state.info.timeStamp;
-        startTime_  = time_;
-        startIndex_ = 0;
-
-        // Register last entry timestamp as stop time
-        stopTime_  = data_.back().state.info.timeStamp;
-        stopIndex_ = static_cast<unsigned int>(FindIndexAtTimestamp(stopTime_));
-    }
+    InitTimeRange();
 }
 
 Replay::Replay(const std::string directory, const std::string scenario, std::string create_datfile)
@@ -90,41 +62,11 @@ Replay::Replay(const std::string directory, const std::string scenario, std::str
 
     for (size_t i = 0; i < scenarios_.size(); i++)
     {
-        file_.open(scenarios_[i], std::ofstream::binary);
-        if (file_.fail())
-        {
-            LOG_ERROR("Cannot open file: {}", scenarios_[i]);
-            throw std::invalid_argument(std::string("Cannot open file: ") + scenarios_[i]);
-        }
-        file_.read(reinterpret_cast<char*>(&header_), sizeof(header_));
-        LOG_INFO("Recording {} opened. dat version: {} odr: {} model: {}",
-                 FileNameOf(scenarios_[i]),
-                 header_.version,
-                 FileNameOf(header_.odr_filename),
-                 FileNameOf(header_.model_filename));
+        ReadFile(scenarios_[i], data_);
 
-        if (header_.version != DAT_FILE_FORMAT_VERSION)
-        {
-            LOG_ERROR_AND_QUIT("Version mismatch. {} is version {} while supported version is {}. Please re-create dat file.",
-                               scenarios_[i],
-                               header_.version,
-                               DAT_FILE_FORMAT_VERSION);
-        }
-        while (!file_.eof())
-        {
-            ReplayEntry entry;
-
-            file_.read(reinterpret_cast<char*>(&entry.state), sizeof(entry.state));
-
-            if (!file_.eof())
-            {
-                data_.push_back(entry);
-            }
-        }
         // pair <scenario name, scenario data>
         scenarioData.push_back(std::make_pair(scenarios_[i], data_));
         data_ = {};
-        file_.close();
     }
 
     if (scenarioData.size() < 2)
@@ -152,18 +94,8 @@ Replay::Replay(const std::string directory, const std::string scenario, std::str
 
     // Build remaining data in order.
     BuildData(scenarioData);
-
-    if (data_.size() > 0)
-    {
-        // Register first entry timestamp as starting time
-        time_       = data_[0].state.info.timeStamp;
-        startTime_  = time_;
-        startIndex_ = 0;
-
-        // Register last entry timestamp as stop time
-        stopTime_  = data_.back().state.info.timeStamp;
-        stopIndex_ = static_cast<unsigned int>(FindIndexAtTimestamp(stopTime_));
-    }
+    UpdateOdometers();
+    InitTimeRange();
 
     if (!create_datfile_.empty())
     {
@@ -280,11 +212,11 @@ void Replay::GoToTime(double time, bool stop_at_next_frame)
         if (time > time_)
         {
             next_index = FindNextTimestamp();
-            if (next_index > index_ && time > static_cast<double>(data_[next_index].state.info.timeStamp) &&
-                static_cast<double>(data_[next_index].state.info.timeStamp) <= GetStopTime())
+            if (next_index > index_ && time > static_cast<double>(GetTimestamp(static_cast<unsigned int>(next_index))) &&
+                static_cast<double>(GetTimestamp(static_cast<unsigned int>(next_index))) <= GetStopTime())
             {
                 index_ = static_cast<unsigned int>(next_index);
-                time_  = data_[index_].state.info.timeStamp;
+                time_  = GetTimestamp(index_);
             }
             else
             {
@@ -301,10 +233,10 @@ void Replay::GoToTime(double time, bool stop_at_next_frame)
         else if (time < time_)
         {
             next_index = FindPreviousTimestamp();
-            if (next_index < index_ && time < static_cast<double>(data_[next_index].state.info.timeStamp))
+            if (next_index < index_ && time < static_cast<double>(GetTimestamp(static_cast<unsigned int>(next_index))))
             {
                 index_ = static_cast<unsigned int>(next_index);
-                time_  = data_[index_].state.info.timeStamp;
+                time_  = GetTimestamp(index_);
             }
             else
             {
@@ -328,12 +260,12 @@ void Replay::GoToDeltaTime(double dt, bool stop_at_next_frame)
 
 int Replay::GoToNextFrame()
 {
-    float ctime = data_[index_].state.info.timeStamp;
-    for (size_t i = index_ + 1; i < data_.size(); i++)
+    float ctime = GetTimestamp(index_);
+    for (unsigned int i = index_ + 1; i < GetNumberOfEntries(); i++)
     {
-        if (data_[i].state.info.timeStamp > ctime)
+        if (GetTimestamp(i) > ctime)
         {
-            GoToTime(data_[i].state.info.timeStamp);
+            GoToTime(static_cast<double>(GetTimestamp(i)));
             return static_cast<int>(i);
         }
     }
@@ -344,7 +276,7 @@ void Replay::GoToPreviousFrame()
 {
     if (index_ > 0)
     {
-        GoToTime(data_[index_ - 1].state.info.timeStamp);
+        GoToTime(static_cast<double>(GetTimestamp(index_ - 1)));
     }
 }
 
@@ -368,29 +300,64 @@ int Replay::FindIndexAtTimestamp(double timestamp, int startSearchIndex)
         startSearchIndex = 0;
     }
 
-    for (i = startSearchIndex; i < static_cast<int>(data_.size()); i++)
+    int n_entries = static_cast<int>(GetNumberOfEntries());
+    if (sorted_ && startSearchIndex < n_entries)
     {
-        if (static_cast<double>(data_[static_cast<unsigned int>(i)].state.info.timeStamp) >= timestamp)
+        // binary search for first entry at or after given timestamp
+        auto before = [](const ReplayEntry& entry, double t) { return static_cast<double>(entry.state.info.timeStamp) < t; };
+
+        if (streaming_)
         {
-            break;
+            // first narrow down to segment, then search within it
+            auto seg_it = std::lower_bound(segments_.begin() + FindSegment(static_cast<unsigned int>(startSearchIndex)),
+                                           segments_.end(),
+                                           timestamp,
+                                           [](const Segment& seg, double t) { return static_cast<double>(seg.t_end) < t; });
+
+            if (seg_it == segments_.end())
+            {
+                i = n_entries;
+            }
+            else
+            {
+                unsigned int first = MAX(seg_it->first, static_cast<unsigned int>(startSearchIndex));
+                unsigned int n     = seg_it->first + seg_it->n_entries - first;
+                ReplayEntry* entry = GetEntryByIdx(first);
+                i                  = static_cast<int>(first) + static_cast<int>(std::lower_bound(entry, entry + n, timestamp, before) - entry);
+            }
+        }
+        else
+        {
+            i = static_cast<int>(std::lower_bound(data_.begin() + startSearchIndex, data_.end(), timestamp, before) - data_.begin());
+        }
+    }
+    else
+    {
+        for (i = startSearchIndex; i < n_entries; i++)
+        {
+            if (static_cast<double>(GetTimestamp(static_cast<unsigned int>(i))) >= timestamp)
+            {
+                break;
+            }
         }
     }
 
-    return MIN(i, static_cast<int>(data_.size()) - 1);
+    return MIN(i, n_entries - 1);
 }
 
 unsigned int Replay::FindNextTimestamp(bool wrap)
 {
     unsigned int index = index_ + 1;
-    for (; index < data_.size(); index++)
+    float        ctime = GetTimestamp(index_);
+    for (; index < GetNumberOfEntries(); index++)
     {
-        if (data_[index].state.info.timeStamp > data_[index_].state.info.timeStamp)
+        if (GetTimestamp(index) > ctime)
         {
             break;
         }
     }
 
-    if (index >= data_.size())
+    if (index >= GetNumberOfEntries())
     {
         if (wrap)
         {
@@ -413,7 +380,7 @@ unsigned int Replay::FindPreviousTimestamp(bool wrap)
     {
         if (wrap)
         {
-            index = static_cast<int>(data_.size()) - 1;
+            index = static_cast<int>(GetNumberOfEntries()) - 1;
         }
         else
         {
@@ -421,10 +388,11 @@ unsigned int Replay::FindPreviousTimestamp(bool wrap)
         }
     }
 
+    float ctime = GetTimestamp(static_cast<unsigned int>(index));
     for (int i = index - 1; i >= 0; i--)
     {
         // go backwards until we identify the first entry with same timestamp
-        if (data_[static_cast<unsigned int>(i)].state.info.timeStamp < data_[static_cast<unsigned int>(index)].state.info.timeStamp)
+        if (GetTimestamp(static_cast<unsigned int>(i)) < ctime)
         {
             break;
         }
@@ -437,15 +405,18 @@ unsigned int Replay::FindPreviousTimestamp(bool wrap)
 ReplayEntry* Replay::GetEntry(int id)
 {
     // Read all vehicles at current timestamp
-    float timestamp = data_[index_].state.info.timeStamp;
-    int   i         = 0;
-    while (index_ + static_cast<unsigned int>(i) < data_.size() && !(data_[index_ + static_cast<unsigned int>(i)].state.info.timeStamp > timestamp))
+    float timestamp = GetTimestamp(index_);
+    for (unsigned int i = index_; i < GetNumberOfEntries(); i++)
     {
-        if (data_[index_ + static_cast<unsigned int>(i)].state.info.id == id)
+        ReplayEntry* entry = GetEntryByIdx(i);
+        if (entry->state.info.timeStamp > timestamp)
+        {
+            break;
+        }
+        if (entry->state.info.id == id)
         {
-            return &data_[index_ + static_cast<unsigned int>(i)];
+            return entry;
         }
-        i++;
     }
 
     return nullptr;
@@ -583,22 +554,471 @@ void Replay::BuildData(std::vector<std::pair<std::string, std::vector<ReplayEntr
 
 void Replay::CreateMergedDatfile(const std::string filename)
 {
-    std::ofstream data_file_;
-    data_file_.open(filename, std::ofstream::binary);
-    if (data_file_.fail())
+    DatWriter writer;
+    if (writer.Open(filename, header_.odr_filename, header_.model_filename) != 0)
     {
-        LOG_ERROR("Cannot open file: {}", filename);
         exit(-1);
     }
 
-    data_file_.write(reinterpret_cast<char*>(&header_), sizeof(header_));
+    // Write status to file - for later replay
+    for (size_t i = 0; i < data_.size(); i++)
+    {
+        writer.Write(data_[i].state);
+        if (i + 1 == data_.size() || data_[i + 1].state.info.timeStamp > data_[i].state.info.timeStamp)
+        {
+            writer.EndFrame();
+        }
+    }
+    writer.Close();
+}
+
+void Replay::ReadFile(const std::string filename, std::vector<ReplayEntry>& entries)
+{
+    DatReader reader;
+
+    int retval = reader.Open(filename);
+    if (retval == -1)
+    {
+        LOG_ERROR("Cannot open file: {}", filename);
+        throw std::invalid_argument(std::string("Cannot open file: ") + filename);
+    }
+
+    header_ = reader.header_;
+    LOG_INFO("Recording {} opened. dat version: {} odr: {} model: {}",
+             FileNameOf(filename),
+             header_.version,
+             FileNameOf(header_.odr_filename),
+             FileNameOf(header_.model_filename));
+
+    if (retval != 0)
+    {
+        LOG_ERROR_AND_QUIT("Version mismatch. {} is version {} while supported versions are {} and {}. Please re-create dat file.",
+                           filename,
+                           header_.version,
+                           DAT_FILE_FORMAT_VERSION_RAW,
+                           DAT_FILE_FORMAT_VERSION);
+    }
+
+    ReplayEntry entry;
+    entry.odometer = 0.0;
+    while (reader.ReadNext(entry.state) == 0)
+    {
+        entries.push_back(entry);
+    }
+}
+
+ReplayEntry* Replay::GetEntryByIdx(unsigned int idx)
+{
+    if (!streaming_)
+    {
+        return &data_[idx];
+    }
+
+    if (idx >= n_entries_)
+    {
+        return nullptr;
+    }
+
+    unsigned int segment = FindSegment(idx);
+    unsigned int offset  = idx - segments_[segment].first;
+
+    for (auto it = segment_cache_.begin(); it != segment_cache_.end(); it++)
+    {
+        if (it->first == segment)
+        {
+            // move to front, i.e. most recently used
+            segment_cache_.splice(segment_cache_.begin(), segment_cache_, it);
+            return &segment_cache_.front().second[offset];
+        }
+    }
+
+    std::vector<ReplayEntry> entries;
+    if (DecodeSegment(segment, entries) != 0 || offset >= entries.size())
+    {
+        return nullptr;
+    }
+
+    segment_cache_.emplace_front(segment, std::move(entries));
+    if (segment_cache_.size() > REPLAY_SEGMENT_CACHE_SIZE)
+    {
+        segment_cache_.pop_back();
+    }
+
+    return &segment_cache_.front().second[offset];
+}
+
+unsigned int Replay::FindSegment(unsigned int idx)
+{
+    auto it = std::upper_bound(segments_.begin(), segments_.end(), idx, [](unsigned int i, const Segment& seg) { return i < seg.first; });
+    return it == segments_.begin() ? 0 : static_cast<unsigned int>(it - segments_.begin()) - 1;
+}
+
+void Replay::StepOdometer(std::map<int, OdometerState>& odometers, ReplayEntry& entry)
+{
+    const ObjectStateStructDat& state = entry.state;
+
+    auto it = odometers.find(state.info.id);
+    if (it == odometers.end())
+    {
+        // Set inital odometer value for the entity
+        odometers[state.info.id] = {state.info.id, state.pos.x, state.pos.y, 0.0};
+        entry.odometer           = 0.0;
+        return;
+    }
+
+    OdometerState& odo = it->second;
+    odo.odometer +=
+        GetLengthOfLine2D(static_cast<double>(odo.x), static_cast<double>(odo.y), static_cast<double>(state.pos.x), static_cast<double>(state.pos.y));
+    odo.x          = state.pos.x;
+    odo.y          = state.pos.y;
+    entry.odometer = odo.odometer;
+}
 
-    if (data_file_.is_open())
+void Replay::UpdateOdometers()
+{
+    std::map<int, OdometerState> odometers;
+
+    sorted_ = true;
+    for (size_t i = 0; i < data_.size(); i++)
     {
-        // Write status to file - for later replay
-        for (size_t i = 0; i < data_.size(); i++)
+        if (i > 0 && data_[i].state.info.timeStamp < data_[i - 1].state.info.timeStamp)
         {
-            data_file_.write(reinterpret_cast<char*>(&data_[i].state), sizeof(data_[i].state));
+            sorted_ = false;
         }
+        StepOdometer(odometers, data_[i]);
     }
-}
\ No newline at end of file
+}
+
+void Replay::InitTimeRange()
+{
+    if (GetNumberOfEntries() > 0)
+    {
+        // Register first entry timestamp as starting time
+        time_       = GetTimestamp(0);
+        startTime_  = time_;
+        startIndex_ = 0;
+
+        // Register last entry timestamp as stop time
+        stopTime_  = GetTimestamp(GetNumberOfEntries() - 1);
+        stopIndex_ = static_cast<unsigned int>(FindIndexAtTimestamp(stopTime_));
+    }
+}
+
+int Replay::OpenStreaming(const std::string& filename)
+{
+    if (mapped_file_.Open(filename) != 0 || mapped_file_.GetSize() < sizeof(DatHeader))
+    {
+        mapped_file_.Close();
+        return -1;
+    }
+
+    memcpy(&header_, mapped_file_.GetData(), sizeof(DatHeader));
+    if (header_.version != DAT_FILE_FORMAT_VERSION && header_.version != DAT_FILE_FORMAT_VERSION_RAW)
+    {
+        // let regular file reading report the issue
+        mapped_file_.Close();
+        return -1;
+    }
+
+    // streaming is active while indexing, entries being decoded by segment
+    streaming_       = true;
+    bool needs_clean = false;
+    if (LoadIndex(filename, needs_clean) != 0)
+    {
+        BuildIndex(needs_clean);
+        if (mapped_file_.GetSize() > REPLAY_INDEX_MIN_FILE_SIZE)
+        {
+            SaveIndex(filename, needs_clean);
+        }
+    }
+
+    if (clean_ && needs_clean)
+    {
+        LOG_INFO("Recording {} has unordered or duplicate entries, loading all of it for cleaning", FileNameOf(filename));
+        streaming_ = false;
+        n_entries_ = 0;
+        segments_.clear();
+        segment_odometer_.clear();
+        segment_cache_.clear();
+        mapped_file_.Close();
+        return -1;
+    }
+
+    LOG_INFO("Recording {} opened for streaming. dat version: {} odr: {} model: {} entries: {} segments: {}",
+             FileNameOf(filename),
+             header_.version,
+             FileNameOf(header_.odr_filename),
+             FileNameOf(header_.model_filename),
+             n_entries_,
+             segments_.size());
+
+    return 0;
+}
+
+int Replay::BuildIndex(bool& needs_clean)
+{
+    const unsigned char* data = mapped_file_.GetData();
+    size_t               size = mapped_file_.GetSize();
+
+    n_entries_ = 0;
+    segments_.clear();
+    segment_odometer_.clear();
+    segment_cache_.clear();
+
+    if (header_.version == DAT_FILE_FORMAT_VERSION_RAW)
+    {
+        unsigned int n = static_cast<unsigned int>((size - sizeof(DatHeader)) / sizeof(ObjectStateStructDat));
+        for (unsigned int first = 0; first < n; first += REPLAY_SEGMENT_SIZE)
+        {
+            unsigned int       n_seg  = MIN(static_cast<unsigned int>(REPLAY_SEGMENT_SIZE), n - first);
+            unsigned long long offset = sizeof(DatHeader) + static_cast<unsigned long long>(first) * sizeof(ObjectStateStructDat);
+            segments_.push_back({0.0f, 0.0f, offset, first, n_seg});
+        }
+        n_entries_ = n;
+    }
+    else
+    {
+        // chunks end where the index begins, or at end of file if recording was not closed properly
+        size_t         data_end = size;
+        DatIndexFooter footer;
+        if (size >= sizeof(DatHeader) + sizeof(footer))
+        {
+            memcpy(&footer, data + size - sizeof(footer), sizeof(footer));
+            if (IsValidDatIndexFooter(footer, size))
+            {
+                data_end = static_cast<size_t>(footer.offset);
+            }
+        }
+
+        DatChunkHeader chunk_header;
+        for (size_t pos = sizeof(DatHeader); pos + sizeof(chunk_header) <= data_end; pos += sizeof(chunk_header) + chunk_header.size)
+        {
+            memcpy(&chunk_header, data + pos, sizeof(chunk_header));
+            if (pos + sizeof(chunk_header) + chunk_header.size > data_end)
+            {
+                LOG_WARN("dat: Truncated chunk, skipping remaining data");
+                break;
+            }
+
+            if (chunk_header.n_records > 0)
+            {
+                segments_.push_back({chunk_header.t_start, chunk_header.t_end, pos, n_entries_, chunk_header.n_records});
+                n_entries_ += chunk_header.n_records;
+            }
+        }
+    }
+
+    // Decode all segments once to register odometers at start of each segment, and to look for entries needing cleaning
+    std::map<int, OdometerState> odometers;
+    std::vector<int>             frame_ids;
+    float                        frame_time = 0.0f;
+    float                        prev_time  = 0.0f;
+    std::vector<ReplayEntry>     entries;
+    bool                         first_entry = true;
+
+    sorted_     = true;
+    needs_clean = false;
+    for (unsigned int i = 0; i < segments_.size(); i++)
+    {
+        segment_odometer_.emplace_back();
+        for (auto& odo : odometers)
+        {
+            segment_odometer_.back().push_back(odo.second);
+        }
+
+        entries.clear();
+        if (DecodeSegment(i, entries) != 0)
+        {
+            // keep entries up to the corrupt one, same as when reading all entries
+            n_entries_             = segments_[i].first + static_cast<unsigned int>(entries.size());
+            segments_[i].n_entries = static_cast<unsigned int>(entries.size());
+            segments_.resize(entries.size() > 0 ? i + 1 : i);
+            segment_odometer_.resize(segments_.size());
+        }
+
+        for (auto& entry : entries)
+        {
+            const ObjectInfoStructDat& info = entry.state.info;
+            if (!first_entry)
+            {
+                if (info.timeStamp < prev_time)
+                {
+                    sorted_     = false;
+                    needs_clean = true;
+                }
+
+                if (!NEAR_NUMBERSF(info.timeStamp, frame_time))
+                {
+                    frame_time = info.timeStamp;
+                    frame_ids.clear();
+                }
+                else if (std::find(frame_ids.begin(), frame_ids.end(), info.id) != frame_ids.end())
+                {
+                    needs_clean = true;
+                }
+            }
+            else
+            {
+                frame_time  = info.timeStamp;
+                first_entry = false;
+            }
+            frame_ids.push_back(info.id);
+            prev_time = info.timeStamp;
+
+            odometers[info.id] = {info.id, entry.state.pos.x, entry.state.pos.y, entry.odometer};
+        }
+
+        if (entries.size() > 0)
+        {
+            segments_[i].t_start = entries.front().state.info.timeStamp;
+            segments_[i].t_end   = entries.back().state.info.timeStamp;
+        }
+    }
+
+    return 0;
+}
+
+int Replay::LoadIndex(const std::string& filename, bool& needs_clean)
+{
+    struct stat file_stat;
+    if (stat(filename.c_str(), &file_stat) != 0)
+    {
+        return -1;
+    }
+
+    std::ifstream file(filename + ".idx", std::ifstream::binary);
+    if (file.fail())
+    {
+        return -1;
+    }
+
+    ReplayIndexHeader header;
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) || header.version != REPLAY_INDEX_FILE_VERSION ||
+        header.entry_size != sizeof(ObjectStateStructDat) || header.dat_size != static_cast<unsigned long long>(mapped_file_.GetSize()) ||
+        header.dat_mtime != static_cast<long long>(file_stat.st_mtime))
+    {
+        // outdated or not matching recording
+        return -1;
+    }
+
+    segments_.resize(header.n_segments);
+    segment_odometer_.resize(header.n_segments);
+    if (!file.read(reinterpret_cast<char*>(segments_.data()), static_cast<std::streamsize>(segments_.size() * sizeof(Segment))))
+    {
+        segments_.clear();
+        segment_odometer_.clear();
+        return -1;
+    }
+
+    for (auto& odometers : segment_odometer_)
+    {
+        unsigned int n = 0;
+        if (!file.read(reinterpret_cast<char*>(&n), sizeof(n)))
+        {
+            segments_.clear();
+            segment_odometer_.clear();
+            return -1;
+        }
+        odometers.resize(n);
+        file.read(reinterpret_cast<char*>(odometers.data()), static_cast<std::streamsize>(n * sizeof(OdometerState)));
+    }
+
+    if (file.fail())
+    {
+        segments_.clear();
+        segment_odometer_.clear();
+        return -1;
+    }
+
+    n_entries_  = header.n_entries;
+    sorted_     = header.sorted != 0;
+    needs_clean = header.needs_clean != 0;
+
+    return 0;
+}
+
+void Replay::SaveIndex(const std::string& filename, bool needs_clean)
+{
+    struct stat file_stat;
+    if (stat(filename.c_str(), &file_stat) != 0)
+    {
+        return;
+    }
+
+    std::ofstream file(filename + ".idx", std::ofstream::binary);
+    if (file.fail())
+    {
+        LOG_WARN("Failed to save replay index {}.idx", filename);
+        return;
+    }
+
+    ReplayIndexHeader header = {REPLAY_INDEX_FILE_VERSION,
+                                needs_clean ? 1 : 0,
+                                sorted_ ? 1 : 0,
+                                n_entries_,
+                                static_cast<unsigned int>(segments_.size()),
+                                static_cast<unsigned int>(sizeof(ObjectStateStructDat)),
+                                static_cast<unsigned long long>(mapped_file_.GetSize()),
+                                static_cast<long long>(file_stat.st_mtime)};
+
+    file.write(reinterpret_cast<char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<char*>(segments_.data()), static_cast<std::streamsize>(segments_.size() * sizeof(Segment)));
+    for (auto& odometers : segment_odometer_)
+    {
+        unsigned int n = static_cast<unsigned int>(odometers.size());
+        file.write(reinterpret_cast<char*>(&n), sizeof(n));
+        file.write(reinterpret_cast<char*>(odometers.data()), static_cast<std::streamsize>(n * sizeof(OdometerState)));
+    }
+}
+
+int Replay::DecodeSegment(unsigned int segment, std::vector<ReplayEntry>& entries)
+{
+    const Segment&       seg  = segments_[segment];
+    const unsigned char* data = mapped_file_.GetData() + seg.offset;
+    ReplayEntry          entry;
+    int                  retval = 0;
+
+    entries.reserve(seg.n_entries);
+    entry.odometer = 0.0;
+
+    if (header_.version == DAT_FILE_FORMAT_VERSION_RAW)
+    {
+        for (unsigned int i = 0; i < seg.n_entries; i++)
+        {
+            memcpy(&entry.state, data + i * sizeof(ObjectStateStructDat), sizeof(ObjectStateStructDat));
+            entries.push_back(entry);
+        }
+    }
+    else
+    {
+        DatChunkHeader chunk_header;
+        DatCodec       codec;
+        size_t         pos = 0;
+
+        memcpy(&chunk_header, data, sizeof(chunk_header));
+        for (unsigned int i = 0; i < seg.n_entries; i++)
+        {
+            if (codec.Decode(data + sizeof(chunk_header), chunk_header.size, pos, entry.state) != 0)
+            {
+                LOG_ERROR("dat: Failed to decode object state");
+                retval = -1;
+                break;
+            }
+            entries.push_back(entry);
+        }
+    }
+
+    // continue odometers from start of segment
+    std::map<int, OdometerState> odometers;
+    for (auto& odo : segment_odometer_[segment])
+    {
+        odometers[odo.id] = odo;
+    }
+
+    for (auto& e : entries)
+    {
+        StepOdometer(odometers, e);
+    }
+
+    return retval;
+}
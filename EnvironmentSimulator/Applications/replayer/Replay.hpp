@@ -14,9 +14,16 @@
 
 #include <string>
 #include <fstream>
+#include <list>
+#include <map>
 #include "CommonMini.hpp"
 #include "ScenarioGateway.hpp"
 
+#define REPLAY_SEGMENT_SIZE        1024               // number of entries per segment for uncompressed (version 2) recordings
+#define REPLAY_SEGMENT_CACHE_SIZE  4                  // number of decoded segments kept in memory when streaming
+#define REPLAY_INDEX_MIN_FILE_SIZE (8 * 1024 * 1024)  // save index sidecar file for recordings larger than this, in bytes
+#define REPLAY_INDEX_FILE_VERSION  1
+
 namespace scenarioengine
 {
     typedef struct
@@ -31,7 +38,20 @@ namespace scenarioengine
         DatHeader                header_;
         std::vector<ReplayEntry> data_;
 
-        Replay(std::string filename, bool clean);
+        enum class LoadMode
+        {
+            LOAD_ALL,   // read all entries into memory
+            STREAMING,  // memory map the file and decode only segments being accessed
+        };
+
+        /**
+                Open recording
+                @param filename Recording (.dat) file
+                @param clean If true remove entries with decreasing timestamps and duplicate entries of same timestamp
+                @param mode How to access entries. Streaming falls back to loading all entries if cleaning is requested and the recording
+                needs it.
+        */
+        Replay(std::string filename, bool clean, LoadMode mode = LoadMode::LOAD_ALL);
         // Replay(const std::string directory, const std::string scenario, bool clean);
         Replay(const std::string directory, const std::string scenario, std::string create_datfile);
         ~Replay();
@@ -75,12 +95,42 @@ namespace scenarioengine
         {
             repeat_ = repeat;
         }
+        /**
+                Get entry by index, regardless of mode. When streaming the pointer is valid until a few other segments have been accessed.
+        */
+        ReplayEntry* GetEntryByIdx(unsigned int idx);
+        unsigned int GetNumberOfEntries() const
+        {
+            return streaming_ ? n_entries_ : static_cast<unsigned int>(data_.size());
+        }
+        bool IsStreaming() const
+        {
+            return streaming_;
+        }
         void CleanEntries(std::vector<ReplayEntry>& entries);
         void BuildData(std::vector<std::pair<std::string, std::vector<ReplayEntry>>>& scenarios);
         void CreateMergedDatfile(const std::string filename);
 
     private:
-        std::ifstream            file_;
+        // Contiguous range of entries, decoded as a unit when streaming
+        struct Segment
+        {
+            float              t_start;
+            float              t_end;
+            unsigned long long offset;  // file position of first entry (version 2) or chunk header (version 3)
+            unsigned int       first;   // index of first entry
+            unsigned int       n_entries;
+        };
+
+        // Odometer of an object at the start of a segment
+        struct OdometerState
+        {
+            int    id;
+            float  x;
+            float  y;
+            double odometer;
+        };
+
         std::vector<std::string> scenarios_;
         double                   time_;
         double                   startTime_;
@@ -92,7 +142,32 @@ namespace scenarioengine
         bool                     clean_;
         std::string              create_datfile_;
 
-        int FindIndexAtTimestamp(double timestamp, int startSearchIndex = 0);
+        bool                                                         sorted_    = true;  // timestamps are non-decreasing
+        bool                                                         streaming_ = false;
+        SE_MappedFile                                                mapped_file_;
+        unsigned int                                                 n_entries_ = 0;
+        std::vector<Segment>                                         segments_;
+        std::vector<std::vector<OdometerState>>                      segment_odometer_;  // per segment
+        std::list<std::pair<unsigned int, std::vector<ReplayEntry>>> segment_cache_;     // decoded segments, most recently used first
+
+        int   FindIndexAtTimestamp(double timestamp, int startSearchIndex = 0);
+        float GetTimestamp(unsigned int idx)
+        {
+            return GetEntryByIdx(idx)->state.info.timeStamp;
+        }
+        void ReadFile(const std::string filename, std::vector<ReplayEntry>& entries);
+        void UpdateOdometers();
+        void StepOdometer(std::map<int, OdometerState>& odometers, ReplayEntry& entry);
+        void InitTimeRange();
+
+        int  OpenStreaming(const std::string& filename);
+        int  BuildIndex(bool& needs_clean);
+        int  LoadIndex(const std::string& filename, bool& needs_clean);
+        void SaveIndex(const std::string& filename, bool needs_clean);
+        int  DecodeSegment(unsigned int segment, std::vector<ReplayEntry>& entries);
+
+        // Find segment containing entry of given index
+        unsigned int FindSegment(unsigned int idx);
     };
 
 }  // namespace scenarioengine
\ No newline at end of file
@@ -48,7 +48,7 @@ int main(int argc, char** argv)
     // Create replayer object for parsing the binary data file
     try
     {
-        player = new Replay(argv[1], false);
+        player = new Replay(argv[1], false, Replay::LoadMode::STREAMING);
     }
     catch (const std::exception& e)
     {
@@ -68,9 +68,9 @@ int main(int argc, char** argv)
     file << line;
 
     // Then output all entries with comma separated values
-    for (size_t i = 0; i < player->data_.size(); i++)
+    for (unsigned int i = 0; i < player->GetNumberOfEntries(); i++)
     {
-        ObjectStateStructDat* state = &player->data_[i].state;
+        ObjectStateStructDat* state = &player->GetEntryByIdx(i)->state;
 
         snprintf(line,
                  MAX_LINE_LEN,
@@ -205,17 +205,9 @@ ScenarioEntity* getScenarioEntityById(int id)
 
 int ParseEntities(Replay* player)
 {
-    struct OdoInfo
+    for (unsigned int i = 0; i < player->GetNumberOfEntries(); i++)
     {
-        double x, y, odometer;
-    };
-    std::map<int, OdoInfo> odo_info;  // temporary keep track of entity odometers
-
-    for (int i = 0; i < static_cast<int>(player->data_.size()); i++)
-    {
-        ReplayEntry*          entry = &player->data_[static_cast<unsigned int>(i)];
-        ObjectStateStructDat* state = &entry->state;
-        OdoInfo               odo_entry;
+        ObjectStateStructDat* state = &player->GetEntryByIdx(i)->state;
 
         if (no_ghost && state->info.ctrl_type == GHOST_CTRL_TYPE)
         {
@@ -242,11 +234,6 @@ int ParseEntities(Replay* player)
             new_sc.visible        = true;
             new_sc.bounding_box   = state->info.boundingbox;
 
-            odo_entry.x        = state->pos.x;
-            odo_entry.y        = state->pos.y;
-            odo_entry.odometer = 0.0;
-            odo_info.insert(std::make_pair(new_sc.id, odo_entry));  // Set inital odometer value for the entity
-
 #ifdef _USE_OSG
             new_sc.trajectory = nullptr;
             new_sc.trajPoints = 0;
@@ -322,16 +309,6 @@ int ParseEntities(Replay* player)
             }
         }
 #endif  // _USE_OSG
-
-        // calculate odometer
-        odo_entry    = odo_info[sc->id];
-        double delta = GetLengthOfLine2D(odo_entry.x, odo_entry.y, state->pos.x, state->pos.y);
-        odo_entry.odometer += delta;
-        odo_entry.x      = state->pos.x;
-        odo_entry.y      = state->pos.y;
-        odo_info[sc->id] = odo_entry;  // save updated odo info for next calculation
-
-        entry->odometer = odo_entry.odometer;  // update odometer
     }
 
 #ifdef _USE_OSG
@@ -434,6 +411,7 @@ int main(int argc, char** argv)
     opt.AddOption("save_merged", "Save merged data into one dat file, instead of viewing", "filename");
     opt.AddOption("start_time", "Start playing at timestamp", "ms");
     opt.AddOption("stop_time", "Stop playing at timestamp (set equal to time_start for single frame)", "ms");
+    opt.AddOption("stream", "Memory map the recording and decode only parts being played, for large files");
 #ifdef _USE_OSG
     opt.AddOption("text_scale", "Scale screen overlay text", "size factor", "1.0", true);
 #endif  // _USEOSG
@@ -514,7 +492,9 @@ int main(int argc, char** argv)
                 LOG_ERROR("\"--saved_merged\" works only in combination with \"--dir\" argument, combining multiple dat files");
                 return -1;
             }
-            player = std::make_unique<Replay>(opt.GetOptionArg("file"), true);
+            player = std::make_unique<Replay>(opt.GetOptionArg("file"),
+                                              true,
+                                              opt.GetOptionSet("stream") ? Replay::LoadMode::STREAMING : Replay::LoadMode::LOAD_ALL);
         }
     }
     catch (const std::exception& e)
@@ -855,20 +835,18 @@ int main(int argc, char** argv)
         std::string start_time_str = opt.GetOptionArg("start_time");
         if (!start_time_str.empty())
         {
-            double startTime = 1E-3 * strtod(start_time_str);
-            if (static_cast<float>(startTime) < player->data_[0].state.info.timeStamp)
+            float  first_timestamp = player->GetEntryByIdx(0)->state.info.timeStamp;
+            float  last_timestamp  = player->GetEntryByIdx(player->GetNumberOfEntries() - 1)->state.info.timeStamp;
+            double startTime       = 1E-3 * strtod(start_time_str);
+            if (static_cast<float>(startTime) < first_timestamp)
             {
-                printf("Specified start time (%.2f) < first timestamp (%.2f), adapting.\n",
-                       startTime,
-                       static_cast<double>(player->data_[0].state.info.timeStamp));
-                startTime = static_cast<double>(player->data_[0].state.info.timeStamp);
+                printf("Specified start time (%.2f) < first timestamp (%.2f), adapting.\n", startTime, static_cast<double>(first_timestamp));
+                startTime = static_cast<double>(first_timestamp);
             }
-            else if (static_cast<float>(startTime) > player->data_.back().state.info.timeStamp)
+            else if (static_cast<float>(startTime) > last_timestamp)
             {
-                printf("Specified start time (%.2f) > last timestamp (%.2f), adapting.\n",
-                       startTime,
-                       static_cast<double>(player->data_.back().state.info.timeStamp));
-                startTime = static_cast<double>(player->data_.back().state.info.timeStamp);
+                printf("Specified start time (%.2f) > last timestamp (%.2f), adapting.\n", startTime, static_cast<double>(last_timestamp));
+                startTime = static_cast<double>(last_timestamp);
             }
             player->SetStartTime(startTime);
             player->GoToTime(startTime);
@@ -877,20 +855,18 @@ int main(int argc, char** argv)
         std::string stop_time_str = opt.GetOptionArg("stop_time");
         if (!stop_time_str.empty())
         {
-            double stopTime = 1E-3 * strtod(stop_time_str);
-            if (static_cast<float>(stopTime) > player->data_.back().state.info.timeStamp)
+            float  first_timestamp = player->GetEntryByIdx(0)->state.info.timeStamp;
+            float  last_timestamp  = player->GetEntryByIdx(player->GetNumberOfEntries() - 1)->state.info.timeStamp;
+            double stopTime        = 1E-3 * strtod(stop_time_str);
+            if (static_cast<float>(stopTime) > last_timestamp)
             {
-                printf("Specified stop time (%.2f) > last timestamp (%.2f), adapting.\n",
-                       stopTime,
-                       static_cast<double>(player->data_.back().state.info.timeStamp));
-                stopTime = static_cast<double>(player->data_.back().state.info.timeStamp);
+                printf("Specified stop time (%.2f) > last timestamp (%.2f), adapting.\n", stopTime, static_cast<double>(last_timestamp));
+                stopTime = static_cast<double>(last_timestamp);
             }
-            else if (static_cast<float>(stopTime) < player->data_[0].state.info.timeStamp)
+            else if (static_cast<float>(stopTime) < first_timestamp)
             {
-                printf("Specified stop time (%.2f) < first timestamp (%.2f), adapting.\n",
-                       stopTime,
-                       static_cast<double>(player->data_[0].state.info.timeStamp));
-                stopTime = static_cast<double>(player->data_[0].state.info.timeStamp);
+                printf("Specified stop time (%.2f) < first timestamp (%.2f), adapting.\n", stopTime, static_cast<double>(first_timestamp));
+                stopTime = static_cast<double>(first_timestamp);
             }
             player->SetStopTime(stopTime);
         }
@@ -0,0 +1,429 @@
+/*
+ * esmini - Environment Simulator Minimalistic
+ * https://github.com/esmini/esmini
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) partners of Simulation Scenarios
+ * https://sites.google.com/view/simulationscenarios
+ */
+
+/*
+ * Micro benchmarks of RoadManager hot paths, based on google benchmark.
+ *
+ * Each benchmark is run on a set of road networks from resources/xodr and EnvironmentSimulator/Unittest/xodr. Query
+ * positions are drawn from a fixed seed, so that figures of different esmini versions can be compared. Results are
+ * written in JSON format to RoadManager_bench.json, unless another --benchmark_out file is specified.
+ *
+ * Usage: RoadManager_bench [--root <esmini root folder>] [google benchmark options...]
+ * Default root is ../../../, i.e. running from the build/EnvironmentSimulator/Benchmark folder.
+ */
+
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "RoadManager.hpp"
+#include "CommonMini.hpp"
+#include "logger.hpp"
+
+using namespace roadmanager;
+
+extern const char* ESMINI_GIT_REV;
+extern const char* ESMINI_BUILD_VERSION;
+
+namespace
+{
+    const char* maps[] = {"resources/xodr/e6mini.xodr",
+                          "resources/xodr/fabriksgatan.xodr",
+                          "resources/xodr/multi_intersections.xodr",
+                          "resources/xodr/soderleden.xodr",
+                          "EnvironmentSimulator/Unittest/xodr/highway_example_with_merge_and_split.xodr"};
+
+    const unsigned int SEED      = 12345;
+    const size_t       N_SAMPLES = 1024;
+    std::string        root_dir  = "../../../";
+
+    bool LoadMap(benchmark::State& state, const std::string& map)
+    {
+        if (!Position::LoadOpenDrive((root_dir + map).c_str()))
+        {
+            state.SkipWithError(("Failed to load " + root_dir + map).c_str());
+            return false;
+        }
+
+        // junction choices of MoveAlongS
+        SE_Env::Inst().GetRand().SetSeed(SEED);
+
+        return true;
+    }
+
+    // Random positions at the center of driving lanes, same for every run on a given road network
+    std::vector<Position> SamplePositions(size_t n)
+    {
+        OpenDrive*            odr = Position::GetOpenDrive();
+        std::mt19937          gen(SEED);
+        std::vector<Position> samples;
+        Position              pos;
+
+        for (size_t attempts = 0; samples.size() < n && attempts < 100 * n; attempts++)
+        {
+            Road*        road = odr->GetRoadByIdx(static_cast<idx_t>(gen() % odr->GetNumOfRoads()));
+            double       s    = std::uniform_real_distribution<double>(0.0, road->GetLength())(gen);
+            LaneSection* lsec = road->GetLaneSectionByS(s);
+
+            if (lsec == nullptr || lsec->GetNumberOfLanes() == 0)
+            {
+                continue;
+            }
+
+            Lane* lane = lsec->GetLaneByIdx(static_cast<idx_t>(gen() % lsec->GetNumberOfLanes()));
+
+            if (lane->IsDriving() && pos.SetLanePos(road->GetId(), lane->GetId(), s, 0.0) == Position::ReturnCode::OK)
+            {
+                samples.push_back(pos);
+            }
+        }
+
+        return samples;
+    }
+
+    // Consecutive points along the road network, moving from given start position
+    std::vector<Position> SamplePath(const Position& start, double step, size_t n)
+    {
+        std::vector<Position> path;
+        Position              pos = start;
+
+        while (path.size() < n)
+        {
+            path.push_back(pos);
+            if (pos.MoveAlongS(step) < Position::ReturnCode::OK)
+            {
+                break;
+            }
+        }
+
+        return path;
+    }
+
+    void BM_LoadOpenDriveFile(benchmark::State& state, const std::string& map)
+    {
+        // includes OSI point generation, unless a precompiled .odrbin file or OSI points cache is present
+        for (auto _ : state)
+        {
+            if (!LoadMap(state, map))
+            {
+                break;
+            }
+        }
+        state.counters["roads"] = Position::GetOpenDrive()->GetNumOfRoads();
+    }
+
+    void BM_GenerateOSIPoints(benchmark::State& state, const std::string& map)
+    {
+        if (!LoadMap(state, map))
+        {
+            return;
+        }
+
+        // lanes, road marks and lane boundaries of all roads, in one thread
+        OpenDrive*                                      odr = Position::GetOpenDrive();
+        std::vector<std::pair<Lane*, LaneBoundaryOSI*>> lane_boundaries;
+        for (auto _ : state)
+        {
+            for (unsigned int i = 0; i < odr->GetNumOfRoads(); i++)
+            {
+                odr->SetLaneOSIPoints(odr->GetRoadByIdx(i));
+                odr->SetRoadMarkOSIPoints(odr->GetRoadByIdx(i));
+                odr->SetLaneBoundaryPoints(odr->GetRoadByIdx(i), lane_boundaries);
+            }
+            for (auto& lane_boundary : lane_boundaries)
+            {
+                lane_boundary.first->SetLaneBoundary(lane_boundary.second);
+            }
+            lane_boundaries.clear();
+        }
+        state.counters["roads"] = odr->GetNumOfRoads();
+    }
+
+    void BM_XYZ2TrackPosCold(benchmark::State& state, const std::string& map)
+    {
+        if (!LoadMap(state, map))
+        {
+            return;
+        }
+
+        // scattered points, no use of previous road as search hint
+        std::vector<Position> samples = SamplePositions(N_SAMPLES);
+        Position              pos;
+        size_t                i = 0;
+
+        for (auto _ : state)
+        {
+            const Position& p = samples[i++ % samples.size()];
+            benchmark::DoNotOptimize(pos.XYZ2TrackPos(p.GetX(), p.GetY(), p.GetZ()));
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    void BM_XYZ2TrackPosWarm(benchmark::State& state, const std::string& map)
+    {
+        if (!LoadMap(state, map))
+        {
+            return;
+        }
+
+        // points 0.5 m apart along the road network, like a moving entity
+        std::vector<Position> path = SamplePath(SamplePositions(1)[0], 0.5, 4 * N_SAMPLES);
+        Position              pos  = path[0];
+        size_t                i    = 0;
+
+        for (auto _ : state)
+        {
+            const Position& p = path[i++ % path.size()];
+            benchmark::DoNotOptimize(pos.XYZ2TrackPos(p.GetX(), p.GetY(), p.GetZ()));
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    void BM_SetLanePos(benchmark::State& state, const std::string& map)
+    {
+        if (!LoadMap(state, map))
+        {
+            return;
+        }
+
+        std::vector<Position> samples = SamplePositions(N_SAMPLES);
+        Position              pos;
+        size_t                i = 0;
+
+        for (auto _ : state)
+        {
+            const Position& p = samples[i++ % samples.size()];
+            benchmark::DoNotOptimize(pos.SetLanePos(p.GetTrackId(), p.GetLaneId(), p.GetS(), 0.0));
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    void BM_MoveAlongS(benchmark::State& state, const std::string& map)
+    {
+        if (!LoadMap(state, map))
+        {
+            return;
+        }
+
+        // 1 m steps, crossing roads and junctions. Restart at next sample when reaching a dead end.
+        std::vector<Position> samples = SamplePositions(N_SAMPLES);
+        Position              pos     = samples[0];
+        size_t                i       = 1;
+
+        for (auto _ : state)
+        {
+            if (pos.MoveAlongS(1.0) < Position::ReturnCode::OK)
+            {
+                pos = samples[i++ % samples.size()];
+            }
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    // Pairs of positions 50 to 500 m apart along the road network
+    std::vector<std::pair<Position, Position>> SamplePositionPairs(size_t n)
+    {
+        std::vector<Position>                      samples = SamplePositions(n);
+        std::vector<std::pair<Position, Position>> pairs;
+        std::mt19937                               gen(SEED);
+        std::uniform_real_distribution<double>     dist(50.0, 500.0);
+
+        for (const Position& p : samples)
+        {
+            Position target = p;
+            if (target.MoveAlongS(dist(gen)) >= Position::ReturnCode::OK)
+            {
+                pairs.push_back(std::make_pair(p, target));
+            }
+        }
+
+        return pairs;
+    }
+
+    void BM_Delta(benchmark::State& state, const std::string& map)
+    {
+        if (!LoadMap(state, map))
+        {
+            return;
+        }
+
+        std::vector<std::pair<Position, Position>> pairs = SamplePositionPairs(N_SAMPLES);
+        PositionDiff                               diff;
+        size_t                                     i = 0;
+
+        for (auto _ : state)
+        {
+            auto& pair = pairs[i++ % pairs.size()];
+            benchmark::DoNotOptimize(pair.first.Delta(&pair.second, diff));
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    void BM_RoadPathCalculate(benchmark::State& state, const std::string& map, bool cached)
+    {
+        if (!LoadMap(state, map))
+        {
+            return;
+        }
+
+        // single direction searches, which may reuse results from the road path cache
+        std::vector<std::pair<Position, Position>> pairs = SamplePositionPairs(N_SAMPLES);
+        OpenDrive*                                 odr   = Position::GetOpenDrive();
+        double                                     dist  = 0.0;
+        size_t                                     i     = 0;
+
+        for (auto _ : state)
+        {
+            if (!cached)
+            {
+                state.PauseTiming();
+                odr->GetRoadPathCache().Clear();
+                state.ResumeTiming();
+            }
+            auto&    pair = pairs[i++ % pairs.size()];
+            RoadPath path(&pair.first, &pair.second);
+            benchmark::DoNotOptimize(path.Calculate(dist, false));
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    void BM_GetProbeInfo(benchmark::State& state, const std::string& map)
+    {
+        if (!LoadMap(state, map))
+        {
+            return;
+        }
+
+        std::vector<Position> samples = SamplePositions(N_SAMPLES);
+        RoadProbeInfo         info;
+        size_t                i = 0;
+
+        for (auto _ : state)
+        {
+            const Position& p = samples[i++ % samples.size()];
+            benchmark::DoNotOptimize(
+                p.GetProbeInfo(static_cast<double>(state.range(0)), &info, Position::LookAheadMode::LOOKAHEADMODE_AT_LANE_CENTER));
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    void BM_FindClosestPoint(benchmark::State& state, const std::string& map)
+    {
+        if (!LoadMap(state, map))
+        {
+            return;
+        }
+
+        // polyline following the road network with 1 m segments, queried at random points beside it
+        std::vector<Position> path = SamplePath(SamplePositions(1)[0], 1.0, 2 * N_SAMPLES);
+        PolyLineBase          pline;
+        for (const Position& p : path)
+        {
+            TrajVertex v;
+            v.s = std::nan("");
+            v.x = p.GetX();
+            v.y = p.GetY();
+            v.z = p.GetZ();
+            v.h = p.GetH();
+            pline.AddVertex(v);
+        }
+
+        std::mt19937                           gen(SEED);
+        std::uniform_real_distribution<double> noise(-5.0, 5.0);
+        std::vector<std::pair<double, double>> points;
+        for (size_t j = 0; j < N_SAMPLES; j++)
+        {
+            const Position& p = path[gen() % path.size()];
+            points.push_back(std::make_pair(p.GetX() + noise(gen), p.GetY() + noise(gen)));
+        }
+
+        TrajVertex vertex;
+        idx_t      index = 0;
+        size_t     i     = 0;
+
+        for (auto _ : state)
+        {
+            const auto& point = points[i++ % points.size()];
+            benchmark::DoNotOptimize(pline.FindClosestPoint(point.first, point.second, vertex, index));
+        }
+        state.SetItemsProcessed(state.iterations());
+        state.counters["vertices"] = static_cast<double>(pline.GetNumberOfVertices());
+    }
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    std::vector<char*> args;
+    bool               out_specified = false;
+
+    for (int i = 0; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "--root") && i + 1 < argc)
+        {
+            root_dir = std::string(argv[++i]) + "/";
+            continue;
+        }
+        if (!strncmp(argv[i], "--benchmark_out=", strlen("--benchmark_out=")))
+        {
+            out_specified = true;
+        }
+        args.push_back(argv[i]);
+    }
+
+    std::string out_arg    = "--benchmark_out=RoadManager_bench.json";
+    std::string format_arg = "--benchmark_out_format=json";
+    if (!out_specified)
+    {
+        args.push_back(&out_arg[0]);
+        args.push_back(&format_arg[0]);
+    }
+
+    int n_args = static_cast<int>(args.size());
+    benchmark::Initialize(&n_args, args.data());
+    if (benchmark::ReportUnrecognizedArguments(n_args, args.data()))
+    {
+        printf("Usage: %s [--root <esmini root folder>] [google benchmark options...]\n", argv[0]);
+        return -1;
+    }
+
+    // logging would dominate some of the measurements
+    SE_Env::Inst().GetOptions().SetOptionValue("disable_stdout", "", false, true);
+    esmini::common::TxtLogger::Inst().StopFileLogging();
+
+    benchmark::AddCustomContext("esmini_git_rev", ESMINI_GIT_REV);
+    benchmark::AddCustomContext("esmini_build_version", ESMINI_BUILD_VERSION);
+
+    for (const char* map : maps)
+    {
+        std::string name = FileNameWithoutExtOf(map);
+
+        benchmark::RegisterBenchmark(("LoadOpenDriveFile/" + name).c_str(), BM_LoadOpenDriveFile, map)->Unit(benchmark::kMillisecond);
+        benchmark::RegisterBenchmark(("GenerateOSIPoints/" + name).c_str(), BM_GenerateOSIPoints, map)->Unit(benchmark::kMillisecond);
+        benchmark::RegisterBenchmark(("XYZ2TrackPos/cold/" + name).c_str(), BM_XYZ2TrackPosCold, map);
+        benchmark::RegisterBenchmark(("XYZ2TrackPos/warm/" + name).c_str(), BM_XYZ2TrackPosWarm, map);
+        benchmark::RegisterBenchmark(("SetLanePos/" + name).c_str(), BM_SetLanePos, map);
+        benchmark::RegisterBenchmark(("MoveAlongS/" + name).c_str(), BM_MoveAlongS, map);
+        benchmark::RegisterBenchmark(("Delta/" + name).c_str(), BM_Delta, map);
+        benchmark::RegisterBenchmark(("RoadPathCalculate/cold/" + name).c_str(), BM_RoadPathCalculate, map, false);
+        benchmark::RegisterBenchmark(("RoadPathCalculate/warm/" + name).c_str(), BM_RoadPathCalculate, map, true);
+        benchmark::RegisterBenchmark(("GetProbeInfo/" + name).c_str(), BM_GetProbeInfo, map)->Arg(10)->Arg(100);
+        benchmark::RegisterBenchmark(("FindClosestPoint/" + name).c_str(), BM_FindClosestPoint, map);
+    }
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    return 0;
+}
@@ -347,6 +347,27 @@ namespace ESMini
         /// <return>0 if successful, -1 if not</return>
         public static extern int SE_GetObjectState(int object_id, ref ScenarioObjectState state);
 
+        [DllImport(LIB_NAME, EntryPoint = "SE_GetObjectStates")]
+        /// <summary>Get the state of all objects in one call, ordered as by GetId(index)</summary>
+        /// <param name="nObjects">In: Capacity of the states array. Out: Number of states filled in</param>
+        /// <param name="states">Array of ScenarioObjectState structs to be filled in</param>
+        /// <return>0 if successful, -1 if not</return>
+        public static extern int SE_GetObjectStates(ref int nObjects, [In, Out] ScenarioObjectState[] states);
+
+        [DllImport(LIB_NAME, EntryPoint = "SE_GetObjectStatesSoA")]
+        /// <summary>Get the state of all objects in one call, into separate arrays per property. Any array may be null to skip it.</summary>
+        /// <param name="nObjects">In: Capacity of each array. Out: Number of objects filled in</param>
+        /// <return>0 if successful, -1 if not</return>
+        public static extern int SE_GetObjectStatesSoA(ref int nObjects,
+                                                        [Out] int[] id,
+                                                        [Out] float[] x,
+                                                        [Out] float[] y,
+                                                        [Out] float[] z,
+                                                        [Out] float[] h,
+                                                        [Out] float[] p,
+                                                        [Out] float[] r,
+                                                        [Out] float[] speed);
+
         [DllImport(LIB_NAME, EntryPoint = "SE_GetObjectInLaneType")]
         /// <summary>
         /// Find out what lane type object is currently in, reference point projected on road
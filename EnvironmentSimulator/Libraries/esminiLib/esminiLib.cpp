@@ -12,6 +12,7 @@
 
 #include <string>
 #include <clocale>
+#include <type_traits>
 
 #include "CommonMini.hpp"
 #include "playerbase.hpp"
@@ -32,21 +33,6 @@ using namespace scenarioengine;
 
 #define EGO_ID 0  // need to match appearing order in the OpenSCENARIO file
 
-static ScenarioPlayer *player = 0;
-
-static char                   **argv_ = 0;
-static int                      argc_ = 0;
-static std::vector<std::string> args_v;
-static __int64                  time_stamp = 0;
-
-static struct
-{
-    int x;
-    int y;
-    int w;
-    int h;
-} winDim = {60, 60, 800, 400};
-
 typedef struct
 {
     int id;
@@ -54,36 +40,146 @@ typedef struct
     void *data;
 } SE_ObjCallback;
 
-static std::vector<SE_ObjCallback> objCallback;
+// State of one scenario instance. The traditional API works on a default instance, which uses the process wide
+// environment, parameter distribution and road network. Instances created by SE_CreateInstance() own their copies
+// of those, which are bound to the calling thread for the duration of each SE_*Instance() call, or while selected
+// by SE_SelectInstance(). Hence instances can run in parallel threads.
+struct SE_Instance
+{
+    ScenarioPlayer             *player = nullptr;
+    char                      **argv_  = nullptr;
+    int                         argc_  = 0;
+    std::vector<std::string>    args_v;
+    __int64                     time_stamp = 0;
+    std::vector<SE_ObjCallback> objCallback;
+    struct
+    {
+        int x;
+        int y;
+        int w;
+        int h;
+    } winDim = {60, 60, 800, 400};
+
+    void (*conditionCallback)(const char *name, double timestamp)                                = nullptr;
+    void (*stateChangeCallback)(const char *name, int type, int state, const char *full_path) = nullptr;
+    CallBack paramDeclCallback                                                                = {nullptr, nullptr};
+
+    // Owned by instances created by SE_CreateInstance(), nullptr for the default instance
+    std::unique_ptr<SE_Env>                   env;
+    std::unique_ptr<OSCParameterDistribution> param_dist;
+    std::unique_ptr<roadmanager::OpenDrive>   odr;
+
+    // Strings returned by the API, valid until next call of the same function for the same instance
+    struct
+    {
+        std::string option_value;
+        std::string odr_filename;
+        std::string scene_graph_filename;
+        std::string parameter_name;
+        std::string variable_name;
+        std::string object_type_name;
+        std::string object_name;
+        std::string object_model_filename;
+        std::string road_sign_name;
+    } return_string;
+};
+
+static SE_Instance               default_instance_;
+static thread_local SE_Instance *instance_ = &default_instance_;  // instance the API currently works on, in calling thread
+
+// Let the API, and the singletons, refer to given instance in the calling thread
+static void BindInstance(SE_Instance *instance)
+{
+    instance_ = instance;
+    SE_Env::SetThreadInst(instance->env.get());
+    OSCParameterDistribution::SetThreadInst(instance->param_dist.get());
+    roadmanager::Position::SetThreadOpenDrive(instance->odr.get());
+    SetThreadParameterDeclarationCallback(instance->env ? &instance->paramDeclCallback : nullptr);
+}
+
+// Binds an instance to the calling thread during the lifetime of the scope, then restores previous one
+class InstanceScope
+{
+public:
+    InstanceScope(void *handle) : previous_(instance_)
+    {
+        BindInstance(static_cast<SE_Instance *>(handle));
+    }
+    ~InstanceScope()
+    {
+        BindInstance(previous_);
+    }
 
-// List of 3D models populated from any found found model_ids.txt file
-static std::map<int, std::string> entity_model_map_;
+private:
+    SE_Instance *previous_;
+};
+
+// Callbacks from the scenario engine are common for all scenarios, route them to the instance of the calling thread
+static void conditionCallbackFn(const char *name, double timestamp)
+{
+    if (instance_->conditionCallback != nullptr)
+    {
+        instance_->conditionCallback(name, timestamp);
+    }
+}
+
+static void stateChangeCallbackFn(const char *name, int type, int state, const char *full_path)
+{
+    if (instance_->stateChangeCallback != nullptr)
+    {
+        instance_->stateChangeCallback(name, type, state, full_path);
+    }
+}
+
+static const bool callbacks_registered_ = []()
+{
+    OSCCondition::conditionCallback        = conditionCallbackFn;
+    StoryBoardElement::stateChangeCallback = stateChangeCallbackFn;
+    return true;
+}();
+
+// Parameters and variables of the scenario, also available from within the parameter declaration callback
+static Parameters *GetParameters(bool variables = false)
+{
+    ScenarioEngine *engine = GetParameterDeclarationCallbackEngine();
+    if (engine == nullptr && instance_->player != nullptr)
+    {
+        engine = instance_->player->scenarioEngine;
+    }
+
+    if (engine == nullptr)
+    {
+        return nullptr;
+    }
+
+    return variables ? &engine->GetScenarioReader()->variables : &engine->GetScenarioReader()->parameters;
+}
 
 static void resetScenario(void)
 {
-    if (player != nullptr)
+    if (instance_->player != nullptr)
     {
-        delete player;
-        player = nullptr;
+        delete instance_->player;
+        instance_->player = nullptr;
         SE_Env::Inst().ClearModelFilenames();
     }
-    if (argv_)
+    if (instance_->argv_)
     {
-        for (int i = 0; i < static_cast<int>(args_v.size()); i++)
+        for (int i = 0; i < static_cast<int>(instance_->args_v.size()); i++)
         {
-            free(argv_[i]);
+            free(instance_->argv_[i]);
         }
-        free(argv_);
-        argv_ = 0;
-        argc_ = 0;
+        free(instance_->argv_);
+        instance_->argv_ = 0;
+        instance_->argc_ = 0;
     }
-    args_v.clear();
+    instance_->args_v.clear();
 
-    // Reset (global) callbacks
-    OSCCondition::conditionCallback        = nullptr;
-    StoryBoardElement::stateChangeCallback = nullptr;
+    // Reset callbacks
+    instance_->conditionCallback   = nullptr;
+    instance_->stateChangeCallback = nullptr;
 
-    time_stamp = 0;
+    instance_->time_stamp = 0;
 }
 
 static void AddArgument(const char *str, bool split = true)
@@ -101,20 +197,20 @@ static void AddArgument(const char *str, bool split = true)
 
     for (size_t i = 0; i < args.size(); i++)
     {
-        args_v.push_back(args[i]);
+        instance_->args_v.push_back(args[i]);
     }
 }
 
 static void ConvertArguments()
 {
-    argc_ = static_cast<int>(args_v.size());
-    argv_ = reinterpret_cast<char **>(malloc(args_v.size() * sizeof(char *)));
+    instance_->argc_ = static_cast<int>(instance_->args_v.size());
+    instance_->argv_ = reinterpret_cast<char **>(malloc(instance_->args_v.size() * sizeof(char *)));
     std::string argument_list;
-    for (unsigned int i = 0; i < static_cast<unsigned int>(argc_); i++)
+    for (unsigned int i = 0; i < static_cast<unsigned int>(instance_->argc_); i++)
     {
-        argv_[i] = reinterpret_cast<char *>(malloc((args_v[i].size() + 1) * sizeof(char)));
-        StrCopy(argv_[i], args_v[i].c_str(), static_cast<unsigned int>(args_v[i].size()) + 1);
-        argument_list += std::string(" ") + argv_[i];
+        instance_->argv_[i] = reinterpret_cast<char *>(malloc((instance_->args_v[i].size() + 1) * sizeof(char)));
+        StrCopy(instance_->argv_[i], instance_->args_v[i].c_str(), static_cast<unsigned int>(instance_->args_v[i].size()) + 1);
+        argument_list += std::string(" ") + instance_->argv_[i];
     }
 }
 
@@ -169,13 +265,13 @@ static void copyWheelDataFromScenarioGateway(SE_WheelData *wheeldata, ObjectStat
 
 static int getObjectById(int object_id, Object *&obj)
 {
-    if (player == nullptr)
+    if (instance_->player == nullptr)
     {
         return -1;
     }
     else
     {
-        obj = player->scenarioEngine->entities_.GetObjectById(object_id);
+        obj = instance_->player->scenarioEngine->entities_.GetObjectById(object_id);
         if (obj == nullptr)
         {
             LOG_ERROR("Invalid object_id ({})", object_id);
@@ -258,7 +354,7 @@ static int GetRoadInfoAtDistance(int object_id, float lookahead_distance, SE_Roa
         return -1;
     }
 
-    roadmanager::Position            *pos = &player->scenarioGateway->getObjectStatePtrByIdx(object_id)->state_.pos;
+    roadmanager::Position            *pos = &instance_->player->scenarioGateway->getObjectStatePtrByIdx(object_id)->state_.pos;
     roadmanager::Position::ReturnCode retval =
         pos->GetProbeInfo(lookahead_distance, &s_data, static_cast<roadmanager::Position::LookAheadMode>(lookAheadMode));
 
@@ -268,7 +364,7 @@ static int GetRoadInfoAtDistance(int object_id, float lookahead_distance, SE_Roa
 
         // Visualize forward looking road sensor probe
         main_object->SetSensorPosition(s_data.road_lane_info.pos[0], s_data.road_lane_info.pos[1], s_data.road_lane_info.pos[2]);
-        player->SteeringSensorSetVisible(object_id, true);
+        instance_->player->SteeringSensorSetVisible(object_id, true);
     }
 
     return static_cast<int>(retval);
@@ -355,7 +451,7 @@ static int GetRoadInfoAtGhostTrailTime(int object_id, float time, SE_RoadInfo *r
     if (returncode == SE_GHOST_TRAIL_NO_VERTICES || returncode == SE_GHOST_TRAIL_ERROR)
     {
         LOG_ERROR("Failed to lookup point at time {:.2f} (time arg = {:.2f}) along ghost ({}) trail",
-                  player->scenarioEngine->getSimulationTime() - ghost->GetHeadstartTime() + static_cast<double>(time),
+                  instance_->player->scenarioEngine->getSimulationTime() - ghost->GetHeadstartTime() + static_cast<double>(time),
                   static_cast<double>(time),
                   ghost->GetId());
         return returncode;
@@ -396,8 +492,8 @@ static int InitScenario()
     try
     {
         // Initialize the scenario engine and viewer
-        player     = new ScenarioPlayer(argc_, argv_);
-        int retval = player->Init();
+        instance_->player = new ScenarioPlayer(instance_->argc_, instance_->argv_);
+        int retval        = instance_->player->Init();
         if (retval == -1)
         {
             LOG_ERROR("Failed to initialize scenario player");
@@ -487,9 +583,8 @@ extern "C"
         {
             return 0;
         }
-        static std::string val;
-        val = SE_Env::Inst().GetOptions().GetOptionArg(name);
-        return val.c_str();
+        instance_->return_string.option_value = SE_Env::Inst().GetOptions().GetOptionArg(name);
+        return instance_->return_string.option_value.c_str();
     }
 
     SE_DLL_API bool SE_GetOptionSet(const char *name)
@@ -524,7 +619,7 @@ extern "C"
 
     SE_DLL_API void SE_SetWindowPosAndSize(int x, int y, int w, int h)
     {
-        winDim = {x, y, w, h};
+        instance_->winDim = {x, y, w, h};
     }
 
     SE_DLL_API int SE_SetOSITolerances(double maxLongitudinalDistance, double maxLateralDeviation)
@@ -559,8 +654,14 @@ extern "C"
         }
         else  // Viewer bit set, create a window for on and/or off-screen rendering
         {
-            static char winArg[64];
-            snprintf(winArg, sizeof(winArg), "--window %d %d %d %d", winDim.x, winDim.y, winDim.w, winDim.h);
+            char winArg[64];
+            snprintf(winArg,
+                     sizeof(winArg),
+                     "--window %d %d %d %d",
+                     instance_->winDim.x,
+                     instance_->winDim.y,
+                     instance_->winDim.w,
+                     instance_->winDim.h);
             AddArgument(winArg, true);
 
             if (use_viewer & 2)  // off_screen
@@ -661,9 +762,9 @@ extern "C"
     {
         int quit_flag = -1;
 
-        if (player != nullptr)
+        if (instance_->player != nullptr)
         {
-            if (player->IsQuitRequested())
+            if (instance_->player->IsQuitRequested())
             {
                 quit_flag = 1;
             }
@@ -680,9 +781,9 @@ extern "C"
     {
         int pause_flag = -1;
 
-        if (player != nullptr)
+        if (instance_->player != nullptr)
         {
-            if (player->IsPaused())
+            if (instance_->player->IsPaused())
             {
                 pause_flag = 1;
             }
@@ -697,81 +798,74 @@ extern "C"
 
     SE_DLL_API const char *SE_GetODRFilename()
     {
-        static std::string returnString;
-        if (player == nullptr)
+        if (instance_->player == nullptr)
         {
             return 0;
         }
-        returnString = player->scenarioEngine->getOdrFilename().c_str();
-        return returnString.c_str();
+        instance_->return_string.odr_filename = instance_->player->scenarioEngine->getOdrFilename().c_str();
+        return instance_->return_string.odr_filename.c_str();
     }
 
     SE_DLL_API const char *SE_GetSceneGraphFilename()
     {
-        static std::string returnString;
-
-        if (player == nullptr)
+        if (instance_->player == nullptr)
         {
             return 0;
         }
 
-        returnString = player->scenarioEngine->getSceneGraphFilename().c_str();
-        return returnString.c_str();
+        instance_->return_string.scene_graph_filename = instance_->player->scenarioEngine->getSceneGraphFilename().c_str();
+        return instance_->return_string.scene_graph_filename.c_str();
     }
 
     SE_DLL_API int SE_GetNumberOfParameters()
     {
-        if (player == nullptr)
+        if (instance_->player == nullptr)
         {
             return -1;
         }
 
-        return player->GetNumberOfParameters();
+        return instance_->player->GetNumberOfParameters();
     }
 
     SE_DLL_API const char *SE_GetParameterName(int index, int *type)
     {
-        static std::string returnString;
-
-        if (player == nullptr)
+        if (instance_->player == nullptr)
         {
             return 0;
         }
 
-        returnString = player->GetParameterName(index, (OSCParameterDeclarations::ParameterType *)type);
+        instance_->return_string.parameter_name = instance_->player->GetParameterName(index, (OSCParameterDeclarations::ParameterType *)type);
 
-        return returnString.c_str();
+        return instance_->return_string.parameter_name.c_str();
     }
 
     SE_DLL_API int SE_GetNumberOfVariables()
     {
-        if (player == nullptr)
+        if (instance_->player == nullptr)
         {
             return -1;
         }
 
-        return player->GetNumberOfVariables();
+        return instance_->player->GetNumberOfVariables();
     }
 
     SE_DLL_API const char *SE_GetVariableName(int index, int *type)
     {
-        static std::string returnString;
-
-        if (player == nullptr)
+        if (instance_->player == nullptr)
         {
             return 0;
         }
 
-        returnString = player->GetVariableName(index, (OSCParameterDeclarations::ParameterType *)type);
+        instance_->return_string.variable_name = instance_->player->GetVariableName(index, (OSCParameterDeclarations::ParameterType *)type);
 
-        return returnString.c_str();
+        return instance_->return_string.variable_name.c_str();
     }
 
     SE_DLL_API int SE_GetNumberOfProperties(int index)
     {
-        if (player != nullptr && index >= 0 && index < player->scenarioGateway->getNumberOfObjects())
+        if (instance_->player != nullptr && index >= 0 && index < instance_->player->scenarioGateway->getNumberOfObjects())
         {
-            return player->GetNumberOfProperties(index);
+            return instance_->player->GetNumberOfProperties(index);
         }
 
         return -1;
@@ -779,12 +873,12 @@ extern "C"
 
     SE_DLL_API const char *SE_GetObjectPropertyName(int index, int propertyIndex)
     {
-        if (player != nullptr && index >= 0 && index < player->scenarioGateway->getNumberOfObjects())
+        if (instance_->player != nullptr && index >= 0 && index < instance_->player->scenarioGateway->getNumberOfObjects())
         {
-            int number = player->GetNumberOfProperties(index);
+            int number = instance_->player->GetNumberOfProperties(index);
             if (number > 0 && propertyIndex < number && propertyIndex >= 0)
             {
-                return player->GetPropertyName(index, propertyIndex);
+                return instance_->player->GetPropertyName(index, propertyIndex);
             }
         }
 
@@ -793,13 +887,13 @@ extern "C"
 
     SE_DLL_API const char *SE_GetObjectPropertyValue(int index, const char *objectPropertyName)
     {
-        if (player != nullptr && index >= 0 && index < player->scenarioGateway->getNumberOfObjects())
+        if (instance_->player != nullptr && index >= 0 && index < instance_->player->scenarioGateway->getNumberOfObjects())
         {
-            for (int i = 0; i < player->GetNumberOfProperties(index); i++)
+            for (int i = 0; i < instance_->player->GetNumberOfProperties(index); i++)
             {
-                if (strcmp(player->GetPropertyName(index, i), objectPropertyName) == 0)
+                if (strcmp(instance_->player->GetPropertyName(index, i), objectPropertyName) == 0)
                 {
-                    return player->GetPropertyValue(index, i);
+                    return instance_->player->GetPropertyValue(index, i);
                 }
             }
         }
@@ -809,109 +903,129 @@ extern "C"
 
     SE_DLL_API int SE_SetParameter(SE_Parameter parameter)
     {
-        return ScenarioReader::parameters.setParameterValue(parameter.name, parameter.value);
+        Parameters *parameters = GetParameters();
+        return parameters != nullptr ? parameters->setParameterValue(parameter.name, parameter.value) : -1;
     }
 
     SE_DLL_API int SE_GetParameter(SE_Parameter *parameter)
     {
-        return ScenarioReader::parameters.getParameterValue(parameter->name, parameter->value);
+        Parameters *parameters = GetParameters();
+        return parameters != nullptr ? parameters->getParameterValue(parameter->name, parameter->value) : -1;
     }
 
     SE_DLL_API int SE_GetParameterInt(const char *parameterName, int *value)
     {
-        return ScenarioReader::parameters.getParameterValueInt(parameterName, *value);
+        Parameters *parameters = GetParameters();
+        return parameters != nullptr ? parameters->getParameterValueInt(parameterName, *value) : -1;
     }
 
     SE_DLL_API int SE_GetParameterDouble(const char *parameterName, double *value)
     {
-        return ScenarioReader::parameters.getParameterValueDouble(parameterName, *value);
+        Parameters *parameters = GetParameters();
+        return parameters != nullptr ? parameters->getParameterValueDouble(parameterName, *value) : -1;
     }
 
     SE_DLL_API int SE_GetParameterString(const char *parameterName, const char **value)
     {
-        return ScenarioReader::parameters.getParameterValueString(parameterName, *value);
+        Parameters *parameters = GetParameters();
+        return parameters != nullptr ? parameters->getParameterValueString(parameterName, *value) : -1;
     }
 
     SE_DLL_API int SE_GetParameterBool(const char *parameterName, bool *value)
     {
-        return ScenarioReader::parameters.getParameterValueBool(parameterName, *value);
+        Parameters *parameters = GetParameters();
+        return parameters != nullptr ? parameters->getParameterValueBool(parameterName, *value) : -1;
     }
 
     SE_DLL_API int SE_SetParameterInt(const char *parameterName, int value)
     {
-        return ScenarioReader::parameters.setParameterValue(parameterName, value);
+        Parameters *parameters = GetParameters();
+        return parameters != nullptr ? parameters->setParameterValue(parameterName, value) : -1;
     }
 
     SE_DLL_API int SE_SetParameterDouble(const char *parameterName, double value)
     {
-        return ScenarioReader::parameters.setParameterValue(parameterName, value);
+        Parameters *parameters = GetParameters();
+        return parameters != nullptr ? parameters->setParameterValue(parameterName, value) : -1;
     }
 
     SE_DLL_API int SE_SetParameterString(const char *parameterName, const char *value)
     {
-        return ScenarioReader::parameters.setParameterValue(parameterName, value);
+        Parameters *parameters = GetParameters();
+        return parameters != nullptr ? parameters->setParameterValue(parameterName, value) : -1;
     }
 
     SE_DLL_API int SE_SetParameterBool(const char *parameterName, bool value)
     {
-        return ScenarioReader::parameters.setParameterValue(parameterName, value);
+        Parameters *parameters = GetParameters();
+        return parameters != nullptr ? parameters->setParameterValue(parameterName, value) : -1;
     }
 
     SE_DLL_API int SE_SetVariable(SE_Variable variable)
     {
-        return ScenarioReader::variables.setParameterValue(variable.name, variable.value);
+        Parameters *variables = GetParameters(true);
+        return variables != nullptr ? variables->setParameterValue(variable.name, variable.value) : -1;
     }
 
     SE_DLL_API int SE_GetVariable(SE_Variable *variable)
     {
-        return ScenarioReader::variables.getParameterValue(variable->name, variable->value);
+        Parameters *variables = GetParameters(true);
+        return variables != nullptr ? variables->getParameterValue(variable->name, variable->value) : -1;
     }
 
     SE_DLL_API int SE_GetVariableInt(const char *variableName, int *value)
     {
-        return ScenarioReader::variables.getParameterValueInt(variableName, *value);
+        Parameters *variables = GetParameters(true);
+        return variables != nullptr ? variables->getParameterValueInt(variableName, *value) : -1;
     }
 
     SE_DLL_API int SE_GetVariableDouble(const char *variableName, double *value)
     {
-        return ScenarioReader::variables.getParameterValueDouble(variableName, *value);
+        Parameters *variables = GetParameters(true);
+        return variables != nullptr ? variables->getParameterValueDouble(variableName, *value) : -1;
     }
 
     SE_DLL_API int SE_GetVariableString(const char *variableName, const char **value)
     {
-        return ScenarioReader::variables.getParameterValueString(variableName, *value);
+        Parameters *variables = GetParameters(true);
+        return variables != nullptr ? variables->getParameterValueString(variableName, *value) : -1;
     }
 
     SE_DLL_API int SE_GetVariableBool(const char *variableName, bool *value)
     {
-        return ScenarioReader::variables.getParameterValueBool(variableName, *value);
+        Parameters *variables = GetParameters(true);
+        return variables != nullptr ? variables->getParameterValueBool(variableName, *value) : -1;
     }
 
     SE_DLL_API int SE_SetVariableInt(const char *variableName, int value)
     {
-        return ScenarioReader::variables.setParameterValue(variableName, value);
+        Parameters *variables = GetParameters(true);
+        return variables != nullptr ? variables->setParameterValue(variableName, value) : -1;
     }
 
     SE_DLL_API int SE_SetVariableDouble(const char *variableName, double value)
     {
-        return ScenarioReader::variables.setParameterValue(variableName, value);
+        Parameters *variables = GetParameters(true);
+        return variables != nullptr ? variables->setParameterValue(variableName, value) : -1;
     }
 
     SE_DLL_API int SE_SetVariableString(const char *variableName, const char *value)
     {
-        return ScenarioReader::variables.setParameterValue(variableName, value);
+        Parameters *variables = GetParameters(true);
+        return variables != nullptr ? variables->setParameterValue(variableName, value) : -1;
     }
 
     SE_DLL_API int SE_SetVariableBool(const char *variableName, bool value)
     {
-        return ScenarioReader::variables.setParameterValue(variableName, value);
+        Parameters *variables = GetParameters(true);
+        return variables != nullptr ? variables->setParameterValue(variableName, value) : -1;
     }
 
     SE_DLL_API void *SE_GetODRManager()
     {
-        if (player != nullptr)
+        if (instance_->player != nullptr)
         {
-            return (void *)player->GetODRManager();
+            return (void *)instance_->player->GetODRManager();
         }
 
         return NULL;
@@ -924,6 +1038,138 @@ extern "C"
         TxtLogger::Inst().Stop();
     }
 
+    SE_DLL_API void *SE_CreateInstance()
+    {
+        SE_Instance *instance = new SE_Instance;
+        instance->env         = std::make_unique<SE_Env>();
+        instance->param_dist  = std::make_unique<OSCParameterDistribution>();
+        instance->odr         = std::make_unique<roadmanager::OpenDrive>();
+
+        {
+            // inherit options of the default instance, e.g. persistent ones
+            InstanceScope scope(&default_instance_);
+            instance->env->GetOptions() = SE_Env::Inst().GetOptions();
+        }
+
+        return instance;
+    }
+
+    SE_DLL_API void SE_DestroyInstance(void *handle)
+    {
+        if (handle == nullptr || handle == &default_instance_)
+        {
+            return;
+        }
+
+        {
+            InstanceScope scope(handle);
+            resetScenario();
+        }
+
+        if (instance_ == handle)
+        {
+            // destroyed while selected, fall back to default instance
+            BindInstance(&default_instance_);
+        }
+
+        delete static_cast<SE_Instance *>(handle);
+    }
+
+    SE_DLL_API int SE_SelectInstance(void *handle)
+    {
+        BindInstance(handle != nullptr ? static_cast<SE_Instance *>(handle) : &default_instance_);
+        return 0;
+    }
+
+    SE_DLL_API int SE_InitInstance(void *handle, const char *oscFilename, int disable_ctrls, int record)
+    {
+        if (handle == nullptr)
+        {
+            return -1;
+        }
+
+        InstanceScope scope(handle);
+        return SE_Init(oscFilename, disable_ctrls, 0, 0, record);
+    }
+
+    SE_DLL_API int SE_InitInstanceWithArgs(void *handle, int argc, const char *argv[])
+    {
+        if (handle == nullptr)
+        {
+            return -1;
+        }
+
+        InstanceScope scope(handle);
+        return SE_InitWithArgs(argc, argv);
+    }
+
+    SE_DLL_API int SE_StepInstance(void *handle, float dt)
+    {
+        if (handle == nullptr)
+        {
+            return -1;
+        }
+
+        InstanceScope scope(handle);
+        return dt > 0.0f ? SE_StepDT(dt) : SE_Step();
+    }
+
+    SE_DLL_API void SE_CloseInstance(void *handle)
+    {
+        if (handle == nullptr)
+        {
+            return;
+        }
+
+        InstanceScope scope(handle);
+        resetScenario();
+        RegisterParameterDeclarationCallback(nullptr, nullptr);
+    }
+
+    SE_DLL_API double SE_GetSimulationTimeInstance(void *handle)
+    {
+        if (handle == nullptr)
+        {
+            return 0.0;
+        }
+
+        InstanceScope scope(handle);
+        return SE_GetSimulationTimeDouble();
+    }
+
+    SE_DLL_API int SE_GetQuitFlagInstance(void *handle)
+    {
+        if (handle == nullptr)
+        {
+            return -1;
+        }
+
+        InstanceScope scope(handle);
+        return SE_GetQuitFlag();
+    }
+
+    SE_DLL_API int SE_GetNumberOfObjectsInstance(void *handle)
+    {
+        if (handle == nullptr)
+        {
+            return -1;
+        }
+
+        InstanceScope scope(handle);
+        return SE_GetNumberOfObjects();
+    }
+
+    SE_DLL_API int SE_GetObjectStateInstance(void *handle, int object_id, SE_ScenarioObjectState *state)
+    {
+        if (handle == nullptr)
+        {
+            return -1;
+        }
+
+        InstanceScope scope(handle);
+        return SE_GetObjectState(object_id, state);
+    }
+
     SE_DLL_API void SE_LogToConsole(bool mode)
     {
         if (mode)
@@ -941,12 +1187,52 @@ extern "C"
         SE_Env::Inst().SetCollisionDetection(mode);
     }
 
+    SE_DLL_API void SE_EnableProfiling(bool mode)
+    {
+        if (mode)
+        {
+            SE_Profiler::Inst().Reset();
+        }
+        SE_Profiler::Inst().Enable(mode);
+    }
+
+    SE_DLL_API int SE_GetNumberOfProfilePhases()
+    {
+        return static_cast<int>(SE_Profiler::Inst().GetPhases().size());
+    }
+
+    SE_DLL_API int SE_GetProfilePhase(int index, SE_ProfilePhase *phase)
+    {
+        static_assert(std::extent<decltype(SE_ProfilePhase::histogram)>::value == std::extent<decltype(SE_Profiler::Phase::histogram)>::value,
+                      "Profile histogram size mismatch");
+
+        std::vector<SE_Profiler::Phase> phases = SE_Profiler::Inst().GetPhases();
+
+        if (phase == nullptr || index < 0 || index >= static_cast<int>(phases.size()))
+        {
+            return -1;
+        }
+
+        SE_Profiler::Phase &p = phases[static_cast<unsigned int>(index)];
+        StrCopy(phase->name, p.name.c_str(), SE_PROFILE_NAME_SIZE);
+        phase->count = static_cast<int>(p.count);
+        phase->total = static_cast<float>(1E-3 * p.total_us);
+        phase->min   = static_cast<float>(1E-3 * p.min_us);
+        phase->max   = static_cast<float>(1E-3 * p.max_us);
+        for (int i = 0; i < SE_PROFILE_NUM_BUCKETS; i++)
+        {
+            phase->histogram[i] = static_cast<int>(p.histogram[i]);
+        }
+
+        return 0;
+    }
+
     SE_DLL_API int SE_Step()
     {
-        if (player != nullptr)
+        if (instance_->player != nullptr)
         {
-            player->SetFixedTimestep(-1.0);
-            player->Frame();
+            instance_->player->SetFixedTimestep(-1.0);
+            instance_->player->Frame();
             return 0;
         }
         else
@@ -957,10 +1243,10 @@ extern "C"
 
     SE_DLL_API int SE_StepDT(float dt)
     {
-        if (player != nullptr)
+        if (instance_->player != nullptr)
         {
-            player->SetFixedTimestep(dt);
-            player->Frame(dt);
+            instance_->player->SetFixedTimestep(dt);
+            instance_->player->Frame(dt);
             return 0;
         }
         else
@@ -969,39 +1255,64 @@ extern "C"
         }
     }
 
+    SE_DLL_API void *SE_SaveState()
+    {
+        if (instance_->player == nullptr)
+        {
+            return nullptr;
+        }
+
+        return static_cast<void *>(instance_->player->SaveState());
+    }
+
+    SE_DLL_API int SE_RestoreState(void *state)
+    {
+        if (instance_->player == nullptr || state == nullptr)
+        {
+            return -1;
+        }
+
+        return instance_->player->RestoreState(static_cast<SE_StateBuffer *>(state));
+    }
+
+    SE_DLL_API void SE_DeleteState(void *state)
+    {
+        delete static_cast<SE_StateBuffer *>(state);
+    }
+
     SE_DLL_API float SE_GetSimulationTime()
     {
-        if (player == nullptr)
+        if (instance_->player == nullptr)
         {
             return 0.0f;
         }
 
-        return static_cast<float>(player->scenarioEngine->getSimulationTime());
+        return static_cast<float>(instance_->player->scenarioEngine->getSimulationTime());
     }
 
     SE_DLL_API double SE_GetSimulationTimeDouble()
     {
-        if (player == nullptr)
+        if (instance_->player == nullptr)
         {
             return 0.0;
         }
 
-        return player->scenarioEngine->getSimulationTime();
+        return instance_->player->scenarioEngine->getSimulationTime();
     }
 
     SE_DLL_API float SE_GetSimTimeStep()
     {
-        if (player == nullptr)
+        if (instance_->player == nullptr)
         {
             return 0.0f;
         }
 
-        return static_cast<float>(SE_getSimTimeStep(time_stamp, 0.001, 0.1));
+        return static_cast<float>(SE_getSimTimeStep(instance_->time_stamp, 0.001, 0.1));
     }
 
     SE_DLL_API void SE_SetObjectPositionMode(int object_id, SE_PositionModeType type, int mode)
     {
-        if (player != nullptr)
+        if (instance_->player != nullptr)
         {
             Object *obj = nullptr;
             if (getObjectById(object_id, obj) == -1)
@@ -1009,13 +1320,13 @@ extern "C"
                 return;
             }
 
-            player->scenarioGateway->setObjectPositionMode(object_id, type, mode);
+            instance_->player->scenarioGateway->setObjectPositionMode(object_id, type, mode);
         }
     }
 
     SE_DLL_API void SE_SetObjectPositionModeDefault(int object_id, SE_PositionModeType type)
     {
-        if (player != nullptr)
+        if (instance_->player != nullptr)
         {
             Object *obj = nullptr;
             if (getObjectById(object_id, obj) == -1)
@@ -1023,7 +1334,7 @@ extern "C"
                 return;
             }
 
-            player->scenarioGateway->setObjectPositionModeDefault(object_id, type);
+            instance_->player->scenarioGateway->setObjectPositionModeDefault(object_id, type);
         }
     }
 
@@ -1050,7 +1361,7 @@ extern "C"
         int object_id = -1;
 
         // Add missing object
-        if (player != nullptr)
+        if (instance_->player != nullptr)
         {
             std::string name;
             if (object_name == nullptr)
@@ -1079,7 +1390,7 @@ extern "C"
             if (object_type == scenarioengine::Object::Type::VEHICLE)
             {
                 vehicle               = new Vehicle();
-                object_id             = player->scenarioEngine->entities_.addObject(vehicle, true);
+                object_id             = instance_->player->scenarioEngine->entities_.addObject(vehicle, true);
                 vehicle->name_        = name;
                 vehicle->scaleMode_   = static_cast<EntityScaleMode>(scale_mode);
                 vehicle->model_id_    = model_id;
@@ -1093,7 +1404,7 @@ extern "C"
                 Controller *ctrl          = InstantiateControllerExternal(&args);
                 if (ctrl != nullptr)
                 {
-                    player->scenarioEngine->scenarioReader->AddController(ctrl);
+                    instance_->player->scenarioEngine->scenarioReader->AddController(ctrl);
                     vehicle->AssignController(ctrl);
                     ctrl->Activate(ControlActivationMode::ON, ControlActivationMode::ON, ControlActivationMode::OFF, ControlActivationMode::OFF);
                 }
@@ -1104,7 +1415,7 @@ extern "C"
                 return -1;
             }
 
-            if (player->scenarioGateway->reportObject(object_id,
+            if (instance_->player->scenarioGateway->reportObject(object_id,
                                                       name,
                                                       object_type,
                                                       object_category,
@@ -1142,16 +1453,16 @@ extern "C"
             return -1;
         }
 
-        if (player != nullptr)
+        if (instance_->player != nullptr)
         {
             for (auto &ctrl : obj->controllers_)
             {
                 obj->UnassignController(ctrl);
                 ctrl->UnlinkObject();
-                player->scenarioEngine->scenarioReader->RemoveController(ctrl);
+                instance_->player->scenarioEngine->scenarioReader->RemoveController(ctrl);
             }
-            player->scenarioEngine->entities_.removeObject(object_id);
-            player->scenarioGateway->removeObject(object_id);
+            instance_->player->scenarioEngine->entities_.removeObject(object_id);
+            instance_->player->scenarioGateway->removeObject(object_id);
             return 0;
         }
 
@@ -1166,7 +1477,7 @@ extern "C"
             return -1;
         }
 
-        player->scenarioGateway->updateObjectWorldPos(object_id, timestamp, x, y, z, h, p, r);
+        instance_->player->scenarioGateway->updateObjectWorldPos(object_id, timestamp, x, y, z, h, p, r);
 
         return 0;
     }
@@ -1179,7 +1490,7 @@ extern "C"
             return -1;
         }
 
-        player->scenarioGateway->updateObjectWorldPosMode(object_id, timestamp, x, y, z, h, p, r, mode);
+        instance_->player->scenarioGateway->updateObjectWorldPosMode(object_id, timestamp, x, y, z, h, p, r, mode);
 
         return 0;
     }
@@ -1192,7 +1503,7 @@ extern "C"
             return -1;
         }
 
-        player->scenarioGateway->updateObjectWorldPosXYH(object_id, timestamp, x, y, h);
+        instance_->player->scenarioGateway->updateObjectWorldPosXYH(object_id, timestamp, x, y, h);
 
         return 0;
     }
@@ -1205,7 +1516,7 @@ extern "C"
             return -1;
         }
 
-        player->scenarioGateway->updateObjectLanePos(object_id, timestamp, roadId, laneId, laneOffset, s);
+        instance_->player->scenarioGateway->updateObjectLanePos(object_id, timestamp, roadId, laneId, laneOffset, s);
 
         return 0;
     }
@@ -1217,7 +1528,7 @@ extern "C"
         {
             return -1;
         }
-        player->scenarioGateway->updateObjectSpeed(object_id, 0.0, speed);
+        instance_->player->scenarioGateway->updateObjectSpeed(object_id, 0.0, speed);
 
         return 0;
     }
@@ -1230,7 +1541,7 @@ extern "C"
             return -1;
         }
 
-        player->scenarioGateway->reportObject(object_id,
+        instance_->player->scenarioGateway->reportObject(object_id,
                                               obj->name_,
                                               obj->type_,
                                               obj->category_,
@@ -1261,7 +1572,7 @@ extern "C"
             return -1;
         }
 
-        player->scenarioGateway->reportObject(object_id,
+        instance_->player->scenarioGateway->reportObject(object_id,
                                               obj->name_,
                                               obj->type_,
                                               obj->category_,
@@ -1292,7 +1603,7 @@ extern "C"
         {
             return -1;
         }
-        player->scenarioGateway->updateObjectVel(object_id, 0.0, x_vel, y_vel, z_vel);
+        instance_->player->scenarioGateway->updateObjectVel(object_id, 0.0, x_vel, y_vel, z_vel);
         // Also update velocities directly in scenario object, in case we're in a callback
         obj->SetVel(x_vel, y_vel, z_vel);
 
@@ -1307,7 +1618,7 @@ extern "C"
         {
             return -1;
         }
-        player->scenarioGateway->updateObjectAngularVel(object_id, 0.0, h_rate, p_rate, r_rate);
+        instance_->player->scenarioGateway->updateObjectAngularVel(object_id, 0.0, h_rate, p_rate, r_rate);
         // Also update accelerations directly in scenario object, in case we're in a callback
         obj->SetAngularVel(h_rate, p_rate, r_rate);
 
@@ -1322,7 +1633,7 @@ extern "C"
         {
             return -1;
         }
-        player->scenarioGateway->updateObjectAcc(object_id, 0.0, x_acc, y_acc, z_acc);
+        instance_->player->scenarioGateway->updateObjectAcc(object_id, 0.0, x_acc, y_acc, z_acc);
         // Also update accelerations directly in scenario object, in case we're in a callback
         obj->SetAcc(x_acc, y_acc, z_acc);
 
@@ -1337,7 +1648,7 @@ extern "C"
         {
             return -1;
         }
-        player->scenarioGateway->updateObjectAngularAcc(object_id, 0.0, h_acc, p_acc, r_acc);
+        instance_->player->scenarioGateway->updateObjectAngularAcc(object_id, 0.0, h_acc, p_acc, r_acc);
         // Also update accelerations directly in scenario object, in case we're in a callback
         obj->SetAngularAcc(h_acc, p_acc, r_acc);
 
@@ -1351,8 +1662,8 @@ extern "C"
         {
             return -1;
         }
-        player->scenarioGateway->updateObjectWheelRotation(object_id, 0, rotation);
-        player->scenarioGateway->updateObjectWheelAngle(object_id, 0, angle);
+        instance_->player->scenarioGateway->updateObjectWheelRotation(object_id, 0, rotation);
+        instance_->player->scenarioGateway->updateObjectWheelAngle(object_id, 0, angle);
 
         return 0;
     }
@@ -1365,9 +1676,9 @@ extern "C"
             return -1;
         }
 
-        if (object_id >= 0 && object_id < static_cast<int>(player->scenarioEngine->entities_.object_.size()))
+        if (object_id >= 0 && object_id < static_cast<int>(instance_->player->scenarioEngine->entities_.object_.size()))
         {
-            player->scenarioGateway->getObjectStatePtrByIdx(object_id)->state_.pos.SetSnapLaneTypes(laneTypes);
+            instance_->player->scenarioGateway->getObjectStatePtrByIdx(object_id)->state_.pos.SetSnapLaneTypes(laneTypes);
         }
         else
         {
@@ -1385,9 +1696,9 @@ extern "C"
             return -1;
         }
 
-        if (object_id >= 0 && object_id < static_cast<int>(player->scenarioEngine->entities_.object_.size()))
+        if (object_id >= 0 && object_id < static_cast<int>(instance_->player->scenarioEngine->entities_.object_.size()))
         {
-            player->scenarioGateway->getObjectStatePtrByIdx(object_id)->state_.pos.SetLockOnLane(mode);
+            instance_->player->scenarioGateway->getObjectStatePtrByIdx(object_id)->state_.pos.SetLockOnLane(mode);
         }
         else
         {
@@ -1399,36 +1710,36 @@ extern "C"
 
     SE_DLL_API int SE_GetNumberOfObjects()
     {
-        if (player == nullptr)
+        if (instance_->player == nullptr)
         {
             return -1;
         }
 
-        return player->scenarioGateway->getNumberOfObjects();
+        return instance_->player->scenarioGateway->getNumberOfObjects();
     }
 
     SE_DLL_API int SE_GetId(int index)
     {
-        if (player == nullptr || index < 0 || index >= player->scenarioGateway->getNumberOfObjects())
+        if (instance_->player == nullptr || index < 0 || index >= instance_->player->scenarioGateway->getNumberOfObjects())
         {
             return -1;
         }
 
-        return player->scenarioGateway->getObjectStatePtrByIdx(index)->state_.info.id;
+        return instance_->player->scenarioGateway->getObjectStatePtrByIdx(index)->state_.info.id;
     }
 
     SE_DLL_API int SE_GetIdByName(const char *name)
     {
-        if (player == nullptr)
+        if (instance_->player == nullptr)
         {
             return -1;
         }
 
-        for (size_t i = 0; player->scenarioEngine && i < player->scenarioEngine->entities_.object_.size(); i++)
+        for (size_t i = 0; instance_->player->scenarioEngine && i < instance_->player->scenarioEngine->entities_.object_.size(); i++)
         {
-            if (player->scenarioEngine->entities_.object_[i]->GetName() == name)
+            if (instance_->player->scenarioEngine->entities_.object_[i]->GetName() == name)
             {
-                return player->scenarioEngine->entities_.object_[i]->GetId();
+                return instance_->player->scenarioEngine->entities_.object_[i]->GetId();
             }
         }
 
@@ -1437,16 +1748,15 @@ extern "C"
 
     SE_DLL_API int SE_GetObjectState(int object_id, SE_ScenarioObjectState *state)
     {
-        scenarioengine::ObjectState obj_state;
-
-        if (player == nullptr)
+        if (instance_->player == nullptr)
         {
             return -1;
         }
 
-        if (player->scenarioGateway->getObjectStateById(object_id, obj_state) != -1)
+        scenarioengine::ObjectState *obj_state = instance_->player->scenarioGateway->getObjectStatePtrById(object_id);
+        if (obj_state != nullptr)
         {
-            copyStateFromScenarioGateway(state, &obj_state.state_);
+            copyStateFromScenarioGateway(state, &obj_state->state_);
             return 0;
         }
 
@@ -1455,9 +1765,9 @@ extern "C"
 
     SE_DLL_API int SE_GetObjectRouteStatus(int object_id)
     {
-        if (player != nullptr)
+        if (instance_->player != nullptr)
         {
-            Object *obj = player->scenarioEngine->entities_.GetObjectById(object_id);
+            Object *obj = instance_->player->scenarioEngine->entities_.GetObjectById(object_id);
             if (obj == nullptr)
             {
                 return -1;
@@ -1500,50 +1810,47 @@ extern "C"
 
     SE_DLL_API const char *SE_GetObjectTypeName(int object_id)
     {
-        static std::string returnString;
-        Object            *obj = nullptr;
+        Object *obj = nullptr;
         if (getObjectById(object_id, obj) == -1)
         {
             return 0;
         }
 
-        returnString = obj->GetTypeName();
-        return returnString.c_str();
+        instance_->return_string.object_type_name = obj->GetTypeName();
+        return instance_->return_string.object_type_name.c_str();
     }
 
     SE_DLL_API const char *SE_GetObjectName(int object_id)
     {
-        static std::string returnString;
-        Object            *obj = nullptr;
+        Object *obj = nullptr;
         if (getObjectById(object_id, obj) == -1)
         {
             return 0;
         }
-        returnString = obj->name_;
-        return returnString.c_str();
+        instance_->return_string.object_name = obj->name_;
+        return instance_->return_string.object_name.c_str();
     }
 
     SE_DLL_API const char *SE_GetObjectModelFileName(int object_id)
     {
-        static std::string returnString;
-        Object            *obj = nullptr;
+        Object *obj = nullptr;
         if (getObjectById(object_id, obj) == -1)
         {
             return 0;
         }
-        returnString = obj->GetModelFileName();
-        return returnString.c_str();
+        instance_->return_string.object_model_filename = obj->GetModelFileName();
+        return instance_->return_string.object_model_filename.c_str();
     }
 
     SE_DLL_API int SE_OpenOSISocket(const char *ipaddr)
     {
 #ifdef _USE_OSI
-        if (player == nullptr)
+        if (instance_->player == nullptr)
         {
             return -1;
         }
 
-        player->osiReporter->OpenSocket(ipaddr);
+        instance_->player->osiReporter->OpenSocket(ipaddr);
 #else
         (void)ipaddr;
 #endif  // _USE_OSI
@@ -1554,9 +1861,9 @@ extern "C"
     SE_DLL_API const char *SE_GetOSIGroundTruth(int *size)
     {
 #ifdef _USE_OSI
-        if (player != nullptr)
+        if (instance_->player != nullptr)
         {
-            return player->osiReporter->GetOSIGroundTruth(size);
+            return instance_->player->osiReporter->GetOSIGroundTruth(size);
         }
 
         *size = 0;
@@ -1569,9 +1876,9 @@ extern "C"
     SE_DLL_API const char *SE_GetOSIGroundTruthRaw()
     {
 #ifdef _USE_OSI
-        if (player != nullptr)
+        if (instance_->player != nullptr)
         {
-            return player->osiReporter->GetOSIGroundTruthRaw();
+            return instance_->player->osiReporter->GetOSIGroundTruthRaw();
         }
 #endif  // _USE_OSI
 
@@ -1581,9 +1888,9 @@ extern "C"
     SE_DLL_API const char *SE_GetOSITrafficCommandRaw()
     {
 #ifdef _USE_OSI
-        if (player != nullptr)
+        if (instance_->player != nullptr)
         {
-            return player->osiReporter->GetOSITrafficCommandRaw();
+            return instance_->player->osiReporter->GetOSITrafficCommandRaw();
         }
 #endif  // _USE_OSI
 
@@ -1595,18 +1902,18 @@ extern "C"
         (void)sensordata;
 
 #ifdef _USE_OSI
-        if (player != nullptr)
+        if (instance_->player != nullptr)
         {
 #ifdef _USE_OSG
-            if (player->viewer_)
+            if (instance_->player->viewer_)
             {
                 const osi3::SensorData *sd = reinterpret_cast<const osi3::SensorData *>(sensordata);
-                player->osiReporter->CreateSensorViewFromSensorData(*sd);
-                if (player->osiReporter->GetSensorView())
+                instance_->player->osiReporter->CreateSensorViewFromSensorData(*sd);
+                if (instance_->player->osiReporter->GetSensorView())
                 {
-                    if (player->OSISensorDetection)
+                    if (instance_->player->OSISensorDetection)
                     {
-                        player->OSISensorDetection->SensorUpdate(player->osiReporter->GetSensorView());
+                        instance_->player->OSISensorDetection->SensorUpdate(instance_->player->osiReporter->GetSensorView());
                     }
                 }
             }
@@ -1620,9 +1927,9 @@ extern "C"
     SE_DLL_API const char *SE_GetOSIRoadLane(int *size, int object_id)
     {
 #ifdef _USE_OSI
-        if (player != nullptr)
+        if (instance_->player != nullptr)
         {
-            return player->osiReporter->GetOSIRoadLane(player->scenarioGateway->objectState_, size, object_id);
+            return instance_->player->osiReporter->GetOSIRoadLane(instance_->player->scenarioGateway->objectState_, size, object_id);
         }
 
         *size = 0;
@@ -1637,9 +1944,9 @@ extern "C"
     SE_DLL_API const char *SE_GetOSILaneBoundary(int *size, int global_id)
     {
 #ifdef _USE_OSI
-        if (player != nullptr)
+        if (instance_->player != nullptr)
         {
-            return player->osiReporter->GetOSIRoadLaneBoundary(size, global_id);
+            return instance_->player->osiReporter->GetOSIRoadLaneBoundary(size, global_id);
         }
 
         *size = 0;
@@ -1654,10 +1961,10 @@ extern "C"
     SE_DLL_API void SE_GetOSILaneBoundaryIds(int object_id, SE_LaneBoundaryId *ids)
     {
 #ifdef _USE_OSI
-        if (player != nullptr)
+        if (instance_->player != nullptr)
         {
             std::vector<id_t> ids_vector;
-            player->osiReporter->GetOSILaneBoundaryIds(player->scenarioGateway->objectState_, ids_vector, object_id);
+            instance_->player->osiReporter->GetOSILaneBoundaryIds(instance_->player->scenarioGateway->objectState_, ids_vector, object_id);
             if (!ids_vector.empty())
             {
                 ids->far_left_lb_id  = ids_vector[0];
@@ -1677,9 +1984,9 @@ extern "C"
     SE_DLL_API int SE_ClearOSIGroundTruth()
     {
 #ifdef _USE_OSI
-        if (player != nullptr)
+        if (instance_->player != nullptr)
         {
-            return player->osiReporter->ClearOSIGroundTruth();
+            return instance_->player->osiReporter->ClearOSIGroundTruth();
         }
 #endif  // _USE_OSI
 
@@ -1689,9 +1996,9 @@ extern "C"
     SE_DLL_API int SE_UpdateOSIGroundTruth(bool refetchStaticGt)
     {
 #ifdef _USE_OSI
-        if (player != nullptr)
+        if (instance_->player != nullptr)
         {
-            return player->osiReporter->UpdateOSIGroundTruth(player->scenarioGateway->objectState_, refetchStaticGt);
+            return instance_->player->osiReporter->UpdateOSIGroundTruth(instance_->player->scenarioGateway->objectState_, refetchStaticGt);
         }
 #else
         (void)refetchStaticGt;
@@ -1702,9 +2009,9 @@ extern "C"
     SE_DLL_API int SE_UpdateOSIStaticGroundTruth()
     {
 #ifdef _USE_OSI
-        if (player != nullptr)
+        if (instance_->player != nullptr)
         {
-            return player->osiReporter->UpdateOSIStaticGroundTruth(player->scenarioGateway->objectState_);
+            return instance_->player->osiReporter->UpdateOSIStaticGroundTruth(instance_->player->scenarioGateway->objectState_);
         }
 #endif  // _USE_OSI
 
@@ -1714,9 +2021,9 @@ extern "C"
     SE_DLL_API int SE_UpdateOSIDynamicGroundTruth(bool reportGhost)
     {
 #ifdef _USE_OSI
-        if (player != nullptr)
+        if (instance_->player != nullptr)
         {
-            return player->osiReporter->UpdateOSIDynamicGroundTruth(player->scenarioGateway->objectState_, reportGhost);
+            return instance_->player->osiReporter->UpdateOSIDynamicGroundTruth(instance_->player->scenarioGateway->objectState_, reportGhost);
         }
 #else
         (void)reportGhost;
@@ -1728,9 +2035,9 @@ extern "C"
     SE_DLL_API int SE_UpdateOSITrafficCommand()
     {
 #ifdef _USE_OSI
-        if (player != nullptr)
+        if (instance_->player != nullptr)
         {
-            return player->osiReporter->UpdateOSITrafficCommand();
+            return instance_->player->osiReporter->UpdateOSITrafficCommand();
         }
 #endif  // _USE_OSI
 
@@ -1740,9 +2047,9 @@ extern "C"
     SE_DLL_API const char *SE_GetOSISensorDataRaw()
     {
 #ifdef _USE_OSI
-        if (player != nullptr)
+        if (instance_->player != nullptr)
         {
-            return player->osiReporter->GetOSISensorDataRaw();
+            return instance_->player->osiReporter->GetOSISensorDataRaw();
         }
 #endif  // _USE_OSI
 
@@ -1752,9 +2059,9 @@ extern "C"
     SE_DLL_API int SE_OSISetTimeStamp(unsigned long long int nanoseconds)
     {
 #ifdef _USE_OSI
-        if (player != nullptr)
+        if (instance_->player != nullptr)
         {
-            player->osiReporter->SetOSITimeStampExplicit(nanoseconds);
+            instance_->player->osiReporter->SetOSITimeStampExplicit(nanoseconds);
             return 0;
         }
 #else
@@ -1815,9 +2122,12 @@ extern "C"
 
         if (ghost)
         {
-            scenarioengine::ObjectState obj_state;
-            player->scenarioGateway->getObjectStateById(ghost->id_, obj_state);
-            copyStateFromScenarioGateway(state, &obj_state.state_);
+            scenarioengine::ObjectState *obj_state = instance_->player->scenarioGateway->getObjectStatePtrById(ghost->id_);
+            if (obj_state == nullptr)
+            {
+                return -1;
+            }
+            copyStateFromScenarioGateway(state, &obj_state->state_);
         }
         else
         {
@@ -1869,9 +2179,9 @@ extern "C"
 
     SE_DLL_API float SE_GetObjectAcceleration(int object_id)
     {
-        if (player != nullptr)
+        if (instance_->player != nullptr)
         {
-            Object *obj = player->scenarioEngine->entities_.GetObjectById(object_id);
+            Object *obj = instance_->player->scenarioEngine->entities_.GetObjectById(object_id);
             if (obj != nullptr)
             {
                 return static_cast<float>(obj->pos_.GetAcc());
@@ -1883,9 +2193,9 @@ extern "C"
 
     SE_DLL_API int SE_GetObjectAccelerationGlobalXYZ(int object_id, float *acc_x, float *acc_y, float *acc_z)
     {
-        if (player != nullptr)
+        if (instance_->player != nullptr)
         {
-            Object *obj = player->scenarioEngine->entities_.GetObjectById(object_id);
+            Object *obj = instance_->player->scenarioEngine->entities_.GetObjectById(object_id);
             if (obj != nullptr && (acc_x != nullptr || acc_y != nullptr || acc_z != nullptr))
             {
                 if (acc_x != nullptr)
@@ -1909,9 +2219,9 @@ extern "C"
 
     SE_DLL_API int SE_GetObjectAccelerationLocalLatLong(int object_id, float *acc_lat, float *acc_long)
     {
-        if (player != nullptr)
+        if (instance_->player != nullptr)
         {
-            Object *obj = player->scenarioEngine->entities_.GetObjectById(object_id);
+            Object *obj = instance_->player->scenarioEngine->entities_.GetObjectById(object_id);
             if (obj != nullptr && (acc_lat != nullptr || acc_long != nullptr))
             {
                 if (acc_lat != nullptr)
@@ -1933,7 +2243,7 @@ extern "C"
     {
         scenarioengine::ObjectState gw_obj_state;
 
-        if (player->scenarioGateway->getObjectStateById(object_id, gw_obj_state) != -1)
+        if (instance_->player->scenarioGateway->getObjectStateById(object_id, gw_obj_state) != -1)
         {
             return static_cast<int>(gw_obj_state.state_.info.wheel_data.size());
         }
@@ -1945,7 +2255,7 @@ extern "C"
     {
         scenarioengine::ObjectState gw_obj_state;
 
-        if (player->scenarioGateway->getObjectStateById(object_id, gw_obj_state) != -1)
+        if (instance_->player->scenarioGateway->getObjectStateById(object_id, gw_obj_state) != -1)
         {
             int number_of_wheels = static_cast<int>(gw_obj_state.state_.info.wheel_data.size());
 
@@ -1961,17 +2271,17 @@ extern "C"
 
     /*SE_DLL_API int SE_GetObjectGhostStateFromOSI(const char* output, int index)
     {
-            if (player)
+            if (instance_->player)
             {
-                    if (index < player->scenarioEngine->entities_.object_.size())
+                    if (index < instance_->player->scenarioEngine->entities_.object_.size())
                     {
-                            for (size_t i = 0; i < player->scenarioEngine->entities_.object_.size(); i++)  // ghost index always higher than external
+                            for (size_t i = 0; i < instance_->player->scenarioEngine->entities_.object_.size(); i++)  // ghost index always higher than external
     buddy
                             {
-                                    if (player->scenarioEngine->entities_.object_[index]->ghost_)
+                                    if (instance_->player->scenarioEngine->entities_.object_[index]->ghost_)
                                     {
                                             scenarioengine::ObjectState obj_state;
-                                            player->scenarioGateway->getObjectStateById(player->scenarioEngine->entities_.object_[index]->ghost_->id_,
+                                            instance_->player->scenarioGateway->getObjectStateById(instance_->player->scenarioEngine->entities_.object_[index]->ghost_->id_,
     obj_state); copyStateFromScenarioGatewayToOSI(&output, &obj_state.state_);
                                     }
                             }
@@ -1984,19 +2294,69 @@ extern "C"
 
     SE_DLL_API int SE_GetObjectStates(int *nObjects, SE_ScenarioObjectState *state)
     {
-        int i;
-        *nObjects = 0;
+        if (instance_->player == nullptr || nObjects == nullptr || state == nullptr)
+        {
+            return -1;
+        }
+
+        ScenarioGateway *gw = instance_->player->scenarioGateway;
+        int              n  = MAX(0, MIN(*nObjects, gw->getNumberOfObjects()));
+        for (int i = 0; i < n; i++)
+        {
+            copyStateFromScenarioGateway(&state[i], &gw->getObjectStatePtrByIdx(i)->state_);
+        }
+        *nObjects = n;
+
+        return 0;
+    }
 
-        if (player == nullptr)
+    SE_DLL_API int SE_GetObjectStatesSoA(int *nObjects, int *id, float *x, float *y, float *z, float *h, float *p, float *r, float *speed)
+    {
+        if (instance_->player == nullptr || nObjects == nullptr)
         {
             return -1;
         }
 
-        for (i = 0; i < *nObjects && i < player->scenarioGateway->getNumberOfObjects(); i++)
+        ScenarioGateway *gw = instance_->player->scenarioGateway;
+        int              n  = MAX(0, MIN(*nObjects, gw->getNumberOfObjects()));
+        for (int i = 0; i < n; i++)
         {
-            copyStateFromScenarioGateway(&state[i], &player->scenarioGateway->getObjectStatePtrByIdx(i)->state_);
+            ObjectStateStruct &state = gw->getObjectStatePtrByIdx(i)->state_;
+
+            if (id != nullptr)
+            {
+                id[i] = state.info.id;
+            }
+            if (x != nullptr)
+            {
+                x[i] = static_cast<float>(state.pos.GetX());
+            }
+            if (y != nullptr)
+            {
+                y[i] = static_cast<float>(state.pos.GetY());
+            }
+            if (z != nullptr)
+            {
+                z[i] = static_cast<float>(state.pos.GetZ());
+            }
+            if (h != nullptr)
+            {
+                h[i] = static_cast<float>(state.pos.GetH());
+            }
+            if (p != nullptr)
+            {
+                p[i] = static_cast<float>(state.pos.GetP());
+            }
+            if (r != nullptr)
+            {
+                r[i] = static_cast<float>(state.pos.GetR());
+            }
+            if (speed != nullptr)
+            {
+                speed[i] = static_cast<float>(state.info.speed);
+            }
         }
-        *nObjects = i;
+        *nObjects = n;
 
         return 0;
     }
@@ -2005,7 +2365,7 @@ extern "C"
     {
         Object *obj = nullptr;
 
-        if (player == nullptr)
+        if (instance_->player == nullptr)
         {
             return -1;
         }
@@ -2015,17 +2375,17 @@ extern "C"
             return -1;
         }
 
-        return player->AddObjectSensor(obj, x, y, z, h, rangeNear, rangeFar, fovH, maxObj);
+        return instance_->player->AddObjectSensor(obj, x, y, z, h, rangeNear, rangeFar, fovH, maxObj);
     }
 
     SE_DLL_API int SE_GetNumberOfObjectSensors()
     {
-        if (player == nullptr)
+        if (instance_->player == nullptr)
         {
             return -1;
         }
 
-        return player->GetNumberOfObjectSensors();
+        return instance_->player->GetNumberOfObjectSensors();
     }
 
     SE_DLL_API int SE_ViewSensorData(int object_id)
@@ -2036,8 +2396,8 @@ extern "C"
             return -1;
         }
 
-        player->AddOSIDetection(object_id);
-        player->ShowObjectSensors(false);
+        instance_->player->AddOSIDetection(object_id);
+        instance_->player->ShowObjectSensors(false);
 
         return 0;
     }
@@ -2046,9 +2406,9 @@ extern "C"
     {
         SE_Env::Inst().DisableOSIFile();
 
-        if (player != nullptr)
+        if (instance_->player != nullptr)
         {
-            player->SetOSIFileStatus(false);
+            instance_->player->SetOSIFileStatus(false);
         }
     }
 
@@ -2056,38 +2416,38 @@ extern "C"
     {
         SE_Env::Inst().EnableOSIFile(filename == nullptr ? "" : filename);
 
-        if (player != nullptr)
+        if (instance_->player != nullptr)
         {
-            player->SetOSIFileStatus(true, filename);
+            instance_->player->SetOSIFileStatus(true, filename);
         }
     }
 
     SE_DLL_API void SE_FlushOSIFile()
     {
 #ifdef _USE_OSI
-        if (player != nullptr && player->osiReporter != nullptr)
+        if (instance_->player != nullptr && instance_->player->osiReporter != nullptr)
         {
-            player->osiReporter->FlushOSIFile();
+            instance_->player->osiReporter->FlushOSIFile();
         }
 #endif  // _USE_OSI
     }
 
     SE_DLL_API int SE_FetchSensorObjectList(int sensor_id, int *list)
     {
-        if (player != nullptr)
+        if (instance_->player != nullptr)
         {
-            if (sensor_id < 0 || sensor_id >= static_cast<int>(player->sensor.size()))
+            if (sensor_id < 0 || sensor_id >= static_cast<int>(instance_->player->sensor.size()))
             {
-                LOG_ERROR("Invalid sensor_id ({} specified / {} available)", sensor_id, player->sensor.size());
+                LOG_ERROR("Invalid sensor_id ({} specified / {} available)", sensor_id, instance_->player->sensor.size());
                 return -1;
             }
 
-            for (int i = 0; i < player->sensor[static_cast<unsigned int>(sensor_id)]->nObj_; i++)
+            for (int i = 0; i < instance_->player->sensor[static_cast<unsigned int>(sensor_id)]->nObj_; i++)
             {
-                list[i] = player->sensor[static_cast<unsigned int>(sensor_id)]->hitList_[i].obj_->id_;
+                list[i] = instance_->player->sensor[static_cast<unsigned int>(sensor_id)]->hitList_[i].obj_->id_;
             }
 
-            return player->sensor[static_cast<unsigned int>(sensor_id)]->nObj_;
+            return instance_->player->sensor[static_cast<unsigned int>(sensor_id)]->nObj_;
         }
 
         return -1;
@@ -2183,13 +2543,13 @@ extern "C"
 
     void objCallbackFn(ObjectStateStruct *state, void *my_data)
     {
-        for (size_t i = 0; i < objCallback.size(); i++)
+        for (size_t i = 0; i < instance_->objCallback.size(); i++)
         {
-            if (objCallback[i].id == state->info.id)
+            if (instance_->objCallback[i].id == state->info.id)
             {
                 SE_ScenarioObjectState se_state;
                 copyStateFromScenarioGateway(&se_state, state);
-                objCallback[i].func(&se_state, my_data);
+                instance_->objCallback[i].func(&se_state, my_data);
             }
         }
     }
@@ -2199,25 +2559,25 @@ extern "C"
         SE_ObjCallback cb;
         cb.id   = object_id;
         cb.func = fnPtr;
-        objCallback.push_back(cb);
-        player->RegisterObjCallback(object_id, objCallbackFn, user_data);
+        instance_->objCallback.push_back(cb);
+        instance_->player->RegisterObjCallback(object_id, objCallbackFn, user_data);
     }
 
     SE_DLL_API void SE_RegisterConditionCallback(void (*fnPtr)(const char *name, double timestamp))
     {
-        OSCCondition::conditionCallback = fnPtr;
+        instance_->conditionCallback = fnPtr;
     }
 
     SE_DLL_API void SE_RegisterStoryBoardElementStateChangeCallback(void (*fnPtr)(const char *name, int type, int state, const char *full_path))
     {
-        StoryBoardElement::stateChangeCallback = fnPtr;
+        instance_->stateChangeCallback = fnPtr;
     }
 
     SE_DLL_API unsigned int SE_GetNumberOfRoadSigns(id_t road_id)
     {
-        if (player != nullptr)
+        if (instance_->player != nullptr)
         {
-            roadmanager::Road *road = player->odr_manager->GetRoadById(road_id);
+            roadmanager::Road *road = instance_->player->odr_manager->GetRoadById(road_id);
             if (road != NULL)
             {
                 return road->GetNumberOfSignals();
@@ -2228,11 +2588,9 @@ extern "C"
 
     SE_DLL_API int SE_GetRoadSign(id_t road_id, unsigned int index, SE_RoadSign *road_sign)
     {
-        static std::string returnString;
-
-        if (player != nullptr)
+        if (instance_->player != nullptr)
         {
-            roadmanager::Road *road = player->odr_manager->GetRoadById(road_id);
+            roadmanager::Road *road = instance_->player->odr_manager->GetRoadById(road_id);
             if (road != NULL)
             {
                 roadmanager::Signal *s = road->GetSignal(index);
@@ -2242,10 +2600,10 @@ extern "C"
                     // Resolve global cartesian position (x, y, z, h) from the road coordinate
                     roadmanager::Position pos;
                     pos.SetTrackPos(road_id, s->GetS(), s->GetT());
+                    instance_->return_string.road_sign_name = s->GetName();
 
                     road_sign->id          = s->GetId();
-                    returnString           = s->GetName();
-                    road_sign->name        = returnString.c_str();
+                    road_sign->name        = instance_->return_string.road_sign_name.c_str();
                     road_sign->x           = static_cast<float>(pos.GetX());
                     road_sign->y           = static_cast<float>(pos.GetY());
                     road_sign->z           = static_cast<float>(pos.GetZ());
@@ -2269,9 +2627,9 @@ extern "C"
 
     SE_DLL_API unsigned int SE_GetNumberOfRoadSignValidityRecords(id_t road_id, unsigned int index)
     {
-        if (player != nullptr)
+        if (instance_->player != nullptr)
         {
-            roadmanager::Road *road = player->odr_manager->GetRoadById(road_id);
+            roadmanager::Road *road = instance_->player->odr_manager->GetRoadById(road_id);
             if (road != nullptr)
             {
                 roadmanager::Signal *s = road->GetSignal(index);
@@ -2284,9 +2642,9 @@ extern "C"
 
     SE_DLL_API int SE_GetRoadSignValidityRecord(id_t road_id, unsigned int signIndex, unsigned int validityIndex, SE_RoadObjValidity *validity)
     {
-        if (player != nullptr)
+        if (instance_->player != nullptr)
         {
-            roadmanager::Road *road = player->odr_manager->GetRoadById(road_id);
+            roadmanager::Road *road = instance_->player->odr_manager->GetRoadById(road_id);
             if (road != NULL)
             {
                 roadmanager::Signal *s = road->GetSignal(signIndex);
@@ -2304,9 +2662,9 @@ extern "C"
 
     SE_DLL_API const char *SE_GetRoadIdString(id_t road_id)
     {
-        if (player != nullptr)
+        if (instance_->player != nullptr)
         {
-            roadmanager::Road *road = player->odr_manager->GetRoadById(road_id);
+            roadmanager::Road *road = instance_->player->odr_manager->GetRoadById(road_id);
             if (road != NULL)
             {
                 return road->GetIdStrRef().c_str();
@@ -2318,9 +2676,9 @@ extern "C"
 
     SE_DLL_API id_t SE_GetRoadIdFromString(const char *road_id_str)
     {
-        if (player != nullptr)
+        if (instance_->player != nullptr)
         {
-            roadmanager::Road *road = player->odr_manager->GetRoadByIdStr(road_id_str);
+            roadmanager::Road *road = instance_->player->odr_manager->GetRoadByIdStr(road_id_str);
             if (road != NULL)
             {
                 return road->GetId();
@@ -2332,9 +2690,9 @@ extern "C"
 
     SE_DLL_API const char *SE_GetJunctionIdString(id_t junction_id)
     {
-        if (player != nullptr)
+        if (instance_->player != nullptr)
         {
-            roadmanager::Junction *junction = player->odr_manager->GetJunctionById(junction_id);
+            roadmanager::Junction *junction = instance_->player->odr_manager->GetJunctionById(junction_id);
             if (junction != NULL)
             {
                 return junction->GetIdStrRef().c_str();
@@ -2346,9 +2704,9 @@ extern "C"
 
     SE_DLL_API id_t SE_GetJunctionIdFromString(const char *junction_id_str)
     {
-        if (player != nullptr)
+        if (instance_->player != nullptr)
         {
-            roadmanager::Junction *junction = player->odr_manager->GetJunctionByIdStr(junction_id_str);
+            roadmanager::Junction *junction = instance_->player->odr_manager->GetJunctionByIdStr(junction_id_str);
             if (junction != NULL)
             {
                 return junction->GetId();
@@ -2361,9 +2719,9 @@ extern "C"
     SE_DLL_API void SE_ViewerShowFeature(int featureType, bool enable)
     {
 #ifdef _USE_OSG
-        if (player != nullptr && player->viewer_)
+        if (instance_->player != nullptr && instance_->player->viewer_)
         {
-            player->viewer_->SetNodeMaskBits(featureType, enable ? featureType : 0x0);
+            instance_->player->viewer_->SetNodeMaskBits(featureType, enable ? featureType : 0x0);
         }
 #else
         (void)featureType;
@@ -2530,9 +2888,9 @@ extern "C"
     {
 #ifdef _USE_OSG
         // prioritize setting via player, else update environment variable for next run
-        if (player)
+        if (instance_->player)
         {
-            player->SaveImagesToRAM(state);
+            instance_->player->SaveImagesToRAM(state);
         }
         else
         {
@@ -2548,9 +2906,9 @@ extern "C"
     SE_DLL_API int SE_SaveImagesToFile(int nrOfFrames)
     {
 #ifdef _USE_OSG
-        if (player)
+        if (instance_->player)
         {
-            return player->SaveImagesToFile(nrOfFrames);
+            return instance_->player->SaveImagesToFile(nrOfFrames);
         }
 #else
         (void)nrOfFrames;
@@ -2561,10 +2919,10 @@ extern "C"
     SE_DLL_API int SE_FetchImage(SE_Image *img)
     {
 #ifdef _USE_OSG
-        if (player)
+        if (instance_->player)
         {
             OffScreenImage *offScrImg = nullptr;
-            if ((offScrImg = player->FetchCapturedImagePtr()) == nullptr)
+            if ((offScrImg = instance_->player->FetchCapturedImagePtr()) == nullptr)
             {
                 return -1;
             }
@@ -2607,9 +2965,9 @@ extern "C"
     SE_DLL_API int SE_AddCustomCamera(double x, double y, double z, double h, double p)
     {
 #ifdef _USE_OSG
-        if (player)
+        if (instance_->player)
         {
-            return player->AddCustomCamera(x, y, z, h, p, false);
+            return instance_->player->AddCustomCamera(x, y, z, h, p, false);
         }
 #else
         (void)x;
@@ -2624,9 +2982,9 @@ extern "C"
     SE_DLL_API int SE_AddCustomFixedCamera(double x, double y, double z, double h, double p)
     {
 #ifdef _USE_OSG
-        if (player)
+        if (instance_->player)
         {
-            return player->AddCustomCamera(x, y, z, h, p, true);
+            return instance_->player->AddCustomCamera(x, y, z, h, p, true);
         }
 #else
         (void)x;
@@ -2641,9 +2999,9 @@ extern "C"
     SE_DLL_API int SE_AddCustomAimingCamera(double x, double y, double z)
     {
 #ifdef _USE_OSG
-        if (player)
+        if (instance_->player)
         {
-            return player->AddCustomCamera(x, y, z, false);
+            return instance_->player->AddCustomCamera(x, y, z, false);
         }
 #else
         (void)x;
@@ -2656,9 +3014,9 @@ extern "C"
     SE_DLL_API int SE_AddCustomFixedAimingCamera(double x, double y, double z)
     {
 #ifdef _USE_OSG
-        if (player)
+        if (instance_->player)
         {
-            return player->AddCustomCamera(x, y, z, true);
+            return instance_->player->AddCustomCamera(x, y, z, true);
         }
 #else
         (void)x;
@@ -2671,9 +3029,9 @@ extern "C"
     SE_DLL_API int SE_AddCustomFixedTopCamera(double x, double y, double z, double rot)
     {
 #ifdef _USE_OSG
-        if (player)
+        if (instance_->player)
         {
-            return player->AddCustomFixedTopCamera(x, y, z, rot);
+            return instance_->player->AddCustomFixedTopCamera(x, y, z, rot);
         }
 #else
         (void)x;
@@ -2687,9 +3045,9 @@ extern "C"
     SE_DLL_API int SE_SetCameraMode(int mode)
     {
 #ifdef _USE_OSG
-        if (player && player->viewer_)
+        if (instance_->player && instance_->player->viewer_)
         {
-            player->viewer_->SetCameraMode(mode);
+            instance_->player->viewer_->SetCameraMode(mode);
             return 0;
         }
 #else
@@ -2701,13 +3059,13 @@ extern "C"
     SE_DLL_API int SE_SetCameraObjectFocus(int object_id)
     {
 #ifdef _USE_OSG
-        if (player && player->viewer_)
+        if (instance_->player && instance_->player->viewer_)
         {
-            for (size_t i = 0; i < player->scenarioEngine->entities_.object_.size(); i++)
+            for (size_t i = 0; i < instance_->player->scenarioEngine->entities_.object_.size(); i++)
             {
-                if (player->scenarioEngine->entities_.object_[i]->GetId() == object_id)
+                if (instance_->player->scenarioEngine->entities_.object_[i]->GetId() == object_id)
                 {
-                    player->viewer_->SetVehicleInFocus(static_cast<int>(i));
+                    instance_->player->viewer_->SetVehicleInFocus(static_cast<int>(i));
                 }
             }
             return 0;
@@ -2758,7 +3116,7 @@ extern "C"
             return -1;
         }
 
-        roadmanager::Road *road = player->odr_manager->GetRoadById(route->all_waypoints_[route_index].GetTrackId());
+        roadmanager::Road *road = instance_->player->odr_manager->GetRoadById(route->all_waypoints_[route_index].GetTrackId());
 
         routeinfo->x          = static_cast<float>(route->all_waypoints_[route_index].GetX());
         routeinfo->y          = static_cast<float>(route->all_waypoints_[route_index].GetY());
@@ -2796,33 +3154,33 @@ extern "C"
 
     SE_DLL_API void SE_InjectSpeedAction(SE_SpeedActionStruct *action)
     {
-        if (player)
+        if (instance_->player)
         {
-            player->player_server_->InjectSpeedAction(*((SpeedActionStruct *)action));
+            instance_->player->player_server_->InjectSpeedAction(*((SpeedActionStruct *)action));
         }
     }
 
     SE_DLL_API void SE_InjectLaneChangeAction(SE_LaneChangeActionStruct *action)
     {
-        if (player)
+        if (instance_->player)
         {
-            player->player_server_->InjectLaneChangeAction(*((LaneChangeActionStruct *)action));
+            instance_->player->player_server_->InjectLaneChangeAction(*((LaneChangeActionStruct *)action));
         }
     }
 
     SE_DLL_API void SE_InjectLaneOffsetAction(SE_LaneOffsetActionStruct *action)
     {
-        if (player)
+        if (instance_->player)
         {
-            player->player_server_->InjectLaneOffsetAction(*((LaneOffsetActionStruct *)action));
+            instance_->player->player_server_->InjectLaneOffsetAction(*((LaneOffsetActionStruct *)action));
         }
     }
 
     SE_DLL_API bool SE_InjectedActionOngoing(int action_type)
     {
-        if (player)
+        if (instance_->player)
         {
-            return player->player_server_->InjectedActionOngoing(action_type);
+            return instance_->player->player_server_->InjectedActionOngoing(action_type);
         }
 
         return false;
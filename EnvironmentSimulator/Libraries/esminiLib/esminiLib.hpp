@@ -282,6 +282,19 @@ typedef struct
     int   transition_shape;  // 0 = cubic, 1 = linear, 2 = sinusoidal, 3 = step
 } SE_LaneOffsetActionStruct;
 
+#define SE_PROFILE_NAME_SIZE   64
+#define SE_PROFILE_NUM_BUCKETS 20
+
+typedef struct
+{
+    char  name[SE_PROFILE_NAME_SIZE];         // phase name, e.g. "storyboard" or "controller ACCController"
+    int   count;                              // number of measurements
+    float total;                              // total time (ms)
+    float min;                                // shortest measurement (ms)
+    float max;                                // longest measurement (ms)
+    int   histogram[SE_PROFILE_NUM_BUCKETS];  // number of measurements per duration, bucket 0: < 1 us, bucket i: 2^(i-1) - 2^i us
+} SE_ProfilePhase;
+
 // Modes for interpret Z, Head, Pitch, Roll coordinate value as absolute or relative
 // grouped as bitmask: 0000 => skip/use current, 0001=DEFAULT, 0011=ABS, 0111=REL
 // example: Relative Z, Absolute H, Default R, Current P = SE_Z_REL | SE_H_ABS | SE_R_DEF = 4151 = 0001 0000 0011 0111
@@ -574,6 +587,111 @@ extern "C"
     */
     SE_DLL_API void SE_Close();
 
+    /**
+            Save current state of the simulation, to later continue from the same point in time, e.g. to try different inputs.
+            Entities, actions and controllers are included. Output files, viewer and external controllers are not.
+            @return Handle to the saved state, or 0 on failure. Release by SE_DeleteState().
+    */
+    SE_DLL_API void *SE_SaveState();
+
+    /**
+            Restore a saved state. Can be done any number of times for the same state.
+            Fails, without changing the simulation, if entities have been added or deleted since the state was saved.
+            @param state Handle returned by SE_SaveState()
+            @return 0 if successful, -1 if not
+    */
+    SE_DLL_API int SE_RestoreState(void *state);
+
+    /**
+            Release a state saved by SE_SaveState()
+            @param state Handle returned by SE_SaveState()
+    */
+    SE_DLL_API void SE_DeleteState(void *state);
+
+    /**
+            Create an additional, independent, scenario engine instance. Multiple instances can run headless in parallel threads,
+            one thread per instance at a time. Logging, UDP/server ports and viewer are shared by all instances.
+            The functions not taking an instance handle operate on the default instance, see SE_SelectInstance().
+            Strings returned, e.g. by SE_GetObjectName(), are stored per instance.
+            @return Handle to the new instance, or 0 on failure
+    */
+    SE_DLL_API void *SE_CreateInstance();
+
+    /**
+            Close and release an instance created by SE_CreateInstance()
+            @param handle Instance handle
+    */
+    SE_DLL_API void SE_DestroyInstance(void *handle);
+
+    /**
+            Select instance for subsequent calls, not taking an instance handle, from the calling thread
+            @param handle Instance handle, 0 to select the default instance
+            @return 0 if successful, -1 if not
+    */
+    SE_DLL_API int SE_SelectInstance(void *handle);
+
+    /**
+            Initialize the scenario engine of an instance, headless i.e. no viewer
+            @param handle Instance handle
+            @param oscFilename Path to the OpenSCENARIO file
+            @param disable_ctrls 1=Any controller will be disabled 0=Controllers applied according to OSC file
+            @param record Create recording for later playback 0=no recording 1=recording
+            @return 0 if successful, -1 if not
+    */
+    SE_DLL_API int SE_InitInstance(void *handle, const char *oscFilename, int disable_ctrls, int record);
+
+    /**
+            Initialize the scenario engine of an instance
+            @param handle Instance handle
+            @param argc Number of arguments
+            @param argv Arguments
+            @return 0 if successful, -1 if not
+    */
+    SE_DLL_API int SE_InitInstanceWithArgs(void *handle, int argc, const char *argv[]);
+
+    /**
+            Step the simulation of an instance forward
+            @param handle Instance handle
+            @param dt time step in seconds, 0 or negative means elapsed system time since last step (see SE_Step())
+            @return 0 if successful, -1 if not
+    */
+    SE_DLL_API int SE_StepInstance(void *handle, float dt);
+
+    /**
+            Stop simulation of an instance gracefully, keeping the instance for next simulation
+            @param handle Instance handle
+    */
+    SE_DLL_API void SE_CloseInstance(void *handle);
+
+    /**
+            Get simulation time of an instance in seconds
+            @param handle Instance handle
+    */
+    SE_DLL_API double SE_GetSimulationTimeInstance(void *handle);
+
+    /**
+            Is esmini about to quit?
+            @param handle Instance handle
+            @return 0 if not, 1 if yes, -1 if some error e.g. scenario not loaded
+    */
+    SE_DLL_API int SE_GetQuitFlagInstance(void *handle);
+
+    /**
+            Get the number of entities in the scenario of an instance
+            @param handle Instance handle
+            @return Number of entities, -1 on error e.g. scenario not initialized
+    */
+    SE_DLL_API int SE_GetNumberOfObjectsInstance(void *handle);
+
+    /**
+            Get the state of specified object of an instance
+            @param handle Instance handle
+            @param object_id Id of the object
+            @param state Pointer/reference to a SE_ScenarioObjectState struct to be filled in
+            @return 0 if successful, -1 if not
+    */
+    SE_DLL_API int SE_GetObjectStateInstance(void *handle, int object_id, SE_ScenarioObjectState *state);
+
     /**
             Enable or disable log to stdout/console
             Deprecated, use SE_SetOption() / SE_UnsetOption() with "disable_stdout" instead
@@ -588,6 +706,27 @@ extern "C"
     */
     SE_DLL_API void SE_CollisionDetection(bool mode);
 
+    /**
+    Enable or disable profiling, i.e. measuring time spent per simulation phase (storyboard, controllers, OSI etc.)
+    Enabling clears any previous measurements, disabling keeps them. Also enabled by launch argument --profile.
+    @param mode true=enable, false=disable
+    */
+    SE_DLL_API void SE_EnableProfiling(bool mode);
+
+    /**
+    Get number of simulation phases measured by the profiler
+    @return Number of phases
+    */
+    SE_DLL_API int SE_GetNumberOfProfilePhases();
+
+    /**
+    Get time measurements of a simulation phase, see SE_EnableProfiling()
+    @param index Index of phase (0 .. SE_GetNumberOfProfilePhases() - 1)
+    @param phase Pointer to struct to fill in
+    @return 0 if successful, -1 if not
+    */
+    SE_DLL_API int SE_GetProfilePhase(int index, SE_ProfilePhase *phase);
+
     /**
             Get simulation time in seconds - float (32 bit) precision
     */
@@ -1062,6 +1201,31 @@ extern "C"
     */
     SE_DLL_API int SE_GetObjectState(int object_id, SE_ScenarioObjectState *state);
 
+    /**
+            Get the state of all objects in one call, ordered as by SE_GetId(index)
+            @param nObjects In: Capacity of the state array. Out: Number of states filled in
+            @param state Array of SE_ScenarioObjectState structs to be filled in
+            @return 0 if successful, -1 if not
+    */
+    SE_DLL_API int SE_GetObjectStates(int *nObjects, SE_ScenarioObjectState *state);
+
+    /**
+            Get the state of all objects in one call, into separate arrays per property (structure of arrays),
+            e.g. for direct use as numpy arrays. Any array pointer may be 0 to skip that property.
+            Ordered as by SE_GetId(index)
+            @param nObjects In: Capacity of each array. Out: Number of objects filled in
+            @param id Array of object ids
+            @param x Array of x coordinates
+            @param y Array of y coordinates
+            @param z Array of z coordinates
+            @param h Array of heading angles
+            @param p Array of pitch angles
+            @param r Array of roll angles
+            @param speed Array of speeds
+            @return 0 if successful, -1 if not
+    */
+    SE_DLL_API int SE_GetObjectStatesSoA(int *nObjects, int *id, float *x, float *y, float *z, float *h, float *p, float *r, float *speed);
+
     /**
             Get the object route status
             @param object_id Id of the object
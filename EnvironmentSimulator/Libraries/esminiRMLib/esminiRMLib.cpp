@@ -10,7 +10,9 @@
  * https://sites.google.com/view/simulationscenarios
  */
 
+#include <atomic>
 #include <clocale>
+#include <thread>
 
 #include "esminiRMLib.hpp"
 #include "RoadManager.hpp"
@@ -20,7 +22,8 @@ using namespace roadmanager;
 
 static roadmanager::OpenDrive* odrManager = nullptr;
 static std::vector<Position>   position;
-static std::string             returnString;  // use this for returning strings
+static std::string             returnString;         // use this for returning strings
+static SE_ThreadPool*          batch_pool = nullptr;  // see RM_SetBatchThreads()
 
 static int GetProbeInfo(int index, float lookahead_distance, RM_RoadProbeInfo* r_data, int lookAheadMode, bool inRoadDrivingDirection)
 {
@@ -143,6 +146,22 @@ static int GetRoadLaneInfo(int index, float lookahead_distance, RM_RoadLaneInfo*
     return 0;
 }
 
+static void GetPositionData(const Position& pos, RM_PositionData* data)
+{
+    data->x          = static_cast<float>(pos.GetX());
+    data->y          = static_cast<float>(pos.GetY());
+    data->z          = static_cast<float>(pos.GetZ());
+    data->h          = static_cast<float>(pos.GetH());
+    data->p          = static_cast<float>(pos.GetP());
+    data->r          = static_cast<float>(pos.GetR());
+    data->hRelative  = static_cast<float>(pos.GetHRelative());
+    data->roadId     = pos.GetTrackId();
+    data->junctionId = pos.GetJunctionId();
+    data->laneId     = pos.GetLaneId();
+    data->laneOffset = static_cast<float>(pos.GetOffset());
+    data->s          = static_cast<float>(pos.GetS());
+}
+
 extern "C"
 {
     RM_DLL_API int RM_Init(const char* odrFilename)
@@ -176,6 +195,8 @@ extern "C"
     {
         odrManager = nullptr;
         position.clear();
+        delete batch_pool;
+        batch_pool = nullptr;
 
         return 0;
     }
@@ -755,23 +776,91 @@ extern "C"
         }
         else
         {
-            data->x          = static_cast<float>(position[static_cast<unsigned int>(handle)].GetX());
-            data->y          = static_cast<float>(position[static_cast<unsigned int>(handle)].GetY());
-            data->z          = static_cast<float>(position[static_cast<unsigned int>(handle)].GetZ());
-            data->h          = static_cast<float>(position[static_cast<unsigned int>(handle)].GetH());
-            data->p          = static_cast<float>(position[static_cast<unsigned int>(handle)].GetP());
-            data->r          = static_cast<float>(position[static_cast<unsigned int>(handle)].GetR());
-            data->hRelative  = static_cast<float>(position[static_cast<unsigned int>(handle)].GetHRelative());
-            data->roadId     = position[static_cast<unsigned int>(handle)].GetTrackId();
-            data->junctionId = position[static_cast<unsigned int>(handle)].GetJunctionId();
-            data->laneId     = position[static_cast<unsigned int>(handle)].GetLaneId();
-            data->laneOffset = static_cast<float>(position[static_cast<unsigned int>(handle)].GetOffset());
-            data->s          = static_cast<float>(position[static_cast<unsigned int>(handle)].GetS());
+            GetPositionData(position[static_cast<unsigned int>(handle)], data);
         }
 
         return 0;
     }
 
+    RM_DLL_API void RM_SetBatchThreads(int n_threads)
+    {
+        delete batch_pool;
+        batch_pool = nullptr;
+
+        unsigned int n = n_threads > 0 ? static_cast<unsigned int>(n_threads) : MAX(1U, std::thread::hardware_concurrency());
+        if (n > 1)
+        {
+            batch_pool = new SE_ThreadPool(n);
+        }
+    }
+
+    RM_DLL_API int RM_LanePosToWorldBatch(const RM_LanePosition* lane_pos, int n, RM_PositionData* data, int* status)
+    {
+        if (odrManager == nullptr || lane_pos == nullptr || data == nullptr || n < 0)
+        {
+            return -1;
+        }
+
+        std::atomic<int> n_failed{0};
+
+        ProcessPositionBatch(
+            static_cast<size_t>(n),
+            [&](size_t i, Position& pos)
+            {
+                int retval = static_cast<int>(pos.SetLanePos(lane_pos[i].roadId, lane_pos[i].laneId, lane_pos[i].s, lane_pos[i].laneOffset));
+                GetPositionData(pos, &data[i]);
+                if (status != nullptr)
+                {
+                    status[i] = retval;
+                }
+                if (retval < 0)
+                {
+                    n_failed++;
+                }
+            },
+            batch_pool);
+
+        return n_failed;
+    }
+
+    RM_DLL_API int RM_WorldToLanePosBatch(const RM_PositionXYZ* world_pos, int n, RM_PositionData* data, int* status)
+    {
+        if (odrManager == nullptr || world_pos == nullptr || data == nullptr || n < 0)
+        {
+            return -1;
+        }
+
+        std::atomic<int> n_failed{0};
+
+        ProcessPositionBatch(
+            static_cast<size_t>(n),
+            [&](size_t i, Position& pos)
+            {
+                // heading, pitch and roll along road, z on road surface unless specified
+                bool z_set  = !std::isnan(world_pos[i].z);
+                int  retval = pos.SetInertiaPosMode(world_pos[i].x,
+                                                   world_pos[i].y,
+                                                   z_set ? static_cast<double>(world_pos[i].z) : 0.0,
+                                                   0.0,
+                                                   0.0,
+                                                   0.0,
+                                                   (z_set ? Position::PosMode::Z_ABS : Position::PosMode::Z_REL) | Position::PosMode::H_REL |
+                                                       Position::PosMode::P_REL | Position::PosMode::R_REL);
+                GetPositionData(pos, &data[i]);
+                if (status != nullptr)
+                {
+                    status[i] = retval;
+                }
+                if (retval < 0)
+                {
+                    n_failed++;
+                }
+            },
+            batch_pool);
+
+        return n_failed;
+    }
+
     RM_DLL_API int RM_GetLaneInfo(int handle, float lookahead_distance, RM_RoadLaneInfo* data, int lookAheadMode, bool inRoadDrivingDirection)
     {
         if (odrManager == nullptr || handle >= static_cast<int>(position.size()))
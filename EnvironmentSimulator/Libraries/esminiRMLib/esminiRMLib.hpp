@@ -31,6 +31,14 @@ typedef struct
     float z;
 } RM_PositionXYZ;
 
+typedef struct
+{
+    id_t  roadId;
+    int   laneId;
+    float laneOffset;  // offset from lane center
+    float s;           // distance along the road
+} RM_LanePosition;
+
 typedef struct
 {
     float x;
@@ -440,6 +448,35 @@ extern "C"
     */
     RM_DLL_API int RM_GetPositionData(int handle, RM_PositionData* data);
 
+    /**
+    Set number of threads used by batch functions, e.g. RM_LanePosToWorldBatch(). Applies until RM_Close().
+    Result is identical regardless of number of threads.
+    @param n_threads Number of threads, 0 = one per CPU core, 1 = calling thread only (default)
+    */
+    RM_DLL_API void RM_SetBatchThreads(int n_threads);
+
+    /**
+    Convert an array of road coordinates to world coordinates, same as RM_SetLanePosition() and RM_GetPositionData() for each point
+    @param lane_pos Array of road positions
+    @param n Number of positions
+    @param data Array of n structs to fill in the resulting position data
+    @param status Optional array of n return codes, see roadmanager.hpp::Position::enum class ReturnCode. Set 0 to skip.
+    @return Number of positions failed (return code < 0), -1 on error
+    */
+    RM_DLL_API int RM_LanePosToWorldBatch(const RM_LanePosition* lane_pos, int n, RM_PositionData* data, int* status);
+
+    /**
+    Convert an array of world coordinates to road coordinates. Each point is looked up starting from the road of the previous
+    one, so for best performance and continuity through junctions consecutive points should be close to each other, e.g.
+    points of a trajectory. Resulting heading, pitch and roll are aligned to the road.
+    @param world_pos Array of world positions. Set z to std::nanf("") for the road surface, else z selects among overlapping roads.
+    @param n Number of positions
+    @param data Array of n structs to fill in the resulting position data
+    @param status Optional array of n return codes, see roadmanager.hpp::Position::enum class ReturnCode. Set 0 to skip.
+    @return Number of positions failed (return code < 0), -1 on error
+    */
+    RM_DLL_API int RM_WorldToLanePosBatch(const RM_PositionXYZ* world_pos, int n, RM_PositionData* data, int* status);
+
     /**
     Retrieve current speed limit (at current road, s-value and lane) based on ODR type elements or nr of lanes
     @param handle Handle to the position object
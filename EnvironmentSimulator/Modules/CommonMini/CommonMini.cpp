@@ -34,6 +34,15 @@
 #include <Ws2tcpip.h>
 #endif
 
+// Memory mapped file includes
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#endif
+
 #include "CommonMini.hpp"
 
 // #define DEBUG_TRACE
@@ -1387,12 +1396,23 @@ void Logger::LogVersion()
         callback_(message);
 }
 
+static thread_local SE_Env* threadEnv_ = nullptr;
+
 SE_Env& SE_Env::Inst()
 {
+    if (threadEnv_ != nullptr)
+    {
+        return *threadEnv_;
+    }
     static SE_Env instance_;
     return instance_;
 }
 
+void SE_Env::SetThreadInst(SE_Env* env)
+{
+    threadEnv_ = env;
+}
+
 void SE_Env::SetDatFilePath(std::string datFilePath)
 {
     datFilePath_ = datFilePath;
@@ -1724,6 +1744,402 @@ void SE_Mutex::Unlock()
 #endif
 }
 
+SE_ThreadPool::SE_ThreadPool(unsigned int n_threads)
+{
+    for (unsigned int i = 0; i < n_threads; i++)
+    {
+        threads_.emplace_back(&SE_ThreadPool::Worker, this);
+    }
+}
+
+SE_ThreadPool::~SE_ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        quit_ = true;
+    }
+    start_cv_.notify_all();
+
+    for (auto& thread : threads_)
+    {
+        thread.join();
+    }
+}
+
+void SE_ThreadPool::Run(size_t n, const std::function<void(size_t)>& func)
+{
+    if (n == 0 || threads_.empty())
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        func_ = &func;
+        n_    = n;
+        next_ = 0;
+        busy_ = static_cast<unsigned int>(threads_.size());
+        generation_++;
+    }
+    start_cv_.notify_all();
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_cv_.wait(lock, [this]() { return busy_ == 0; });
+    func_ = nullptr;
+
+    if (error_)
+    {
+        // pass on to the caller, as if func had been called from this thread
+        std::exception_ptr error = error_;
+        error_                   = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+
+void SE_ThreadPool::Worker()
+{
+    unsigned long long generation = 0;
+
+    while (true)
+    {
+        const std::function<void(size_t)>* func = nullptr;
+        size_t                             n    = 0;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            start_cv_.wait(lock, [&]() { return quit_ || generation_ != generation; });
+            if (quit_)
+            {
+                return;
+            }
+            generation = generation_;
+            func       = func_;
+            n          = n_;
+        }
+
+        for (size_t i = next_++; i < n; i = next_++)
+        {
+            try
+            {
+                (*func)(i);
+            }
+            catch (...)
+            {
+                // keep first exception for Run to rethrow, and skip remaining indices like a serial loop would
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (!error_)
+                {
+                    error_ = std::current_exception();
+                }
+                next_ = n;
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (--busy_ == 0)
+            {
+                done_cv_.notify_one();
+            }
+        }
+    }
+}
+
+SE_MappedFile::~SE_MappedFile()
+{
+    Close();
+}
+
+int SE_MappedFile::Open(const std::string& filename)
+{
+    Close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return -1;
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+    {
+        CloseHandle(file);
+        return -1;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr)
+    {
+        CloseHandle(file);
+        return -1;
+    }
+
+    void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (data == nullptr)
+    {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return -1;
+    }
+
+    file_    = file;
+    mapping_ = mapping;
+    data_    = static_cast<const unsigned char*>(data);
+    size_    = static_cast<size_t>(size.QuadPart);
+#else
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        return -1;
+    }
+
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0 || file_stat.st_size <= 0)
+    {
+        close(fd);
+        return -1;
+    }
+
+    void* data = mmap(nullptr, static_cast<size_t>(file_stat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);  // mapping stays valid
+    if (data == MAP_FAILED)
+    {
+        return -1;
+    }
+
+    data_ = static_cast<const unsigned char*>(data);
+    size_ = static_cast<size_t>(file_stat.st_size);
+#endif
+
+    return 0;
+}
+
+void SE_MappedFile::Close()
+{
+    if (data_ == nullptr)
+    {
+        return;
+    }
+
+#ifdef _WIN32
+    UnmapViewOfFile(data_);
+    CloseHandle(mapping_);
+    CloseHandle(file_);
+    file_    = nullptr;
+    mapping_ = nullptr;
+#else
+    munmap(const_cast<unsigned char*>(data_), size_);
+#endif
+    data_ = nullptr;
+    size_ = 0;
+}
+
+SE_Profiler::SE_Profiler() : epoch_(std::chrono::steady_clock::now())
+{
+}
+
+SE_Profiler& SE_Profiler::Inst()
+{
+    static SE_Profiler instance;
+    return instance;
+}
+
+void SE_Profiler::Enable(bool enable, bool trace)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    trace_   = enable && trace;
+    enabled_ = enable;
+}
+
+void SE_Profiler::Reset()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& phase : phases_)
+    {
+        std::string name = phase.name;
+        phase            = Phase();
+        phase.name       = name;
+    }
+    events_.clear();
+    threads_.clear();
+    epoch_ = std::chrono::steady_clock::now();
+}
+
+int SE_Profiler::GetPhaseId(const std::string& name)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto it = phase_ids_.find(name);
+    if (it != phase_ids_.end())
+    {
+        return it->second;
+    }
+
+    int id           = static_cast<int>(phases_.size());
+    phase_ids_[name] = id;
+    phases_.emplace_back();
+    phases_.back().name = name;
+
+    return id;
+}
+
+void SE_Profiler::Add(int id, std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end)
+{
+    double us = 1E-3 * static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+
+    unsigned int bucket = 0;
+    for (unsigned long long i = static_cast<unsigned long long>(us); i > 0 && bucket < SE_PROFILE_NUM_BUCKETS - 1; i >>= 1)
+    {
+        bucket++;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (id < 0 || id >= static_cast<int>(phases_.size()))
+    {
+        return;
+    }
+
+    Phase& phase = phases_[static_cast<unsigned int>(id)];
+    phase.min_us = phase.count == 0 ? us : MIN(phase.min_us, us);
+    phase.max_us = phase.count == 0 ? us : MAX(phase.max_us, us);
+    phase.total_us += us;
+    phase.count++;
+    phase.histogram[bucket]++;
+
+    if (trace_ && events_.size() < SE_PROFILE_MAX_TRACE_EVENTS && start >= epoch_)
+    {
+        auto thread = threads_.emplace(std::this_thread::get_id(), static_cast<unsigned int>(threads_.size())).first;
+        events_.push_back({id,
+                           thread->second,
+                           static_cast<unsigned long long>(std::chrono::duration_cast<std::chrono::nanoseconds>(start - epoch_).count()),
+                           static_cast<unsigned long long>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count())});
+    }
+}
+
+std::vector<SE_Profiler::Phase> SE_Profiler::GetPhases()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return phases_;
+}
+
+void SE_Profiler::LogSummary()
+{
+    std::vector<Phase> phases = GetPhases();
+
+    LOG_INFO("{:<32} {:>8} {:>11} {:>10} {:>10} {:>10}", "Phase", "Count", "Total (ms)", "Mean (us)", "Min (us)", "Max (us)");
+    for (auto& phase : phases)
+    {
+        if (phase.count > 0)
+        {
+            LOG_INFO("{:<32} {:>8} {:>11.2f} {:>10.1f} {:>10.1f} {:>10.1f}",
+                     phase.name,
+                     phase.count,
+                     1E-3 * phase.total_us,
+                     phase.total_us / static_cast<double>(phase.count),
+                     phase.min_us,
+                     phase.max_us);
+        }
+    }
+}
+
+int SE_Profiler::SaveTrace(const std::string& filename)
+{
+    std::ofstream file(filename);
+    if (!file.good())
+    {
+        LOG_ERROR("Failed to create profile trace file {}", filename);
+        return -1;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    file << "{\"traceEvents\":[";
+    for (size_t i = 0; i < events_.size(); i++)
+    {
+        const TraceEvent& e = events_[i];
+        std::string       name;
+        for (char c : phases_[static_cast<unsigned int>(e.id)].name)
+        {
+            if (c == '"' || c == '\\')
+            {
+                name += '\\';
+            }
+            name += c;
+        }
+        file << (i > 0 ? ",\n" : "\n")
+             << fmt::format("{{\"name\":\"{}\",\"ph\":\"X\",\"ts\":{:.3f},\"dur\":{:.3f},\"pid\":1,\"tid\":{}}}",
+                            name,
+                            1E-3 * static_cast<double>(e.start_ns),
+                            1E-3 * static_cast<double>(e.duration_ns),
+                            e.thread);
+    }
+    file << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+    if (events_.size() >= SE_PROFILE_MAX_TRACE_EVENTS)
+    {
+        LOG_WARN("Profile trace limited to first {} events", SE_PROFILE_MAX_TRACE_EVENTS);
+    }
+    LOG_INFO("Profile trace with {} events saved in {}", events_.size(), filename);
+
+    return 0;
+}
+
+void SE_StateBuffer::Begin(Mode mode)
+{
+    mode_   = mode;
+    failed_ = false;
+    error_.clear();
+    pos_ = 0;
+
+    if (mode == Mode::SAVE)
+    {
+        items_.clear();
+        bytes_.clear();
+    }
+}
+
+bool SE_StateBuffer::End()
+{
+    if (!failed_ && mode_ != Mode::SAVE && pos_ != items_.size())
+    {
+        Fail("State structure changed, " + std::to_string(items_.size() - pos_) + " stored values not read");
+    }
+
+    return !failed_;
+}
+
+void SE_StateBuffer::Fail(const std::string& reason)
+{
+    if (!failed_)
+    {
+        failed_ = true;
+        error_  = reason;
+    }
+}
+
+const SE_StateBuffer::Item* SE_StateBuffer::Next(const std::type_info& type)
+{
+    if (failed_)
+    {
+        return nullptr;
+    }
+
+    if (pos_ >= items_.size())
+    {
+        Fail("State structure changed, more values than stored");
+        return nullptr;
+    }
+
+    if (*items_[pos_].type != type)
+    {
+        Fail("State structure changed, value " + std::to_string(pos_) + " type mismatch");
+        return nullptr;
+    }
+
+    return &items_[pos_++];
+}
+
 void SE_Option::Usage()
 {
     if (!default_value_.empty())
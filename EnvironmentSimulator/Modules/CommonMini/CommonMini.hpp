@@ -19,8 +19,13 @@
 #define _USE_MATH_DEFINES
 #include <math.h>
 #include <condition_variable>
+#include <chrono>
 #include <cstring>
 #include <map>
+#include <memory>
+#include <exception>
+#include <typeinfo>
+#include <type_traits>
 
 #ifndef _WIN32
 #include <inttypes.h>
@@ -611,6 +616,8 @@ bool IsNumber(const std::string& str, int max_digits = -1);
 #else
 #include <thread>
 #include <mutex>
+#include <atomic>
+#include <functional>
 #endif
 
 class SE_Thread
@@ -711,6 +718,467 @@ private:
     bool flag;
 };
 
+// Fixed set of worker threads running parallel loops. Threads pick the next index from a shared counter when done
+// with the previous one, so that slow items do not hold up the remaining ones.
+class SE_ThreadPool
+{
+public:
+    explicit SE_ThreadPool(unsigned int n_threads);
+    ~SE_ThreadPool();
+
+    /**
+            Call func for every index 0 .. n-1, spread over the worker threads. Returns when all calls are done.
+            Calls are made from worker threads only, never from the calling thread. If a call throws, remaining indices
+            are skipped and the first exception is rethrown here once all threads are done.
+            @param n Number of indices
+            @param func Function to call with index as argument
+    */
+    void Run(size_t n, const std::function<void(size_t)>& func);
+
+    unsigned int GetNumThreads() const
+    {
+        return static_cast<unsigned int>(threads_.size());
+    }
+
+private:
+    void Worker();
+
+    std::vector<std::thread>           threads_;
+    std::mutex                         mutex_;
+    std::condition_variable            start_cv_;
+    std::condition_variable            done_cv_;
+    const std::function<void(size_t)>* func_ = nullptr;
+    size_t                             n_    = 0;
+    std::atomic<size_t>                next_{0};
+    unsigned int                       busy_       = 0;  // number of workers not done with current run
+    unsigned long long                 generation_ = 0;  // incremented for each run
+    bool                               quit_       = false;
+    std::exception_ptr                 error_;
+};
+
+/**
+        Read only memory mapping of a file
+*/
+class SE_MappedFile
+{
+public:
+    SE_MappedFile()
+    {
+    }
+    ~SE_MappedFile();
+
+    /**
+            Map the complete file into memory
+            @return 0 on success, -1 on failure
+    */
+    int  Open(const std::string& filename);
+    void Close();
+
+    const unsigned char* GetData() const
+    {
+        return data_;
+    }
+    size_t GetSize() const
+    {
+        return size_;
+    }
+
+private:
+    const unsigned char* data_ = nullptr;
+    size_t               size_ = 0;
+#ifdef _WIN32
+    void* file_    = nullptr;
+    void* mapping_ = nullptr;
+#endif
+};
+
+// Repeated in esminiLib.hpp to keep the API header self-contained, where a different value is caught at compile time
+#define SE_PROFILE_NUM_BUCKETS      20  // bucket 0: < 1 us, bucket i: 2^(i-1) - 2^i us, last bucket: any longer
+#define SE_PROFILE_MAX_TRACE_EVENTS 1000000
+
+// Time spent per named phase of the simulation, e.g. storyboard or controllers. One instance for the whole process,
+// measuring from any thread. Disabled by default, then a measurement costs one check of the enabled flag.
+class SE_Profiler
+{
+public:
+    struct Phase
+    {
+        std::string        name;
+        unsigned long long count    = 0;
+        double             total_us = 0.0;
+        double             min_us   = 0.0;
+        double             max_us   = 0.0;
+
+        unsigned int histogram[SE_PROFILE_NUM_BUCKETS] = {};
+    };
+
+    static SE_Profiler& Inst();
+
+    /**
+            Enable or disable measurements. Collected data is kept until Reset.
+            @param enable Measure or not
+            @param trace Also register each measurement as an event, for SaveTrace
+    */
+    void Enable(bool enable, bool trace = false);
+    bool IsEnabled() const
+    {
+        return enabled_;
+    }
+
+    // Clear collected data, but keep phase ids
+    void Reset();
+
+    /**
+            Get id of named phase, register it on first call
+    */
+    int GetPhaseId(const std::string& name);
+
+    /**
+            Register a measurement
+            @param id Phase id
+            @param start Start time of measurement
+            @param end End time of measurement
+    */
+    void Add(int id, std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end);
+
+    /**
+            Copy of collected data of all phases, in order of registration
+    */
+    std::vector<Phase> GetPhases();
+
+    /**
+            Log a table of all phases measured at least once
+    */
+    void LogSummary();
+
+    /**
+            Save events in Chrome trace JSON format, e.g. for ui.perfetto.dev or chrome://tracing
+            @return 0 on success, -1 on failure
+    */
+    int SaveTrace(const std::string& filename);
+
+private:
+    struct TraceEvent
+    {
+        int                id;
+        unsigned int       thread;
+        unsigned long long start_ns;  // relative profiler epoch
+        unsigned long long duration_ns;
+    };
+
+    SE_Profiler();
+
+    std::atomic<bool>                       enabled_{false};
+    bool                                    trace_ = false;
+    std::mutex                              mutex_;
+    std::vector<Phase>                      phases_;
+    std::map<std::string, int>              phase_ids_;
+    std::vector<TraceEvent>                 events_;
+    std::map<std::thread::id, unsigned int> threads_;  // small ids for trace
+    std::chrono::steady_clock::time_point   epoch_;
+};
+
+// Measure time from construction until End or destruction. Pass phase id -1 to skip measurement.
+class SE_ProfileScope
+{
+public:
+    explicit SE_ProfileScope(int id) : id_(id)
+    {
+        if (id_ >= 0)
+        {
+            start_ = std::chrono::steady_clock::now();
+        }
+    }
+    // Measure named phase if profiling is enabled
+    explicit SE_ProfileScope(const char* name) : SE_ProfileScope(SE_Profiler::Inst().IsEnabled() ? SE_Profiler::Inst().GetPhaseId(name) : -1)
+    {
+    }
+    ~SE_ProfileScope()
+    {
+        End();
+    }
+    void End()
+    {
+        if (id_ >= 0)
+        {
+            SE_Profiler::Inst().Add(id_, start_, std::chrono::steady_clock::now());
+            id_ = -1;
+        }
+    }
+
+private:
+    int                                   id_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+// In-memory snapshot of a sequence of values, e.g. the complete state of a simulation. Each class implements one function
+// calling Sync() for each state member, used for all modes. Values are read back in the same order and type as saved.
+// Restore should be preceded by a VERIFY pass, checking the sequence of types and expected values without modifying anything.
+class SE_StateBuffer
+{
+public:
+    enum class Mode
+    {
+        SAVE,     // store values
+        VERIFY,   // check stored types and expected values against current structure
+        RESTORE,  // assign stored values
+    };
+
+    /**
+            Start a pass. SAVE clears any stored values, VERIFY and RESTORE read from the first value.
+    */
+    void Begin(Mode mode);
+
+    /**
+            Finish a pass
+            @return true if no error was found and, in VERIFY and RESTORE mode, all stored values were read
+    */
+    bool End();
+
+    Mode GetMode() const
+    {
+        return mode_;
+    }
+    bool IsSaving() const
+    {
+        return mode_ == Mode::SAVE;
+    }
+    bool IsRestoring() const
+    {
+        return mode_ == Mode::RESTORE;
+    }
+
+    // false once any error has been found in current pass, after which no values are read or assigned
+    bool IsOK() const
+    {
+        return !failed_;
+    }
+
+    // Register error, e.g. a structural change making the stored values incompatible with the current state
+    void Fail(const std::string& reason);
+
+    const std::string& GetError() const
+    {
+        return error_;
+    }
+
+    // Number of stored values
+    size_t GetNumberOfValues() const
+    {
+        return items_.size();
+    }
+
+    /**
+            Store value in SAVE mode, assign stored value in RESTORE mode, only check type in VERIFY mode
+    */
+    template <class T>
+    void Sync(T& value)
+    {
+        if (mode_ == Mode::SAVE)
+        {
+            Save(value);
+        }
+        else if (mode_ == Mode::RESTORE)
+        {
+            Load(value);
+        }
+        else
+        {
+            Next(typeid(T));
+        }
+    }
+
+    template <class T, class... Ts>
+    void Sync(T& value, Ts&... values)
+    {
+        Sync(value);
+        Sync(values...);
+    }
+
+    /**
+            Store value in SAVE mode, in other modes check that the current value equals the stored one
+    */
+    template <class T>
+    void Expect(const T& value)
+    {
+        if (mode_ == Mode::SAVE)
+        {
+            Save(value);
+        }
+        else
+        {
+            T stored;
+            if (Load(stored) && !(stored == value))
+            {
+                Fail("State structure changed, value " + std::to_string(pos_ - 1) + " differs");
+            }
+        }
+    }
+
+    /**
+            Store value in SAVE mode, in other modes assign the stored value. For values deciding what follows, e.g.
+            whether an optional member is present, so that also the VERIFY pass follows the stored structure.
+    */
+    template <class T>
+    void SyncLayout(T& value)
+    {
+        if (mode_ == Mode::SAVE)
+        {
+            Save(value);
+        }
+        else
+        {
+            Load(value);
+        }
+    }
+
+    /**
+            Store the id of referred object, see SE_StateRegistered. In other modes look up the stored id and, in RESTORE
+            mode, assign the object. Fails if the object has been deleted since saved.
+    */
+    template <class T>
+    void SyncRef(T*& ref)
+    {
+        unsigned long long id = ref != nullptr ? ref->GetStateId() : 0;
+        SyncLayout(id);
+        if (mode_ == Mode::SAVE || failed_)
+        {
+            return;
+        }
+
+        T* object = T::FindByStateId(id);
+        if (id != 0 && object == nullptr)
+        {
+            Fail("Object referred to by saved state has been deleted");
+        }
+        else if (mode_ == Mode::RESTORE)
+        {
+            ref = object;
+        }
+    }
+
+    /**
+            Store a copy of the value, regardless of mode
+    */
+    template <class T>
+    void Save(const T& value)
+    {
+        if constexpr (std::is_trivially_copyable<T>::value)
+        {
+            items_.push_back({&typeid(T), bytes_.size(), nullptr});
+            bytes_.resize(bytes_.size() + sizeof(T));
+            memcpy(&bytes_[items_.back().offset], &value, sizeof(T));
+        }
+        else
+        {
+            items_.push_back({&typeid(T), 0, std::make_shared<T>(value)});
+        }
+    }
+
+    /**
+            Read next stored value, regardless of mode
+            @param value Assigned the stored value
+            @return true if read, false if the type of next value does not match or an error has already been found
+    */
+    template <class T>
+    bool Load(T& value)
+    {
+        const Item* item = Next(typeid(T));
+        if (item == nullptr)
+        {
+            return false;
+        }
+
+        if constexpr (std::is_trivially_copyable<T>::value)
+        {
+            memcpy(static_cast<void*>(&value), &bytes_[item->offset], sizeof(T));
+        }
+        else
+        {
+            value = *static_cast<const T*>(item->value.get());
+        }
+        return true;
+    }
+
+private:
+    struct Item
+    {
+        const std::type_info* type;
+        size_t                offset;  // in bytes_, for trivially copyable values
+        std::shared_ptr<void> value;   // copy of other values
+    };
+
+    const Item* Next(const std::type_info& type);
+
+    Mode                       mode_   = Mode::SAVE;
+    bool                       failed_ = false;
+    std::string                error_;
+    size_t                     pos_ = 0;
+    std::vector<Item>          items_;
+    std::vector<unsigned char> bytes_;
+};
+
+// Base class giving each instance of T a unique id, for saved states to refer to objects that might be deleted or
+// replaced before restore. Copies get their own id. FindByStateId() returns nullptr for ids of deleted instances.
+template <class T>
+class SE_StateRegistered
+{
+public:
+    SE_StateRegistered()
+    {
+        Register();
+    }
+    SE_StateRegistered(const SE_StateRegistered&)
+    {
+        Register();
+    }
+    SE_StateRegistered& operator=(const SE_StateRegistered&)
+    {
+        return *this;  // keep own id
+    }
+    ~SE_StateRegistered()
+    {
+        std::lock_guard<std::mutex> lock(Mutex());
+        Registry().erase(state_id_);
+    }
+
+    // Unique id of this instance, never 0
+    unsigned long long GetStateId() const
+    {
+        return state_id_;
+    }
+
+    // Instance with given id, nullptr if 0 or deleted
+    static T* FindByStateId(unsigned long long id)
+    {
+        std::lock_guard<std::mutex> lock(Mutex());
+        auto                        it = Registry().find(id);
+        return it == Registry().end() ? nullptr : static_cast<T*>(it->second);
+    }
+
+private:
+    // never deleted, since instances may be destroyed after static objects at exit
+    static std::mutex& Mutex()
+    {
+        static std::mutex* mutex = new std::mutex;
+        return *mutex;
+    }
+    static std::map<unsigned long long, SE_StateRegistered*>& Registry()
+    {
+        static std::map<unsigned long long, SE_StateRegistered*>* registry = new std::map<unsigned long long, SE_StateRegistered*>;
+        return *registry;
+    }
+    void Register()
+    {
+        static unsigned long long   next_id = 0;
+        std::lock_guard<std::mutex> lock(Mutex());
+        state_id_             = ++next_id;
+        Registry()[state_id_] = this;
+    }
+
+    unsigned long long state_id_ = 0;
+};
+
 std::vector<std::string> SplitString(const std::string& str, char delimiter);
 std::string              DirNameOf(const std::string& fname);
 std::string              FileNameOf(const std::string& fname);
@@ -1188,6 +1656,13 @@ public:
 
     static SE_Env& Inst();
 
+    /**
+            Let Inst() return given environment for the calling thread instead of the process wide one,
+            e.g. to run several scenarios in parallel threads. Set nullptr to restore.
+            @param env Environment to use, owned by caller
+    */
+    static void SetThreadInst(SE_Env* env);
+
     void SetOSIMaxLongitudinalDistance(double maxLongitudinalDistance)
     {
         osiMaxLongitudinalDistance_ = maxLongitudinalDistance;
@@ -1204,6 +1679,21 @@ public:
     {
         return osiMaxLateralDeviation_;
     }
+
+    /**
+            Specify directory for cached OpenDRIVE OSI points. Points generated when loading a road network are stored
+            there and reused whenever the same road network is loaded with same OSI tolerances.
+            Set "" to disable (default)
+            @param dir Directory path, must exist
+    */
+    void SetOSIPointsCacheDir(std::string dir)
+    {
+        osiPointsCacheDir_ = dir;
+    }
+    std::string GetOSIPointsCacheDir()
+    {
+        return osiPointsCacheDir_;
+    }
     void SetCollisionDetection(bool enable)
     {
         collisionDetection_ = enable;
@@ -1329,6 +1819,16 @@ public:
         return opt;
     };
 
+    // Scenario time to include in log messages, nullptr if not available
+    void SetLogTime(double* time)
+    {
+        logTime_ = time;
+    }
+    double* GetLogTime()
+    {
+        return logTime_;
+    }
+
 private:
     std::vector<std::string>   paths_;
     double                     osiMaxLongitudinalDistance_;
@@ -1337,6 +1837,7 @@ private:
     std::string                datFilePath_;
     std::string                osiFilePath_;
     bool                       osiFileEnabled_;
+    std::string                osiPointsCacheDir_;
     SE_SystemTime              systemTime_;
     SE_Rand                    rand_;
     bool                       collisionDetection_;
@@ -1345,6 +1846,7 @@ private:
     GhostMode                  ghost_mode_;
     double                     ghost_headstart_;
     SE_Options                 opt;
+    double*                    logTime_ = nullptr;
 };
 
 /**
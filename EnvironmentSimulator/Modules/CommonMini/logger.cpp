@@ -175,6 +175,8 @@ namespace esmini::common
 
     void TxtLogger::SetLogFilePath(const std::string& path)
     {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+
         std::string filePath = ValidateAndCreateFilePath(path, LOG_FILENAME, "txt");
         if (path.empty() || currentLogFileName_ == filePath)
         {
@@ -216,6 +218,8 @@ namespace esmini::common
 
     void TxtLogger::Stop()
     {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+
         StopFileLogging();
         StopConsoleLogging();
         logOnlyModules_.clear();
@@ -224,6 +228,8 @@ namespace esmini::common
 
     void TxtLogger::StopFileLogging()
     {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+
         if (fileLogger)
         {
             spdlog::drop("file");
@@ -235,6 +241,8 @@ namespace esmini::common
 
     void TxtLogger::StopConsoleLogging()
     {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+
         if (consoleLogger)
         {
             spdlog::drop("console");
@@ -281,9 +289,10 @@ namespace esmini::common
     std::string TxtLogger::AddTimeAndMetaData(char const* function, char const* file, long line, const std::string& level, const std::string& log)
     {
         std::string strTime;
-        if (time_ != nullptr)
+        double*     time = SE_Env::Inst().GetLogTime();
+        if (time != nullptr)
         {
-            strTime = fmt::format("[{:.3f}]", *time_);
+            strTime = fmt::format("[{:.3f}]", *time);
         }
         else
         {
@@ -304,7 +313,7 @@ namespace esmini::common
 
     void TxtLogger::SetLoggerTime(double* ptr)
     {
-        time_ = ptr;
+        SE_Env::Inst().SetLogTime(ptr);
     }
 
     void TxtLogger::LogVersion()
@@ -315,6 +324,8 @@ namespace esmini::common
 
     void TxtLogger::LogTimeOnly()
     {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+
         if (ShouldLogToConsole())
         {
             consoleLogger->set_pattern("[%Y-%m-%d %H:%M:%S]");
@@ -331,6 +342,8 @@ namespace esmini::common
 
     bool TxtLogger::ShouldLogToConsole()
     {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+
         bool shouldLog = !SE_Env::Inst().GetOptions().IsOptionArgumentSet("disable_stdout");
         if (shouldLog && !consoleLogger)
         {
@@ -344,6 +357,8 @@ namespace esmini::common
 
     bool TxtLogger::ShouldLogToFile()
     {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+
         bool fileLoggerDisabled = SE_Env::Inst().GetOptions().GetOptionSet("disable_log");
 
         if (fileLogger)
@@ -17,6 +17,7 @@
 #include <unordered_set>
 #include <string>
 #include <iostream>
+#include <mutex>
 
 // Converts enum to its underlying integer type and formats it
 template <typename T>
@@ -53,6 +54,7 @@ namespace esmini::common
         void LogTimeOnly();
 
         // sets logger time which will be used with logged messages, it is normally the scenario time
+        // the time is stored in the environment (SE_Env), hence separate per scenario instance
         void SetLoggerTime(double* ptr);
 
         // stops file logging
@@ -100,6 +102,12 @@ namespace esmini::common
         // creates and validates log file path
         std::string CreateLogFilePath();
 
+        // serializes logging and (re)creation of the loggers, e.g. between scenarios running in parallel threads
+        std::recursive_mutex& GetMutex()
+        {
+            return mutex_;
+        }
+
         // private interface
     private:
         // Private constructor for use in singleton pattern
@@ -121,8 +129,8 @@ namespace esmini::common
         std::string currentLogFileName_ = "";
         // flag to enable/disable metadata in log
         bool metaDataEnabled_ = false;
-        // time of the scenario
-        double* time_ = nullptr;
+        // see GetMutex()
+        std::recursive_mutex mutex_;
     };  // class TxtLogger
 
     extern std::shared_ptr<spdlog::logger> consoleLogger;
@@ -135,6 +143,7 @@ using TxtLogger = esmini::common::TxtLogger;
 template <class... ARGS>
 void __LOG_DEBUG__(char const* function, char const* file, long line, const std::string& log, ARGS... args)
 {
+    std::lock_guard<std::recursive_mutex> lock(TxtLogger::Inst().GetMutex());
     if (!TxtLogger::Inst().ShouldLogModule(file))
     {
         return;
@@ -158,6 +167,7 @@ void __LOG_DEBUG__(char const* function, char const* file, long line, const std:
 template <class... ARGS>
 void __LOG_INFO__(char const* function, char const* file, long line, const std::string& log, ARGS... args)
 {
+    std::lock_guard<std::recursive_mutex> lock(TxtLogger::Inst().GetMutex());
     if (!TxtLogger::Inst().ShouldLogModule(file))
     {
         return;
@@ -181,6 +191,7 @@ void __LOG_INFO__(char const* function, char const* file, long line, const std::
 template <class... ARGS>
 void __LOG_WARN__(char const* function, char const* file, long line, const std::string& log, ARGS... args)
 {
+    std::lock_guard<std::recursive_mutex> lock(TxtLogger::Inst().GetMutex());
     if (!TxtLogger::Inst().ShouldLogModule(file))
     {
         return;
@@ -204,6 +215,7 @@ void __LOG_WARN__(char const* function, char const* file, long line, const std::
 template <class... ARGS>
 void __LOG_ERROR__(char const* function, char const* file, long line, const std::string& log, ARGS... args)
 {
+    std::lock_guard<std::recursive_mutex> lock(TxtLogger::Inst().GetMutex());
     if (!TxtLogger::Inst().ShouldLogModule(file))
     {
         return;
@@ -227,7 +239,8 @@ void __LOG_ERROR__(char const* function, char const* file, long line, const std:
 template <class... ARGS>
 void __LOG_ERROR__AND__QUIT__(char const* function, char const* file, long line, const std::string& log, ARGS... args)
 {
-    std::string logMsg;
+    std::unique_lock<std::recursive_mutex> lock(TxtLogger::Inst().GetMutex());
+    std::string                            logMsg;
     if (TxtLogger::Inst().ShouldLogToConsole())
     {
         logMsg = fmt::format(TxtLogger::Inst().AddTimeAndMetaData(function, file, line, "error", log), args...);
@@ -241,6 +254,7 @@ void __LOG_ERROR__AND__QUIT__(char const* function, char const* file, long line,
         }
         esmini::common::fileLogger->error(logMsg);
     }
+    lock.unlock();
     throw std::runtime_error(logMsg);
 }
 
@@ -171,6 +171,11 @@ void Controller::ReportKeyEvent(int key, bool down)
     LOG_DEBUG("Key {} {}", key, down ? "down" : "up");
 }
 
+void Controller::SyncState(SE_StateBuffer& buf)
+{
+    buf.Sync(active_domains_, mode_, object_);
+}
+
 std::string Controller::Mode2Str(ControlOperationMode mode)
 {
     if (mode == ControlOperationMode::MODE_OVERRIDE)
@@ -217,6 +222,15 @@ bool Controller::IsActive()
     return GetActiveDomains() != static_cast<unsigned int>(ControlDomains::DOMAIN_NONE);
 }
 
+int Controller::GetProfilePhaseId()
+{
+    if (profile_phase_id_ < 0)
+    {
+        profile_phase_id_ = SE_Profiler::Inst().GetPhaseId(std::string("controller ") + GetTypeName());
+    }
+    return profile_phase_id_;
+}
+
 void scenarioengine::Controller::AlignToRoadHeading()
 {
     if (object_ != nullptr)
@@ -108,6 +108,10 @@ namespace scenarioengine
         virtual void InitPostPlayer(){};
 
         virtual void ReportKeyEvent(int key, bool down);
+
+        // Save or restore runtime state, see SE_StateBuffer. Derived controllers add their own state.
+        virtual void SyncState(SE_StateBuffer& buf);
+
         virtual void SetScenarioEngine(ScenarioEngine* scenario_engine)
         {
             scenario_engine_ = scenario_engine;
@@ -165,6 +169,11 @@ namespace scenarioengine
             return object_;
         }
 
+        /**
+        Get profiler phase id of the controller type, e.g. "controller ACCController". Registered on first call, then cached.
+        */
+        int GetProfilePhaseId();
+
     protected:
         unsigned int         operating_domains_;  // bitmask representing domains controller is operating on
         unsigned int         active_domains_;     // bitmask representing domains controller is currently active on
@@ -178,6 +187,7 @@ namespace scenarioengine
         ScenarioPlayer*      player_;
         bool                 align_to_road_heading_on_deactivation_ = false;
         bool                 align_to_road_heading_on_activation_   = false;
+        int                  profile_phase_id_                      = -1;
 
         void AlignToRoadHeading();
     };
@@ -85,7 +85,7 @@ void ControllerACC::Step(double timeStep)
 {
     double minGapLength = LARGE_NUMBER;
     // double minSpeedDiff = 0.0; // TODO: Commented out because it is not used
-    int          minObjIndex        = -1;
+    Object*      minObj             = nullptr;
     const double minDist            = 3.0;  // minimum distance to keep to lead vehicle
     const double accelerationFactor = 0.7;
 
@@ -105,9 +105,16 @@ void ControllerACC::Step(double timeStep)
     // Lookahead distance is at least 50m or twice the distance required to stop
     // https://www.symbolab.com/solver/equation-calculator/s%5Cleft(t%5Cright)%3D2%5Cleft(m%2Bvt%2B%5Cfrac%7B1%7D%7B2%7Dat%5E%7B2%7D%5Cright)%2C%20t%3D%5Cfrac%7B-v%7D%7Ba%7D
     double lookaheadDist = MAX(50.0, 2 * minDist - pow(currentSpeed_, 2) / -object_->GetMaxDeceleration());  // (m)
-    for (size_t i = 0; i < entities_->object_.size(); i++)
+
+    // Only consider objects within lookahead distance along the road or close enough for the free space check below. Free space
+    // distance is limited by pivot length and speed difference, reference points additionally by the bounding box extents.
+    double maxExtent = entities_->lane_occupancy_.GetMaxExtent();
+    double closeDist = 1.5 + 6.0 * maxExtent + 0.5 * MAX(0.0, currentSpeed_ - entities_->lane_occupancy_.GetMinSpeed());
+    entities_->lane_occupancy_.GetObjectsNearby(object_->pos_, lookaheadDist, closeDist, candidates_);
+
+    for (size_t i = 0; i < candidates_.size(); i++)
     {
-        Object* pivot_obj = entities_->object_[i];
+        Object* pivot_obj = candidates_[i];
         if (pivot_obj == nullptr || pivot_obj == object_)
         {
             continue;
@@ -142,12 +149,12 @@ void ControllerACC::Step(double timeStep)
             {
                 minGapLength = adjustedGapLength;
                 // minSpeedDiff = currentSpeed_ - pivot_obj->GetSpeed();
-                minObjIndex = static_cast<int>(i);  // TODO: size_t to int
+                minObj = pivot_obj;
             }
         }
 
         // Also check for really close entities in front
-        if (static_cast<unsigned int>(minObjIndex) != i)
+        if (minObj != pivot_obj)
         {
             double x_local, y_local;
             object_->FreeSpaceDistance(pivot_obj, &y_local, &x_local);
@@ -159,13 +166,13 @@ void ControllerACC::Step(double timeStep)
             {
                 minGapLength = x_local;
                 // minSpeedDiff = currentSpeed_ - pivot_obj->GetSpeed();
-                minObjIndex = static_cast<int>(i);
+                minObj = pivot_obj;
             }
         }
     }
 
     double acc = 0.0;
-    if (minObjIndex > -1)
+    if (minObj != nullptr)
     {
         if (minGapLength < 1)
         {
@@ -174,12 +181,12 @@ void ControllerACC::Step(double timeStep)
         else
         {
             // Follow distance = minimum distance + timeGap_ seconds
-            double speedForTimeGap = MAX(currentSpeed_, entities_->object_[static_cast<unsigned int>(minObjIndex)]->GetSpeed());
+            double speedForTimeGap = MAX(currentSpeed_, minObj->GetSpeed());
             double followDist      = minDist + timeGap_ * fabs(speedForTimeGap);  // (m)
             double dist            = minGapLength - followDist;
             double distFactor      = MIN(1.0, dist / followDist);
 
-            double dvMin = currentSpeed_ - MIN(setSpeed_, entities_->object_[static_cast<unsigned int>(minObjIndex)]->GetSpeed());
+            double dvMin = currentSpeed_ - MIN(setSpeed_, minObj->GetSpeed());
             double dvSet = currentSpeed_ - setSpeed_;
 
             acc = 2.5 * distFactor - distFactor * dvSet - (1 - distFactor) * dvMin;  // weighted combination of relative distance and speed
@@ -191,9 +198,7 @@ void ControllerACC::Step(double timeStep)
             currentSpeed_ = MIN(MAX(0.0, currentSpeed_), setSpeed_);
         }
 
-        object_->SetSensorPosition(entities_->object_[static_cast<unsigned int>(minObjIndex)]->pos_.GetX(),
-                                   entities_->object_[static_cast<unsigned int>(minObjIndex)]->pos_.GetY(),
-                                   entities_->object_[static_cast<unsigned int>(minObjIndex)]->pos_.GetZ());
+        object_->SetSensorPosition(minObj->pos_.GetX(), minObj->pos_.GetY(), minObj->pos_.GetZ());
     }
     else
     {
@@ -266,4 +271,10 @@ void ControllerACC::ReportKeyEvent(int key, bool down)
 {
     (void)key;
     (void)down;
+}
+
+void ControllerACC::SyncState(SE_StateBuffer& buf)
+{
+    Controller::SyncState(buf);
+    buf.Sync(vehicle_, active_, timeGap_, setSpeed_, lateralDist_, currentSpeed_, setSpeedSet_, candidates_);
 }
\ No newline at end of file
@@ -51,20 +51,22 @@ namespace scenarioengine
                       ControlActivationMode light_activation_mode,
                       ControlActivationMode anim_activation_mode);
         void ReportKeyEvent(int key, bool down);
+        void SyncState(SE_StateBuffer& buf) override;
         void SetSetSpeed(double setSpeed)
         {
             setSpeed_ = setSpeed;
         }
 
     private:
-        vehicle::Vehicle vehicle_;
-        bool             active_;
-        double           timeGap_;  // target headway time
-        double           setSpeed_;
-        double           lateralDist_;
-        double           currentSpeed_;
-        bool             setSpeedSet_;
-        bool             virtual_;
+        vehicle::Vehicle     vehicle_;
+        bool                 active_;
+        double               timeGap_;  // target headway time
+        double               setSpeed_;
+        double               lateralDist_;
+        double               currentSpeed_;
+        bool                 setSpeedSet_;
+        bool                 virtual_;
+        std::vector<Object*> candidates_;  // objects to consider, see LaneOccupancy
     };
 
     Controller* InstantiateControllerACC(void* args);
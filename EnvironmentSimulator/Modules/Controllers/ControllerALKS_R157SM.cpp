@@ -290,6 +290,16 @@ void ControllerALKS_R157SM::ReportKeyEvent(int key, bool down)
     (void)down;
 }
 
+void ControllerALKS_R157SM::SyncState(SE_StateBuffer& buf)
+{
+    Controller::SyncState(buf);
+    buf.Expect(model_ != nullptr ? static_cast<int>(model_->GetModelType()) : -1);
+    if (model_ != nullptr && buf.IsOK())
+    {
+        model_->SyncState(buf);
+    }
+}
+
 int ControllerALKS_R157SM::Model::Detect()
 {
     ObjectInfo candidate_obj_info, tmp_obj_info;
@@ -300,9 +310,12 @@ int ControllerALKS_R157SM::Model::Detect()
         return -1;
     }
 
-    for (size_t i = 0; i < entities_->object_.size(); i++)
+    // Only objects within range along the road are processed, see Process()
+    entities_->lane_occupancy_.GetObjectsAlongRoad(veh_->pos_, GetMaxRange(), candidates_);
+
+    for (size_t i = 0; i < candidates_.size(); i++)
     {
-        tmp_obj_info.obj = entities_->object_[i];
+        tmp_obj_info.obj = candidates_[i];
 
         if (Process(tmp_obj_info) != 0)
         {
@@ -487,6 +500,12 @@ void ControllerALKS_R157SM::Model::ResetReactionTime()
     rt_counter_ = GetReactionTime();
 }
 
+void ControllerALKS_R157SM::Model::SyncState(SE_StateBuffer& buf)
+{
+    buf.Sync(object_in_focus_, cut_in_detected_timestamp_, candidates_, rt_counter_, set_speed_, dt_, acc_, model_mode_, scenario_type_);
+    buf.Sync(cruise_, full_stop_);
+}
+
 ControllerALKS_R157SM::Model::Model(ModelType type, double reaction_time, double max_dec, double max_range)
     : type_(type),
       veh_(nullptr),
@@ -743,6 +762,20 @@ ControllerALKS_R157SM::ReferenceDriver::~ReferenceDriver()
     }
 }
 
+void ControllerALKS_R157SM::ReferenceDriver::SyncState(SE_StateBuffer& buf)
+{
+    Model::SyncState(buf);
+    buf.Sync(c_lane_offset_, phase_, timer_, perception_dist_, perception_t_, aeb_);
+
+    for (LateralDistTrigger* trigger : {lateral_dist_trigger_, static_cast<LateralDistTrigger*>(wandering_trigger_)})
+    {
+        if (trigger != nullptr)
+        {
+            buf.Sync(trigger->threshold_, trigger->active_, trigger->obj_, trigger->t0_);
+        }
+    }
+}
+
 void ControllerALKS_R157SM::ReferenceDriver::UpdateAEB(Vehicle* ego, ObjectInfo* info)
 {
     if (aeb_.available_ && !aeb_.active_ && info->ttc < aeb_.ttc_critical_aeb_ &&
@@ -1466,6 +1499,12 @@ double ControllerALKS_R157SM::FSM::CFS(double dist, double speed_rear, double sp
     }
 }
 
+void ControllerALKS_R157SM::FSM::SyncState(SE_StateBuffer& buf)
+{
+    Model::SyncState(buf);
+    buf.Sync(cfs_, pfs_);
+}
+
 bool ControllerALKS_R157SM::FSM::CheckSafety(ObjectInfo* info)
 {
     if (info->obj == nullptr || info->dist_lat == LARGE_NUMBER)
@@ -209,11 +209,15 @@ namespace scenarioengine
             {
             }
 
-            ModelType  type_;
-            Vehicle*   veh_;
-            Entities*  entities_;
-            ObjectInfo object_in_focus_;
-            double     cut_in_detected_timestamp_;
+            // Save or restore runtime state, see SE_StateBuffer
+            virtual void SyncState(SE_StateBuffer& buf);
+
+            ModelType            type_;
+            Vehicle*             veh_;
+            Entities*            entities_;
+            ObjectInfo           object_in_focus_;
+            double               cut_in_detected_timestamp_;
+            std::vector<Object*> candidates_;  // objects to consider, see LaneOccupancy
 
             // driver parameters
             double rt_;          // reaction time
@@ -464,6 +468,7 @@ namespace scenarioengine
                 SetScenarioType(ScenarioType::None);
             }
             void UpdateAEB(Vehicle* ego, ObjectInfo* info);
+            void SyncState(SE_StateBuffer& buf) override;
 
             double                   c_lane_offset_;
             double                   min_jerk_;
@@ -586,6 +591,7 @@ namespace scenarioengine
                        double margin_dist,
                        double margin_safe_dist);
             double CFS(double dist, double speed_rear, double speed_lead, double rt, double br_min, double br_max, double ar);
+            void   SyncState(SE_StateBuffer& buf) override;
 
             double min_jerk_;
             double br_min_;
@@ -629,6 +635,7 @@ namespace scenarioengine
                       ControlActivationMode light_activation_mode,
                       ControlActivationMode anim_activation_mode);
         void ReportKeyEvent(int key, bool down);
+        void SyncState(SE_StateBuffer& buf) override;
         void SetScenarioEngine(ScenarioEngine* scenario_engine) override;
     };
 
@@ -505,3 +505,10 @@ void ControllerECE_ALKS_REF_DRIVER::ReportKeyEvent(int key, bool down)
     (void)key;
     (void)down;
 }
+
+void ControllerECE_ALKS_REF_DRIVER::SyncState(SE_StateBuffer& buf)
+{
+    Controller::SyncState(buf);
+    buf.Sync(vehicle_, active_, setSpeed_, currentSpeed_, dtFreeCutOut_, cutInDetected_, waitTime_, driverBraking_, aebBraking_);
+    buf.Sync(timeSinceBraking_);
+}
@@ -54,6 +54,7 @@ namespace scenarioengine
                       ControlActivationMode anim_activation_mode);
         void Reset();
         void ReportKeyEvent(int key, bool down);
+        void SyncState(SE_StateBuffer& buf) override;
 
     private:
         vehicle::Vehicle vehicle_;
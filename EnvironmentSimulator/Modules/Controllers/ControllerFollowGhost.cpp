@@ -270,4 +270,11 @@ void ControllerFollowGhost::ReportKeyEvent(int key, bool down)
 {
     (void)key;
     (void)down;
+}
+
+void ControllerFollowGhost::SyncState(SE_StateBuffer& buf)
+{
+    Controller::SyncState(buf);
+    buf.Sync(vehicle_, headstart_time_, follow_mode_, lookahead_speed_, min_lookahead_speed_, lookahead_steering_, min_lookahead_steering_);
+    buf.Sync(steering_speed_inertia_);
 }
\ No newline at end of file
@@ -68,6 +68,7 @@ namespace scenarioengine
                       ControlActivationMode light_activation_mode,
                       ControlActivationMode anim_activation_mode);
         void ReportKeyEvent(int key, bool down);
+        void SyncState(SE_StateBuffer& buf) override;
 
     private:
         vehicle::Vehicle vehicle_;
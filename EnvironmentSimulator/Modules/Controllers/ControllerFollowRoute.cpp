@@ -160,6 +160,42 @@ void ControllerFollowRoute::ReportKeyEvent(int key, bool down)
     (void)down;
 }
 
+void ControllerFollowRoute::SyncState(SE_StateBuffer& buf)
+{
+    Controller::SyncState(buf);
+    buf.Sync(vehicle_, waypoints_, currentWaypointIndex_, scenarioWaypointIndex_, changingLane_, pathCalculated_, allWaypoints_, odr_);
+
+    // Any ongoing lane change is created by the controller, so store target lane and action state to recreate it
+    int                             lane_change_lane = 0;
+    std::shared_ptr<SE_StateBuffer> lane_change_state;
+    if (buf.IsSaving() && laneChangeAction_ != nullptr)
+    {
+        lane_change_lane  = laneChangeAction_->target_->value_;
+        lane_change_state = std::make_shared<SE_StateBuffer>();
+        lane_change_state->Begin(SE_StateBuffer::Mode::SAVE);
+        laneChangeAction_->SyncState(*lane_change_state);
+        lane_change_state->End();
+    }
+    buf.Sync(lane_change_lane, lane_change_state);
+
+    if (buf.IsRestoring() && buf.IsOK())
+    {
+        delete laneChangeAction_;
+        laneChangeAction_ = nullptr;
+
+        if (lane_change_state != nullptr)
+        {
+            CreateLaneChange(lane_change_lane);
+            lane_change_state->Begin(SE_StateBuffer::Mode::RESTORE);
+            laneChangeAction_->SyncState(*lane_change_state);
+            if (!lane_change_state->End())
+            {
+                buf.Fail(lane_change_state->GetError());
+            }
+        }
+    }
+}
+
 void ControllerFollowRoute::UpdateWaypoints(roadmanager::Position vehiclePos, roadmanager::Position nextWaypoint)
 {
     WaypointStatus waypointStatus = GetWaypointStatus(vehiclePos, nextWaypoint);
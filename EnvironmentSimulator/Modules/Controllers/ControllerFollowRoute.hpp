@@ -66,6 +66,7 @@ namespace scenarioengine
                       ControlActivationMode light_activation_mode,
                       ControlActivationMode anim_activation_mode);
         void ReportKeyEvent(int key, bool down);
+        void SyncState(SE_StateBuffer& buf) override;
         void SetScenarioEngine(ScenarioEngine *scenarioEngine)
         {
             scenarioEngine_ = scenarioEngine;
@@ -184,3 +184,9 @@ void ControllerInteractive::ReportKeyEvent(int key, bool down)
         }
     }
 }
+
+void ControllerInteractive::SyncState(SE_StateBuffer& buf)
+{
+    Controller::SyncState(buf);
+    buf.Sync(vehicle_, accelerate, steer, steering_rate_, speed_factor_);
+}
@@ -293,20 +293,24 @@ void ControllerLooming::Step(double timeStep)
     }
 
     bool         hasLeadFar   = false;
-    int          minObjIndex  = -1;
+    Object*      minObj       = nullptr;
     double       minGapLength = LARGE_NUMBER;
     const double minDist      = 3.0;  // minimum distance to keep to lead vehicle
 
     const double minLateralDist = 5.0;
-    for (size_t i = 0; i < entities_->object_.size(); i++)
+    const double lookaheadDist  = 130;
+
+    // Only objects within lookahead distance along the road can be lead vehicles
+    entities_->lane_occupancy_.GetObjectsAlongRoad(object_->pos_, lookaheadDist, candidates_);
+
+    for (size_t i = 0; i < candidates_.size(); i++)
     {
-        Object* pivot_obj = entities_->object_[i];
+        Object* pivot_obj = candidates_[i];
         if (pivot_obj == nullptr || pivot_obj == object_)
         {
             continue;
         }
 
-        double lookaheadDist = 130;
         // Measure longitudinal distance to all vehicles, don't utilize costly free-space option, instead measure ref point to ref point
         roadmanager::PositionDiff diff;
         if (object_->pos_.Delta(&pivot_obj->pos_, diff, false, lookaheadDist) == true)  // look only double timeGap ahead
@@ -334,7 +338,7 @@ void ControllerLooming::Step(double timeStep)
             if (diff.dLaneId == 0 && adjustedGapLength > 0 && adjustedGapLength < minGapLength && abs(diff.dt) < minLateralDist)
             {
                 minGapLength = adjustedGapLength;
-                minObjIndex  = static_cast<int>(i);  // TODO: size_t to int
+                minObj       = pivot_obj;
 
                 // find far point from lead as reference, if lead <= farPointDistance(80) m
                 if (minGapLength <= farPointDistance)
@@ -369,7 +373,7 @@ void ControllerLooming::Step(double timeStep)
         far_y = s_data.road_lane_info.pos[1];
     }
 
-    if (minObjIndex > -1)
+    if (minObj != nullptr)
     {
         if (minGapLength < 1)
         {
@@ -377,12 +381,12 @@ void ControllerLooming::Step(double timeStep)
         }
         else
         {
-            double speedForTimeGap = MAX(currentSpeed_, entities_->object_[static_cast<unsigned int>(minObjIndex)]->GetSpeed());
+            double speedForTimeGap = MAX(currentSpeed_, minObj->GetSpeed());
             double followDist      = minDist + timeGap_ * fabs(speedForTimeGap);  // (m)
             double distRem         = minGapLength - followDist;
             double distFactor      = MIN(1.0, distRem / followDist);
 
-            double dvMin = currentSpeed_ - MIN(setSpeed_, entities_->object_[static_cast<unsigned int>(minObjIndex)]->GetSpeed());
+            double dvMin = currentSpeed_ - MIN(setSpeed_, minObj->GetSpeed());
             double dvSet = currentSpeed_ - setSpeed_;
 
             acc = distFactor - distFactor * dvSet - (1 - distFactor) * dvMin;  // weighted combination of relative distance and speed
@@ -469,3 +473,10 @@ void ControllerLooming::ReportKeyEvent(int key, bool down)
     (void)key;
     (void)down;
 }
+
+void ControllerLooming::SyncState(SE_StateBuffer& buf)
+{
+    Controller::SyncState(buf);
+    buf.Sync(vehicle_, active_, timeGap_, setSpeed_, currentSpeed_, setSpeedSet_, prevNearAngle, prevFarAngle);
+    buf.Sync(steering, acc, steering_rate_, angleDiff, candidates_);
+}
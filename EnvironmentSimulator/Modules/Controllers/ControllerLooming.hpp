@@ -62,6 +62,7 @@ namespace scenarioengine
                       ControlActivationMode light_activation_mode,
                       ControlActivationMode anim_activation_mode);
         void ReportKeyEvent(int key, bool down);
+        void SyncState(SE_StateBuffer& buf) override;
         void SetSetSpeed(double setSpeed)
         {
             setSpeed_ = setSpeed;
@@ -74,18 +75,19 @@ namespace scenarioengine
         }
 
     private:
-        vehicle::Vehicle vehicle_;
-        bool             active_        = false;
-        double           timeGap_       = 1.5;  // target headway time
-        double           setSpeed_      = 0.0;
-        double           currentSpeed_  = 0.0;
-        bool             setSpeedSet_   = false;
-        double           prevNearAngle  = 0.0;
-        double           prevFarAngle   = 0.0;
-        double           steering       = 0.0;
-        double           acc            = 0.0;
-        double           steering_rate_ = 4.0;
-        double           angleDiff      = 0.0;
+        vehicle::Vehicle     vehicle_;
+        bool                 active_        = false;
+        double               timeGap_       = 1.5;  // target headway time
+        double               setSpeed_      = 0.0;
+        double               currentSpeed_  = 0.0;
+        bool                 setSpeedSet_   = false;
+        double               prevNearAngle  = 0.0;
+        double               prevFarAngle   = 0.0;
+        double               steering       = 0.0;
+        double               acc            = 0.0;
+        double               steering_rate_ = 4.0;
+        double               angleDiff      = 0.0;
+        std::vector<Object*> candidates_;  // objects to consider, see LaneOccupancy
     };
 
     Controller* InstantiateControllerLooming(void* args);
@@ -411,6 +411,15 @@ void ControllerNaturalDriver::ReportKeyEvent(int key, bool down)
     (void)down;
 }
 
+void ControllerNaturalDriver::SyncState(SE_StateBuffer& buf)
+{
+    Controller::SyncState(buf);
+    buf.Sync(active_, desired_distance_, desired_speed_, current_speed_, lane_change_duration_, lookahead_dist_);
+    buf.Sync(max_deceleration_, max_acceleration_, lane_ids_available_, vehicles_in_radius_, vehicles_of_interest_);
+    buf.Sync(lane_change_injected, state_, lane_change_delay_, lane_change_cooldown_, target_lane_, desired_thw_);
+    buf.Sync(max_imposed_braking_, politeness_, lane_change_acc_gain_, route_, initiate_lanechange_);
+}
+
 void ControllerNaturalDriver::GetVehicleOfInterestType(int lane_id, VoIType& lead, VoIType& follow)
 {
     if (lane_id == lane_ids_available_[0])
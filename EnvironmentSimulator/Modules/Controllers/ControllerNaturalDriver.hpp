@@ -93,6 +93,7 @@ namespace scenarioengine
                                                double desired_thw) const;
 
         void ReportKeyEvent(int key, bool down);
+        void SyncState(SE_StateBuffer& buf) override;
 
     private:
         bool                             active_;
@@ -138,4 +138,10 @@ void ControllerOffroadFollower::ReportKeyEvent(int key, bool down)
 {
     (void)key;
     (void)down;
+}
+
+void ControllerOffroadFollower::SyncState(SE_StateBuffer& buf)
+{
+    Controller::SyncState(buf);
+    buf.Sync(vehicle_, follow_entity_, target_distance_, steering_rate_, speed_factor_);
 }
\ No newline at end of file
@@ -208,4 +208,11 @@ void ControllerSloppyDriver::ReportKeyEvent(int key, bool down)
 {
     (void)key;
     (void)down;
+}
+
+void ControllerSloppyDriver::SyncState(SE_StateBuffer& buf)
+{
+    Controller::SyncState(buf);
+    buf.Sync(sloppiness_, time_, speedTimer_, speedTimerAverage_, referenceSpeed_, initSpeed_, currentSpeed_, targetFactor_);
+    buf.Sync(lateralTimer_, lateralTimerAverage_, currentT_, tFuzz0, tFuzzTarget, currentH_);
 }
\ No newline at end of file
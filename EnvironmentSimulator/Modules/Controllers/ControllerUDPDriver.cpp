@@ -397,3 +397,10 @@ void ControllerUDPDriver::ReportKeyEvent(int key, bool down)
     (void)key;
     (void)down;
 }
+
+void ControllerUDPDriver::SyncState(SE_StateBuffer& buf)
+{
+    // received messages are not rewound, only the vehicle model state
+    Controller::SyncState(buf);
+    buf.Sync(vehicle_, accelerate, steer, lastMsg);
+}
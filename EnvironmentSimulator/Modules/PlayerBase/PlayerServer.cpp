@@ -99,6 +99,59 @@ namespace scenarioengine
         }
     }
 
+    // Create a copy of an injected action, including its current state
+    static OSCPrivateAction *CopyInjectedAction(OSCAction *action)
+    {
+        OSCPrivateAction *copy = static_cast<OSCPrivateAction *>(action)->Copy();
+        if (copy != nullptr)
+        {
+            copy->max_num_executions_ = action->max_num_executions_;
+
+            SE_StateBuffer state;
+            state.Begin(SE_StateBuffer::Mode::SAVE);
+            action->SyncState(state);
+            state.End();
+            state.Begin(SE_StateBuffer::Mode::RESTORE);
+            copy->SyncState(state);
+            state.End();
+        }
+        return copy;
+    }
+
+    void PlayerServer::SyncState(SE_StateBuffer &buf)
+    {
+        // Actions are injected and deleted during the simulation, e.g. lane changes of the natural driver controller.
+        // Hence store copies and replace any current actions with new copies at restore.
+        std::vector<std::shared_ptr<OSCPrivateAction>> actions;
+        if (buf.IsSaving())
+        {
+            for (auto action : action_)
+            {
+                if (action->GetBaseType() != OSCAction::BaseType::PRIVATE)
+                {
+                    buf.Fail("Injected action " + action->GetName() + " not supported in saved state");
+                    return;
+                }
+                actions.push_back(std::shared_ptr<OSCPrivateAction>(CopyInjectedAction(action)));
+            }
+        }
+        buf.Sync(actions, counter_);
+
+        if (buf.IsRestoring() && buf.IsOK())
+        {
+            for (auto action : action_)
+            {
+                delete action;
+            }
+            action_.clear();
+
+            for (auto &action : actions)
+            {
+                action_.push_back(CopyInjectedAction(action.get()));
+            }
+        }
+    }
+
     std::string PlayerServer::Type2Name(UDP_ACTION_TYPE type)
     {
         switch (type)
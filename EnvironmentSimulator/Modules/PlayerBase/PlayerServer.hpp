@@ -114,6 +114,9 @@ namespace scenarioengine
         void Start();
         void Stop();
 
+        // Save or restore injected actions, see SE_StateBuffer
+        void SyncState(SE_StateBuffer& buf);
+
     private:
         std::vector<OSCAction*> action_;
         ScenarioPlayer*         player_;
@@ -124,6 +124,13 @@ ScenarioPlayer::~ScenarioPlayer()
     }
 #endif  // _USE_OSI
 
+    if (!profile_filename_.empty())
+    {
+        SE_Profiler::Inst().Enable(false);
+        SE_Profiler::Inst().LogSummary();
+        SE_Profiler::Inst().SaveTrace(profile_filename_);
+    }
+
     SE_Env::Inst().GetOptions().Reset();
 }
 
@@ -183,9 +190,10 @@ void ScenarioPlayer::Draw()
 
 int ScenarioPlayer::Frame(double timestep_s, bool server_mode)
 {
-    static bool messageShown  = false;
-    int         retval        = 0;
-    double      ghost_solo_dt = 0.05;
+    int    retval        = 0;
+    double ghost_solo_dt = 0.05;
+
+    SE_ProfileScope profile("frame");
 
     if (!IsPaused() || server_mode)
     {
@@ -226,10 +234,10 @@ int ScenarioPlayer::Frame(double timestep_s, bool server_mode)
     {
         Draw();
 
-        if (scenarioEngine->getSimulationTime() > 3600 && !messageShown)
+        if (scenarioEngine->getSimulationTime() > 3600 && !time_limit_message_shown_)
         {
             LOG_INFO("Info: Simulation time > 1 hour. Put a stopTrigger for automatic ending");
-            messageShown = true;
+            time_limit_message_shown_ = true;
         }
 
         if (player_server_)
@@ -282,10 +290,14 @@ int ScenarioPlayer::ScenarioFrame(double timestep_s, bool keyframe)
 
         if (SE_Env::Inst().GetGhostMode() != GhostMode::RESTART)
         {
-            scenarioGateway->WriteStatesToFile();
+            {
+                SE_ProfileScope profile("dat write");
+                scenarioGateway->WriteStatesToFile();
+            }
 
             if (CSV_Log)
             {
+                SE_ProfileScope profile("CSV log");
                 UpdateCSV_Log();
             }
         }
@@ -309,9 +321,9 @@ void ScenarioPlayer::ScenarioPostFrame()
 {
     mutex.Lock();
 
-    for (size_t i = 0; i < sensor.size(); i++)
     {
-        sensor[i]->Update();
+        SE_ProfileScope profile("sensors");
+        ObjectSensor::Update(sensor, sensor_grid_);
     }
 #ifdef _USE_OSI
     if (NEAR_NUMBERS(scenarioEngine->getSimulationTime(), scenarioEngine->GetTrueTime()))
@@ -319,6 +331,7 @@ void ScenarioPlayer::ScenarioPostFrame()
         // Update OSI info
         if (osi_freq_ > 0)
         {
+            SE_ProfileScope profile("OSI update");
             osiReporter->ReportSensors(sensor);
 
             if ((GetCounter() - 1) % osi_freq_ == 0)
@@ -334,6 +347,70 @@ void ScenarioPlayer::ScenarioPostFrame()
     mutex.Unlock();
 }
 
+SE_StateBuffer* ScenarioPlayer::SaveState()
+{
+    SE_StateBuffer* buf = new SE_StateBuffer;
+
+    scenarioEngine->mutex_.Lock();
+    mutex.Lock();
+    buf->Begin(SE_StateBuffer::Mode::SAVE);
+    SyncState(*buf);
+    buf->End();
+    mutex.Unlock();
+    scenarioEngine->mutex_.Unlock();
+
+    return buf;
+}
+
+int ScenarioPlayer::RestoreState(SE_StateBuffer* buf)
+{
+    if (buf == nullptr)
+    {
+        return -1;
+    }
+
+    int retval = 0;
+
+    scenarioEngine->mutex_.Lock();
+    mutex.Lock();
+
+    // check complete state first, so that a failed restore leaves the simulation untouched
+    buf->Begin(SE_StateBuffer::Mode::VERIFY);
+    SyncState(*buf);
+    if (!buf->End())
+    {
+        LOG_ERROR("Failed to restore state: {}", buf->GetError());
+        retval = -1;
+    }
+    else
+    {
+        buf->Begin(SE_StateBuffer::Mode::RESTORE);
+        SyncState(*buf);
+        if (!buf->End())
+        {
+            LOG_ERROR("Failed to restore state: {}", buf->GetError());
+            retval = -1;
+        }
+    }
+
+    mutex.Unlock();
+    scenarioEngine->mutex_.Unlock();
+
+    return retval;
+}
+
+void ScenarioPlayer::SyncState(SE_StateBuffer& buf)
+{
+    buf.Sync(frame_counter_, quit_request, state_, osi_updated_, time_limit_message_shown_);
+    scenarioEngine->SyncState(buf);
+
+    buf.Expect(player_server_ != nullptr);
+    if (player_server_ && buf.IsOK())
+    {
+        player_server_->SyncState(buf);
+    }
+}
+
 #ifdef _USE_OSG
 void ScenarioPlayer::ViewerFrame(bool init)
 {
@@ -342,6 +419,8 @@ void ScenarioPlayer::ViewerFrame(bool init)
         return;
     }
 
+    SE_ProfileScope profile("viewer frame");
+
     mutex.Lock();
 
     // remove deleted cars
@@ -1261,13 +1340,25 @@ int ScenarioPlayer::Init()
     opt.AddOption("osc_str", "OpenSCENARIO XML string", "string");
     opt.AddOption("osg_screenshot_event_handler", "Revert to OSG default jpg images ('c'/'C' keys handler)");
 #ifdef _USE_OSI
+    opt.AddOption("osi_async",
+                  "Write OSI file and UDP packages from a separate thread, buffering up to given number of messages",
+                  "queue depth",
+                  "4");
+    opt.AddOption("osi_async_drop", "Skip OSI messages when async output queue is full, instead of waiting for free space");
     opt.AddOption("osi_file", "Save osi trace file", "filename", DEFAULT_OSI_TRACE_FILENAME);
     opt.AddOption("osi_freq", "Decrease OSI file entries, e.g. --osi_freq 2 -> OSI written every two simulation steps", "frequency");
+    opt.AddOption("osi_incremental", "Serialize static OSI ground truth once, then only dynamic content per frame. Output is unchanged.");
     opt.AddOption("osi_lines", "Show OSI road lines. Toggle key 'u'");
     opt.AddOption("osi_points", "Show OSI road points. Toggle key 'y'");
     opt.AddOption("osi_receiver_ip", "IP address where to send OSI UDP packages", "IP address", "127.0.0.1");
 #endif
+    opt.AddOption("osi_points_cache", "Cache OSI road points on disk, skipping generation next time the road network is loaded", "path", ".");
     opt.AddOption("param_dist", "Run variations of the scenario according to specified parameter distribution file", "filename");
+    opt.AddOption("param_dist_parallel",
+                  "Run all permutations of parameter distribution headless in parallel threads, 0 = one per CPU core. Result summarized in file",
+                  "threads",
+                  "0");
+    opt.AddOption("param_dist_summary", "Summary file of parallel parameter distribution run", "filename", "param_dist_summary.csv", true);
     opt.AddOption("param_permutation", "Run specific permutation of parameter distribution, index in range (0 .. NumberOfPermutations-1)", "index");
     opt.AddOption("pause", "Pause simulation after initialization");
     opt.AddOption("path", "Search path prefix for assets, e.g. OpenDRIVE files. Multiple occurrences of option supported", "path");
@@ -1275,6 +1366,13 @@ int ScenarioPlayer::Init()
 #ifdef _USE_IMPLOT
     opt.AddOption("plot", "Show window with line-plots of interesting data. Modes: asynchronous, synchronous", "mode", "asynchronous");
 #endif
+    opt.AddOption("preload_catalogs",
+                  "Parse all catalogs of given directory at startup, kept for any following scenario runs. Multiple occurrences of option supported",
+                  "path");
+    opt.AddOption("profile",
+                  "Measure time spent per simulation phase. Summary logged at end, trace saved for chrome://tracing or ui.perfetto.dev",
+                  "filename",
+                  "profile.json");
     opt.AddOption("record", "Record position data into a file for later replay", "filename", DAT_FILENAME);
     opt.AddOption("road_features", "Show OpenDRIVE road features. Modes: on, off. Toggle key 'o'", "mode", "on");
     opt.AddOption("return_nr_permutations", "Return number of permutations without executing the scenario (-1 = error)");
@@ -1287,6 +1385,11 @@ int ScenarioPlayer::Init()
     opt.AddOption("seed", "Specify seed number for random generator", "number");
     opt.AddOption("sensors", "Show sensor frustums. Toggle key 'r'");
     opt.AddOption("server", "Launch server to receive state of external Ego simulator");
+    opt.AddOption("spiral_exact", "Evaluate OpenDRIVE spirals (clothoids) by Fresnel integrals instead of precomputed lookup tables");
+    opt.AddOption("step_threads",
+                  "Move entities in parallel threads, 0 = one per CPU core. Result is identical to a single thread",
+                  "threads",
+                  "0");
     opt.AddOption("text_scale", "Scale screen overlay text", "size factor", "1.0", true);
     opt.AddOption("threads", "Run viewer in a separate thread, parallel to scenario engine");
     opt.AddOption("trail_mode", "Show trail lines and/or dots. Modes: 0=None 1=lines 2=dots 3=both. Toggle key 'j'", "mode", "0");
@@ -1514,12 +1617,39 @@ int ScenarioPlayer::Init()
         }
     }
 
+    if (opt.GetOptionSet("profile"))
+    {
+        profile_filename_ = opt.GetOptionArg("profile");
+        SE_Profiler::Inst().Reset();
+        SE_Profiler::Inst().Enable(true, true);
+    }
+
+    if (opt.GetOptionArg("preload_catalogs") != "")
+    {
+        int counter = 0;
+        while ((arg_str = opt.GetOptionArg("preload_catalogs", counter)) != "")
+        {
+            int n_catalogs = CatalogCache::Inst().Preload(arg_str);
+            if (n_catalogs >= 0)
+            {
+                LOG_INFO("Preloaded {} catalogs from {}", n_catalogs, arg_str);
+            }
+            counter++;
+        }
+    }
+
     if (opt.GetOptionSet("disable_controllers"))
     {
         disable_controllers_ = true;
         LOG_INFO("Disable entity controllers");
     }
 
+    if (opt.GetOptionSet("osi_points_cache"))
+    {
+        SE_Env::Inst().SetOSIPointsCacheDir(opt.GetOptionArg("osi_points_cache"));
+        LOG_INFO("Cache OSI points in {}", SE_Env::Inst().GetOSIPointsCacheDir());
+    }
+
     if (opt.GetOptionSet("ignore_z"))
     {
         LOG_INFO("Ignoring z values and placing vehicle relative to road");
@@ -1578,7 +1708,6 @@ int ScenarioPlayer::Init()
         {
             SE_Env::Inst().AddPath(DirNameOf(arg_str));  // add scenario directory to list pf paths
             scenarioEngine = new ScenarioEngine(arg_str, disable_controllers_);
-            Logger::Inst().SetTimePtr(scenarioEngine->GetSimulationTimePtr());
         }
         else if ((arg_str = opt.GetOptionArg("osc_str")) != "")
         {
@@ -1590,7 +1719,6 @@ int ScenarioPlayer::Init()
                 return -1;
             }
             scenarioEngine = new ScenarioEngine(doc, disable_controllers_);
-            Logger::Inst().SetTimePtr(scenarioEngine->GetSimulationTimePtr());
         }
         else
         {
@@ -1614,6 +1742,11 @@ int ScenarioPlayer::Init()
         return -1;
     }
 
+    if (opt.GetOptionSet("step_threads"))
+    {
+        scenarioEngine->SetStepThreads(static_cast<unsigned int>(MAX(0, strtoi(opt.GetOptionArg("step_threads")))));
+    }
+
     // Save xml
     if (opt.GetOptionSet("save_xosc"))
     {
@@ -1640,7 +1773,28 @@ int ScenarioPlayer::Init()
 #ifdef _USE_OSI
     osiReporter = new OSIReporter(scenarioEngine);
     osiReporter->SetStationaryModelReference(scenarioEngine->getSceneGraphFilename());
-    scenarioEngine->storyBoard.SetOSIReporter(osiReporter);
+    scenarioEngine->SetOSIReporter(osiReporter);
+
+    if (opt.GetOptionSet("osi_incremental"))
+    {
+        osiReporter->SetIncrementalSerialization(true);
+    }
+
+    if (opt.GetOptionSet("osi_async"))
+    {
+        int queue_depth = strtoi(opt.GetOptionArg("osi_async"));
+        if (queue_depth < 1)
+        {
+            LOG_ERROR("Invalid osi_async queue depth {}, expected > 0", opt.GetOptionArg("osi_async"));
+            return -1;
+        }
+        osiReporter->SetAsyncOutput(static_cast<unsigned int>(queue_depth),
+                                    opt.GetOptionSet("osi_async_drop") ? OSIWriter::Policy::DROP : OSIWriter::Policy::BLOCK);
+    }
+    else if (opt.GetOptionSet("osi_async_drop"))
+    {
+        LOG_WARN("osi_async_drop ignored, only applies with osi_async");
+    }
 
     if (opt.GetOptionSet("osi_receiver_ip"))
     {
@@ -103,6 +103,21 @@ namespace scenarioengine
         int  ScenarioFrame(double timestep_s, bool keyframe);
         void ShowObjectSensors(bool mode);
 
+        /**
+        Save current simulation state, e.g. to run several variants from the same point in time
+        Output files, viewer and external controllers are not included
+        @return Pointer to the saved state, to be deleted by the caller
+        */
+        SE_StateBuffer *SaveState();
+
+        /**
+        Restore simulation state. Fails if entities or storyboard have changed structurally since the state was saved.
+        The state can be restored any number of times.
+        @param buf State returned by SaveState()
+        @return -1 on failure, 0 on success
+        */
+        int RestoreState(SE_StateBuffer *buf);
+
         /**
         Add an ideal sensor to an object
         @param obj Pointer to the object
@@ -258,6 +273,8 @@ namespace scenarioengine
         SE_Semaphore                viewer_init_semaphore;
 
     private:
+        void SyncState(SE_StateBuffer &buf);
+
         double      trail_dt;
         SE_Thread   thread;
         SE_Mutex    mutex;
@@ -274,6 +291,10 @@ namespace scenarioengine
         char      **argv_;
         std::string titleString;
         PlayerState state_;
+        bool        time_limit_message_shown_ = false;
+        std::string profile_filename_;  // set when profiling
+
+        SensorObjectGrid sensor_grid_;  // object positions shared by all sensors each frame
     };
 
 }  // namespace scenarioengine
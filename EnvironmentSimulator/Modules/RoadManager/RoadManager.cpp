@@ -53,6 +53,10 @@
 #include <map>
 #include <sstream>
 #include <string>
+#include <string_view>
+#include <fstream>
+#include <thread>
+#include <cinttypes>
 
 #include "RoadManager.hpp"
 #include "odrSpiral.h"
@@ -66,13 +70,19 @@ using namespace roadmanager;
 #define MAX_TRACK_DIST             10
 #define OSI_POINT_CALC_STEPSIZE    1     // [m]
 #define OSI_TANGENT_LINE_TOLERANCE 0.01  // [m]
+#define OSI_ROADS_PER_THREAD       8     // min number of roads per thread when generating OSI points
+#define POSITION_BATCH_RANGE       1024  // number of consecutive points sharing one position object in batch processing
+#define OSI_CACHE_VERSION          1     // increase when changing OSI point generation or cache file format
 #define OSI_POINT_DIST_SCALE       0.025
 #define ROADMARK_WIDTH_STANDARD    0.15
 #define ROADMARK_WIDTH_BOLD        0.20
 #define NURBS_STEPLENGTH           1.0
+#define SPIRAL_TABLE_TOLERANCE     1e-9   // max position error of interpolated spiral [m]
+#define SPIRAL_TABLE_MAX_SIZE      10000  // max number of samples per spiral, else evaluated exactly
 
-static id_t g_Lane_id;
-static id_t g_Laneb_id;
+// Global lane ids are assigned while loading a road network, in the loading thread
+static thread_local id_t g_Lane_id;
+static thread_local id_t g_Laneb_id;
 
 const char* object_type_str[] = {"barrier",   "bike",     "building",     "bus",          "car",           "crosswalk",  "gantry",
                                  "motorbike", "none",     "obstacle",     "parkingSpace", "patch",         "pedestrian", "pole",
@@ -692,7 +702,63 @@ Spiral::Spiral(double s, double x, double y, double hdg, double length, double c
             SetY0(y0);
             SetH0(h0);
         }
+
+        if (!SE_Env::Inst().GetOptions().GetOptionSet("spiral_exact"))
+        {
+            BuildTable();
+        }
+    }
+}
+
+void Spiral::BuildTable()
+{
+    table_.clear();
+
+    if (clothoid_type_ != CLOTHOID || length_ < SMALL_NUMBER)
+    {
+        return;
+    }
+
+    // Error of cubic Hermite interpolation is bounded by step^4 / 384 * max norm of 4th derivative, per coordinate.
+    // For a curve parameterized by arc length with linear curvature k it is (-3 k k', -k^3) in the tangent frame.
+    double k_max   = MAX(fabs(curv_start_), fabs(curv_end_));
+    double d4_max  = k_max * k_max * k_max + 3 * k_max * fabs(c_dot_);
+    double step    = pow(384.0 * SPIRAL_TABLE_TOLERANCE / (sqrt(2.0) * d4_max), 0.25);
+    double n_steps = ceil(length_ / step);
+
+    if (n_steps + 1 > SPIRAL_TABLE_MAX_SIZE)
+    {
+        return;
+    }
+
+    table_step_ = length_ / n_steps;
+    table_.resize(static_cast<size_t>(n_steps) + 1);
+    for (size_t i = 0; i < table_.size(); i++)
+    {
+        double ds = MIN(static_cast<double>(i) * table_step_, length_);
+        double h;
+        EvaluateLocal(ds, &table_[i].x, &table_[i].y, &h);
+        table_[i].dx = cos(h);
+        table_[i].dy = sin(h);
     }
+
+    cos_hdg_ = cos(GetHdg());
+    sin_hdg_ = sin(GetHdg());
+}
+
+void Spiral::EvaluateLocal(double ds, double* x, double* y, double* h) const
+{
+    double xTmp, yTmp, t;
+
+    odrSpiral(s0_ + ds, c_dot_, &xTmp, &yTmp, &t);
+
+    *h = t - GetH0();
+
+    // transform spline segment to origo and start angle = 0
+    double x1 = xTmp - GetX0();
+    double y1 = yTmp - GetY0();
+    *x        = x1 * cos(-GetH0()) - y1 * sin(-GetH0());
+    *y        = x1 * sin(-GetH0()) + y1 * cos(-GetH0());
 }
 
 void Spiral::Print() const
@@ -711,8 +777,6 @@ void Spiral::Print() const
 
 void Spiral::EvaluateDS(double ds, double* x, double* y, double* h) const
 {
-    double xTmp, yTmp, t;
-
     ds = MAX(MIN(ds, length_), 0.0);
 
     if (clothoid_type_ == LINE)
@@ -723,19 +787,35 @@ void Spiral::EvaluateDS(double ds, double* x, double* y, double* h) const
     {
         arc_.EvaluateDS(ds, x, y, h);
     }
-    else
+    else if (!table_.empty())
     {
-        odrSpiral(s0_ + ds, c_dot_, &xTmp, &yTmp, &t);
+        // cubic Hermite interpolation between samples, heading given by integrated linear curvature
+        double u  = ds / table_step_;
+        size_t i  = MIN(static_cast<size_t>(u), table_.size() - 2);
+        double t1 = u - static_cast<double>(i);
+        double t2 = t1 * t1;
+        double t3 = t2 * t1;
+
+        double h00 = 2 * t3 - 3 * t2 + 1;
+        double h10 = (t3 - 2 * t2 + t1) * table_step_;
+        double h01 = 3 * t2 - 2 * t3;
+        double h11 = (t3 - t2) * table_step_;
 
-        *h = t - GetH0() + GetHdg();
+        const TableEntry& p0 = table_[i];
+        const TableEntry& p1 = table_[i + 1];
+        double            x2 = h00 * p0.x + h10 * p0.dx + h01 * p1.x + h11 * p1.dx;
+        double            y2 = h00 * p0.y + h10 * p0.dy + h01 * p1.y + h11 * p1.dy;
 
-        double x1, x2, y1, y2;
+        *h = GetHdg() + ds * (curv_start_ + 0.5 * c_dot_ * ds);
+        *x = GetX() + x2 * cos_hdg_ - y2 * sin_hdg_;
+        *y = GetY() + x2 * sin_hdg_ + y2 * cos_hdg_;
+    }
+    else
+    {
+        double x2, y2, h2;
+        EvaluateLocal(ds, &x2, &y2, &h2);
 
-        // transform spline segment to origo and start angle = 0
-        x1 = xTmp - GetX0();
-        y1 = yTmp - GetY0();
-        x2 = x1 * cos(-GetH0()) - y1 * sin(-GetH0());
-        y2 = x1 * sin(-GetH0()) + y1 * cos(-GetH0());
+        *h = h2 + GetHdg();
 
         // Then transform according to segment start position and heading
         *x = GetX() + x2 * cos(GetHdg()) - y2 * sin(GetHdg());
@@ -803,7 +883,9 @@ void Spiral::SetHdg(double h)
     }
     else
     {
-        hdg_ = h;
+        hdg_     = h;
+        cos_hdg_ = cos(GetHdg());
+        sin_hdg_ = sin(GetHdg());
     }
 }
 
@@ -1312,6 +1394,11 @@ void LaneRoadMarkType::AddLine(std::shared_ptr<LaneRoadMarkTypeLine> lane_roadMa
 
 void Lane::SetLaneBoundary(LaneBoundaryOSI* lane_boundary)
 {
+    if (lane_boundary_ != nullptr && lane_boundary_ != lane_boundary)
+    {
+        // replaced, e.g. when OSI points are generated again or loaded from cache
+        delete lane_boundary_;
+    }
     lane_boundary->SetGlobalId();
     lane_boundary_ = lane_boundary;
 }
@@ -1698,12 +1785,10 @@ bool LaneSection::IsOSILaneById(int id) const
 
 Lane* LaneSection::GetLaneById(int id) const
 {
-    for (size_t i = 0; i < lane_.size(); i++)
+    idx_t idx = GetLaneIdxById(id);
+    if (idx != IDX_UNDEFINED)
     {
-        if (lane_[i]->GetId() == id)
-        {
-            return lane_[i];
-        }
+        return lane_[idx];
     }
     return 0;
 }
@@ -1723,6 +1808,19 @@ int LaneSection::GetLaneIdByIdx(idx_t idx) const
 
 idx_t LaneSection::GetLaneIdxById(int id) const
 {
+    if (lane_.empty())
+    {
+        return IDX_UNDEFINED;
+    }
+
+    // Lanes are sorted on descending ID (see AddLane) and normally contiguous, so the index is given by the offset from the first lane
+    int offset = lane_[0]->GetId() - id;
+    if (offset >= 0 && static_cast<size_t>(offset) < lane_.size() && lane_[static_cast<size_t>(offset)]->GetId() == id)
+    {
+        return static_cast<idx_t>(offset);
+    }
+
+    // gap in lane IDs, fall back to search
     for (unsigned int i = 0; i < lane_.size(); i++)
     {
         if (lane_[i]->GetId() == id)
@@ -3024,12 +3122,10 @@ bool Road::UpdateZAndRollBySAndT(double s, double t, double* z, double* roadSupe
 
 Road* OpenDrive::GetRoadById(id_t id) const
 {
-    for (size_t i = 0; i < road_.size(); i++)
+    auto it = road_idx_.find(id);
+    if (it != road_idx_.end())
     {
-        if (road_[i]->GetId() == id)
-        {
-            return road_[i];
-        }
+        return road_[it->second];
     }
     return 0;
 }
@@ -3048,24 +3144,20 @@ Road* OpenDrive::GetRoadByIdx(idx_t idx) const
 
 Road* roadmanager::OpenDrive::GetRoadByIdStr(std::string id_str) const
 {
-    for (auto r : road_)
+    Road* r = GetRoadById(LookupIdFromStr(road_id_by_str_, id_str));
+    if (r != nullptr && r->GetIdStrRef() == id_str)
     {
-        if (r->GetIdStr() == id_str)
-        {
-            return r;
-        }
+        return r;
     }
     return nullptr;
 }
 
 Junction* roadmanager::OpenDrive::GetJunctionByIdStr(std::string id_str) const
 {
-    for (auto j : junction_)
+    Junction* j = GetJunctionById(LookupIdFromStr(junction_id_by_str_, id_str));
+    if (j != nullptr && j->GetIdStrRef() == id_str)
     {
-        if (j->GetIdStr() == id_str)
-        {
-            return j;
-        }
+        return j;
     }
     return nullptr;
 }
@@ -3084,12 +3176,10 @@ Geometry* OpenDrive::GetGeometryByIdx(idx_t road_idx, idx_t geom_idx) const
 
 Junction* OpenDrive::GetJunctionById(id_t id) const
 {
-    for (size_t i = 0; i < junction_.size(); i++)
+    auto it = junction_idx_.find(id);
+    if (it != junction_idx_.end())
     {
-        if (junction_[i]->GetId() == id)
-        {
-            return junction_[i];
-        }
+        return junction_[it->second];
     }
     return nullptr;
 }
@@ -3179,6 +3269,13 @@ void OpenDrive::Clear()
 
     road_ids_.clear();
     junction_ids_.clear();
+    road_id_by_str_.clear();
+    junction_id_by_str_.clear();
+    road_idx_.clear();
+    junction_idx_.clear();
+    road_grid_.Clear();
+    road_graph_.clear();
+    road_path_cache_.Clear();
 
     for (size_t i = 0; i < road_.size(); i++)
     {
@@ -3292,6 +3389,8 @@ bool OpenDrive::LoadOpenDriveFile(const char* filename, bool replace)
 
     EstablishUniqueIds(node, "road", road_ids_);
     EstablishUniqueIds(node, "junction", junction_ids_);
+    IndexIdStrings(road_ids_, road_id_by_str_);
+    IndexIdStrings(junction_ids_, junction_id_by_str_);
 
     for (pugi::xml_node road_node : node.children("road"))
     {
@@ -4195,6 +4294,7 @@ bool OpenDrive::LoadOpenDriveFile(const char* filename, bool replace)
             }
         }
 
+        road_idx_.emplace(r->GetId(), static_cast<idx_t>(road_.size()));
         road_.push_back(r);
 
         pugi::xml_node signals = road_node.child("signals");
@@ -4785,10 +4885,12 @@ bool OpenDrive::LoadOpenDriveFile(const char* filename, bool replace)
             j->AddController(controller);
         }
 
+        junction_idx_.emplace(j->GetId(), static_cast<idx_t>(junction_.size()));
         junction_.push_back(j);
     }
 
     CheckConnections();
+    BuildRoadGraph();
 
     if (!SetRoadOSI())
     {
@@ -5057,6 +5159,135 @@ Road* Junction::GetRoadAtOtherEndOfConnectingRoad(Road* connecting_road, Road* i
     return nullptr;
 }
 
+void OpenDrive::BuildRoadGraph()
+{
+    road_graph_.clear();
+    road_path_cache_.Clear();
+
+    for (size_t i = 0; i < road_.size(); i++)
+    {
+        for (LinkType link_type : {LinkType::PREDECESSOR, LinkType::SUCCESSOR})
+        {
+            RoadLink* link = road_[i]->GetLink(link_type);
+            if (link == nullptr)
+            {
+                continue;
+            }
+
+            std::vector<Road*>& roads = road_graph_[link];
+            roads.clear();
+
+            if (link->GetElementType() == RoadLink::ElementType::ELEMENT_TYPE_ROAD)
+            {
+                roads.push_back(GetRoadById(link->GetElementId()));
+            }
+            else if (link->GetElementType() == RoadLink::ElementType::ELEMENT_TYPE_JUNCTION)
+            {
+                Junction* junction = GetJunctionById(link->GetElementId());
+                if (junction == nullptr)
+                {
+                    LOG_ERROR("Failed to lookup junction with id {}", link->GetElementId());
+                    continue;
+                }
+
+                // all connecting roads having this road as incoming road
+                for (unsigned int j = 0; j < junction->GetNumberOfConnections(); j++)
+                {
+                    Connection* connection = junction->GetConnectionByIdx(j);
+                    if (connection && connection->GetIncomingRoad()->GetId() == road_[i]->GetId())
+                    {
+                        roads.push_back(connection->GetConnectingRoad());
+                    }
+                }
+            }
+        }
+    }
+}
+
+void OpenDrive::GetLinkedRoads(Road* road, RoadLink* link, std::vector<Road*>& roads)
+{
+    auto it = road_graph_.find(link);
+    if (it != road_graph_.end())
+    {
+        roads.assign(it->second.begin(), it->second.end());
+        return;
+    }
+
+    // link not known at load time, resolve it now
+    roads.clear();
+    if (link->GetElementType() == RoadLink::ElementType::ELEMENT_TYPE_ROAD)
+    {
+        roads.push_back(GetRoadById(link->GetElementId()));
+    }
+    else if (link->GetElementType() == RoadLink::ElementType::ELEMENT_TYPE_JUNCTION)
+    {
+        Junction* junction = GetJunctionById(link->GetElementId());
+        if (junction == nullptr)
+        {
+            LOG_ERROR("Failed to lookup junction with id {}", link->GetElementId());
+        }
+        for (unsigned int j = 0; junction && j < junction->GetNoConnectionsFromRoadId(road->GetId()); j++)
+        {
+            roads.push_back(GetRoadById(junction->GetConnectingRoadIdFromIncomingRoadId(road->GetId(), j)));
+        }
+    }
+}
+
+bool RoadPathCache::Get(const Key& key, Entry& entry)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto it = map_.find(key);
+    if (it == map_.end())
+    {
+        return false;
+    }
+
+    // move to front, i.e. most recently used
+    entries_.splice(entries_.begin(), entries_, it->second);
+    entry = it->second->second;
+
+    return true;
+}
+
+void RoadPathCache::Put(const Key& key, const Entry& entry)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto it = map_.find(key);
+    if (it != map_.end())
+    {
+        it->second->second = entry;
+        entries_.splice(entries_.begin(), entries_, it->second);
+        return;
+    }
+
+    if (map_.size() >= capacity_)
+    {
+        // evict least recently used
+        map_.erase(entries_.back().first);
+        entries_.pop_back();
+    }
+
+    entries_.emplace_front(key, entry);
+    map_[key] = entries_.begin();
+}
+
+void RoadPathCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    map_.clear();
+    entries_.clear();
+}
+
+void RoadPath::AddNode(PathNode* node)
+{
+    node->order = n_nodes_++;
+    unvisited_.push_back(node);
+    unvisited_links_[node->link] = node;
+    queue_.push({node->dist, node->order, node});
+}
+
 bool RoadPath::CheckRoad(Road* checkRoad, RoadPath::PathNode* srcNode, Road* fromRoad, int fromLaneId)
 {
     // Register length of this road and find node in other end of the road (link)
@@ -5138,42 +5369,42 @@ bool RoadPath::CheckRoad(Road* checkRoad, RoadPath::PathNode* srcNode, Road* fro
     }
 
     // Check if next node is already visited
-    for (size_t i = 0; i < visited_.size(); i++)
+    if (visited_links_.find(nextLink) != visited_links_.end())
     {
-        if (visited_[i]->link == nextLink)
-        {
-            // Already visited, ignore and return
-            return false;
-        }
+        // Already visited, ignore and return
+        return false;
     }
 
-    // Check if next node is already among unvisited
-    size_t i;
-    for (i = 0; i < unvisited_.size(); i++)
+    // Check if next node is already among unvisited. The link belongs to checkRoad, so only the path to it differs.
+    auto it = unvisited_links_.find(nextLink);
+    if (it != unvisited_links_.end())
     {
-        if (unvisited_[i]->link == nextLink)
+        PathNode* node = it->second;
+        if (srcNode->dist + checkRoad->GetLength() >= node->dist)
         {
-            // Consider it, i.e. calc distance and potentially store it (if less than old)
-            if (srcNode->dist + checkRoad->GetLength() < unvisited_[i]->dist)
-            {
-                unvisited_[i]->dist = srcNode->dist + checkRoad->GetLength();
-            }
+            // not shorter than already registered path
+            return false;
         }
-    }
 
-    if (i == unvisited_.size())
-    {
-        // link not visited before, add it
-        PathNode* pNode     = new PathNode;
-        pNode->dist         = srcNode->dist + checkRoad->GetLength();
-        pNode->link         = nextLink;
-        pNode->fromRoad     = checkRoad;
-        pNode->fromLaneId   = nextLaneId;
-        pNode->previous     = srcNode;
-        pNode->contactPoint = contact_point;
-        unvisited_.push_back(pNode);
+        // shorter path found, replace it
+        node->dist       = srcNode->dist + checkRoad->GetLength();
+        node->fromLaneId = nextLaneId;
+        node->previous   = srcNode;
+        queue_.push({node->dist, node->order, node});  // old queue entry becomes stale
+
+        return true;
     }
 
+    // add node for this path to the link
+    PathNode* pNode     = new PathNode;
+    pNode->dist         = srcNode->dist + checkRoad->GetLength();
+    pNode->link         = nextLink;
+    pNode->fromRoad     = checkRoad;
+    pNode->fromLaneId   = nextLaneId;
+    pNode->previous     = srcNode;
+    pNode->contactPoint = contact_point;
+    AddNode(pNode);
+
     return true;
 }
 
@@ -5181,7 +5412,6 @@ int RoadPath::Calculate(double& dist, bool bothDirections, double maxDist)
 {
     OpenDrive* odr         = startPos_->GetOpenDrive();
     RoadLink*  link        = 0;
-    Junction*  junction    = 0;
     Road*      startRoad   = odr->GetRoadById(startPos_->GetTrackId());
     Road*      targetRoad  = odr->GetRoadById(targetPos_->GetTrackId());
     Road*      pivotRoad   = startRoad;
@@ -5272,7 +5502,7 @@ int RoadPath::Calculate(double& dist, bool bothDirections, double maxDist)
                 pNode->dist = pivotRoad->GetLength() - startPos_->GetS();  // distance to end of road
             }
 
-            unvisited_.push_back(pNode);
+            AddNode(pNode);
         }
     }
 
@@ -5311,26 +5541,79 @@ int RoadPath::Calculate(double& dist, bool bothDirections, double maxDist)
         return -1;
     }
 
-    for (i = 0; i < 100 && !found && unvisited_.size() > 0 && tmpDist < maxDist; i++)
+    // Single direction search results depend only on first link, lane and target road, apart from the start offset
+    // Reuse any previous result, e.g. from earlier query between same pair of entities
+    RoadPathCache*       cache       = (!bothDirections && unvisited_.size() == 1) ? &odr->GetRoadPathCache() : nullptr;
+    RoadPathCache::Key   cache_key;
+    RoadPathCache::Entry cache_entry;
+    double               startDist   = unvisited_[0]->dist;
+    bool                 targetStart = false;
+    bool                 cache_hit   = false;
+
+    if (cache != nullptr)
     {
-        found = false;
+        cache_key.link       = unvisited_[0]->link;
+        cache_key.lane_id    = unvisited_[0]->fromLaneId;
+        cache_key.targetRoad = targetRoad;
+
+        RoadPathCache::Entry entry;
 
-        // Find unvisited PathNode with shortest distance
-        double minDist  = LARGE_NUMBER;
-        idx_t  minIndex = 0;
-        for (unsigned int j = 0; j < unvisited_.size(); j++)
+        // a found path is valid only if the search would have proceeded to it within given max distance
+        if (cache->Get(cache_key, entry) && (!entry.found || (maxDist > 0.0 && entry.max_prev_dist + startDist < maxDist)))
         {
-            if (unvisited_[j]->dist < minDist)
+            cache_hit = true;
+            found     = entry.found;
+            if (found)
             {
-                minIndex = j;
-                minDist  = unvisited_[j]->dist;
+                // restore path, first node is the start node
+                for (size_t j = 1; j < entry.nodes.size(); j++)
+                {
+                    PathNode* pNode     = new PathNode;
+                    pNode->link         = entry.nodes[j].link;
+                    pNode->dist         = entry.nodes[j].dist + startDist;
+                    pNode->fromRoad     = entry.nodes[j].fromRoad;
+                    pNode->fromLaneId   = entry.nodes[j].fromLaneId;
+                    pNode->contactPoint = entry.nodes[j].contactPoint;
+                    pNode->previous     = unvisited_.back();
+                    unvisited_.push_back(pNode);
+                }
+                for (size_t j = 0; j < unvisited_.size(); j++)
+                {
+                    unvisited_[j]->visited = true;
+                }
+                visited_.swap(unvisited_);
+
+                tmpDist     = visited_.back()->dist;
+                targetStart = entry.target_start;
             }
         }
+    }
+
+    double maxPrevDist = -LARGE_NUMBER;  // max distance of visited nodes, excluding the most recent one
+    bool   cacheable   = cache != nullptr;
+
+    std::vector<Road*> linked_roads;  // local, since paths may be calculated in parallel on the same road network
+
+    while (!cache_hit && !found && !queue_.empty() && tmpDist < maxDist)
+    {
+        // Find unvisited PathNode with shortest distance, skipping stale queue entries of relaxed or visited nodes
+        QueueEntry entry = queue_.top();
+        queue_.pop();
+        if (entry.node->visited || entry.dist != entry.node->dist)
+        {
+            continue;
+        }
+
+        if (visited_.size() > 0)
+        {
+            maxPrevDist = MAX(maxPrevDist, tmpDist);
+        }
 
-        link        = unvisited_[minIndex]->link;
-        tmpDist     = unvisited_[minIndex]->dist;
-        pivotRoad   = unvisited_[minIndex]->fromRoad;
-        pivotLaneId = unvisited_[minIndex]->fromLaneId;
+        PathNode* pivot = entry.node;
+        link            = pivot->link;
+        tmpDist         = pivot->dist;
+        pivotRoad       = pivot->fromRoad;
+        pivotLaneId     = pivot->fromLaneId;
 
         // - Inspect all unvisited neighbor nodes (links), measure edge (road) distance to that link
         // - Note the total distance
@@ -5339,38 +5622,27 @@ int RoadPath::Calculate(double& dist, bool bothDirections, double maxDist)
         if (link->GetElementType() == RoadLink::ElementType::ELEMENT_TYPE_ROAD)
         {
             // only one edge (road)
-            nextRoad = odr->GetRoadById(link->GetElementId());
+            odr->GetLinkedRoads(pivotRoad, link, linked_roads);
+            nextRoad = linked_roads[0];
 
             if (nextRoad == targetRoad)
             {
                 // Special case: On same road, distance is equal to delta s, direction considered
-                if (link->GetContactPointType() == ContactPointType::CONTACT_POINT_START)
-                {
-                    tmpDist += targetPos_->GetS();
-                }
-                else
-                {
-                    tmpDist += nextRoad->GetLength() - targetPos_->GetS();
-                }
-
-                found = true;
+                targetStart = link->GetContactPointType() == ContactPointType::CONTACT_POINT_START;
+                found       = true;
             }
-            else
+            else if (nextRoad != nullptr)
             {
-                CheckRoad(nextRoad, unvisited_[minIndex], pivotRoad, pivotLaneId);
+                CheckRoad(nextRoad, pivot, pivotRoad, pivotLaneId);
             }
         }
         else if (link->GetElementType() == RoadLink::ElementType::ELEMENT_TYPE_JUNCTION)
         {
             // check all junction links (connecting roads) that has pivot road as incoming road
-            junction = odr->GetJunctionById(link->GetElementId());
-            if (junction == nullptr)
-            {
-                LOG_ERROR("Failed to lookup junction with id {}", link->GetElementId());
-            }
-            for (unsigned int j = 0; junction && j < junction->GetNoConnectionsFromRoadId(pivotRoad->GetId()); j++)
+            odr->GetLinkedRoads(pivotRoad, link, linked_roads);
+            for (Road* road : linked_roads)
             {
-                nextRoad = odr->GetRoadById(junction->GetConnectingRoadIdFromIncomingRoadId(pivotRoad->GetId(), j));
+                nextRoad = road;
                 if (nextRoad == 0)
                 {
                     return 0;
@@ -5379,16 +5651,15 @@ int RoadPath::Calculate(double& dist, bool bothDirections, double maxDist)
                 if (nextRoad == targetRoad)  // target road reached
                 {
                     ContactPointType contact_point = ContactPointType::CONTACT_POINT_UNDEFINED;
-                    // if (nextRoad->IsSuccessor(pivotRoad, &contact_point) || nextRoad->IsPredecessor(pivotRoad, &contact_point))
                     if (pivotRoad->IsSuccessor(nextRoad, &contact_point) || pivotRoad->IsPredecessor(nextRoad, &contact_point))
                     {
                         if (contact_point == ContactPointType::CONTACT_POINT_START)
                         {
-                            tmpDist += targetPos_->GetS();
+                            targetStart = true;
                         }
                         else if (contact_point == ContactPointType::CONTACT_POINT_END)
                         {
-                            tmpDist += nextRoad->GetLength() - targetPos_->GetS();
+                            targetStart = false;
                         }
                         else
                         {
@@ -5405,14 +5676,41 @@ int RoadPath::Calculate(double& dist, bool bothDirections, double maxDist)
                 }
                 else
                 {
-                    CheckRoad(nextRoad, unvisited_[minIndex], pivotRoad, pivotLaneId);
+                    CheckRoad(nextRoad, pivot, pivotRoad, pivotLaneId);
                 }
             }
         }
 
         // Mark pivot link as visited (move it from unvisited to visited)
-        visited_.push_back(unvisited_[minIndex]);
-        unvisited_.erase(unvisited_.begin() + minIndex);
+        pivot->visited = true;
+        visited_.push_back(pivot);
+        visited_links_.insert(link);
+    }
+
+    if (!cache_hit)
+    {
+        unvisited_.erase(std::remove_if(unvisited_.begin(), unvisited_.end(), [](PathNode* node) { return node->visited; }),
+                         unvisited_.end());
+
+        // store result unless search was cut short by max distance
+        if (cacheable && (found || queue_.empty()) && visited_.size() > 0)
+        {
+            cache_entry.found         = found;
+            cache_entry.target_start  = targetStart;
+            cache_entry.max_prev_dist = maxPrevDist - startDist;
+            for (PathNode* node = found ? visited_.back() : nullptr; node != nullptr; node = node->previous)
+            {
+                cache_entry.nodes.insert(cache_entry.nodes.begin(),
+                                         {node->link, node->dist - startDist, node->fromRoad, node->fromLaneId, node->contactPoint});
+            }
+            cache->Put(cache_key, cache_entry);
+        }
+    }
+
+    if (found)
+    {
+        // add distance from the link to target position
+        tmpDist += targetStart ? targetPos_->GetS() : targetRoad->GetLength() - targetPos_->GetS();
     }
 
     if (found)
@@ -5463,17 +5761,21 @@ int RoadPath::Calculate(double& dist, bool bothDirections, double maxDist)
 
 RoadPath::~RoadPath()
 {
-    for (size_t i = 0; i < visited_.size(); i++)
+    // unvisited nodes first, since visited ones might still be referred to if search was aborted
+    for (size_t i = 0; i < unvisited_.size(); i++)
     {
-        delete (visited_[i]);
+        if (!unvisited_[i]->visited)
+        {
+            delete (unvisited_[i]);
+        }
     }
-    visited_.clear();
+    unvisited_.clear();
 
-    for (size_t i = 0; i < unvisited_.size(); i++)
+    for (size_t i = 0; i < visited_.size(); i++)
     {
-        delete (unvisited_[i]);
+        delete (visited_[i]);
     }
-    unvisited_.clear();
+    visited_.clear();
 }
 
 OpenDrive::~OpenDrive()
@@ -5494,12 +5796,10 @@ void OpenDrive::Reset()
 
 idx_t OpenDrive::GetTrackIdxById(id_t id) const
 {
-    for (unsigned int i = 0; i < road_.size(); i++)
+    auto it = road_idx_.find(id);
+    if (it != road_idx_.end())
     {
-        if (road_[i]->GetId() == id)
-        {
-            return i;
-        }
+        return it->second;
     }
     LOG_ERROR("OpenDrive::GetTrackIdxById Error: Road id {} not found", id);
     return IDX_UNDEFINED;
@@ -5982,14 +6282,23 @@ void OpenDrive::EstablishUniqueIds(pugi::xml_node& parent, std::string name, std
     }
 }
 
-id_t OpenDrive::LookupIdFromStr(std::vector<std::pair<id_t, std::string>>& ids, std::string id_str)
+void OpenDrive::IndexIdStrings(const std::vector<std::pair<id_t, std::string>>& ids, std::unordered_map<std::string, id_t>& index)
 {
+    index.clear();
+    index.reserve(ids.size());
     for (auto& id : ids)
     {
-        if (id.second == id_str)
-        {
-            return id.first;
-        }
+        // emplace keeps first occurrence, same as a linear search would find
+        index.emplace(id.second, id.first);
+    }
+}
+
+id_t OpenDrive::LookupIdFromStr(const std::unordered_map<std::string, id_t>& ids, const std::string& id_str) const
+{
+    auto it = ids.find(id_str);
+    if (it != ids.end())
+    {
+        return it->second;
     }
 
     return ID_UNDEFINED;
@@ -5997,7 +6306,7 @@ id_t OpenDrive::LookupIdFromStr(std::vector<std::pair<id_t, std::string>>& ids,
 
 id_t OpenDrive::LookupRoadIdFromStr(std::string id_str)
 {
-    id_t id = LookupIdFromStr(road_ids_, id_str);
+    id_t id = LookupIdFromStr(road_id_by_str_, id_str);
 
     return id;
 }
@@ -6009,7 +6318,7 @@ id_t OpenDrive::LookupJunctionIdFromStr(std::string id_str)
         return ID_UNDEFINED;
     }
 
-    id_t id = LookupIdFromStr(junction_ids_, id_str);
+    id_t id = LookupIdFromStr(junction_id_by_str_, id_str);
 
     if (id == ID_UNDEFINED)
     {
@@ -6512,6 +6821,15 @@ void Position::Duplicate(const Position& from)
     t_trajectory_    = from.t_trajectory_;
 }
 
+void Position::SyncState(SE_StateBuffer& buf)
+{
+    // assignment excludes references to route and trajectory, see Duplicate(). Those are owned elsewhere and might be
+    // deleted before restore, so refer to them by id.
+    buf.Sync(*this, super_elevation_idx_, overlapping_roads);
+    buf.SyncRef(route_);
+    buf.SyncRef(trajectory_);
+}
+
 void Position::Clean()
 {
     if (route_ != nullptr)
@@ -6538,12 +6856,23 @@ bool Position::LoadOpenDrive(OpenDrive* odr)
     return (GetOpenDrive() != nullptr);
 }
 
+static thread_local OpenDrive* thread_od = nullptr;
+
 OpenDrive* Position::GetOpenDrive()
 {
+    if (thread_od != nullptr)
+    {
+        return thread_od;
+    }
     static OpenDrive od;
     return &od;
 }
 
+void Position::SetThreadOpenDrive(OpenDrive* odr)
+{
+    thread_od = odr;
+}
+
 static double
 GetMaxSegmentLen(const Position* pivot, const Position* pos, double min, double max, double pitchResScale, double rollResScale, bool& osi_requirement)
 {
@@ -6721,11 +7050,10 @@ bool OpenDrive::CheckLaneOSIRequirement(std::vector<double> x0, std::vector<doub
     }
 }
 
-void OpenDrive::SetLaneOSIPoints()
+void OpenDrive::SetLaneOSIPoints(Road* road)
 {
     // Initialization
     Position                 pos_pivot, pos_tmp, pos_candidate, pos_last_ok;
-    Road*                    road;
     LaneSection*             lsec;
     Lane*                    lane;
     unsigned int             number_of_lane_sections, number_of_lanes;
@@ -6738,116 +7066,274 @@ void OpenDrive::SetLaneOSIPoints()
     pos_tmp.SetMode(Position::PosModeType::SET, Position::PosMode::H_REL);
     pos_candidate.SetMode(Position::PosModeType::SET, Position::PosMode::H_REL);
 
-    // Looping through each road
-    for (unsigned int i = 0; i < road_.size(); i++)
+    if (road->GetJunction() == ID_UNDEFINED)
     {
-        road = road_[i];
-
-        if (road->GetJunction() == ID_UNDEFINED)
+        osiintersection = ID_UNDEFINED;
+    }
+    else
+    {
+        Junction* junction = GetJunctionById(road->GetJunction());
+        if (junction && junction->IsOsiIntersection())
+        {
+            osiintersection = GetJunctionById(road->GetJunction())->GetGlobalId();
+        }
+        else
         {
             osiintersection = ID_UNDEFINED;
         }
+    }
+
+    // Looping through each lane section
+    number_of_lane_sections = road->GetNumberOfLaneSections();
+    for (unsigned int j = 0; j < number_of_lane_sections; j++)
+    {
+        // Get the ending position of the current lane section
+        lsec = road->GetLaneSectionByIdx(j);
+        if (j == number_of_lane_sections - 1)
+        {
+            lsec_end = road->GetLength();
+        }
         else
         {
-            Junction* junction = GetJunctionById(road->GetJunction());
-            if (junction && junction->IsOsiIntersection())
-            {
-                osiintersection = GetJunctionById(road->GetJunction())->GetGlobalId();
-            }
-            else
-            {
-                osiintersection = ID_UNDEFINED;
-            }
+            lsec_end = road->GetLaneSectionByIdx(j + 1)->GetS();
         }
 
-        // Looping through each lane section
-        number_of_lane_sections = road_[i]->GetNumberOfLaneSections();
-        for (unsigned int j = 0; j < number_of_lane_sections; j++)
+        // Looping through each lane
+        number_of_lanes        = lsec->GetNumberOfLanes();
+        double lane_offset_max = 0.0;
+        for (unsigned int k = 0; k < number_of_lanes + 1; k++)  // +1 for center lane
         {
-            // Get the ending position of the current lane section
-            lsec = road->GetLaneSectionByIdx(j);
-            if (j == number_of_lane_sections - 1)
+            std::vector<double> x0, y0, x1, y1;
+
+            if (k < number_of_lanes)
             {
-                lsec_end = road->GetLength();
+                lane = lsec->GetLaneByIdx(k);
             }
             else
             {
-                lsec_end = road->GetLaneSectionByIdx(j + 1)->GetS();
-            }
-
-            // Looping through each lane
-            number_of_lanes        = lsec->GetNumberOfLanes();
-            double lane_offset_max = 0.0;
-            for (unsigned int k = 0; k < number_of_lanes + 1; k++)  // +1 for center lane
-            {
-                std::vector<double> x0, y0, x1, y1;
-
-                if (k < number_of_lanes)
+                lane = lsec->GetLaneById(0);
+                if (lane_offset_max < SMALL_NUMBER)
                 {
-                    lane = lsec->GetLaneByIdx(k);
+                    // no lane offset, reference line identical to center lane
+                    lsec->GetRefLineOSIPoints().Set(lane->GetOSIPoints()->GetPoints());
+                    continue;
                 }
                 else
                 {
-                    lane = lsec->GetLaneById(0);
-                    if (lane_offset_max < SMALL_NUMBER)
-                    {
-                        // no lane offset, reference line identical to center lane
-                        lsec->GetRefLineOSIPoints().Set(lane->GetOSIPoints()->GetPoints());
-                        continue;
-                    }
-                    else
-                    {
-                        // create unique points for reference line
-                    }
+                    // create unique points for reference line
                 }
-                int counter = 0;
+            }
+            int counter = 0;
 
-                // [XO, YO] = Real position with no tolerance
-                if (k < number_of_lanes)
+            // [XO, YO] = Real position with no tolerance
+            if (k < number_of_lanes)
+            {
+                if (pos_pivot.SetLanePos(road->GetId(), lane->GetId(), lsec->GetS(), 0, j) != Position::ReturnCode::OK)
                 {
-                    if (pos_pivot.SetLanePos(road->GetId(), lane->GetId(), lsec->GetS(), 0, j) != Position::ReturnCode::OK)
-                    {
-                        break;
-                    }
+                    break;
                 }
-                else
+            }
+            else
+            {
+                if (pos_pivot.SetTrackPos(road->GetId(), lsec->GetS(), 0.0) != Position::ReturnCode::OK)
                 {
-                    if (pos_pivot.SetTrackPos(road->GetId(), lsec->GetS(), 0.0) != Position::ReturnCode::OK)
-                    {
-                        break;
-                    }
+                    break;
                 }
+            }
 
-                // Add the starting point of each lane as osi point
-                PointStruct p = {lsec->GetS(), pos_pivot.GetX(), pos_pivot.GetY(), pos_pivot.GetZ(), pos_pivot.GetHRoad(), false};
-                osi_point.push_back(p);
-                pos_last_ok = pos_pivot;
+            // Add the starting point of each lane as osi point
+            PointStruct p = {lsec->GetS(), pos_pivot.GetX(), pos_pivot.GetY(), pos_pivot.GetZ(), pos_pivot.GetHRoad(), false};
+            osi_point.push_back(p);
+            pos_last_ok = pos_pivot;
 
-                // [XO, YO] = closest position with given (-) tolerance
+            // [XO, YO] = closest position with given (-) tolerance
+            if (k < number_of_lanes)
+            {
+                pos_tmp.SetLanePos(road->GetId(), lane->GetId(), MAX(0, lsec->GetS() - OSI_TANGENT_LINE_TOLERANCE), 0, j);
+            }
+            else
+            {
+                pos_tmp.SetTrackPos(road->GetId(), MAX(0, lsec->GetS() - OSI_TANGENT_LINE_TOLERANCE), 0.0);
+            }
+            x0.push_back(pos_tmp.GetX());
+            y0.push_back(pos_tmp.GetY());
+
+            // Push real position between the +/- tolerance points
+            x0.push_back(pos_pivot.GetX());
+            y0.push_back(pos_pivot.GetY());
+
+            // [XO, YO] = closest position with given (+) tolerance
+            if (k < number_of_lanes)
+            {
+                pos_tmp.SetLanePos(road->GetId(), lane->GetId(), MIN(lsec->GetS() + OSI_TANGENT_LINE_TOLERANCE, lsec_end), 0, j);
+            }
+            else
+            {
+                pos_tmp.SetTrackPos(road->GetId(), MIN(lsec->GetS() + OSI_TANGENT_LINE_TOLERANCE, lsec_end), 0.0);
+            }
+            x0.push_back(pos_tmp.GetX());
+            y0.push_back(pos_tmp.GetY());
+
+            bool   insert = false;
+            double step   = MIN(OSI_POINT_CALC_STEPSIZE, lsec->GetLength());
+
+            pos_candidate = pos_pivot;
+
+            // Looping through sequential points along the track determined by "OSI_POINT_CALC_STEPSIZE"
+            while (++counter)
+            {
+                // Make sure we stay within lane section length
+                double s = MIN(pos_candidate.GetS() + step, lsec_end - SMALL_NUMBER / 2);
+
+                if (lane->GetId() == 0)  // center lane
+                {
+                    lane_offset_max = MAX(lane_offset_max, fabs(road->GetLaneOffset(s)));
+                }
+
+                // [X1, Y1] = Real position with no tolerance
                 if (k < number_of_lanes)
                 {
-                    pos_tmp.SetLanePos(road->GetId(), lane->GetId(), MAX(0, lsec->GetS() - OSI_TANGENT_LINE_TOLERANCE), 0, j);
+                    pos_candidate.SetLanePos(road->GetId(), lane->GetId(), s, 0, j);
                 }
                 else
                 {
-                    pos_tmp.SetTrackPos(road->GetId(), MAX(0, lsec->GetS() - OSI_TANGENT_LINE_TOLERANCE), 0.0);
+                    pos_candidate.SetTrackPos(road->GetId(), s, 0.0);
                 }
-                x0.push_back(pos_tmp.GetX());
-                y0.push_back(pos_tmp.GetY());
 
-                // Push real position between the +/- tolerance points
-                x0.push_back(pos_pivot.GetX());
-                y0.push_back(pos_pivot.GetY());
+                // [X1, Y1] = closest position with given (-) tolerance
+                if (k < number_of_lanes)
+                {
+                    pos_tmp.SetLanePos(road->GetId(), lane->GetId(), MAX(s - OSI_TANGENT_LINE_TOLERANCE, 0), 0, j);
+                }
+                else
+                {
+                    pos_tmp.SetTrackPos(road->GetId(), MAX(s - OSI_TANGENT_LINE_TOLERANCE, 0), 0.0);
+                }
+                x1.push_back(pos_tmp.GetX());
+                y1.push_back(pos_tmp.GetY());
 
-                // [XO, YO] = closest position with given (+) tolerance
+                x1.push_back(pos_candidate.GetX());
+                y1.push_back(pos_candidate.GetY());
+
+                // [X1, Y1] = closest position with given (+) tolerance
                 if (k < number_of_lanes)
                 {
-                    pos_tmp.SetLanePos(road->GetId(), lane->GetId(), MIN(lsec->GetS() + OSI_TANGENT_LINE_TOLERANCE, lsec_end), 0, j);
+                    pos_tmp.SetLanePos(road->GetId(), lane->GetId(), MIN(s + OSI_TANGENT_LINE_TOLERANCE, lsec_end), 0, j);
                 }
                 else
                 {
-                    pos_tmp.SetTrackPos(road->GetId(), MIN(lsec->GetS() + OSI_TANGENT_LINE_TOLERANCE, lsec_end), 0.0);
+                    pos_tmp.SetTrackPos(road->GetId(), MIN(s + OSI_TANGENT_LINE_TOLERANCE, lsec_end), 0.0);
+                }
+
+                x1.push_back(pos_tmp.GetX());
+                y1.push_back(pos_tmp.GetY());
+
+                int add_point_status = CheckAndAddOSIPoint(pos_pivot,
+                                                           pos_candidate,
+                                                           pos_last_ok,
+                                                           x0,
+                                                           y0,
+                                                           x1,
+                                                           y1,
+                                                           step,
+                                                           osi_requirement,
+                                                           osi_point,
+                                                           insert,
+                                                           lsec_end);
+                if (add_point_status == 2)
+                {
+                    break;
                 }
+                else if (add_point_status == 1)
+                {
+                    pos_candidate = pos_pivot;
+                }
+            }
+
+            if (k < number_of_lanes)
+            {
+                // Set all collected osi points for the current lane
+                lane->osi_points_.Set(osi_point);
+                lane->SetOSIIntersection(osiintersection);
+            }
+            else
+            {
+                // Set collected osi points for the reference line
+                lsec->GetRefLineOSIPoints().Set(osi_point);
+            }
+
+            // Clear osi collectors for next iteration
+            osi_point.clear();
+        }
+    }
+}
+
+void OpenDrive::SetLaneBoundaryPoints(Road* road, std::vector<std::pair<Lane*, LaneBoundaryOSI*>>& lane_boundaries)
+{
+    // Initialization
+    Position                 pos_pivot, pos_tmp, pos_candidate, pos_last_ok;
+    LaneSection*             lsec;
+    Lane*                    lane;
+    unsigned int             number_of_lane_sections, number_of_lanes;
+    double                   lsec_end;
+    std::vector<PointStruct> osi_point;
+    bool                     osi_requirement;
+
+    pos_pivot.SetMode(Position::PosModeType::SET, Position::PosMode::H_REL);
+    pos_tmp.SetMode(Position::PosModeType::SET, Position::PosMode::H_REL);
+    pos_candidate.SetMode(Position::PosModeType::SET, Position::PosMode::H_REL);
+
+    // Looping through each lane section
+    number_of_lane_sections = road->GetNumberOfLaneSections();
+    for (unsigned int j = 0; j < number_of_lane_sections; j++)
+    {
+        // Get the ending position of the current lane section
+        lsec = road->GetLaneSectionByIdx(j);
+        if (j == number_of_lane_sections - 1)
+        {
+            lsec_end = road->GetLength();
+        }
+        else
+        {
+            lsec_end = road->GetLaneSectionByIdx(j + 1)->GetS();
+        }
+
+        // Looping through each lane
+        number_of_lanes = lsec->GetNumberOfLanes();
+        for (unsigned int k = 0; k < number_of_lanes; k++)
+        {
+            lane                     = lsec->GetLaneByIdx(k);
+            unsigned int n_roadmarks = lane->GetNumberOfRoadMarks();
+
+            if (n_roadmarks == 0)
+            {
+                std::vector<double> x0, y0, x1, y1;
+
+                lane                 = lsec->GetLaneByIdx(k);
+                unsigned int counter = 0;
+
+                // [XO, YO] = Real position with no tolerance
+                if (pos_pivot.SetLaneBoundaryPos(road->GetId(), lane->GetId(), lsec->GetS(), 0, j) != Position::ReturnCode::OK)
+                {
+                    break;
+                }
+
+                // Add the starting point of each lane as osi point
+                PointStruct p = {lsec->GetS(), pos_pivot.GetX(), pos_pivot.GetY(), pos_pivot.GetZ(), pos_pivot.GetHRoad(), false};
+                osi_point.push_back(p);
+                pos_last_ok = pos_pivot;
+
+                // [XO, YO] = closest position with given (-) tolerance
+                pos_tmp.SetLaneBoundaryPos(road->GetId(), lane->GetId(), MAX(0, lsec->GetS() - OSI_TANGENT_LINE_TOLERANCE), 0, j);
+                x0.push_back(pos_tmp.GetX());
+                y0.push_back(pos_tmp.GetY());
+
+                // Push real position between the +/- tolerance points
+                x0.push_back(pos_pivot.GetX());
+                y0.push_back(pos_pivot.GetY());
+
+                // [XO, YO] = closest position with given (+) tolerance
+                pos_tmp.SetLaneBoundaryPos(road->GetId(), lane->GetId(), MIN(lsec->GetS() + OSI_TANGENT_LINE_TOLERANCE, lsec_end), 0, j);
                 x0.push_back(pos_tmp.GetX());
                 y0.push_back(pos_tmp.GetY());
 
@@ -6862,30 +7348,11 @@ void OpenDrive::SetLaneOSIPoints()
                     // Make sure we stay within lane section length
                     double s = MIN(pos_candidate.GetS() + step, lsec_end - SMALL_NUMBER / 2);
 
-                    if (lane->GetId() == 0)  // center lane
-                    {
-                        lane_offset_max = MAX(lane_offset_max, fabs(road->GetLaneOffset(s)));
-                    }
-
                     // [X1, Y1] = Real position with no tolerance
-                    if (k < number_of_lanes)
-                    {
-                        pos_candidate.SetLanePos(road->GetId(), lane->GetId(), s, 0, j);
-                    }
-                    else
-                    {
-                        pos_candidate.SetTrackPos(road->GetId(), s, 0.0);
-                    }
+                    pos_candidate.SetLaneBoundaryPos(road->GetId(), lane->GetId(), s, 0, j);
 
                     // [X1, Y1] = closest position with given (-) tolerance
-                    if (k < number_of_lanes)
-                    {
-                        pos_tmp.SetLanePos(road->GetId(), lane->GetId(), MAX(s - OSI_TANGENT_LINE_TOLERANCE, 0), 0, j);
-                    }
-                    else
-                    {
-                        pos_tmp.SetTrackPos(road->GetId(), MAX(s - OSI_TANGENT_LINE_TOLERANCE, 0), 0.0);
-                    }
+                    pos_tmp.SetLaneBoundaryPos(road->GetId(), lane->GetId(), MAX(s - OSI_TANGENT_LINE_TOLERANCE, 0), 0, j);
                     x1.push_back(pos_tmp.GetX());
                     y1.push_back(pos_tmp.GetY());
 
@@ -6893,15 +7360,7 @@ void OpenDrive::SetLaneOSIPoints()
                     y1.push_back(pos_candidate.GetY());
 
                     // [X1, Y1] = closest position with given (+) tolerance
-                    if (k < number_of_lanes)
-                    {
-                        pos_tmp.SetLanePos(road->GetId(), lane->GetId(), MIN(s + OSI_TANGENT_LINE_TOLERANCE, lsec_end), 0, j);
-                    }
-                    else
-                    {
-                        pos_tmp.SetTrackPos(road->GetId(), MIN(s + OSI_TANGENT_LINE_TOLERANCE, lsec_end), 0.0);
-                    }
-
+                    pos_tmp.SetLaneBoundaryPos(road->GetId(), lane->GetId(), MIN(s + OSI_TANGENT_LINE_TOLERANCE, lsec_end), 0, j);
                     x1.push_back(pos_tmp.GetX());
                     y1.push_back(pos_tmp.GetY());
 
@@ -6927,18 +7386,12 @@ void OpenDrive::SetLaneOSIPoints()
                     }
                 }
 
-                if (k < number_of_lanes)
-                {
-                    // Set all collected osi points for the current lane
-                    lane->osi_points_.Set(osi_point);
-                    lane->SetOSIIntersection(osiintersection);
-                }
-                else
-                {
-                    // Set collected osi points for the reference line
-                    lsec->GetRefLineOSIPoints().Set(osi_point);
-                }
-
+                // Initialization of LaneBoundary class
+                LaneBoundaryOSI* lb = new LaneBoundaryOSI(0);
+                // Fills up the osi points in the lane boundary class
+                lb->osi_points_.Set(osi_point);
+                // added to the lane class later, generating the global id in road order
+                lane_boundaries.push_back({lane, lb});
                 // Clear osi collectors for next iteration
                 osi_point.clear();
             }
@@ -6946,15 +7399,19 @@ void OpenDrive::SetLaneOSIPoints()
     }
 }
 
-void OpenDrive::SetLaneBoundaryPoints()
+void OpenDrive::SetRoadMarkOSIPoints(Road* road)
 {
     // Initialization
-    Position                 pos_pivot, pos_tmp, pos_candidate, pos_last_ok;
-    Road*                    road;
-    LaneSection*             lsec;
-    Lane*                    lane;
-    unsigned int             number_of_lane_sections, number_of_lanes;
-    double                   lsec_end;
+    Position              pos_pivot, pos_tmp, pos_candidate, pos_last_ok;
+    LaneSection*          lsec;
+    Lane*                 lane;
+    LaneRoadMark*         lane_roadMark;
+    LaneRoadMarkType*     lane_roadMarkType;
+    LaneRoadMarkTypeLine* lane_roadMarkTypeLine;
+
+    unsigned int             number_of_lane_sections, number_of_lanes, number_of_roadmarks, number_of_roadmarktypes, number_of_roadmarklines;
+    double                   lsec_end, s_roadmark, s_end_roadmark, s_end_roadmarkline;
+    std::vector<double>      x0, y0, x1, y1;
     std::vector<PointStruct> osi_point;
     bool                     osi_requirement;
 
@@ -6962,406 +7419,809 @@ void OpenDrive::SetLaneBoundaryPoints()
     pos_tmp.SetMode(Position::PosModeType::SET, Position::PosMode::H_REL);
     pos_candidate.SetMode(Position::PosModeType::SET, Position::PosMode::H_REL);
 
-    // Looping through each road
-    for (unsigned int i = 0; i < road_.size(); i++)
+    // Looping through each lane section
+    number_of_lane_sections = road->GetNumberOfLaneSections();
+    for (unsigned int j = 0; j < number_of_lane_sections; j++)
     {
-        road = road_[i];
+        // Get the ending position of the current lane section
+        lsec = road->GetLaneSectionByIdx(j);
+        if (j == number_of_lane_sections - 1)
+        {
+            lsec_end = road->GetLength();
+        }
+        else
+        {
+            lsec_end = road->GetLaneSectionByIdx(j + 1)->GetS();
+        }
 
-        // Looping through each lane section
-        number_of_lane_sections = road_[i]->GetNumberOfLaneSections();
-        for (unsigned int j = 0; j < number_of_lane_sections; j++)
+        // Looping through each lane
+        number_of_lanes = lsec->GetNumberOfLanes();
+        for (unsigned int k = 0; k < number_of_lanes; k++)
         {
-            // Get the ending position of the current lane section
-            lsec = road->GetLaneSectionByIdx(j);
-            if (j == number_of_lane_sections - 1)
-            {
-                lsec_end = road->GetLength();
-            }
-            else
-            {
-                lsec_end = road->GetLaneSectionByIdx(j + 1)->GetS();
-            }
+            lane = lsec->GetLaneByIdx(k);
 
-            // Looping through each lane
-            number_of_lanes = lsec->GetNumberOfLanes();
-            for (unsigned int k = 0; k < number_of_lanes; k++)
+            // Looping through each roadMark within the lane
+            number_of_roadmarks = lane->GetNumberOfRoadMarks();
+            if (number_of_roadmarks != 0)
             {
-                lane                     = lsec->GetLaneByIdx(k);
-                unsigned int n_roadmarks = lane->GetNumberOfRoadMarks();
-
-                if (n_roadmarks == 0)
+                for (unsigned int m = 0; m < number_of_roadmarks; m++)
                 {
-                    std::vector<double> x0, y0, x1, y1;
+                    lane_roadMark = lane->GetLaneRoadMarkByIdx(m);
+                    s_roadmark    = lsec->GetS() + lane_roadMark->GetSOffset();
+                    if (m == number_of_roadmarks - 1)
+                    {
+                        s_end_roadmark = MAX(0, lsec_end - SMALL_NUMBER);
+                    }
+                    else
+                    {
+                        s_end_roadmark = MAX(0, lsec->GetS() + lane->GetLaneRoadMarkByIdx(m + 1)->GetSOffset() - SMALL_NUMBER);
+                    }
+
+                    // create point and lines for the road marks
+                    number_of_roadmarktypes = lane_roadMark->GetNumberOfRoadMarkTypes();
+                    if (number_of_roadmarktypes != 0)
+                    {
+                        lane_roadMarkType       = lane_roadMark->GetLaneRoadMarkTypeByIdx(0);
+                        number_of_roadmarklines = lane_roadMarkType->GetNumberOfRoadMarkTypeLines();
+
+                        // Looping through each roadmark line under roadmark
+                        for (unsigned int n = 0; n < number_of_roadmarklines; n++)
+                        {
+                            lane_roadMarkTypeLine = lane_roadMarkType->GetLaneRoadMarkTypeLineByIdx(n);
+                            if (lane_roadMarkTypeLine != 0)
+                            {
+                                double s_roadmark_point = s_roadmark + lane_roadMarkTypeLine->GetSOffset();
+
+                                if (lane_roadMark->GetType() == LaneRoadMark::RoadMarkType::BOTTS_DOTS)
+                                {
+                                    // Setting OSI points for each dot
+                                    while (true)
+                                    {
+                                        pos_candidate.SetRoadMarkPos(road->GetId(), lane->GetId(), m, 0, n, s_roadmark_point, 0, j);
+                                        PointStruct p = {s_roadmark_point,
+                                                         pos_candidate.GetX(),
+                                                         pos_candidate.GetY(),
+                                                         pos_candidate.GetZ(),
+                                                         pos_candidate.GetHRoad(),
+                                                         true};
+                                        osi_point.push_back(p);
+
+                                        s_roadmark_point += lane_roadMarkTypeLine->GetSpace();
+                                        if (s_roadmark_point < SMALL_NUMBER || s_roadmark_point > s_end_roadmark - SMALL_NUMBER)
+                                        {
+                                            if (s_roadmark_point < SMALL_NUMBER)
+                                            {
+                                                LOG_WARN("Roadmark length + space = 0 - ignoring");
+                                            }
+                                            break;
+                                        }
+                                    }
+                                }
+                                else
+                                {
+                                    int counter = 0;
+
+                                    // create one line at a time for dashed markings, or complete line segment for solid marking
+                                    while (s_roadmark_point < s_end_roadmark - SMALL_NUMBER)
+                                    {
+                                        // [XO, YO] = Real position with no tolerance
+                                        x0.clear();
+                                        y0.clear();
+                                        x1.clear();
+                                        y1.clear();
+
+                                        pos_pivot.SetRoadMarkPos(road->GetId(), lane->GetId(), m, 0, n, s_roadmark_point, 0, j);
+                                        pos_last_ok = pos_pivot;
+
+                                        // Add the starting point of each lane as osi point
+                                        PointStruct p =
+                                            {s_roadmark_point, pos_pivot.GetX(), pos_pivot.GetY(), pos_pivot.GetZ(), pos_pivot.GetHRoad(), false};
+                                        osi_point.push_back(p);
+
+                                        // [XO, YO] = closest position with given (-) tolerance
+                                        pos_tmp.SetRoadMarkPos(road->GetId(),
+                                                               lane->GetId(),
+                                                               m,
+                                                               0,
+                                                               n,
+                                                               MAX(0, s_roadmark_point - OSI_TANGENT_LINE_TOLERANCE),
+                                                               0,
+                                                               j);
+                                        x0.push_back(pos_tmp.GetX());
+                                        y0.push_back(pos_tmp.GetY());
+
+                                        // Push real position between the +/- tolerance points
+                                        x0.push_back(pos_pivot.GetX());
+                                        y0.push_back(pos_pivot.GetY());
+
+                                        // [XO, YO] = closest position with given (+) tolerance
+                                        pos_tmp.SetRoadMarkPos(road->GetId(),
+                                                               lane->GetId(),
+                                                               m,
+                                                               0,
+                                                               n,
+                                                               MIN(s_roadmark_point + OSI_TANGENT_LINE_TOLERANCE, s_end_roadmark),
+                                                               0,
+                                                               j);
+                                        x0.push_back(pos_tmp.GetX());
+                                        y0.push_back(pos_tmp.GetY());
+
+                                        bool   insert = false;
+                                        double step   = MIN(OSI_POINT_CALC_STEPSIZE, lsec->GetLength());
+
+                                        pos_candidate = pos_pivot;
+
+                                        // Make sure we stay within lane section length
+                                        if (lane_roadMarkTypeLine->GetSpace() > SMALL_NUMBER || lane_roadMarkTypeLine->GetRepeat() == false)
+                                        {
+                                            s_end_roadmarkline =
+                                                MIN(s_end_roadmark - SMALL_NUMBER / 2.0, s_roadmark_point + lane_roadMarkTypeLine->GetLength());
+                                        }
+                                        else
+                                        {
+                                            s_end_roadmarkline = s_end_roadmark - SMALL_NUMBER / 2.0;
+                                        }
+
+                                        double s = s_roadmark_point;
+                                        while (++counter)
+                                        {
+                                            // [X1, Y1] = Real position with no tolerance
+                                            s = MIN(pos_candidate.GetS() + step, s_end_roadmarkline - SMALL_NUMBER / 2);
+
+                                            pos_candidate.SetRoadMarkPos(road->GetId(), lane->GetId(), m, 0, n, s, 0, j);
+
+                                            // [X1, Y1] = closest position with given (-) tolerance
+                                            pos_tmp.SetRoadMarkPos(road->GetId(),
+                                                                   lane->GetId(),
+                                                                   m,
+                                                                   0,
+                                                                   n,
+                                                                   MAX(0, s - OSI_TANGENT_LINE_TOLERANCE),
+                                                                   0,
+                                                                   j);
+                                            x1.push_back(pos_tmp.GetX());
+                                            y1.push_back(pos_tmp.GetY());
+
+                                            x1.push_back(pos_candidate.GetX());
+                                            y1.push_back(pos_candidate.GetY());
+
+                                            // [X1, Y1] = closest position with given (+) tolerance
+                                            pos_tmp.SetRoadMarkPos(road->GetId(),
+                                                                   lane->GetId(),
+                                                                   m,
+                                                                   0,
+                                                                   n,
+                                                                   MIN(s + OSI_TANGENT_LINE_TOLERANCE, road->GetLength()),
+                                                                   0,
+                                                                   j);
+                                            x1.push_back(pos_tmp.GetX());
+                                            y1.push_back(pos_tmp.GetY());
+
+                                            // Make sure we stay within lane section length
+                                            int add_point_status = CheckAndAddOSIPoint(pos_pivot,
+                                                                                       pos_candidate,
+                                                                                       pos_last_ok,
+                                                                                       x0,
+                                                                                       y0,
+                                                                                       x1,
+                                                                                       y1,
+                                                                                       step,
+                                                                                       osi_requirement,
+                                                                                       osi_point,
+                                                                                       insert,
+                                                                                       s_end_roadmarkline);
+                                            if (add_point_status == 2)
+                                            {
+                                                break;
+                                            }
+                                            else if (add_point_status == 1)
+                                            {
+                                                pos_candidate = pos_pivot;
+                                            }
+                                        }
+
+                                        if (s > s_end_roadmarkline - SMALL_NUMBER || lane_roadMarkTypeLine->GetRepeat() == false)
+                                        {
+                                            osi_point.back().endpoint = true;
+
+                                            if (lane_roadMarkTypeLine->GetRepeat() == false)
+                                            {
+                                                break;
+                                            }
+                                        }
 
-                    lane                 = lsec->GetLaneByIdx(k);
-                    unsigned int counter = 0;
+                                        s_roadmark_point = MIN(s_end_roadmark, s_end_roadmarkline + lane_roadMarkTypeLine->GetSpace());
+                                    }
+                                }
+
+                                // Set all collected osi points for the current lane rpadmarkline
+                                lane_roadMarkTypeLine->osi_points_.Set(osi_point);
 
-                    // [XO, YO] = Real position with no tolerance
-                    if (pos_pivot.SetLaneBoundaryPos(road->GetId(), lane->GetId(), lsec->GetS(), 0, j) != Position::ReturnCode::OK)
+                                // Clear osi collectors for roadmarks for next iteration
+                                osi_point.clear();
+                            }
+                            else
+                            {
+                                LOG_ERROR("LaneRoadMarkTypeLine {} for LaneRoadMarkType for LaneRoadMark {} for lane {} is not defined",
+                                          n,
+                                          m,
+                                          lane->GetId());
+                            }
+                        }
+                    }
+                    else
                     {
-                        break;
+                        LOG_ERROR("Unexpected missing roadmark type or explicit element!");
                     }
+                }
+            }
+        }
+    }
+}
 
-                    // Add the starting point of each lane as osi point
-                    PointStruct p = {lsec->GetS(), pos_pivot.GetX(), pos_pivot.GetY(), pos_pivot.GetZ(), pos_pivot.GetHRoad(), false};
-                    osi_point.push_back(p);
-                    pos_last_ok = pos_pivot;
+void OpenDrive::GenerateOSIPoints()
+{
+    std::vector<std::vector<std::pair<Lane*, LaneBoundaryOSI*>>> lane_boundaries(road_.size());
 
-                    // [XO, YO] = closest position with given (-) tolerance
-                    pos_tmp.SetLaneBoundaryPos(road->GetId(), lane->GetId(), MAX(0, lsec->GetS() - OSI_TANGENT_LINE_TOLERANCE), 0, j);
-                    x0.push_back(pos_tmp.GetX());
-                    y0.push_back(pos_tmp.GetY());
+    unsigned int n_threads = MIN(std::thread::hardware_concurrency(), static_cast<unsigned int>(road_.size() / OSI_ROADS_PER_THREAD));
 
-                    // Push real position between the +/- tolerance points
-                    x0.push_back(pos_pivot.GetX());
-                    y0.push_back(pos_pivot.GetY());
+    if (n_threads > 1)
+    {
+        // Roads are independent of each other. Workers need the road network and OSI tolerances of calling thread.
+        SE_Env*       env = &SE_Env::Inst();
+        SE_ThreadPool pool(n_threads);
 
-                    // [XO, YO] = closest position with given (+) tolerance
-                    pos_tmp.SetLaneBoundaryPos(road->GetId(), lane->GetId(), MIN(lsec->GetS() + OSI_TANGENT_LINE_TOLERANCE, lsec_end), 0, j);
-                    x0.push_back(pos_tmp.GetX());
-                    y0.push_back(pos_tmp.GetY());
+        pool.Run(road_.size(),
+                 [&](size_t i)
+                 {
+                     SE_Env::SetThreadInst(env);
+                     Position::SetThreadOpenDrive(this);
 
-                    bool   insert = false;
-                    double step   = MIN(OSI_POINT_CALC_STEPSIZE, lsec->GetLength());
+                     SetLaneOSIPoints(road_[i]);
+                     SetRoadMarkOSIPoints(road_[i]);
+                     SetLaneBoundaryPoints(road_[i], lane_boundaries[i]);
+                 });
+    }
+    else
+    {
+        for (size_t i = 0; i < road_.size(); i++)
+        {
+            SetLaneOSIPoints(road_[i]);
+            SetRoadMarkOSIPoints(road_[i]);
+            SetLaneBoundaryPoints(road_[i], lane_boundaries[i]);
+        }
+    }
 
-                    pos_candidate = pos_pivot;
+    // Global IDs of lane boundaries assigned in road order
+    for (auto& road_lane_boundaries : lane_boundaries)
+    {
+        for (auto& lane_boundary : road_lane_boundaries)
+        {
+            lane_boundary.first->SetLaneBoundary(lane_boundary.second);
+        }
+    }
+}
+
+static uint64_t HashFNV1a(const void* data, size_t size, uint64_t hash)
+{
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+
+    for (size_t i = 0; i < size; i++)
+    {
+        hash = (hash ^ bytes[i]) * 1099511628211ULL;
+    }
+
+    return hash;
+}
+
+uint64_t OpenDrive::GetOSIPointsCacheKey() const
+{
+    std::ifstream file(odr_filename_, std::ios::binary | std::ios::ate);
+    if (!file.good())
+    {
+        return 0;
+    }
+
+    std::vector<char> content(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    if (!file.read(content.data(), static_cast<std::streamsize>(content.size())))
+    {
+        return 0;
+    }
+
+    uint32_t version      = OSI_CACHE_VERSION;
+    double   tolerance[2] = {SE_Env::Inst().GetOSIMaxLongitudinalDistance(), SE_Env::Inst().GetOSIMaxLateralDeviation()};
+
+    uint64_t key = HashFNV1a(content.data(), content.size(), 14695981039346656037ULL);
+    key          = HashFNV1a(&version, sizeof(version), key);
+    key          = HashFNV1a(tolerance, sizeof(tolerance), key);
+
+    return key;
+}
+
+static void WriteOSIPoints(std::ofstream& file, const std::vector<PointStruct>& points)
+{
+    uint64_t n = points.size();
+    file.write(reinterpret_cast<const char*>(&n), sizeof(n));
+
+    for (const auto& p : points)
+    {
+        double        values[5] = {p.s, p.x, p.y, p.z, p.h};
+        unsigned char endpoint  = p.endpoint ? 1 : 0;
+        file.write(reinterpret_cast<const char*>(values), sizeof(values));
+        file.write(reinterpret_cast<const char*>(&endpoint), sizeof(endpoint));
+    }
+}
+
+template <class T>
+static bool ReadBinValue(std::string_view buf, size_t& pos, T& value)
+{
+    if (buf.size() - pos < sizeof(T))
+    {
+        return false;
+    }
+    memcpy(&value, buf.data() + pos, sizeof(T));
+    pos += sizeof(T);
+    return true;
+}
+
+static bool ReadOSIPoints(std::string_view buf, size_t& pos, std::vector<PointStruct>& points)
+{
+    const size_t point_size = 5 * sizeof(double) + 1;
+    uint64_t     n          = 0;
+
+    if (!ReadBinValue(buf, pos, n) || n > (buf.size() - pos) / point_size)
+    {
+        return false;
+    }
+
+    points.resize(n);
+    for (auto& p : points)
+    {
+        double values[5];
+        memcpy(values, buf.data() + pos, sizeof(values));
+        p        = {values[0], values[1], values[2], values[3], values[4], buf[pos + sizeof(values)] == 1};
+        pos     += point_size;
+    }
+
+    return true;
+}
 
-                    // Looping through sequential points along the track determined by "OSI_POINT_CALC_STEPSIZE"
-                    while (++counter)
+int OpenDrive::SaveOSIPoints(const std::string& filename, uint64_t key)
+{
+    // Write to a temporary file first, in case another process is reading or writing the same cache entry
+    std::string tmp_filename = filename + "." + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+
+    std::ofstream file(tmp_filename, std::ios::binary);
+    if (!file.good())
+    {
+        LOG_WARN("Failed to create OSI point cache file {}", tmp_filename);
+        return -1;
+    }
+
+    uint32_t version = OSI_CACHE_VERSION;
+    uint64_t n_roads = road_.size();
+    file.write(reinterpret_cast<const char*>(&version), sizeof(version));
+    file.write(reinterpret_cast<const char*>(&key), sizeof(key));
+    file.write(reinterpret_cast<const char*>(&n_roads), sizeof(n_roads));
+
+    for (auto road : road_)
+    {
+        for (unsigned int i = 0; i < road->GetNumberOfLaneSections(); i++)
+        {
+            LaneSection* lsec = road->GetLaneSectionByIdx(i);
+
+            for (unsigned int j = 0; j < lsec->GetNumberOfLanes(); j++)
+            {
+                Lane* lane            = lsec->GetLaneByIdx(j);
+                id_t  osiintersection = lane->GetOSIIntersectionId();
+                file.write(reinterpret_cast<const char*>(&osiintersection), sizeof(osiintersection));
+                WriteOSIPoints(file, lane->osi_points_.GetPoints());
+
+                // points are generated for lines of first road mark type only, see SetRoadMarkOSIPoints()
+                for (unsigned int k = 0; k < lane->GetNumberOfRoadMarks(); k++)
+                {
+                    LaneRoadMark* roadmark = lane->GetLaneRoadMarkByIdx(k);
+                    if (roadmark->GetNumberOfRoadMarkTypes() > 0)
                     {
-                        // Make sure we stay within lane section length
-                        double s = MIN(pos_candidate.GetS() + step, lsec_end - SMALL_NUMBER / 2);
-
-                        // [X1, Y1] = Real position with no tolerance
-                        pos_candidate.SetLaneBoundaryPos(road->GetId(), lane->GetId(), s, 0, j);
-
-                        // [X1, Y1] = closest position with given (-) tolerance
-                        pos_tmp.SetLaneBoundaryPos(road->GetId(), lane->GetId(), MAX(s - OSI_TANGENT_LINE_TOLERANCE, 0), 0, j);
-                        x1.push_back(pos_tmp.GetX());
-                        y1.push_back(pos_tmp.GetY());
-
-                        x1.push_back(pos_candidate.GetX());
-                        y1.push_back(pos_candidate.GetY());
-
-                        // [X1, Y1] = closest position with given (+) tolerance
-                        pos_tmp.SetLaneBoundaryPos(road->GetId(), lane->GetId(), MIN(s + OSI_TANGENT_LINE_TOLERANCE, lsec_end), 0, j);
-                        x1.push_back(pos_tmp.GetX());
-                        y1.push_back(pos_tmp.GetY());
-
-                        int add_point_status = CheckAndAddOSIPoint(pos_pivot,
-                                                                   pos_candidate,
-                                                                   pos_last_ok,
-                                                                   x0,
-                                                                   y0,
-                                                                   x1,
-                                                                   y1,
-                                                                   step,
-                                                                   osi_requirement,
-                                                                   osi_point,
-                                                                   insert,
-                                                                   lsec_end);
-                        if (add_point_status == 2)
+                        LaneRoadMarkType* type = roadmark->GetLaneRoadMarkTypeByIdx(0);
+                        for (unsigned int l = 0; l < type->GetNumberOfRoadMarkTypeLines(); l++)
                         {
-                            break;
+                            if (type->GetLaneRoadMarkTypeLineByIdx(l) != nullptr)
+                            {
+                                WriteOSIPoints(file, type->GetLaneRoadMarkTypeLineByIdx(l)->osi_points_.GetPoints());
+                            }
                         }
-                        else if (add_point_status == 1)
+                    }
+                }
+
+                unsigned char lane_boundary = lane->GetLaneBoundary() != nullptr ? 1 : 0;
+                file.write(reinterpret_cast<const char*>(&lane_boundary), sizeof(lane_boundary));
+                if (lane_boundary)
+                {
+                    WriteOSIPoints(file, lane->GetLaneBoundary()->osi_points_.GetPoints());
+                }
+            }
+
+            WriteOSIPoints(file, lsec->GetRefLineOSIPoints().GetPoints());
+        }
+    }
+
+    // end marker, detecting truncated files
+    file.write(reinterpret_cast<const char*>(&key), sizeof(key));
+    file.close();
+
+    if (file.fail() || std::rename(tmp_filename.c_str(), filename.c_str()) != 0)
+    {
+        LOG_WARN("Failed to write OSI point cache file {}", filename);
+        std::remove(tmp_filename.c_str());
+        return -1;
+    }
+
+    return 0;
+}
+
+int OpenDrive::LoadOSIPoints(const std::string& filename, uint64_t key)
+{
+    // Map whole file into memory and parse from there
+    SE_MappedFile file;
+    if (file.Open(filename) != 0)
+    {
+        return -1;
+    }
+
+    std::string_view buf(reinterpret_cast<const char*>(file.GetData()), file.GetSize());
+    size_t           pos      = 0;
+    uint32_t         version  = 0;
+    uint64_t         file_key = 0;
+    uint64_t         n_roads  = 0;
+
+    if (!ReadBinValue(buf, pos, version) || !ReadBinValue(buf, pos, file_key) || !ReadBinValue(buf, pos, n_roads) ||
+        version != OSI_CACHE_VERSION || file_key != key || n_roads != road_.size())
+    {
+        LOG_WARN("OSI point cache file {} not matching road network, ignoring it", filename);
+        return -1;
+    }
+
+    // Points are parsed into temporaries and applied only when the whole file has been validated, making sure a failure leaves no trace
+    std::vector<std::pair<OSIPoints*, std::vector<PointStruct>>> loaded_points;
+    std::vector<std::pair<Lane*, id_t>>                          osi_intersections;
+    std::vector<std::pair<Lane*, LaneBoundaryOSI*>>              lane_boundaries;
+    std::vector<PointStruct>                                     points;
+    bool                                                         ok = true;
+
+    for (size_t r = 0; r < road_.size() && ok; r++)
+    {
+        Road* road = road_[r];
+
+        for (unsigned int i = 0; i < road->GetNumberOfLaneSections() && ok; i++)
+        {
+            LaneSection* lsec = road->GetLaneSectionByIdx(i);
+
+            for (unsigned int j = 0; j < lsec->GetNumberOfLanes() && ok; j++)
+            {
+                Lane* lane            = lsec->GetLaneByIdx(j);
+                id_t  osiintersection = ID_UNDEFINED;
+                ok                    = ReadBinValue(buf, pos, osiintersection) && ReadOSIPoints(buf, pos, points);
+                loaded_points.push_back({&lane->osi_points_, points});
+                osi_intersections.push_back({lane, osiintersection});
+
+                for (unsigned int k = 0; k < lane->GetNumberOfRoadMarks() && ok; k++)
+                {
+                    LaneRoadMark* roadmark = lane->GetLaneRoadMarkByIdx(k);
+                    if (roadmark->GetNumberOfRoadMarkTypes() > 0)
+                    {
+                        LaneRoadMarkType* type = roadmark->GetLaneRoadMarkTypeByIdx(0);
+                        for (unsigned int l = 0; l < type->GetNumberOfRoadMarkTypeLines() && ok; l++)
                         {
-                            pos_candidate = pos_pivot;
+                            if (type->GetLaneRoadMarkTypeLineByIdx(l) != nullptr)
+                            {
+                                ok = ReadOSIPoints(buf, pos, points);
+                                loaded_points.push_back({&type->GetLaneRoadMarkTypeLineByIdx(l)->osi_points_, points});
+                            }
                         }
                     }
+                }
+
+                unsigned char lane_boundary = 0;
+                ok                          = ok && ReadBinValue(buf, pos, lane_boundary);
+                if (ok && lane_boundary)
+                {
+                    ok                  = ReadOSIPoints(buf, pos, points);
+                    LaneBoundaryOSI* lb = new LaneBoundaryOSI(0);
+                    lb->osi_points_.Set(points);
+                    lane_boundaries.push_back({lane, lb});
+                }
+            }
+
+            ok = ok && ReadOSIPoints(buf, pos, points);
+            loaded_points.push_back({&lsec->GetRefLineOSIPoints(), points});
+        }
+    }
+
+    uint64_t end_key = 0;
+    if (!ok || !ReadBinValue(buf, pos, end_key) || end_key != key || pos != buf.size())
+    {
+        LOG_WARN("OSI point cache file {} corrupt, ignoring it", filename);
+        for (auto& lane_boundary : lane_boundaries)
+        {
+            delete lane_boundary.second;
+        }
+        return -1;
+    }
+
+    for (auto& loaded : loaded_points)
+    {
+        loaded.first->Set(std::move(loaded.second));
+    }
+
+    for (auto& osi_intersection : osi_intersections)
+    {
+        osi_intersection.first->SetOSIIntersection(osi_intersection.second);
+    }
+
+    for (auto& lane_boundary : lane_boundaries)
+    {
+        lane_boundary.first->SetLaneBoundary(lane_boundary.second);
+    }
+
+    return 0;
+}
+
+std::string OpenDrive::GetPrecompiledFilename(const std::string& odr_filename)
+{
+    return FilePathWithoutExtOf(odr_filename) + ".odrbin";
+}
+
+bool OpenDrive::SetRoadOSI()
+{
+    if (this == Position::GetOpenDrive())
+    {
+        std::string bin_file  = GetPrecompiledFilename(odr_filename_);
+        std::string cache_dir = SE_Env::Inst().GetOSIPointsCacheDir();
+        std::string cache_file;
+        uint64_t    key    = 0;
+        bool        loaded = false;
+
+        if (FileExists(bin_file.c_str()) || !cache_dir.empty())
+        {
+            key = GetOSIPointsCacheKey();
+        }
+
+        if (key != 0 && !cache_dir.empty())
+        {
+            char key_str[32];
+            snprintf(key_str, sizeof(key_str), "_%016" PRIx64 ".osip", key);
+            cache_file = CombineDirectoryPathAndFilepath(cache_dir, FileNameWithoutExtOf(odr_filename_) + key_str);
+        }
 
-                    // Initialization of LaneBoundary class
-                    LaneBoundaryOSI* lb = new LaneBoundaryOSI(0);
-                    // add the lane boundary class to the lane class and generating the global id
-                    lane->SetLaneBoundary(lb);
-                    // Fills up the osi points in the lane boundary class
-                    lb->osi_points_.Set(osi_point);
-                    // Clear osi collectors for next iteration
-                    osi_point.clear();
-                }
+        if (key != 0)
+        {
+            // precompiled file, created by odr2bin, has precedence over the cache
+            loaded = (FileExists(bin_file.c_str()) && LoadOSIPoints(bin_file, key) == 0) ||
+                     (!cache_file.empty() && LoadOSIPoints(cache_file, key) == 0);
+        }
+
+        if (!loaded)
+        {
+            GenerateOSIPoints();
+
+            if (!cache_file.empty())
+            {
+                SaveOSIPoints(cache_file, key);
             }
         }
+
+        road_grid_.Build(road_);
+        return true;
     }
+
+    return false;
 }
 
-void OpenDrive::SetRoadMarkOSIPoints()
+void RoadGrid::Clear()
 {
-    // Initialization
-    Position              pos_pivot, pos_tmp, pos_candidate, pos_last_ok;
-    Road*                 road;
-    LaneSection*          lsec;
-    Lane*                 lane;
-    LaneRoadMark*         lane_roadMark;
-    LaneRoadMarkType*     lane_roadMarkType;
-    LaneRoadMarkTypeLine* lane_roadMarkTypeLine;
+    x_min_     = 0.0;
+    y_min_     = 0.0;
+    cell_size_ = 0.0;
+    n_cols_    = 0;
+    n_rows_    = 0;
+    cell_start_.clear();
+    road_idx_.clear();
+}
 
-    unsigned int             number_of_lane_sections, number_of_lanes, number_of_roadmarks, number_of_roadmarktypes, number_of_roadmarklines;
-    double                   lsec_end, s_roadmark, s_end_roadmark, s_end_roadmarkline;
-    std::vector<double>      x0, y0, x1, y1;
-    std::vector<PointStruct> osi_point;
-    bool                     osi_requirement;
+void RoadGrid::Build(const std::vector<Road*>& roads)
+{
+    typedef struct
+    {
+        idx_t  road_idx;
+        double x_min;
+        double y_min;
+        double x_max;
+        double y_max;
+    } SegmentBox;
 
-    pos_pivot.SetMode(Position::PosModeType::SET, Position::PosMode::H_REL);
-    pos_tmp.SetMode(Position::PosModeType::SET, Position::PosMode::H_REL);
-    pos_candidate.SetMode(Position::PosModeType::SET, Position::PosMode::H_REL);
+    std::vector<SegmentBox> boxes;
+    double                  x_min = INFINITY, y_min = INFINITY, x_max = -INFINITY, y_max = -INFINITY;
+    unsigned int            n_roads = 0;
 
-    // Looping through each road
-    for (unsigned int i = 0; i < road_.size(); i++)
+    Clear();
+
+    // Collect bounding boxes of all reference line segments, padded by the widest side of the road
+    for (idx_t i = 0; i < roads.size(); i++)
     {
-        road = road_[i];
+        Road*        road      = roads[i];
+        PointStruct* prev      = nullptr;
+        double       prev_w    = 0.0;
+        size_t       n_boxes_0 = boxes.size();
 
-        // Looping through each lane section
-        number_of_lane_sections = road_[i]->GetNumberOfLaneSections();
-        for (unsigned int j = 0; j < number_of_lane_sections; j++)
+        if (road->GetNumberOfGeometries() == 0)
         {
-            // Get the ending position of the current lane section
-            lsec = road->GetLaneSectionByIdx(j);
-            if (j == number_of_lane_sections - 1)
-            {
-                lsec_end = road->GetLength();
-            }
-            else
+            continue;
+        }
+
+        for (unsigned int j = 0; j < road->GetNumberOfLaneSections(); j++)
+        {
+            Lane* lane = road->GetLaneSectionByIdx(j)->GetLaneById(0);
+            if (lane == nullptr)
             {
-                lsec_end = road->GetLaneSectionByIdx(j + 1)->GetS();
+                continue;
             }
 
-            // Looping through each lane
-            number_of_lanes = lsec->GetNumberOfLanes();
-            for (unsigned int k = 0; k < number_of_lanes; k++)
+            for (unsigned int k = 0; k < lane->GetOSIPoints()->GetNumOfOSIPoints(); k++)
             {
-                lane = lsec->GetLaneByIdx(k);
+                PointStruct& p       = lane->GetOSIPoints()->GetPoint(k);
+                double       w_left  = road->GetWidth(p.s, 1, ~Lane::LaneType::LANE_TYPE_NONE);
+                double       w_right = road->GetWidth(p.s, -1, ~Lane::LaneType::LANE_TYPE_NONE);
+                double       w       = MAX(w_left, w_right);
 
-                // Looping through each roadMark within the lane
-                number_of_roadmarks = lane->GetNumberOfRoadMarks();
-                if (number_of_roadmarks != 0)
+                if (prev == nullptr)
                 {
-                    for (unsigned int m = 0; m < number_of_roadmarks; m++)
-                    {
-                        lane_roadMark = lane->GetLaneRoadMarkByIdx(m);
-                        s_roadmark    = lsec->GetS() + lane_roadMark->GetSOffset();
-                        if (m == number_of_roadmarks - 1)
-                        {
-                            s_end_roadmark = MAX(0, lsec_end - SMALL_NUMBER);
-                        }
-                        else
-                        {
-                            s_end_roadmark = MAX(0, lsec->GetS() + lane->GetLaneRoadMarkByIdx(m + 1)->GetSOffset() - SMALL_NUMBER);
-                        }
-
-                        // create point and lines for the road marks
-                        number_of_roadmarktypes = lane_roadMark->GetNumberOfRoadMarkTypes();
-                        if (number_of_roadmarktypes != 0)
-                        {
-                            lane_roadMarkType       = lane_roadMark->GetLaneRoadMarkTypeByIdx(0);
-                            number_of_roadmarklines = lane_roadMarkType->GetNumberOfRoadMarkTypeLines();
+                    // register first point on its own, in case road consists of one point only
+                    boxes.push_back({i, p.x - w, p.y - w, p.x + w, p.y + w});
+                }
+                else
+                {
+                    double pad = MAX(w, prev_w);
+                    boxes.push_back({i, MIN(prev->x, p.x) - pad, MIN(prev->y, p.y) - pad, MAX(prev->x, p.x) + pad, MAX(prev->y, p.y) + pad});
+                }
+                prev   = &p;
+                prev_w = w;
+            }
+        }
 
-                            // Looping through each roadmark line under roadmark
-                            for (unsigned int n = 0; n < number_of_roadmarklines; n++)
-                            {
-                                lane_roadMarkTypeLine = lane_roadMarkType->GetLaneRoadMarkTypeLineByIdx(n);
-                                if (lane_roadMarkTypeLine != 0)
-                                {
-                                    double s_roadmark_point = s_roadmark + lane_roadMarkTypeLine->GetSOffset();
+        for (size_t j = n_boxes_0; j < boxes.size(); j++)
+        {
+            x_min = MIN(x_min, boxes[j].x_min);
+            y_min = MIN(y_min, boxes[j].y_min);
+            x_max = MAX(x_max, boxes[j].x_max);
+            y_max = MAX(y_max, boxes[j].y_max);
+        }
 
-                                    if (lane_roadMark->GetType() == LaneRoadMark::RoadMarkType::BOTTS_DOTS)
-                                    {
-                                        // Setting OSI points for each dot
-                                        while (true)
-                                        {
-                                            pos_candidate.SetRoadMarkPos(road->GetId(), lane->GetId(), m, 0, n, s_roadmark_point, 0, j);
-                                            PointStruct p = {s_roadmark_point,
-                                                             pos_candidate.GetX(),
-                                                             pos_candidate.GetY(),
-                                                             pos_candidate.GetZ(),
-                                                             pos_candidate.GetHRoad(),
-                                                             true};
-                                            osi_point.push_back(p);
-
-                                            s_roadmark_point += lane_roadMarkTypeLine->GetSpace();
-                                            if (s_roadmark_point < SMALL_NUMBER || s_roadmark_point > s_end_roadmark - SMALL_NUMBER)
-                                            {
-                                                if (s_roadmark_point < SMALL_NUMBER)
-                                                {
-                                                    LOG_WARN("Roadmark length + space = 0 - ignoring");
-                                                }
-                                                break;
-                                            }
-                                        }
-                                    }
-                                    else
-                                    {
-                                        int counter = 0;
+        if (boxes.size() > n_boxes_0)
+        {
+            n_roads++;
+        }
+    }
 
-                                        // create one line at a time for dashed markings, or complete line segment for solid marking
-                                        while (s_roadmark_point < s_end_roadmark - SMALL_NUMBER)
-                                        {
-                                            // [XO, YO] = Real position with no tolerance
-                                            x0.clear();
-                                            y0.clear();
-                                            x1.clear();
-                                            y1.clear();
+    if (boxes.empty())
+    {
+        return;
+    }
 
-                                            pos_pivot.SetRoadMarkPos(road->GetId(), lane->GetId(), m, 0, n, s_roadmark_point, 0, j);
-                                            pos_last_ok = pos_pivot;
+    // Aim for in the order of one road per cell
+    const double min_cell_size = 10.0;
+    cell_size_                 = MAX(min_cell_size, sqrt(MAX(x_max - x_min, 1.0) * MAX(y_max - y_min, 1.0) / n_roads));
+    x_min_                     = x_min;
+    y_min_                     = y_min;
+    n_cols_                    = ColOf(x_max) + 1;
+    n_rows_                    = RowOf(y_max) + 1;
 
-                                            // Add the starting point of each lane as osi point
-                                            PointStruct p =
-                                                {s_roadmark_point, pos_pivot.GetX(), pos_pivot.GetY(), pos_pivot.GetZ(), pos_pivot.GetHRoad(), false};
-                                            osi_point.push_back(p);
+    // Register each road in all cells overlapped by any of its segments
+    std::vector<std::pair<idx_t, idx_t>> cell_road;  // (cell index, road index)
+    for (auto& box : boxes)
+    {
+        for (int row = RowOf(box.y_min); row <= RowOf(box.y_max); row++)
+        {
+            for (int col = ColOf(box.x_min); col <= ColOf(box.x_max); col++)
+            {
+                cell_road.push_back(std::make_pair(static_cast<idx_t>(row * n_cols_ + col), box.road_idx));
+            }
+        }
+    }
+    std::sort(cell_road.begin(), cell_road.end());
+    cell_road.erase(std::unique(cell_road.begin(), cell_road.end()), cell_road.end());
 
-                                            // [XO, YO] = closest position with given (-) tolerance
-                                            pos_tmp.SetRoadMarkPos(road->GetId(),
-                                                                   lane->GetId(),
-                                                                   m,
-                                                                   0,
-                                                                   n,
-                                                                   MAX(0, s_roadmark_point - OSI_TANGENT_LINE_TOLERANCE),
-                                                                   0,
-                                                                   j);
-                                            x0.push_back(pos_tmp.GetX());
-                                            y0.push_back(pos_tmp.GetY());
+    cell_start_.assign(static_cast<size_t>(n_cols_) * static_cast<size_t>(n_rows_) + 1, 0);
+    road_idx_.reserve(cell_road.size());
+    for (auto& entry : cell_road)
+    {
+        cell_start_[entry.first + 1]++;
+        road_idx_.push_back(entry.second);
+    }
+    for (size_t i = 1; i < cell_start_.size(); i++)
+    {
+        cell_start_[i] += cell_start_[i - 1];
+    }
+}
 
-                                            // Push real position between the +/- tolerance points
-                                            x0.push_back(pos_pivot.GetX());
-                                            y0.push_back(pos_pivot.GetY());
+int RoadGrid::GetFirstRing(double x, double y) const
+{
+    if (IsEmpty())
+    {
+        return 0;
+    }
 
-                                            // [XO, YO] = closest position with given (+) tolerance
-                                            pos_tmp.SetRoadMarkPos(road->GetId(),
-                                                                   lane->GetId(),
-                                                                   m,
-                                                                   0,
-                                                                   n,
-                                                                   MIN(s_roadmark_point + OSI_TANGENT_LINE_TOLERANCE, s_end_roadmark),
-                                                                   0,
-                                                                   j);
-                                            x0.push_back(pos_tmp.GetX());
-                                            y0.push_back(pos_tmp.GetY());
+    // clamp to avoid integer overflow for points very far away
+    int col = static_cast<int>(CLAMP((x - x_min_) / cell_size_, -1e8, 1e8));
+    int row = static_cast<int>(CLAMP((y - y_min_) / cell_size_, -1e8, 1e8));
+    int dc  = col < 0 ? -col : (col >= n_cols_ ? col - (n_cols_ - 1) : 0);
+    int dr  = row < 0 ? -row : (row >= n_rows_ ? row - (n_rows_ - 1) : 0);
 
-                                            bool   insert = false;
-                                            double step   = MIN(OSI_POINT_CALC_STEPSIZE, lsec->GetLength());
+    return MAX(dc, dr);
+}
 
-                                            pos_candidate = pos_pivot;
+int RoadGrid::GetLastRing(double x, double y) const
+{
+    if (IsEmpty())
+    {
+        return 0;
+    }
 
-                                            // Make sure we stay within lane section length
-                                            if (lane_roadMarkTypeLine->GetSpace() > SMALL_NUMBER || lane_roadMarkTypeLine->GetRepeat() == false)
-                                            {
-                                                s_end_roadmarkline =
-                                                    MIN(s_end_roadmark - SMALL_NUMBER / 2.0, s_roadmark_point + lane_roadMarkTypeLine->GetLength());
-                                            }
-                                            else
-                                            {
-                                                s_end_roadmarkline = s_end_roadmark - SMALL_NUMBER / 2.0;
-                                            }
+    int col = static_cast<int>(CLAMP((x - x_min_) / cell_size_, -1e8, 1e8));
+    int row = static_cast<int>(CLAMP((y - y_min_) / cell_size_, -1e8, 1e8));
 
-                                            double s = s_roadmark_point;
-                                            while (++counter)
-                                            {
-                                                // [X1, Y1] = Real position with no tolerance
-                                                s = MIN(pos_candidate.GetS() + step, s_end_roadmarkline - SMALL_NUMBER / 2);
-
-                                                pos_candidate.SetRoadMarkPos(road->GetId(), lane->GetId(), m, 0, n, s, 0, j);
-
-                                                // [X1, Y1] = closest position with given (-) tolerance
-                                                pos_tmp.SetRoadMarkPos(road->GetId(),
-                                                                       lane->GetId(),
-                                                                       m,
-                                                                       0,
-                                                                       n,
-                                                                       MAX(0, s - OSI_TANGENT_LINE_TOLERANCE),
-                                                                       0,
-                                                                       j);
-                                                x1.push_back(pos_tmp.GetX());
-                                                y1.push_back(pos_tmp.GetY());
-
-                                                x1.push_back(pos_candidate.GetX());
-                                                y1.push_back(pos_candidate.GetY());
-
-                                                // [X1, Y1] = closest position with given (+) tolerance
-                                                pos_tmp.SetRoadMarkPos(road->GetId(),
-                                                                       lane->GetId(),
-                                                                       m,
-                                                                       0,
-                                                                       n,
-                                                                       MIN(s + OSI_TANGENT_LINE_TOLERANCE, road->GetLength()),
-                                                                       0,
-                                                                       j);
-                                                x1.push_back(pos_tmp.GetX());
-                                                y1.push_back(pos_tmp.GetY());
-
-                                                // Make sure we stay within lane section length
-                                                int add_point_status = CheckAndAddOSIPoint(pos_pivot,
-                                                                                           pos_candidate,
-                                                                                           pos_last_ok,
-                                                                                           x0,
-                                                                                           y0,
-                                                                                           x1,
-                                                                                           y1,
-                                                                                           step,
-                                                                                           osi_requirement,
-                                                                                           osi_point,
-                                                                                           insert,
-                                                                                           s_end_roadmarkline);
-                                                if (add_point_status == 2)
-                                                {
-                                                    break;
-                                                }
-                                                else if (add_point_status == 1)
-                                                {
-                                                    pos_candidate = pos_pivot;
-                                                }
-                                            }
+    return MAX(MAX(abs(col), abs(n_cols_ - 1 - col)), MAX(abs(row), abs(n_rows_ - 1 - row)));
+}
 
-                                            if (s > s_end_roadmarkline - SMALL_NUMBER || lane_roadMarkTypeLine->GetRepeat() == false)
-                                            {
-                                                osi_point.back().endpoint = true;
+void RoadGrid::GetRoadsInRing(double x, double y, int ring, std::vector<idx_t>& roads) const
+{
+    if (IsEmpty() || ring < 0)
+    {
+        return;
+    }
 
-                                                if (lane_roadMarkTypeLine->GetRepeat() == false)
-                                                {
-                                                    break;
-                                                }
-                                            }
+    int col = static_cast<int>(CLAMP((x - x_min_) / cell_size_, -1e8, 1e8));
+    int row = static_cast<int>(CLAMP((y - y_min_) / cell_size_, -1e8, 1e8));
 
-                                            s_roadmark_point = MIN(s_end_roadmark, s_end_roadmarkline + lane_roadMarkTypeLine->GetSpace());
-                                        }
-                                    }
+    auto add_cell = [&](int c, int r)
+    {
+        idx_t cell = static_cast<idx_t>(r * n_cols_ + c);
+        roads.insert(roads.end(), road_idx_.begin() + cell_start_[cell], road_idx_.begin() + cell_start_[cell + 1]);
+    };
 
-                                    // Set all collected osi points for the current lane rpadmarkline
-                                    lane_roadMarkTypeLine->osi_points_.Set(osi_point);
+    int c_start = MAX(0, col - ring);
+    int c_end   = MIN(n_cols_ - 1, col + ring);
+    int r_start = MAX(0, row - ring + 1);
+    int r_end   = MIN(n_rows_ - 1, row + ring - 1);
 
-                                    // Clear osi collectors for roadmarks for next iteration
-                                    osi_point.clear();
-                                }
-                                else
-                                {
-                                    LOG_ERROR("LaneRoadMarkTypeLine {} for LaneRoadMarkType for LaneRoadMark {} for lane {} is not defined",
-                                              n,
-                                              m,
-                                              lane->GetId());
-                                }
-                            }
-                        }
-                        else
-                        {
-                            LOG_ERROR("Unexpected missing roadmark type or explicit element!");
-                        }
-                    }
-                }
+    // top and bottom rows of the ring
+    for (int r : {row - ring, row + ring})
+    {
+        if (r >= 0 && r < n_rows_)
+        {
+            for (int c = c_start; c <= c_end; c++)
+            {
+                add_cell(c, r);
             }
         }
+        if (ring == 0)
+        {
+            return;
+        }
     }
-}
 
-bool OpenDrive::SetRoadOSI()
-{
-    if (this == Position::GetOpenDrive())
+    // left and right columns, excluding corners
+    for (int c : {col - ring, col + ring})
     {
-        SetLaneOSIPoints();
-        SetRoadMarkOSIPoints();
-        SetLaneBoundaryPoints();
-        return true;
+        if (c >= 0 && c < n_cols_)
+        {
+            for (int r = r_start; r <= r_end; r++)
+            {
+                add_cell(c, r);
+            }
+        }
     }
-
-    return false;
 }
 
 idx_t LaneSection::GetClosestLaneIdx(double s, double t, double laneOffset, int side, double& offset, bool noZeroWidth, int laneTypeMask) const
@@ -7547,12 +8407,33 @@ Position::XYZ2TrackPos(double x3, double y3, double z3, int mode, bool connected
 
     // First step is to identify closest road and OSI line segment
 
-    size_t nrOfRoads;
+    size_t          nrOfRoads;
+    const RoadGrid& grid      = GetOpenDrive()->GetRoadGrid();
+    bool            use_grid  = false;
+    int             ring      = 0;  // next ring of grid cells to collect candidate roads from
+    int             last_ring = 0;
+
     if (along_route && route_ && route_->IsValid())
     {
         // Route assigned. Iterate over all roads in the route. I.e. check all waypoints road ID.
         nrOfRoads = route_->minimal_waypoints_.size();
     }
+    else if (!grid.IsEmpty())
+    {
+        // Iterate over roads found in grid cells surrounding the point, ring by ring, until remaining roads are known to be farther away
+        use_grid  = true;
+        ring      = grid.GetFirstRing(x3, y3);
+        last_ring = grid.GetLastRing(x3, y3);
+        nrOfRoads = 0;
+        grid_roads_.clear();
+
+        // new search id, invalidating roads registered by previous searches. Reset when wrapping or road network changed.
+        if (++grid_search_id_ == 0 || grid_road_search_id_.size() != GetOpenDrive()->GetNumOfRoads())
+        {
+            grid_road_search_id_.assign(GetOpenDrive()->GetNumOfRoads(), 0);
+            grid_search_id_ = 1;
+        }
+    }
     else
     {
         // Iterate over all roads in the road network
@@ -7568,10 +8449,41 @@ Position::XYZ2TrackPos(double x3, double y3, double z3, int mode, bool connected
         // Look only at specified road
         current_road = GetOpenDrive()->GetRoadById(roadId);
         nrOfRoads    = 0;
+        use_grid     = false;
     }
 
-    for (int i = -2; !search_done && i < static_cast<int>(nrOfRoads); i++)
+    for (int i = -2; !search_done; i++)
     {
+        if (i >= static_cast<int>(nrOfRoads))
+        {
+            // All candidates checked. When using grid, go on with next ring(s) unless the closest point is within the
+            // area already covered. Rings 0 to n contain all roads within a distance of n * cell size.
+            while (use_grid && grid_roads_.size() == nrOfRoads && ring <= last_ring && closestPointDist > (ring - 1) * grid.GetCellSize())
+            {
+                ring_roads_.clear();
+                grid.GetRoadsInRing(x3, y3, ring++, ring_roads_);
+                for (auto idx : ring_roads_)
+                {
+                    if (grid_road_search_id_[idx] != grid_search_id_)
+                    {
+                        grid_road_search_id_[idx] = grid_search_id_;
+                        grid_roads_.push_back(idx);
+                    }
+                }
+            }
+
+            if (grid_roads_.size() > nrOfRoads)
+            {
+                // check roads of the new ring in index order
+                std::sort(grid_roads_.begin() + static_cast<long>(nrOfRoads), grid_roads_.end());
+                nrOfRoads = grid_roads_.size();
+            }
+            else
+            {
+                break;
+            }
+        }
+
         // i == -2: Check limited point window around last known point
         // i == -1: Check current road
         // i > 0: Check all other roads
@@ -7616,6 +8528,10 @@ Position::XYZ2TrackPos(double x3, double y3, double z3, int mode, bool connected
             {
                 road = GetOpenDrive()->GetRoadById(route_->minimal_waypoints_[static_cast<unsigned int>(i)].GetTrackId());
             }
+            else if (use_grid)
+            {
+                road = GetOpenDrive()->GetRoadByIdx(grid_roads_[static_cast<unsigned int>(i)]);
+            }
             else
             {
                 road = GetOpenDrive()->GetRoadByIdx(static_cast<unsigned int>(i));
@@ -8187,12 +9103,6 @@ Position::XYZ2TrackPos(double x3, double y3, double z3, int mode, bool connected
         SetTrackPosMode(roadMin->GetId(), closestS, latOffset, 0, false, false);  // skip z, h, p, r
     }
 
-    static id_t rid = 0;
-    if (roadMin->GetId() != rid)
-    {
-        rid = roadMin->GetId();
-    }
-
     // Set specified position and heading
     SetX(x3);
     SetY(y3);
@@ -11845,6 +12755,17 @@ Shape* PolyLineShape::Copy()
     return shape;
 }
 
+void PolyLineShape::SyncState(SE_StateBuffer& buf)
+{
+    Shape::SyncState(buf);
+
+    buf.Expect(vertex_.size());
+    for (size_t i = 0; i < vertex_.size() && buf.IsOK(); i++)
+    {
+        vertex_[i].pos_->SyncState(buf);
+    }
+}
+
 double PolyLineShape::GetDuration()
 {
     if (vertex_.size() == 0)
@@ -12142,6 +13063,49 @@ Shape* ClothoidSplineShape::Copy()
     return shape;
 }
 
+void ClothoidSplineShape::SyncState(SE_StateBuffer& buf)
+{
+    Shape::SyncState(buf);
+
+    buf.Expect(segments_.size());
+    for (size_t i = 0; i < segments_.size() && buf.IsOK(); i++)
+    {
+        Segment& segment = segments_[i];
+
+        // missing start positions are created when freezing the shape
+        bool has_start = segment.posStart_ != nullptr;
+        buf.SyncLayout(has_start);
+        if (buf.IsRestoring() && has_start != (segment.posStart_ != nullptr))
+        {
+            if (has_start)
+            {
+                segment.posStart_ = new Position();
+            }
+            else
+            {
+                delete segment.posStart_;
+                segment.posStart_ = nullptr;
+            }
+        }
+
+        if (has_start)
+        {
+            if (segment.posStart_ != nullptr)
+            {
+                segment.posStart_->SyncState(buf);
+            }
+            else
+            {
+                // start position created at restore, verify stored state only
+                Position pos;
+                pos.SyncState(buf);
+            }
+        }
+        segment.posEnd_.SyncState(buf);
+    }
+    buf.Sync(spirals_, length_, time_end_);
+}
+
 double NurbsShape::CoxDeBoor(double x, idx_t i, idx_t k, const std::vector<double>& t)
 {
     // Inspiration: Nurbs Curve Example @
@@ -12546,6 +13510,18 @@ Shape* NurbsShape::Copy()
     return shape;
 }
 
+void NurbsShape::SyncState(SE_StateBuffer& buf)
+{
+    Shape::SyncState(buf);
+
+    buf.Expect(ctrlPoint_.size());
+    for (size_t i = 0; i < ctrlPoint_.size() && buf.IsOK(); i++)
+    {
+        ctrlPoint_[i].pos_.SyncState(buf);
+    }
+    buf.Sync(d_, dPeakT_, dPeakValue_, length_);
+}
+
 ClothoidShape::ClothoidShape(roadmanager::Position pos, double curv, double curvPrime, double len, double tStart, double tEnd)
     : Shape(ShapeType::CLOTHOID),
       pos_(pos),
@@ -12693,6 +13669,14 @@ Shape* ClothoidShape::Copy()
     return shape;
 }
 
+void ClothoidShape::SyncState(SE_StateBuffer& buf)
+{
+    Shape::SyncState(buf);
+
+    pos_.SyncState(buf);
+    buf.Sync(spiral_);
+}
+
 int Position::MoveTrajectoryDS(double ds)
 {
     if (!trajectory_)
@@ -13837,6 +14821,20 @@ RMTrajectory* RMTrajectory::Copy()
     return traj;
 }
 
+void RMTrajectory::SyncState(SE_StateBuffer& buf)
+{
+    buf.Expect(shape_ != nullptr ? static_cast<int>(shape_->type_) : -1);
+    if (shape_ != nullptr && buf.IsOK())
+    {
+        shape_->SyncState(buf);
+    }
+}
+
+void Shape::SyncState(SE_StateBuffer& buf)
+{
+    buf.Sync(following_mode_, initial_speed_, pline_, current_val_);
+}
+
 int Shape::FindClosestPoint(double xin, double yin, TrajVertex& pos, idx_t& index, idx_t startAtIndex)
 {
     if (pline_.vertex_.size() > 0)
@@ -13846,3 +14844,30 @@ int Shape::FindClosestPoint(double xin, double yin, TrajVertex& pos, idx_t& inde
 
     return -1;
 }
+
+void roadmanager::ProcessPositionBatch(size_t n, const std::function<void(size_t, Position&)>& func, SE_ThreadPool* pool)
+{
+    size_t n_ranges = (n + POSITION_BATCH_RANGE - 1) / POSITION_BATCH_RANGE;
+
+    auto process_range = [&](size_t range)
+    {
+        Position pos;
+        size_t   end = MIN(n, (range + 1) * POSITION_BATCH_RANGE);
+        for (size_t i = range * POSITION_BATCH_RANGE; i < end; i++)
+        {
+            func(i, pos);
+        }
+    };
+
+    if (pool != nullptr && n_ranges > 1)
+    {
+        pool->Run(n_ranges, process_range);
+    }
+    else
+    {
+        for (size_t i = 0; i < n_ranges; i++)
+        {
+            process_range(i);
+        }
+    }
+}
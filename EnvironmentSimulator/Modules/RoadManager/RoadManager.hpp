@@ -18,6 +18,10 @@
 #include <map>
 #include <vector>
 #include <list>
+#include <functional>
+#include <queue>
+#include <unordered_map>
+#include <unordered_set>
 #include "pugixml.hpp"
 #include "CommonMini.hpp"
 #include "logger.hpp"
@@ -347,18 +351,44 @@ namespace roadmanager
         void   SetY(double y);
         void   SetHdg(double h);
 
+        /**
+                Sample the spiral for fast evaluation by cubic interpolation instead of Fresnel integrals. Position error is
+                guaranteed below 1 nanometer, heading is still exact. Called by the constructor unless option "spiral_exact"
+                is set. Skipped for extremely sharp spirals, which would need too many samples.
+        */
+        void BuildTable();
+        bool HasTable() const
+        {
+            return !table_.empty();
+        }
+
         ClothoidType clothoid_type_;
         Arc          arc_;
         Line         line_;
 
     private:
-        double curv_start_ = 0.0;
-        double curv_end_   = 0.0;
-        double c_dot_      = 0.0;
-        double x0_         = 0.0;  // 0 if spiral starts with curvature = 0
-        double y0_         = 0.0;  // 0 if spiral starts with curvature = 0
-        double h0_         = 0.0;  // 0 if spiral starts with curvature = 0
-        double s0_         = 0.0;  // 0 if spiral starts with curvature = 0
+        // position and unit tangent of a sample point, relative spiral start point and heading
+        struct TableEntry
+        {
+            double x;
+            double y;
+            double dx;
+            double dy;
+        };
+
+        void EvaluateLocal(double ds, double *x, double *y, double *h) const;
+
+        double                  curv_start_ = 0.0;
+        double                  curv_end_   = 0.0;
+        double                  c_dot_      = 0.0;
+        double                  x0_         = 0.0;  // 0 if spiral starts with curvature = 0
+        double                  y0_         = 0.0;  // 0 if spiral starts with curvature = 0
+        double                  h0_         = 0.0;  // 0 if spiral starts with curvature = 0
+        double                  s0_         = 0.0;  // 0 if spiral starts with curvature = 0
+        std::vector<TableEntry> table_;             // equidistant samples, see BuildTable()
+        double                  table_step_ = 0.0;
+        double                  cos_hdg_    = 1.0;  // of start heading, for transforming table values
+        double                  sin_hdg_    = 0.0;
     };
 
     class Poly3 : public Geometry
@@ -2664,6 +2694,159 @@ namespace roadmanager
 
     class Position;  // forward declaration
 
+    /**
+            Uniform grid spatial index over the road reference lines (lane 0 OSI points)
+            Each OSI segment is registered, with its bounding box padded by the road width, in all cells it overlaps
+            Used to find candidate roads close to a world position without iterating all roads
+    */
+    class RoadGrid
+    {
+    public:
+        RoadGrid()
+        {
+        }
+
+        /**
+                Build index from OSI points of the road reference lines. Any previous content is discarded.
+                @param roads Roads of the road network, grid will refer to roads by index into this vector
+        */
+        void Build(const std::vector<Road *> &roads);
+        void Clear();
+        bool IsEmpty() const
+        {
+            return cell_start_.empty();
+        }
+        double GetCellSize() const
+        {
+            return cell_size_;
+        }
+
+        /**
+                Find ring distance (number of cells, Chebyshev metric) from given point to the grid
+                Rings closer than this contains no cells
+                @return 0 if point is within grid bounds
+        */
+        int GetFirstRing(double x, double y) const;
+
+        /**
+                Find ring distance (number of cells, Chebyshev metric) from given point to the farthest cell
+                All roads are found when rings up to and including this one has been visited
+        */
+        int GetLastRing(double x, double y) const;
+
+        /**
+                Add index of all roads registered in cells at exactly given ring distance from the cell containing the point
+                Roads overlapping several cells will occur multiple times in the list
+                @param x X coordinate of the center point
+                @param y Y coordinate of the center point
+                @param ring Distance (number of cells, Chebyshev metric), 0 is the cell containing the point
+                @param roads Road indices will be appended to this list
+        */
+        void GetRoadsInRing(double x, double y, int ring, std::vector<idx_t> &roads) const;
+
+    private:
+        double             x_min_     = 0.0;
+        double             y_min_     = 0.0;
+        double             cell_size_ = 0.0;
+        int                n_cols_    = 0;
+        int                n_rows_    = 0;
+        std::vector<idx_t> cell_start_;  // per cell, start index into road_idx_. Size is number of cells + 1.
+        std::vector<idx_t> road_idx_;    // road indices of all cells, consecutively stored
+
+        int ColOf(double x) const
+        {
+            return static_cast<int>(floor((x - x_min_) / cell_size_));
+        }
+        int RowOf(double y) const
+        {
+            return static_cast<int>(floor((y - y_min_) / cell_size_));
+        }
+    };
+
+    /**
+            Bounded cache of road path search results, least recently used entries are evicted first
+            Single direction searches depend only on the start link, start lane and target road, apart from a constant
+            start offset. Hence results are stored relative to the start offset and can be reused for subsequent queries.
+            Thread safe, since distance queries on the same road network may be made from several threads.
+    */
+    class RoadPathCache
+    {
+    public:
+        struct Key
+        {
+            const RoadLink *link       = nullptr;  // first link of the path, i.e. in the search direction of the start road
+            int             lane_id    = 0;        // lane id at the first link
+            const Road     *targetRoad = nullptr;
+
+            bool operator==(const Key &rhs) const
+            {
+                return link == rhs.link && lane_id == rhs.lane_id && targetRoad == rhs.targetRoad;
+            }
+        };
+
+        struct Node
+        {
+            RoadLink        *link         = nullptr;
+            double           dist         = 0.0;  // relative to start offset
+            Road            *fromRoad     = nullptr;
+            int              fromLaneId   = 0;
+            ContactPointType contactPoint = ContactPointType::CONTACT_POINT_UNDEFINED;
+        };
+
+        struct Entry
+        {
+            bool              found         = false;
+            std::vector<Node> nodes;                          // path from first link to the link where target road was found
+            double            max_prev_dist = -LARGE_NUMBER;  // max relative distance of nodes visited before the last one
+            bool              target_start  = false;          // true if target road is entered at its start
+        };
+
+        RoadPathCache()
+        {
+        }
+        // entries refer to the road network they were created for, so copies start out empty
+        RoadPathCache(const RoadPathCache &)
+        {
+        }
+        RoadPathCache &operator=(const RoadPathCache &)
+        {
+            Clear();
+            return *this;
+        }
+
+        /**
+                Lookup entry and mark it as most recently used
+                @param key Key to look up
+                @param entry Copy of found entry
+                @return true if found, else false
+        */
+        bool   Get(const Key &key, Entry &entry);
+        void   Put(const Key &key, const Entry &entry);
+        void   Clear();
+        size_t GetSize() const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return map_.size();
+        }
+
+        static const size_t capacity_ = 1024;
+
+    private:
+        struct KeyHash
+        {
+            size_t operator()(const Key &key) const
+            {
+                return std::hash<const void *>()(key.link) ^ (std::hash<const void *>()(key.targetRoad) << 1) ^
+                       (std::hash<int>()(key.lane_id) << 2);
+            }
+        };
+        typedef std::list<std::pair<Key, Entry>> EntryList;
+
+        EntryList                                             entries_;  // most recently used first
+        std::unordered_map<Key, EntryList::iterator, KeyHash> map_;
+        mutable std::mutex                                    mutex_;
+    };
+
     class OpenDrive
     {
     public:
@@ -2718,14 +2901,83 @@ namespace roadmanager
                                  bool                     &insert,
                                  const double              s_max);
         bool CheckLaneOSIRequirement(std::vector<double> x0, std::vector<double> y0, std::vector<double> x1, std::vector<double> y1) const;
-        void SetLaneOSIPoints();
-        void SetRoadMarkOSIPoints();
+        void SetLaneOSIPoints(Road *road);
+        void SetRoadMarkOSIPoints(Road *road);
 
         /**
-                Checks all lanes - if a lane has RoadMarks it does nothing. If a lane does not have roadmarks
+                Checks all lanes of a road - if a lane has RoadMarks it does nothing. If a lane does not have roadmarks
                 then it creates a LaneBoundary following the lane border (left border for left lanes, right border for right lanes)
+                @param road Road to process
+                @param lane_boundaries Created lane boundaries, to be added to respective lane by caller
+        */
+        void SetLaneBoundaryPoints(Road *road, std::vector<std::pair<Lane *, LaneBoundaryOSI *>> &lane_boundaries);
+
+        /**
+                Generate OSI points of all roads, lanes, road marks and lane boundaries. Roads are processed in parallel
+                threads for larger road networks, with same result as in a single thread.
+        */
+        void GenerateOSIPoints();
+
+        /**
+                Store generated OSI points in a file, to be restored by LoadOSIPoints()
+                @param filename File to write
+                @param key Identification of road network and OSI settings, see GetOSIPointsCacheKey()
+                @return 0 on success, -1 on failure
+        */
+        int SaveOSIPoints(const std::string &filename, uint64_t key);
+
+        /**
+                Restore OSI points stored by SaveOSIPoints(), instead of generating them
+                @param filename File to read
+                @param key Identification of road network and OSI settings, must match the one of stored points
+                @return 0 on success, -1 if missing, not matching or corrupt, in which case current points are kept
+        */
+        int LoadOSIPoints(const std::string &filename, uint64_t key);
+
+        /**
+                Get key identifying generated OSI points, i.e. hash of OpenDRIVE file content and OSI tolerances
+                @return key, 0 if file could not be read
+        */
+        uint64_t GetOSIPointsCacheKey() const;
+
+        /**
+                Get name of precompiled OSI points file, created by odr2bin. When present and matching the road network, points
+                are loaded from it instead of being generated.
+                @param odr_filename OpenDRIVE filename
+                @return Filename of same base name, with extension .odrbin, in same folder as the OpenDRIVE file
         */
-        void SetLaneBoundaryPoints();
+        static std::string GetPrecompiledFilename(const std::string &odr_filename);
+
+        /**
+                Get spatial index of roads, based on reference line OSI points. Built by SetRoadOSI().
+        */
+        const RoadGrid &GetRoadGrid() const
+        {
+            return road_grid_;
+        }
+        RoadGrid &GetRoadGrid()
+        {
+            return road_grid_;
+        }
+
+        /**
+                Build road graph, i.e. resolve roads reachable from each road link. Any previous content is discarded.
+        */
+        void BuildRoadGraph();
+
+        /**
+                Get roads reachable from a road link, i.e. the linked road or the connecting roads of a linked junction
+                having the road as incoming road. Resolved by BuildRoadGraph(), links added later are resolved on the fly.
+                @param road Road the link belongs to
+                @param link Predecessor or successor link of the road
+                @param roads Filled with the roads, may contain nullptr for unresolved road ids
+        */
+        void GetLinkedRoads(Road *road, RoadLink *link, std::vector<Road *> &roads);
+
+        RoadPathCache &GetRoadPathCache()
+        {
+            return road_path_cache_;
+        }
 
         /**
                 Retrieve a road segment specified by road ID
@@ -2872,7 +3124,16 @@ namespace roadmanager
         GlobalFriction                            friction_;
         std::vector<std::pair<id_t, std::string>> road_ids_;
         std::vector<std::pair<id_t, std::string>> junction_ids_;
-        id_t                                      LookupIdFromStr(std::vector<std::pair<id_t, std::string>> &ids, std::string id_str);
+        std::unordered_map<std::string, id_t>     road_id_by_str_;      // lookup of road_ids_, first occurrence of each string
+        std::unordered_map<std::string, id_t>     junction_id_by_str_;  // lookup of junction_ids_, first occurrence of each string
+        std::unordered_map<id_t, idx_t>           road_idx_;            // road id to index in road_, first occurrence of each id
+        std::unordered_map<id_t, idx_t>           junction_idx_;        // junction id to index in junction_, first occurrence of each id
+        RoadGrid                                  road_grid_;
+        id_t                                      LookupIdFromStr(const std::unordered_map<std::string, id_t> &ids, const std::string &id_str) const;
+        void                                      IndexIdStrings(const std::vector<std::pair<id_t, std::string>> &ids, std::unordered_map<std::string, id_t> &index);
+
+        std::unordered_map<const RoadLink *, std::vector<Road *>> road_graph_;  // roads reachable from each road link
+        RoadPathCache                                             road_path_cache_;
     };
 
     typedef struct
@@ -3088,13 +3349,25 @@ namespace roadmanager
         // Copy only location data from other position object
         void CopyLocation(const Position &from);
 
+        /**
+        Save or restore complete state, see SE_StateBuffer. Any route and trajectory are referred to by id, not copied.
+        */
+        void SyncState(SE_StateBuffer &buf);
+
         void Clean();
 
         void              Init();
         static bool       LoadOpenDrive(const char *filename);
         static bool       LoadOpenDrive(OpenDrive *odr);
         static OpenDrive *GetOpenDrive();
-        int               GotoClosestDrivingLaneAtCurrentPosition();
+
+        /**
+        Let GetOpenDrive() return given road network for the calling thread instead of the process wide one,
+        e.g. to run several scenarios in parallel threads. Set nullptr to restore.
+        @param odr Road network to use, owned by caller
+        */
+        static void SetThreadOpenDrive(OpenDrive *odr);
+        int         GotoClosestDrivingLaneAtCurrentPosition();
 
         /**
         Specify position by track coordinate (road_id, s, t) using current UPDATE mode
@@ -4091,10 +4364,16 @@ namespace roadmanager
 
         // Store roads overlapping position, updated by XYZ2TrackPos()
         std::vector<id_t> overlapping_roads;  // road ids overlapping position evaluated by XYZ2TrackPos()
+
+        // Scratch buffers of XYZ2TrackPos() road grid search, kept between calls to avoid allocations. Not copied by Duplicate().
+        std::vector<idx_t>        grid_roads_;           // candidate roads, in order of checking
+        std::vector<idx_t>        ring_roads_;           // roads of current ring, possibly duplicated
+        std::vector<unsigned int> grid_road_search_id_;  // per road index, id of last search it was added as candidate in
+        unsigned int              grid_search_id_ = 0;
     };
 
     // A route is a sequence of positions, at least one per road along the route
-    class Route
+    class Route : public SE_StateRegistered<Route>
     {
     public:
         Route()
@@ -4230,6 +4509,8 @@ namespace roadmanager
             ContactPointType contactPoint;
             PathNode        *previous  = 0;
             int              direction = 0;
+            idx_t            order     = 0;  // creation order, breaks ties between nodes of equal distance
+            bool             visited   = false;
         };
 
         std::vector<PathNode *> visited_;
@@ -4260,7 +4541,25 @@ namespace roadmanager
         int Calculate(double &dist, bool bothDirections = true, double maxDist = LARGE_NUMBER);
 
     private:
+        struct QueueEntry
+        {
+            double    dist;
+            idx_t     order;
+            PathNode *node;
+
+            bool operator>(const QueueEntry &rhs) const
+            {
+                return dist > rhs.dist || (dist == rhs.dist && order > rhs.order);
+            }
+        };
+
+        std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> queue_;  // unvisited nodes, closest first
+        std::unordered_set<const RoadLink *>                                            visited_links_;
+        std::unordered_map<const RoadLink *, PathNode *>                                unvisited_links_;
+        idx_t                                                                           n_nodes_ = 0;
+
         bool CheckRoad(Road *checkRoad, RoadPath::PathNode *srcNode, Road *fromRoad, int fromLaneId);
+        void AddNode(PathNode *node);
     };
 
     class PolyLineBase
@@ -4451,6 +4750,9 @@ namespace roadmanager
 
         virtual bool IsHSetExplicitly() = 0;
 
+        // Save or restore state resulting from freezing and evaluating the shape, see SE_StateBuffer
+        virtual void SyncState(SE_StateBuffer &buf);
+
         ShapeType     type_           = SHAPE_TYPE_UNDEFINED;
         FollowingMode following_mode_ = FollowingMode::POSITION;
         double        initial_speed_  = 0.0;
@@ -4490,6 +4792,7 @@ namespace roadmanager
         double GetStartTime();
         double GetDuration();
         bool   IsHSetExplicitly();
+        void   SyncState(SE_StateBuffer &buf) override;
 
         std::vector<Vertex> vertex_;
     };
@@ -4511,6 +4814,7 @@ namespace roadmanager
         double GetDuration();
         Shape *Copy();
         bool   IsHSetExplicitly();
+        void   SyncState(SE_StateBuffer &buf) override;
 
         Position            pos_;
         roadmanager::Spiral spiral_;  // make use of the OpenDRIVE clothoid definition
@@ -4581,6 +4885,7 @@ namespace roadmanager
         }
         bool   IsHSetExplicitly();
         Shape *Copy();
+        void   SyncState(SE_StateBuffer &buf) override;
 
     private:
         std::vector<Segment>             segments_;
@@ -4640,13 +4945,14 @@ namespace roadmanager
         double GetDuration();
         bool   IsHSetExplicitly();
         Shape *Copy();
+        void   SyncState(SE_StateBuffer &buf) override;
 
     private:
         double CoxDeBoor(double x, idx_t i, idx_t p, const std::vector<double> &t);
         double length_ = 0.0;
     };
 
-    class RMTrajectory
+    class RMTrajectory : public SE_StateRegistered<RMTrajectory>
     {
     public:
         RMTrajectory() : closed_(false)
@@ -4672,12 +4978,23 @@ namespace roadmanager
         double        GetH();
         void          Evaluate();  // evaluate for current s-value
         RMTrajectory *Copy();
+        void          SyncState(SE_StateBuffer &buf);
 
         Shape      *shape_;
         std::string name_;
         bool        closed_;
     };
 
+    /**
+            Process a large number of points, e.g. converting coordinates of a whole map or trajectory. The points are split
+            into consecutive ranges, each handled by one reused position object, so that the lookup of a point starts from
+            the road and geometry of the previous one. The ranges do not depend on the number of threads, nor does the result.
+            @param n Number of points
+            @param func Called once for each point index, with the position object of its range
+            @param pool Threads to spread the ranges over, or nullptr to process all points in the calling thread
+    */
+    void ProcessPositionBatch(size_t n, const std::function<void(size_t, Position &)> &func, SE_ThreadPool *pool = nullptr);
+
 }  // namespace roadmanager
 
 #endif  // OPENDRIVE_HH_
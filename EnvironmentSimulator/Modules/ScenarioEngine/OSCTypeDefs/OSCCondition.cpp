@@ -277,9 +277,29 @@ void OSCCondition::Reset()
     history_.Reset();
 }
 
+void OSCCondition::SyncState(SE_StateBuffer& buf)
+{
+    buf.Sync(last_result_, state_, history_, cond_value_);
+}
+
+void TrigByEntity::SyncState(SE_StateBuffer& buf)
+{
+    OSCCondition::SyncState(buf);
+    buf.Sync(triggered_by_entities_);
+}
+
+bool OSCCondition::IsInputChanged(double sim_time)
+{
+    (void)sim_time;
+
+    // unknown dependencies, always check
+    return true;
+}
+
 bool OSCCondition::Evaluate(double sim_time)
 {
-    bool result        = CheckCondition(sim_time);
+    // Conditions not depending on anything changed since last check would give same result again
+    bool result        = (state_ < ConditionState::EVALUATED || IsInputChanged(sim_time)) ? CheckCondition(sim_time) : last_result_;
     bool current_value = CheckEdge(result, last_result_, edge_);
     last_result_       = result;
 
@@ -391,6 +411,17 @@ void Trigger::Reset()
     }
 }
 
+void Trigger::SyncState(SE_StateBuffer& buf)
+{
+    for (auto cg : conditionGroup_)
+    {
+        for (auto c : cg->condition_)
+        {
+            c->SyncState(buf);
+        }
+    }
+}
+
 bool TrigByState::CheckCondition(double sim_time)
 {
     (void)sim_time;
@@ -404,6 +435,8 @@ bool TrigByState::CheckCondition(double sim_time)
         return false;
     }
 
+    idle_ = state_change_.empty();
+
     if (state_change_.empty())
     {
         // if no state change, check state from last change
@@ -578,14 +611,59 @@ std::string TrigByState::CondElementState2Str(CondElementState state)
     return "Unknown state";
 }
 
+bool TrigByState::IsInputChanged(double sim_time)
+{
+    (void)sim_time;
+
+    // Any transition expired at last check, so without new state changes the result is the same
+    return !(idle_ && state_change_.empty());
+}
+
 void TrigByState::Reset()
 {
     state_change_.clear();
     OSCCondition::Reset();
 }
 
+void TrigByState::SyncState(SE_StateBuffer& buf)
+{
+    OSCCondition::SyncState(buf);
+    buf.Sync(state_change_, latest_state_change_, idle_);
+}
+
+int TrigBySimulationTime::GetRegion(double sim_time)
+{
+    // Rules are evaluated with tolerance, result can change only close to the value
+    if (sim_time < value_ - 2 * SMALL_NUMBER)
+    {
+        return -1;
+    }
+    else if (sim_time > value_ + 2 * SMALL_NUMBER)
+    {
+        return 1;
+    }
+
+    return 0;
+}
+
+bool TrigBySimulationTime::IsInputChanged(double sim_time)
+{
+    int region = GetRegion(sim_time);
+
+    sim_time_ = sim_time;
+
+    return region == 0 || region != region_;
+}
+
+void TrigBySimulationTime::SyncState(SE_StateBuffer& buf)
+{
+    OSCCondition::SyncState(buf);
+    buf.Sync(sim_time_, region_);
+}
+
 bool TrigBySimulationTime::CheckCondition(double sim_time)
 {
+    region_     = GetRegion(sim_time);
     sim_time_   = sim_time;
     bool result = EvaluateRule(sim_time_, value_, rule_);
 
@@ -597,12 +675,20 @@ std::string TrigBySimulationTime::GetAdditionalLogInfo()
     return fmt::format("{:.4f} {} {:.4f}, edge: {}", sim_time_, Rule2Str(rule_), value_, Edge2Str());
 }
 
+bool TrigByParameter::IsInputChanged(double sim_time)
+{
+    (void)sim_time;
+
+    return parameters_->GetVersion() != version_;
+}
+
 bool TrigByParameter::CheckCondition(double sim_time)
 {
     (void)sim_time;
     bool result = false;
 
-    OSCParameterDeclarations::ParameterStruct* pe = parameters_->getParameterEntry(name_);
+    OSCParameterDeclarations::ParameterStruct* pe = parameters_->getParameterEntry(name_, slot_);
+    version_                                      = parameters_->GetVersion();  // after lookup, which might update the index
     if (pe == 0)
     {
         if (state_ < ConditionState::EVALUATED)  // print only once
@@ -638,16 +724,24 @@ bool TrigByParameter::CheckCondition(double sim_time)
 
 std::string TrigByParameter::GetAdditionalLogInfo()
 {
-    OSCParameterDeclarations::ParameterStruct* pe = parameters_->getParameterEntry(name_);
+    OSCParameterDeclarations::ParameterStruct* pe = parameters_->getParameterEntry(name_, slot_);
     return fmt::format("{} {} {} {}, edge: {}", name_, pe ? pe->value._string : "NOT_FOUND", Rule2Str(rule_), value_, Edge2Str());
 }
 
+bool TrigByVariable::IsInputChanged(double sim_time)
+{
+    (void)sim_time;
+
+    return variables_->GetVersion() != version_;
+}
+
 bool TrigByVariable::CheckCondition(double sim_time)
 {
     (void)sim_time;
     bool result = false;
 
-    OSCParameterDeclarations::ParameterStruct* pe = variables_->getParameterEntry(name_);
+    OSCParameterDeclarations::ParameterStruct* pe = variables_->getParameterEntry(name_, slot_);
+    version_                                      = variables_->GetVersion();  // after lookup, which might update the index
     if (pe == 0)
     {
         if (state_ < ConditionState::EVALUATED)  // print only once
@@ -683,7 +777,7 @@ bool TrigByVariable::CheckCondition(double sim_time)
 
 std::string TrigByVariable::GetAdditionalLogInfo()
 {
-    OSCParameterDeclarations::ParameterStruct* ve = variables_->getParameterEntry(name_);
+    OSCParameterDeclarations::ParameterStruct* ve = variables_->getParameterEntry(name_, slot_);
     return fmt::format("variable {} {} {} {}, edge: {}", name_, ve ? ve->value._string : "NOT_FOUND", Rule2Str(rule_), value_, Edge2Str());
 }
 
@@ -1092,13 +1186,7 @@ bool TrigByCollision::CheckCondition(double sim_time)
                     else
                     {
                         // reuse results from global collision detection
-                        for (size_t k = 0; k < trigObj->collisions_.size(); k++)
-                        {
-                            if (trigObj->collisions_[k] == storyBoard_->entities_->object_[j])
-                            {
-                                local_result = true;
-                            }
-                        }
+                        local_result = storyBoard_->entities_->IsColliding(trigObj, storyBoard_->entities_->object_[j]);
                     }
                     if (local_result == true)
                     {
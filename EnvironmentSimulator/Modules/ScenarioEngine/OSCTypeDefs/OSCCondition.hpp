@@ -102,12 +102,16 @@ namespace scenarioengine
 
         bool                Evaluate(double sim_time);
         virtual bool        CheckCondition(double sim_time) = 0;
+        virtual bool        IsInputChanged(double sim_time);
         void                Log(bool trig, bool full = false);
         virtual std::string GetAdditionalLogInfo() = 0;
         bool                GetValue();
         bool                CheckEdge(bool new_value, bool old_value, OSCCondition::ConditionEdge edge);
         std::string         Edge2Str();
         virtual void        Reset();
+
+        // Save or restore evaluation state, see SE_StateBuffer. Values recalculated at each check, e.g. distances, are excluded.
+        virtual void SyncState(SE_StateBuffer& buf);
     };
 
     class ConditionGroup
@@ -144,6 +148,7 @@ namespace scenarioengine
 
         bool         Evaluate(double sim_time);
         virtual void Reset();
+        void         SyncState(SE_StateBuffer& buf);
 
     private:
         bool defaultValue_;  // applied on empty conditions
@@ -196,6 +201,8 @@ namespace scenarioengine
         {
         }
 
+        void SyncState(SE_StateBuffer& buf) override;
+
         void print()
         {
         }
@@ -511,9 +518,11 @@ namespace scenarioengine
         StoryBoardElement*       element_;
         std::vector<StateChange> state_change_;
         StateChange              latest_state_change_;
+        bool                     idle_;  // no state change registered at last check
 
         bool CheckCondition(double sim_time);
-        TrigByState() : OSCCondition(BY_STATE), target_element_state_(CondElementState::UNDEFINED), element_(nullptr)
+        bool IsInputChanged(double sim_time) override;
+        TrigByState() : OSCCondition(BY_STATE), target_element_state_(CondElementState::UNDEFINED), element_(nullptr), idle_(false)
         {
             latest_state_change_.element    = nullptr;
             latest_state_change_.state      = StoryBoardElement::State::UNDEFINED_ELEMENT_STATE;
@@ -526,6 +535,7 @@ namespace scenarioengine
         std::string StateChangeToStr(StateChange state_change);
         std::string GetAdditionalLogInfo() override;
         void        Reset();
+        void        SyncState(SE_StateBuffer& buf) override;
     };
 
     class TrigByValue : public OSCCondition
@@ -555,22 +565,31 @@ namespace scenarioengine
         double sim_time_;
 
         bool CheckCondition(double sim_time);
+        bool IsInputChanged(double sim_time) override;
         TrigBySimulationTime() : TrigByValue(TrigByValue::Type::SIMULATION_TIME), sim_time_(0)
         {
         }
         std::string GetAdditionalLogInfo() override;
+        void        SyncState(SE_StateBuffer& buf) override;
+
+    private:
+        int region_ = 0;  // time relative value at last check, -1 = before, 0 = at, 1 = after
+        int GetRegion(double sim_time);
     };
 
     class TrigByParameter : public TrigByValue
     {
     public:
-        Object*     object_;
-        std::string name_;
-        std::string value_;
-        Rule        rule_;
-        Parameters* parameters_;
+        Object*                   object_;
+        std::string               name_;
+        std::string               value_;
+        Rule                      rule_;
+        Parameters*               parameters_;
+        Parameters::ParameterSlot slot_;         // bound on first evaluation
+        unsigned int              version_ = 0;  // version of parameters at last check
 
         bool CheckCondition(double sim_time);
+        bool IsInputChanged(double sim_time) override;
         TrigByParameter() : TrigByValue(TrigByValue::Type::PARAMETER)
         {
         }
@@ -580,13 +599,16 @@ namespace scenarioengine
     class TrigByVariable : public TrigByValue
     {
     public:
-        Object*     object_;
-        std::string name_;
-        std::string value_;
-        Rule        rule_;
-        Parameters* variables_;
+        Object*                   object_;
+        std::string               name_;
+        std::string               value_;
+        Rule                      rule_;
+        Parameters*               variables_;
+        Parameters::ParameterSlot slot_;         // bound on first evaluation
+        unsigned int              version_ = 0;  // version of variables at last check
 
         bool CheckCondition(double sim_time);
+        bool IsInputChanged(double sim_time) override;
         TrigByVariable() : TrigByValue(TrigByValue::Type::VARIABLE)
         {
         }
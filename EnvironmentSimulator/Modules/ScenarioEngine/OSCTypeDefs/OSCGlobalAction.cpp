@@ -40,8 +40,6 @@ using std::vector;
 #define MAX_CARS              1000
 #define MAX_LANES             32
 
-int SwarmTrafficAction::counter_ = 0;
-
 void ParameterSetAction::Start(double simTime)
 {
     LOG_INFO("Set parameter {} = {}", name_, value_);
@@ -407,6 +405,12 @@ void SwarmTrafficAction::Step(double simTime, double dt)
     }
 }
 
+void SwarmTrafficAction::SyncState(SE_StateBuffer& buf)
+{
+    OSCGlobalAction::SyncState(buf);
+    buf.Sync(spawnedV, lastTime, vehicle_pool_, counter_);
+}
+
 void SwarmTrafficAction::createRoadSegments(BBoxVec& vec)
 {
     for (unsigned int i = 0; i < odrManager_->GetNumOfRoads(); i++)
@@ -517,7 +521,7 @@ inline void SwarmTrafficAction::sampleRoads(int minN, int maxN, Solutions& sols,
     {
         // Shuffle and randomly select the points
         // Solutions selected(nCarsToSpawn);
-        static Point selected[MAX_CARS];  // Remove macro when/if found a solution for dynamic array
+        static thread_local Point selected[MAX_CARS];  // Remove macro when/if found a solution for dynamic array
         std::shuffle(sols.begin(), sols.end(), SE_Env::Inst().GetRand().GetGenerator());
         sample(sols.begin(), sols.end(), selected, nCarsToSpawn, SE_Env::Inst().GetRand().GetGenerator());
 
@@ -593,11 +597,11 @@ void SwarmTrafficAction::spawn(Solutions sols, int replace, double simTime)
 
     for (SelectInfo inf : info)
     {
-        unsigned int        lanesNo = MIN(MAX_LANES, inf.road->GetNumberOfDrivingLanes(inf.pos.GetS()));
-        static unsigned int elements[MAX_LANES];
+        unsigned int                     lanesNo = MIN(MAX_LANES, inf.road->GetNumberOfDrivingLanes(inf.pos.GetS()));
+        static thread_local unsigned int elements[MAX_LANES];
         std::iota(elements, elements + lanesNo, 0);
 
-        static idx_t lanes[MAX_LANES];
+        static thread_local idx_t lanes[MAX_LANES];
 
         sample(elements, elements + lanesNo, lanes, MIN(MAX_LANES, inf.nLanes), SE_Env::Inst().GetRand().GetGenerator());
 
@@ -328,6 +328,9 @@ namespace scenarioengine
 
         void Step(double simTime, double dt);
 
+        // Spawned vehicles are entities, see Entities::SyncState(), so restore is possible only until the set of vehicles changes
+        void SyncState(SE_StateBuffer& buf) override;
+
         void print()
         {
         }
@@ -381,7 +384,7 @@ namespace scenarioengine
         roadmanager::OpenDrive* odrManager_;
         double                  innerRadius_, semiMajorAxis_, semiMinorAxis_, midSMjA, midSMnA, minSize_, lastTime;
         std::vector<Vehicle*>   vehicle_pool_;
-        static int              counter_;
+        int                     counter_ = 0;
 
         int         despawn(double simTime);
         void        createRoadSegments(aabbTree::BBoxVec& vec);
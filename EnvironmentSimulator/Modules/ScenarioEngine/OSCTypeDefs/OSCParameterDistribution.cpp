@@ -27,12 +27,23 @@ namespace fs = std::experimental::filesystem;
 
 using namespace scenarioengine;
 
+static thread_local OSCParameterDistribution* threadDist_ = nullptr;
+
 OSCParameterDistribution& OSCParameterDistribution::Inst()
 {
+    if (threadDist_ != nullptr)
+    {
+        return *threadDist_;
+    }
     static OSCParameterDistribution instance_;
     return instance_;
 }
 
+void OSCParameterDistribution::SetThreadInst(OSCParameterDistribution* dist)
+{
+    threadDist_ = dist;
+}
+
 OSCParameterDistribution::~OSCParameterDistribution()
 {
     Reset();
@@ -42,6 +42,12 @@ namespace scenarioengine
         ~OSCParameterDistribution();
         static OSCParameterDistribution& Inst();
 
+        /**
+                Let Inst() return given distribution for the calling thread instead of the process wide one,
+                e.g. to run several scenarios in parallel threads. Set nullptr to restore.
+        */
+        static void SetThreadInst(OSCParameterDistribution* dist);
+
         int          Load(std::string filename);
         unsigned int GetNumPermutations();
         unsigned int GetNumParameters();
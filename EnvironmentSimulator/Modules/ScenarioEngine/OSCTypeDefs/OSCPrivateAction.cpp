@@ -292,6 +292,12 @@ void OSCPrivateAction::TransitionDynamics::UpdateRate()
     }
 }
 
+void OSCPrivateAction::SyncState(SE_StateBuffer& buf)
+{
+    OSCAction::SyncState(buf);
+    buf.Sync(object_);
+}
+
 AssignRouteAction::~AssignRouteAction()
 {
     object_->pos_.SetRoute(nullptr);
@@ -331,6 +337,17 @@ void AssignRouteAction::ReplaceObjectRefs(Object* obj1, Object* obj2)
     }
 }
 
+void AssignRouteAction::SyncState(SE_StateBuffer& buf)
+{
+    OSCPrivateAction::SyncState(buf);
+
+    // route is owned by the action and referred to by the entity position, so restore content only
+    if (route_ != nullptr)
+    {
+        buf.Sync(*route_);
+    }
+}
+
 void FollowTrajectoryAction::Start(double simTime)
 {
     OSCAction::Start(simTime);
@@ -561,6 +578,16 @@ void FollowTrajectoryAction::ReplaceObjectRefs(Object* obj1, Object* obj2)
     }
 }
 
+void FollowTrajectoryAction::SyncState(SE_StateBuffer& buf)
+{
+    OSCPrivateAction::SyncState(buf);
+    buf.Sync(time_, initialHeadingSign_, movingDirection_);
+    if (traj_ != nullptr)
+    {
+        traj_->SyncState(buf);
+    }
+}
+
 AcquirePositionAction::~AcquirePositionAction()
 {
     object_->pos_.SetRoute(nullptr);
@@ -573,13 +600,15 @@ AcquirePositionAction::~AcquirePositionAction()
 
 void AcquirePositionAction::Start(double simTime)
 {
-    // Resolve route
-    if (route_ != nullptr)
+    // Resolve route, reusing any route object from previous execution since it might be referred to by saved states
+    if (route_ == nullptr)
     {
-        delete route_;
-        route_ = nullptr;
+        route_ = new roadmanager::Route;
+    }
+    else
+    {
+        *route_ = roadmanager::Route();
     }
-    route_ = new roadmanager::Route;
     route_->setName("AcquirePositionRoute");
     route_->setObjName(object_->GetName());
 
@@ -614,6 +643,25 @@ void AcquirePositionAction::ReplaceObjectRefs(Object* obj1, Object* obj2)
     }
 }
 
+void AcquirePositionAction::SyncState(SE_StateBuffer& buf)
+{
+    OSCPrivateAction::SyncState(buf);
+    target_position_.SyncState(buf);
+
+    bool has_route = route_ != nullptr;
+    buf.SyncLayout(has_route);
+    if (has_route)
+    {
+        if (route_ == nullptr && buf.IsRestoring())
+        {
+            route_ = new roadmanager::Route;
+        }
+
+        roadmanager::Route route;
+        buf.Sync(route_ != nullptr ? *route_ : route);
+    }
+}
+
 void AssignControllerAction::Start(double simTime)
 {
     if (controller_)
@@ -743,6 +791,12 @@ void ActivateControllerAction::End()
     OSCAction::End();
 }
 
+void ActivateControllerAction::SyncState(SE_StateBuffer& buf)
+{
+    OSCPrivateAction::SyncState(buf);
+    buf.Sync(controller_);
+}
+
 void LatLaneChangeAction::Start(double simTime)
 {
     OSCAction::Start(simTime);
@@ -941,6 +995,13 @@ void LatLaneChangeAction::ReplaceObjectRefs(Object* obj1, Object* obj2)
     }
 }
 
+void LatLaneChangeAction::SyncState(SE_StateBuffer& buf)
+{
+    OSCPrivateAction::SyncState(buf);
+    buf.Sync(transition_, start_offset_, heading_agnostic_);
+    internal_pos_.SyncState(buf);
+}
+
 void LatLaneOffsetAction::Start(double simTime)
 {
     OSCAction::Start(simTime);
@@ -1037,6 +1098,12 @@ void LatLaneOffsetAction::ReplaceObjectRefs(Object* obj1, Object* obj2)
         }
     }
 }
+
+void LatLaneOffsetAction::SyncState(SE_StateBuffer& buf)
+{
+    OSCPrivateAction::SyncState(buf);
+    buf.Sync(transition_);
+}
 double LongSpeedAction::TargetRelative::GetValue()
 {
     double object_speed = object_ ? object_->speed_ : 0.0;
@@ -1664,6 +1731,12 @@ void LongSpeedProfileAction::AddSpeedSegment(double t, double v, double k, doubl
     segment_.push_back({t, v, k, j});
 }
 
+void LongSpeedProfileAction::SyncState(SE_StateBuffer& buf)
+{
+    OSCPrivateAction::SyncState(buf);
+    buf.Sync(following_mode_, segment_, cur_index_, start_time_, elapsed_, speed_, acc_, init_acc_);
+}
+
 void LongSpeedAction::ReplaceObjectRefs(Object* obj1, Object* obj2)
 {
     if (object_ == obj1)
@@ -1680,6 +1753,12 @@ void LongSpeedAction::ReplaceObjectRefs(Object* obj1, Object* obj2)
     }
 }
 
+void LongSpeedAction::SyncState(SE_StateBuffer& buf)
+{
+    OSCPrivateAction::SyncState(buf);
+    buf.Sync(transition_, target_speed_reached_);
+}
+
 void LongDistanceAction::Start(double simTime)
 {
     sim_time_ = simTime;
@@ -1851,6 +1930,12 @@ void LongDistanceAction::ReplaceObjectRefs(Object* obj1, Object* obj2)
     }
 }
 
+void LongDistanceAction::SyncState(SE_StateBuffer& buf)
+{
+    OSCPrivateAction::SyncState(buf);
+    buf.Sync(sim_time_, displacement_, acceleration_);
+}
+
 void TeleportAction::Start(double simTime)
 {
     OSCAction::Start(simTime);
@@ -1923,6 +2008,12 @@ void TeleportAction::ReplaceObjectRefs(Object* obj1, Object* obj2)
     position_.ReplaceObjectRefs(&obj1->pos_, &obj2->pos_);
 }
 
+void TeleportAction::SyncState(SE_StateBuffer& buf)
+{
+    OSCPrivateAction::SyncState(buf);
+    position_.SyncState(buf);
+}
+
 void ConnectTrailerAction::Start(double simTime)
 {
     OSCAction::Start(simTime);
@@ -2524,6 +2615,12 @@ void SynchronizeAction::Step(double simTime, double dt)
     }
 }
 
+void SynchronizeAction::SyncState(SE_StateBuffer& buf)
+{
+    OSCPrivateAction::SyncState(buf);
+    buf.Sync(mode_, submode_, lastDist_, lastMasterDist_, steadyState_.type_, steadyState_.dist_);
+}
+
 void VisibilityAction::Start(double simTime)
 {
     OSCAction::Start(simTime);
@@ -183,6 +183,9 @@ namespace scenarioengine
 
         virtual void ReplaceObjectRefs(Object*, Object*){};
 
+        // Save or restore runtime state, see SE_StateBuffer. Derived actions add their own state.
+        void SyncState(SE_StateBuffer& buf) override;
+
         const std::string DomainActivation2Str(ControlActivationMode mode) const
         {
             switch (mode)
@@ -289,6 +292,8 @@ namespace scenarioengine
         };
 
         void Start(double simTime);
+
+        void SyncState(SE_StateBuffer& buf) override;
         void Step(double simTime, double dt);
 
         void print()
@@ -396,6 +401,8 @@ namespace scenarioengine
         };
 
         void Start(double simTime);
+
+        void SyncState(SE_StateBuffer& buf) override;
         void Step(double simTime, double dt = 0.0);
 
         void print()
@@ -501,6 +508,8 @@ namespace scenarioengine
         };
 
         void Start(double simTime);
+
+        void SyncState(SE_StateBuffer& buf) override;
         void Step(double simTime, double dt);
 
         void print()
@@ -621,6 +630,7 @@ namespace scenarioengine
 
         void Step(double simTime, double dt);
         void Start(double simTime);
+        void SyncState(SE_StateBuffer& buf) override;
 
         void ReplaceObjectRefs(Object* obj1, Object* obj2);
 
@@ -701,6 +711,8 @@ namespace scenarioengine
         };
 
         void Start(double simTime);
+
+        void SyncState(SE_StateBuffer& buf) override;
         void Step(double simTime, double dt);
 
         void ReplaceObjectRefs(Object* obj1, Object* obj2);
@@ -817,6 +829,7 @@ namespace scenarioengine
 
         void Step(double simTime, double dt);
         void Start(double simTime);
+        void SyncState(SE_StateBuffer& buf) override;
 
         const char* Mode2Str(SynchMode mode);
 
@@ -881,6 +894,7 @@ namespace scenarioengine
 
         void Step(double simTime, double dt);
         void Start(double simTime);
+        void SyncState(SE_StateBuffer& buf) override;
 
         void ReplaceObjectRefs(Object* obj1, Object* obj2);
         void SetGhostRestart(bool value)
@@ -1009,6 +1023,8 @@ namespace scenarioengine
         };
 
         void Start(double simTime);
+
+        void SyncState(SE_StateBuffer& buf) override;
         void Step(double simTime, double dt);
 
         void ReplaceObjectRefs(Object* obj1, Object* obj2);
@@ -1082,6 +1098,7 @@ namespace scenarioengine
 
         void Step(double simTime, double dt);
         void Start(double simTime);
+        void SyncState(SE_StateBuffer& buf) override;
         void End();
 
         void Move(double simTime, double dt);
@@ -1126,6 +1143,8 @@ namespace scenarioengine
         };
 
         void Start(double simTime);
+
+        void SyncState(SE_StateBuffer& buf) override;
         void Step(double simTime, double dt);
 
         void ReplaceObjectRefs(Object* obj1, Object* obj2);
@@ -1238,6 +1257,8 @@ namespace scenarioengine
 
         void Start(double simTime);
 
+        void SyncState(SE_StateBuffer& buf) override;
+
         std::string Type2Str()
         {
             return "ActivateControllerAction";
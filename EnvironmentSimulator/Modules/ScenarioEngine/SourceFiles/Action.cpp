@@ -15,7 +15,7 @@
 
 using namespace scenarioengine;
 
-unsigned int OSCAction::n_actions_ = 0;
+std::atomic<unsigned int> OSCAction::n_actions_{0};
 
 std::string OSCAction::BaseType2Str()
 {
@@ -14,6 +14,7 @@
 
 #include "StoryboardElement.hpp"
 #include "logger.hpp"
+#include <atomic>
 
 namespace scenarioengine
 {
@@ -127,10 +128,10 @@ namespace scenarioengine
 
     private:
         // add dummy child list to avoid nullptr checks - don't add elments to this list
-        std::vector<StoryBoardElement*> dummy_child_list_;
-        unsigned int                    id_;  // unique ID for each action
-        static unsigned int             n_actions_;
-        static unsigned int             CreateUniqeActionId()
+        std::vector<StoryBoardElement*>  dummy_child_list_;
+        unsigned int                     id_;         // unique ID for each action
+        static std::atomic<unsigned int> n_actions_;  // shared by all scenarios in the process
+        static unsigned int              CreateUniqeActionId()
         {
             return n_actions_++;
         }
@@ -12,6 +12,15 @@
 
 #include "Catalogs.hpp"
 #include "pugixml.hpp"
+#if __has_include(<filesystem>)
+#include <filesystem>
+namespace fs = std::filesystem;
+#elif __has_include(<experimental/filesystem>)
+#include <experimental/filesystem>
+namespace fs = std::experimental::filesystem;
+#else
+#error "Missing <filesystem> header"
+#endif
 
 using namespace scenarioengine;
 
@@ -132,3 +141,90 @@ std::string Entry::GetTypeAsStr_(CatalogType type)
 
     return "";
 }
+
+CatalogCache &CatalogCache::Inst()
+{
+    static CatalogCache cache;
+    return cache;
+}
+
+std::shared_ptr<const pugi::xml_document> CatalogCache::Load(const std::string &filename, pugi::xml_parse_result &result)
+{
+    std::error_code ec;
+    std::string     path  = fs::absolute(filename, ec).lexically_normal().string();
+    long long       mtime = static_cast<long long>(fs::last_write_time(filename, ec).time_since_epoch().count());
+    uintmax_t       size  = fs::file_size(filename, ec);
+
+    if (ec)
+    {
+        result.status = pugi::status_file_not_found;
+        return nullptr;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto                        it = files_.find(path);
+        if (it != files_.end() && it->second.mtime == mtime && it->second.size == size)
+        {
+            result.status = pugi::status_ok;
+            return it->second.doc;
+        }
+    }
+
+    // Parse outside the lock, not holding up other threads
+    std::shared_ptr<pugi::xml_document> doc = std::make_shared<pugi::xml_document>();
+    result                                  = doc->load_file(filename.c_str());
+    if (!result)
+    {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    files_[path] = {mtime, static_cast<unsigned long long>(size), doc};
+
+    return doc;
+}
+
+int CatalogCache::Preload(const std::string &dirname)
+{
+    std::error_code ec;
+    int             counter = 0;
+
+    for (const auto &file : fs::directory_iterator(dirname, ec))
+    {
+        if (file.path().extension() == ".xosc")
+        {
+            pugi::xml_parse_result                    result;
+            std::shared_ptr<const pugi::xml_document> doc = Load(file.path().string(), result);
+
+            if (doc == nullptr)
+            {
+                LOG_WARN("Failed to preload catalog {}: {}", file.path().string(), result.description());
+            }
+            else if (doc->first_child().child("Catalog"))
+            {
+                counter++;
+            }
+        }
+    }
+
+    if (ec)
+    {
+        LOG_ERROR("Failed to read catalog directory {}: {}", dirname, ec.message());
+        return -1;
+    }
+
+    return counter;
+}
+
+void CatalogCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    files_.clear();
+}
+
+size_t CatalogCache::GetNumberOfFiles()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return files_.size();
+}
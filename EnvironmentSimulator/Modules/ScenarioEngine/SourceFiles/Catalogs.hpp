@@ -15,6 +15,9 @@
 #include <iostream>
 #include <string>
 #include <vector>
+#include <map>
+#include <memory>
+#include <mutex>
 
 #include "CommonMini.hpp"
 #include "RoadManager.hpp"
@@ -183,4 +186,44 @@ namespace scenarioengine
         }
     };
 
+    /**
+            Process wide cache of parsed catalog files, shared by all scenario loads and threads. A file is identified by its
+            path, modification time and size, so it is parsed again if changed. Saves file reading and XML parsing when the
+            same catalogs are used repeatedly, e.g. by parameter distribution permutations.
+    */
+    class CatalogCache
+    {
+    public:
+        static CatalogCache &Inst();
+
+        /**
+                Get parsed catalog file, reading it unless already cached and unchanged
+                @param filename Catalog file
+                @param result Parse result, with description of any failure
+                @return Parsed document, nullptr on failure
+        */
+        std::shared_ptr<const pugi::xml_document> Load(const std::string &filename, pugi::xml_parse_result &result);
+
+        /**
+                Parse and cache all catalog files (.xosc) of a directory
+                @param dirname Directory
+                @return Number of catalog files found, -1 if directory could not be read
+        */
+        int Preload(const std::string &dirname);
+
+        void   Clear();
+        size_t GetNumberOfFiles();
+
+    private:
+        struct CachedFile
+        {
+            long long                                 mtime;
+            unsigned long long                        size;
+            std::shared_ptr<const pugi::xml_document> doc;
+        };
+
+        std::mutex                        mutex_;
+        std::map<std::string, CachedFile> files_;  // key is absolute path
+    };
+
 }  // namespace scenarioengine
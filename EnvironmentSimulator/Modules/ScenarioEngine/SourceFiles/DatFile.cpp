@@ -0,0 +1,486 @@
+/*
+ * esmini - Environment Simulator Minimalistic
+ * https://github.com/esmini/esmini
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) partners of Simulation Scenarios
+ * https://sites.google.com/view/simulationscenarios
+ */
+
+#include <cstring>
+#include "DatFile.hpp"
+#include "logger.hpp"
+
+using namespace scenarioengine;
+
+#define DAT_RECORD_OBJECT_INFO  0
+#define DAT_RECORD_OBJECT_STATE 1
+#define DAT_FIELD_ROAD_ID       10
+#define DAT_FIELD_LANE_ID       11
+
+static void PutVarint(unsigned long long value, std::vector<unsigned char> &buf)
+{
+    while (value >= 0x80)
+    {
+        buf.push_back(static_cast<unsigned char>(value | 0x80));
+        value >>= 7;
+    }
+    buf.push_back(static_cast<unsigned char>(value));
+}
+
+static int GetVarint(const unsigned char *buf, size_t size, size_t &pos, unsigned long long &value)
+{
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7)
+    {
+        if (pos >= size)
+        {
+            return -1;
+        }
+        unsigned char byte = buf[pos++];
+        value |= static_cast<unsigned long long>(byte & 0x7f) << shift;
+        if (!(byte & 0x80))
+        {
+            return 0;
+        }
+    }
+
+    return -1;
+}
+
+static unsigned long long ZigZag(long long value)
+{
+    return (static_cast<unsigned long long>(value) << 1) ^ static_cast<unsigned long long>(value >> 63);
+}
+
+static long long UnZigZag(unsigned long long value)
+{
+    return static_cast<long long>(value >> 1) ^ -static_cast<long long>(value & 1);
+}
+
+static unsigned int FloatBits(float value)
+{
+    unsigned int bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+static float BitsFloat(unsigned int bits)
+{
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+void DatCodec::GetValues(const ObjectStateStructDat &state, unsigned int *values)
+{
+    values[0]                 = FloatBits(state.info.timeStamp);
+    values[1]                 = FloatBits(state.info.speed);
+    values[2]                 = FloatBits(state.info.wheel_angle);
+    values[3]                 = FloatBits(state.info.wheel_rot);
+    values[4]                 = FloatBits(state.pos.x);
+    values[5]                 = FloatBits(state.pos.y);
+    values[6]                 = FloatBits(state.pos.z);
+    values[7]                 = FloatBits(state.pos.h);
+    values[8]                 = FloatBits(state.pos.p);
+    values[9]                 = FloatBits(state.pos.r);
+    values[DAT_FIELD_ROAD_ID] = static_cast<unsigned int>(state.pos.roadId);
+    values[DAT_FIELD_LANE_ID] = static_cast<unsigned int>(state.pos.laneId);
+    values[12]                = FloatBits(state.pos.offset);
+    values[13]                = FloatBits(state.pos.t);
+    values[14]                = FloatBits(state.pos.s);
+}
+
+void DatCodec::SetValues(const unsigned int *values, ObjectStateStructDat &state)
+{
+    state.info.timeStamp   = BitsFloat(values[0]);
+    state.info.speed       = BitsFloat(values[1]);
+    state.info.wheel_angle = BitsFloat(values[2]);
+    state.info.wheel_rot   = BitsFloat(values[3]);
+    state.pos.x            = BitsFloat(values[4]);
+    state.pos.y            = BitsFloat(values[5]);
+    state.pos.z            = BitsFloat(values[6]);
+    state.pos.h            = BitsFloat(values[7]);
+    state.pos.p            = BitsFloat(values[8]);
+    state.pos.r            = BitsFloat(values[9]);
+    state.pos.roadId       = static_cast<id_t>(values[DAT_FIELD_ROAD_ID]);
+    state.pos.laneId       = static_cast<int>(values[DAT_FIELD_LANE_ID]);
+    state.pos.offset       = BitsFloat(values[12]);
+    state.pos.t            = BitsFloat(values[13]);
+    state.pos.s            = BitsFloat(values[14]);
+}
+
+void DatCodec::GetInfo(const ObjectStateStructDat &state, DatObjectInfo &info)
+{
+    memset(&info, 0, sizeof(info));
+    info.id           = state.info.id;
+    info.model_id     = state.info.model_id;
+    info.obj_type     = state.info.obj_type;
+    info.obj_category = state.info.obj_category;
+    info.ctrl_type    = state.info.ctrl_type;
+    memcpy(info.name, state.info.name, sizeof(info.name));
+    info.boundingbox    = state.info.boundingbox;
+    info.scaleMode      = state.info.scaleMode;
+    info.visibilityMask = state.info.visibilityMask;
+}
+
+void DatCodec::SetInfo(const DatObjectInfo &info, ObjectStateStructDat &state)
+{
+    state.info.id           = info.id;
+    state.info.model_id     = info.model_id;
+    state.info.obj_type     = info.obj_type;
+    state.info.obj_category = info.obj_category;
+    state.info.ctrl_type    = info.ctrl_type;
+    memcpy(state.info.name, info.name, sizeof(state.info.name));
+    state.info.boundingbox    = info.boundingbox;
+    state.info.scaleMode      = info.scaleMode;
+    state.info.visibilityMask = info.visibilityMask;
+}
+
+long long DatCodec::Predict(const ObjectHistory &history, int field)
+{
+    if (history.n_values == 0)
+    {
+        return 0;
+    }
+
+    long long latest = static_cast<int>(history.values[1][field]);
+    if (history.n_values == 1 || field == DAT_FIELD_ROAD_ID || field == DAT_FIELD_LANE_ID)
+    {
+        // ids are not expected to change linearly
+        return latest;
+    }
+
+    return 2 * latest - static_cast<int>(history.values[0][field]);
+}
+
+void DatCodec::Encode(const ObjectStateStructDat &state, std::vector<unsigned char> &buf)
+{
+    DatObjectInfo info;
+    GetInfo(state, info);
+
+    auto it = objects_.find(state.info.id);
+    if (it == objects_.end() || memcmp(&it->second.info, &info, sizeof(info)) != 0)
+    {
+        // new object or changed properties, write info record
+        ObjectHistory &history = objects_[state.info.id];
+        history.info           = info;
+        buf.push_back(DAT_RECORD_OBJECT_INFO);
+        const unsigned char *bytes = reinterpret_cast<const unsigned char *>(&info);
+        buf.insert(buf.end(), bytes, bytes + sizeof(info));
+        it = objects_.find(state.info.id);
+    }
+
+    ObjectHistory &history = it->second;
+    unsigned int   values[n_fields_];
+    long long      residual[n_fields_];
+    unsigned int   mask = 0;
+
+    GetValues(state, values);
+    for (int i = 0; i < n_fields_; i++)
+    {
+        residual[i] = static_cast<int>(values[i]) - Predict(history, i);
+        if (residual[i] != 0)
+        {
+            mask |= 1u << i;
+        }
+    }
+
+    buf.push_back(DAT_RECORD_OBJECT_STATE);
+    PutVarint(ZigZag(state.info.id), buf);
+    PutVarint(mask, buf);
+    for (int i = 0; i < n_fields_; i++)
+    {
+        if (mask & (1u << i))
+        {
+            PutVarint(ZigZag(residual[i]), buf);
+        }
+    }
+
+    memcpy(history.values[0], history.values[1], sizeof(history.values[0]));
+    memcpy(history.values[1], values, sizeof(history.values[1]));
+    history.n_values = MIN(history.n_values + 1, 2);
+}
+
+int DatCodec::Decode(const unsigned char *buf, size_t size, size_t &pos, ObjectStateStructDat &state)
+{
+    while (pos < size && buf[pos] == DAT_RECORD_OBJECT_INFO)
+    {
+        DatObjectInfo info;
+        if (pos + 1 + sizeof(info) > size)
+        {
+            return -1;
+        }
+        memcpy(&info, &buf[pos + 1], sizeof(info));
+        pos += 1 + sizeof(info);
+        objects_[info.id].info = info;
+    }
+
+    if (pos >= size || buf[pos] != DAT_RECORD_OBJECT_STATE)
+    {
+        return -1;
+    }
+    pos++;
+
+    unsigned long long id   = 0;
+    unsigned long long mask = 0;
+    if (GetVarint(buf, size, pos, id) != 0 || GetVarint(buf, size, pos, mask) != 0)
+    {
+        return -1;
+    }
+
+    auto it = objects_.find(static_cast<int>(UnZigZag(id)));
+    if (it == objects_.end())
+    {
+        LOG_ERROR("dat: State of unknown object {}", UnZigZag(id));
+        return -1;
+    }
+
+    ObjectHistory &history = it->second;
+    unsigned int   values[n_fields_];
+    for (int i = 0; i < n_fields_; i++)
+    {
+        unsigned long long residual = 0;
+        if ((mask & (1u << i)) && GetVarint(buf, size, pos, residual) != 0)
+        {
+            return -1;
+        }
+        values[i] = static_cast<unsigned int>(Predict(history, i) + UnZigZag(residual));
+    }
+
+    SetInfo(history.info, state);
+    SetValues(values, state);
+
+    memcpy(history.values[0], history.values[1], sizeof(history.values[0]));
+    memcpy(history.values[1], values, sizeof(history.values[1]));
+    history.n_values = MIN(history.n_values + 1, 2);
+
+    return 0;
+}
+
+DatWriter::~DatWriter()
+{
+    Close();
+}
+
+int DatWriter::Open(const std::string &filename, const std::string &odr_filename, const std::string &model_filename)
+{
+    Close();
+
+    file_.open(filename, std::ofstream::binary);
+    if (file_.fail())
+    {
+        LOG_ERROR("Cannot open file: {}", filename);
+        return -1;
+    }
+
+    DatHeader header;
+    header.version = DAT_FILE_FORMAT_VERSION;
+    StrCopy(header.odr_filename, odr_filename.c_str(), MIN(odr_filename.length() + 1, DAT_FILENAME_SIZE));
+    StrCopy(header.model_filename, model_filename.c_str(), MIN(model_filename.length() + 1, DAT_FILENAME_SIZE));
+    file_.write(reinterpret_cast<char *>(&header), sizeof(header));
+
+    chunk_.clear();
+    chunk_header_ = {0, 0, 0.0f, 0.0f};
+    codec_.Reset();
+    index_.clear();
+
+    return 0;
+}
+
+void DatWriter::Write(const ObjectStateStructDat &state)
+{
+    if (!file_.is_open())
+    {
+        return;
+    }
+
+    if (chunk_header_.n_records == 0)
+    {
+        chunk_header_.t_start = state.info.timeStamp;
+    }
+    chunk_header_.t_end = state.info.timeStamp;
+    chunk_header_.n_records++;
+
+    codec_.Encode(state, chunk_);
+}
+
+void DatWriter::EndFrame()
+{
+    if (chunk_.size() >= DAT_CHUNK_SIZE)
+    {
+        WriteChunk();
+    }
+}
+
+void DatWriter::WriteChunk()
+{
+    if (chunk_header_.n_records == 0)
+    {
+        return;
+    }
+
+    DatIndexEntry entry;
+    entry.t_start = chunk_header_.t_start;
+    entry.t_end   = chunk_header_.t_end;
+    entry.offset  = static_cast<unsigned long long>(file_.tellp());
+    index_.push_back(entry);
+
+    chunk_header_.size = static_cast<unsigned int>(chunk_.size());
+    file_.write(reinterpret_cast<char *>(&chunk_header_), sizeof(chunk_header_));
+    file_.write(reinterpret_cast<char *>(chunk_.data()), static_cast<std::streamsize>(chunk_.size()));
+
+    // next chunk starts from scratch, so that it can be decoded without any preceding data
+    chunk_.clear();
+    chunk_header_ = {0, 0, 0.0f, 0.0f};
+    codec_.Reset();
+}
+
+void DatWriter::Close()
+{
+    if (!file_.is_open())
+    {
+        return;
+    }
+
+    WriteChunk();
+
+    DatIndexFooter footer;
+    footer.offset    = static_cast<unsigned long long>(file_.tellp());
+    footer.n_entries = static_cast<unsigned int>(index_.size());
+    footer.tag       = DAT_INDEX_TAG;
+    if (index_.size() > 0)
+    {
+        file_.write(reinterpret_cast<char *>(index_.data()), static_cast<std::streamsize>(index_.size() * sizeof(DatIndexEntry)));
+    }
+    file_.write(reinterpret_cast<char *>(&footer), sizeof(footer));
+
+    file_.flush();
+    file_.close();
+    index_.clear();
+}
+
+int DatReader::Open(const std::string &filename)
+{
+    Close();
+
+    file_.open(filename, std::ifstream::binary);
+    if (file_.fail())
+    {
+        return -1;
+    }
+
+    file_.seekg(0, std::ios::end);
+    std::streamoff file_size = file_.tellg();
+    file_.seekg(0, std::ios::beg);
+
+    if (!file_.read(reinterpret_cast<char *>(&header_), sizeof(header_)))
+    {
+        return -2;
+    }
+
+    data_end_ = file_size;
+    if (header_.version == DAT_FILE_FORMAT_VERSION)
+    {
+        // look for index at end of file. Missing if recording was not closed properly, then read chunks until end of file.
+        DatIndexFooter footer;
+        if (file_size >= static_cast<std::streamoff>(sizeof(header_) + sizeof(footer)))
+        {
+            file_.seekg(file_size - static_cast<std::streamoff>(sizeof(footer)));
+            if (file_.read(reinterpret_cast<char *>(&footer), sizeof(footer)) &&
+                IsValidDatIndexFooter(footer, static_cast<unsigned long long>(file_size)))
+            {
+                index_.resize(footer.n_entries);
+                file_.seekg(static_cast<std::streamoff>(footer.offset));
+                file_.read(reinterpret_cast<char *>(index_.data()), static_cast<std::streamsize>(index_.size() * sizeof(DatIndexEntry)));
+                data_end_ = static_cast<std::streamoff>(footer.offset);
+            }
+            file_.clear();
+            file_.seekg(sizeof(header_));
+        }
+    }
+    else if (header_.version != DAT_FILE_FORMAT_VERSION_RAW)
+    {
+        return -2;
+    }
+
+    return 0;
+}
+
+void DatReader::Close()
+{
+    if (file_.is_open())
+    {
+        file_.close();
+    }
+    file_.clear();
+    chunk_.clear();
+    chunk_pos_          = 0;
+    chunk_records_left_ = 0;
+    data_end_           = 0;
+    index_.clear();
+    codec_.Reset();
+}
+
+int DatReader::ReadChunk()
+{
+    DatChunkHeader chunk_header;
+
+    if (file_.tellg() + static_cast<std::streamoff>(sizeof(chunk_header)) > data_end_ ||
+        !file_.read(reinterpret_cast<char *>(&chunk_header), sizeof(chunk_header)))
+    {
+        return -1;
+    }
+
+    if (file_.tellg() + static_cast<std::streamoff>(chunk_header.size) > data_end_)
+    {
+        LOG_WARN("dat: Truncated chunk, skipping remaining data");
+        return -1;
+    }
+
+    chunk_.resize(chunk_header.size);
+    if (!file_.read(reinterpret_cast<char *>(chunk_.data()), static_cast<std::streamsize>(chunk_.size())))
+    {
+        return -1;
+    }
+
+    chunk_pos_          = 0;
+    chunk_records_left_ = chunk_header.n_records;
+    codec_.Reset();
+
+    return 0;
+}
+
+int DatReader::ReadNext(ObjectStateStructDat &state)
+{
+    if (!file_.is_open())
+    {
+        return -1;
+    }
+
+    if (header_.version == DAT_FILE_FORMAT_VERSION_RAW)
+    {
+        return file_.read(reinterpret_cast<char *>(&state), sizeof(state)) ? 0 : -1;
+    }
+
+    while (chunk_records_left_ == 0)
+    {
+        if (ReadChunk() != 0)
+        {
+            return -1;
+        }
+    }
+
+    if (codec_.Decode(chunk_.data(), chunk_.size(), chunk_pos_, state) != 0)
+    {
+        LOG_ERROR("dat: Failed to decode object state");
+        chunk_records_left_ = 0;
+        return -1;
+    }
+    chunk_records_left_--;
+
+    return 0;
+}
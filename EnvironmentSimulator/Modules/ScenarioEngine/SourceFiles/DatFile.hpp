@@ -0,0 +1,277 @@
+/*
+ * esmini - Environment Simulator Minimalistic
+ * https://github.com/esmini/esmini
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) partners of Simulation Scenarios
+ * https://sites.google.com/view/simulationscenarios
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <unordered_map>
+#include "CommonMini.hpp"
+#include "OSCBoundingBox.hpp"
+
+/*
+ * Scenario recording (.dat) file format
+ *
+ * Version 2: DatHeader followed by one ObjectStateStructDat per object and frame
+ *
+ * Version 3: DatHeader followed by chunks of encoded object states and a trailing index:
+ *   chunk:  DatChunkHeader + payload of records
+ *           record 0: object static info (DatObjectInfo), written for each object at first state in each chunk and whenever changed
+ *           record 1: object state, varint id + varint field mask + zigzag varint residual of each field marked in mask
+ *                     residuals are based on the 32 bit patterns of the values, predicted linearly from the two previous
+ *                     states of same object within the chunk. Hence decoding reproduces the values exactly.
+ *   index:  one DatIndexEntry per chunk, followed by DatIndexFooter
+ *   Chunks are self contained, i.e. can be decoded without any previous data.
+ */
+#define DAT_FILE_FORMAT_VERSION      3
+#define DAT_FILE_FORMAT_VERSION_RAW  2  // uncompressed states, still supported for reading
+#define DAT_FILENAME_SIZE            512
+#define DAT_CHUNK_SIZE               65536       // approximate max payload size of a chunk, in bytes
+#define DAT_INDEX_TAG                0x58444e49  // "INDX"
+
+namespace scenarioengine
+{
+
+#define NAME_LEN 32
+
+    struct ObjectInfoStructDat
+    {
+        int            id;
+        int            model_id;
+        int            obj_type;      // 0=None, 1=Vehicle, 2=Pedestrian, 3=MiscObj (see Object::Type enum)
+        int            obj_category;  // sub type for vehicle, pedestrian and miscobj
+        int            ctrl_type;     // See Controller::Type enum
+        float          timeStamp;
+        char           name[NAME_LEN];
+        float          speed;
+        float          wheel_angle;  // Only used for vehicle
+        float          wheel_rot;    // Only used for vehicle
+        OSCBoundingBox boundingbox;
+        int            scaleMode;       // 0=None, 1=BoundingBoxToModel, 2=ModelToBoundingBox (see enum EntityScaleMode)
+        int            visibilityMask;  // bitmask according to Object::Visibility (1 = Graphics, 2 = Traffic, 4 = Sensors)
+    };
+
+    struct ObjectPositionStructDat
+    {
+        float x;
+        float y;
+        float z;
+        float h;
+        float p;
+        float r;
+        id_t  roadId;
+        int   laneId;
+        float offset;
+        float t;
+        float s;
+    };
+
+    struct ObjectStateStructDat
+    {
+        struct ObjectInfoStructDat     info;
+        struct ObjectPositionStructDat pos;
+    };
+
+    typedef struct
+    {
+        int  version;
+        char odr_filename[DAT_FILENAME_SIZE];
+        char model_filename[DAT_FILENAME_SIZE];
+    } DatHeader;
+
+    // Object properties rarely changing, stored once per object and chunk
+    struct DatObjectInfo
+    {
+        int            id;
+        int            model_id;
+        int            obj_type;
+        int            obj_category;
+        int            ctrl_type;
+        char           name[NAME_LEN];
+        OSCBoundingBox boundingbox;
+        int            scaleMode;
+        int            visibilityMask;
+    };
+
+    struct DatChunkHeader
+    {
+        unsigned int size;       // payload size in bytes
+        unsigned int n_records;  // number of object states in the chunk
+        float        t_start;    // timestamp of first object state
+        float        t_end;      // timestamp of last object state
+    };
+
+    struct DatIndexEntry
+    {
+        float              t_start;
+        float              t_end;
+        unsigned long long offset;  // file position of chunk header
+    };
+
+    struct DatIndexFooter
+    {
+        unsigned long long offset;  // file position of first index entry
+        unsigned int       n_entries;
+        unsigned int       tag;  // DAT_INDEX_TAG
+    };
+
+    /**
+            Check that footer, read from the end of a file, refers to a complete index
+            @param footer Footer as read from last bytes of the file
+            @param file_size Size of the file, in bytes
+            @return true if valid, then chunks end at footer.offset
+    */
+    inline bool IsValidDatIndexFooter(const DatIndexFooter &footer, unsigned long long file_size)
+    {
+        return footer.tag == DAT_INDEX_TAG && footer.offset >= sizeof(DatHeader) &&
+               footer.offset + footer.n_entries * sizeof(DatIndexEntry) + sizeof(DatIndexFooter) == file_size;
+    }
+
+    /**
+            Encoding and decoding state of a chunk, i.e. the latest values of each object
+    */
+    class DatCodec
+    {
+    public:
+        static const int n_fields_ = 15;
+
+        void Reset()
+        {
+            objects_.clear();
+        }
+
+        /**
+                Encode object state and append to buffer
+                @param state Object state to encode
+                @param buf Buffer to append bytes to
+        */
+        void Encode(const ObjectStateStructDat &state, std::vector<unsigned char> &buf);
+
+        /**
+                Decode next object state from buffer, any preceding object info records are consumed as well
+                @param buf Buffer holding encoded records
+                @param size Size of buffer
+                @param pos Position of next record in buffer, will be updated
+                @param state Decoded object state
+                @return 0 on success, -1 on corrupt or truncated data
+        */
+        int Decode(const unsigned char *buf, size_t size, size_t &pos, ObjectStateStructDat &state);
+
+    private:
+        struct ObjectHistory
+        {
+            DatObjectInfo info;
+            unsigned int  values[2][n_fields_];  // bit patterns of the two latest states, [1] being the latest
+            int           n_values = 0;
+        };
+        std::unordered_map<int, ObjectHistory> objects_;
+
+        static void GetValues(const ObjectStateStructDat &state, unsigned int *values);
+        static void SetValues(const unsigned int *values, ObjectStateStructDat &state);
+        static void GetInfo(const ObjectStateStructDat &state, DatObjectInfo &info);
+        static void SetInfo(const DatObjectInfo &info, ObjectStateStructDat &state);
+        static long long Predict(const ObjectHistory &history, int field);
+    };
+
+    /**
+            Writes scenario recordings in the latest .dat format version
+    */
+    class DatWriter
+    {
+    public:
+        DatWriter()
+        {
+        }
+        ~DatWriter();
+
+        /**
+                Create file and write header
+                @return 0 on success, -1 on failure
+        */
+        int  Open(const std::string &filename, const std::string &odr_filename, const std::string &model_filename);
+        bool IsOpen() const
+        {
+            return file_.is_open();
+        }
+
+        /**
+                Add object state to current chunk
+        */
+        void Write(const ObjectStateStructDat &state);
+
+        /**
+                Call after all objects of a frame have been written. Chunks are completed at frame boundaries only.
+        */
+        void EndFrame();
+
+        /**
+                Write any pending chunk, the index and close the file
+        */
+        void Close();
+
+    private:
+        std::ofstream              file_;
+        std::vector<unsigned char> chunk_;
+        DatChunkHeader             chunk_header_ = {0, 0, 0.0f, 0.0f};
+        DatCodec                   codec_;
+        std::vector<DatIndexEntry> index_;
+
+        void WriteChunk();
+    };
+
+    /**
+            Reads scenario recordings of any supported .dat format version, one object state at a time
+    */
+    class DatReader
+    {
+    public:
+        DatHeader header_;
+
+        DatReader()
+        {
+        }
+
+        /**
+                Open file and read header and any index
+                @return 0 on success, -1 if file could not be opened, -2 if version is not supported
+        */
+        int  Open(const std::string &filename);
+        void Close();
+
+        /**
+                Read next object state
+                @return 0 on success, -1 at end of file or unreadable data
+        */
+        int ReadNext(ObjectStateStructDat &state);
+
+        /**
+                Get chunk index, time to file position. Empty for version 2 or if the file was not closed properly.
+        */
+        const std::vector<DatIndexEntry> &GetIndex() const
+        {
+            return index_;
+        }
+
+    private:
+        std::ifstream              file_;
+        std::streamoff             data_end_ = 0;  // end of chunks, i.e. start of index
+        std::vector<unsigned char> chunk_;
+        size_t                     chunk_pos_          = 0;
+        unsigned int               chunk_records_left_ = 0;
+        DatCodec                   codec_;
+        std::vector<DatIndexEntry> index_;
+
+        int ReadChunk();
+    };
+
+}  // namespace scenarioengine
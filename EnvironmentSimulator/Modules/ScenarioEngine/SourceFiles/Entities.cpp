@@ -1443,6 +1443,8 @@ int Entities::addObject(Object* obj, bool activate, int call_index)
     }
 
     obj->id_ = getNewId();
+    object_by_id_[obj->id_] = obj;
+    lane_occupancy_.Clear();
     if (activate)
     {
         object_.push_back(obj);
@@ -1497,6 +1499,7 @@ int Entities::activateObject(Object* obj, int call_index)
     {
         object_.push_back(obj);
         obj->SetActive(true);
+        lane_occupancy_.Clear();
 
         int n_objs = static_cast<int>(std::count(object_pool_.begin(), object_pool_.end(), obj));
         if (n_objs == 1)
@@ -1542,6 +1545,7 @@ int Entities::deactivateObject(Object* obj, int call_index)
     {
         object_.erase(std::remove(object_.begin(), object_.end(), obj), object_.end());
         obj->SetActive(false);
+        lane_occupancy_.Clear();
 
         int n_objs = static_cast<int>(std::count(object_pool_.begin(), object_pool_.end(), obj));
         if (n_objs == 0)
@@ -1575,13 +1579,10 @@ int Entities::deactivateObject(Object* obj, int call_index)
 
 void Entities::removeObject(int id, bool recursive)
 {
-    for (size_t i = 0; i < object_.size(); i++)
+    auto it = object_by_id_.find(id);
+    if (it != object_by_id_.end() && it->second->IsActive())
     {
-        if (object_[i]->id_ == id)
-        {
-            removeObject(object_[i], recursive);
-            return;
-        }
+        removeObject(it->second, recursive);
     }
 }
 
@@ -1619,6 +1620,20 @@ void Entities::removeObject(Object* object, bool recursive)
     }
 
     object_.erase(std::remove(object_.begin(), object_.end(), object), object_.end());
+    lane_occupancy_.Clear();
+
+    auto it = object_by_id_.find(object->id_);
+    if (it != object_by_id_.end() && it->second == object)
+    {
+        object_by_id_.erase(it);
+    }
+
+    // name might have changed since indexed, so look for any entry referring to the object
+    for (auto it_name = object_by_name_.begin(); it_name != object_by_name_.end();)
+    {
+        it_name = it_name->second == object ? object_by_name_.erase(it_name) : std::next(it_name);
+    }
+
     delete object;
 
     return;
@@ -1703,6 +1718,22 @@ Vehicle::~Vehicle()
 {
 }
 
+void Vehicle::SyncState(SE_StateBuffer& buf)
+{
+    Object::SyncState(buf);
+
+    // mounting points are shared with copies of the vehicle, so restore content rather than replacing them
+    buf.Sync(wheel_data);
+    if (trailer_coupler_)
+    {
+        buf.Sync(trailer_coupler_->dx_, trailer_coupler_->tow_vehicle_);
+    }
+    if (trailer_hitch_)
+    {
+        buf.Sync(trailer_hitch_->dx_, trailer_hitch_->trailer_vehicle_);
+    }
+}
+
 int Vehicle::ConnectTrailer(Vehicle* trailer)
 {
     if (trailer && trailer->trailer_coupler_)
@@ -1807,45 +1838,58 @@ std::string Object::Role2String(int role)
     }
 }
 
-Object* Entities::GetObjectByName(std::string name)
+Object* Entities::FindObjectByName(const std::string& name)
 {
-    for (size_t i = 0; i < object_.size(); i++)
+    auto it = object_by_name_.find(name);
+    if (it != object_by_name_.end() && it->second->name_ == name)
+    {
+        return it->second;
+    }
+
+    // not indexed yet or renamed, search active objects first
+    Object* obj = nullptr;
+    for (size_t i = 0; i < object_.size() && obj == nullptr; i++)
     {
         if (name == object_[i]->name_)
         {
-            return object_[i];
+            obj = object_[i];
         }
     }
 
-    for (size_t i = 0; i < object_pool_.size(); i++)
+    for (size_t i = 0; i < object_pool_.size() && obj == nullptr; i++)
     {
         if (name == object_pool_[i]->name_)
         {
-            return object_pool_[i];
+            obj = object_pool_[i];
         }
     }
 
-    LOG_ERROR("Failed to find object {}", name);
+    if (obj != nullptr)
+    {
+        object_by_name_[name] = obj;
+    }
 
-    return 0;
+    return obj;
 }
 
-Object* Entities::GetObjectById(int id)
+Object* Entities::GetObjectByName(std::string name)
 {
-    for (size_t i = 0; i < object_.size(); i++)
+    Object* obj = FindObjectByName(name);
+
+    if (obj == nullptr)
     {
-        if (id == object_[i]->id_)
-        {
-            return object_[i];
-        }
+        LOG_ERROR("Failed to find object {}", name);
     }
 
-    for (size_t i = 0; i < object_pool_.size(); i++)
+    return obj;
+}
+
+Object* Entities::GetObjectById(int id)
+{
+    auto it = object_by_id_.find(id);
+    if (it != object_by_id_.end())
     {
-        if (id == object_pool_[i]->id_)
-        {
-            return object_pool_[i];
-        }
+        return it->second;
     }
 
     LOG_ERROR("Failed to find object with id {}", id);
@@ -1866,6 +1910,56 @@ int Entities::GetObjectIdxById(int id)
     return -1;
 }
 
+uint64_t Entities::GetCollisionKey(int id0, int id1)
+{
+    uint32_t lo = static_cast<uint32_t>(MIN(id0, id1));
+    uint32_t hi = static_cast<uint32_t>(MAX(id0, id1));
+
+    return (static_cast<uint64_t>(hi) << 32) | lo;
+}
+
+bool Entities::IsColliding(Object* obj0, Object* obj1) const
+{
+    if (obj0 == nullptr || obj1 == nullptr || collision_keys_.empty())
+    {
+        return false;
+    }
+
+    return collision_keys_.find(GetCollisionKey(obj0->GetId(), obj1->GetId())) != collision_keys_.end();
+}
+
+void Entities::SyncState(SE_StateBuffer& buf)
+{
+    // objects created or deleted since state was saved can't be restored
+    std::vector<Object*> objects = object_;
+    objects.insert(objects.end(), object_pool_.begin(), object_pool_.end());
+    std::sort(objects.begin(), objects.end());
+    buf.Expect(objects);
+    if (!buf.IsOK())
+    {
+        return;
+    }
+
+    buf.Sync(object_, object_pool_, collision_keys_, nextId_, object_by_id_, object_by_name_);
+
+    for (size_t i = 0; i < objects.size() && buf.IsOK(); i++)
+    {
+        objects[i]->SyncState(buf);
+    }
+}
+
+void Object::SyncState(SE_StateBuffer& buf)
+{
+    // runtime state only, while type, dimensions, properties and similar remain as loaded. Referred objects and
+    // controllers are verified to be the same set as when saved, see Entities::SyncState() and ScenarioEngine::SyncState().
+    buf.Sync(overrideActionList, speed_, wheel_angle_, wheel_rot_, odometer_, reset_, dirty_, is_active_);
+    buf.Sync(end_of_road_timestamp_, off_road_timestamp_, stand_still_timestamp_);
+    buf.Sync(controllers_, headstart_time_, ghost_, ghost_Ego_, visibilityMask_, collisions_);
+    buf.Sync(junctionSelectorStrategy_, nextJunctionSelectorAngle_, sensor_pos_, state_old);
+    buf.Sync(trail_, trail_closest_pos_, ghost_trail_s_, trail_follow_index_);
+    pos_.SyncState(buf);
+}
+
 void Object::removeEvent(Event* event)
 {
     auto it = std::find(objectEvents_.begin(), objectEvents_.end(), event);
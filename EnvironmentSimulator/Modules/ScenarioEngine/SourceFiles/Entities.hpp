@@ -15,11 +15,14 @@
 #include <iostream>
 #include <string>
 #include <vector>
+#include <unordered_set>
+#include <unordered_map>
 #include "RoadManager.hpp"
 #include "CommonMini.hpp"
 #include "OSCBoundingBox.hpp"
 #include "OSCProperties.hpp"
 #include "Controller.hpp"
+#include "LaneOccupancy.hpp"
 #include <algorithm>
 
 namespace scenarioengine
@@ -229,6 +232,12 @@ namespace scenarioengine
         virtual ~Object()
         {
         }
+
+        /**
+                Save or restore runtime state of the object, see SE_StateBuffer
+        */
+        virtual void SyncState(SE_StateBuffer& buf);
+
         void SetEndOfRoad(bool state, double time = 0.0);
         bool IsEndOfRoad()
         {
@@ -756,6 +765,7 @@ namespace scenarioengine
         int                             DisconnectTrailer();
         void                            AlignTrailers();
         static std::string              Category2String(int category);
+        void                            SyncState(SE_StateBuffer& buf) override;
         std::shared_ptr<TrailerCoupler> trailer_coupler_;  // mounting point to any tow vehicle
         std::shared_ptr<TrailerHitch>   trailer_hitch_;    // mounting point to any tow vehicle
         std::vector<WheelData>          wheel_data;
@@ -927,7 +937,7 @@ namespace scenarioengine
     class Entities
     {
     public:
-        Entities() : nextId_(0)
+        Entities() : lane_occupancy_(this), nextId_(0)
         {
         }
         ~Entities()
@@ -959,8 +969,37 @@ namespace scenarioengine
         Object* GetObjectById(int id);
         int     GetObjectIdxById(int id);
 
+        /**
+                Create key identifying a pair of objects, independent of order
+                @param id0 Id of first object
+                @param id1 Id of second object
+                @return key composed by the two ids
+        */
+        static uint64_t GetCollisionKey(int id0, int id1);
+
+        /**
+                Check whether two objects were overlapping at latest collision detection, see ScenarioEngine::DetectCollisions()
+                @return true if registered as colliding, else false
+        */
+        bool IsColliding(Object* obj0, Object* obj1) const;
+
+        /**
+                Save or restore state of all entities, see SE_StateBuffer. Objects must be the same as when state was saved.
+        */
+        void SyncState(SE_StateBuffer& buf);
+
+        std::unordered_set<uint64_t> collision_keys_;  // key of each pair of currently colliding objects, see GetCollisionKey()
+        LaneOccupancy                lane_occupancy_;  // per frame index of objects per road and lane, see LaneOccupancy
+
     private:
         int nextId_;  // Is incremented for each new object created
+
+        // Lookup tables covering both active objects and the pool. Entries are added by addObject() and removed by removeObject().
+        // Names may be assigned after an object is added, so name entries are resolved on first lookup and verified on each hit.
+        std::unordered_map<int, Object*>         object_by_id_;
+        std::unordered_map<std::string, Object*> object_by_name_;
+
+        Object* FindObjectByName(const std::string& name);
     };
 
 }  // namespace scenarioengine
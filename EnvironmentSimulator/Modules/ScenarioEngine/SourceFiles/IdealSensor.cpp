@@ -10,6 +10,7 @@
  * https://sites.google.com/view/simulationscenarios
  */
 
+#include <algorithm>
 #include "IdealSensor.hpp"
 
 using namespace scenarioengine;
@@ -57,9 +58,94 @@ ObjectSensor::~ObjectSensor()
     free(hitList_);
 }
 
+// Update global position of the sensor and find its heading vector
+void ObjectSensor::UpdatePosition(double &hx, double &hy)
+{
+    RotateVec2D(1.0, 0.0, host_->pos_.GetH(), hx, hy);
+
+    double sensor_pos_x, sensor_pos_y;
+    RotateVec2D(pos_.x, pos_.y, host_->pos_.GetH(), sensor_pos_x, sensor_pos_y);
+    pos_.x_global = host_->pos_.GetX() + sensor_pos_x;
+    pos_.y_global = host_->pos_.GetY() + sensor_pos_y;
+    pos_.z_global = host_->pos_.GetZ() + pos_.z;
+}
+
+// Add object, known to be within range, to the hit list if within field of view
+void ObjectSensor::AddHitIfInView(Object *obj, double hx, double hy)
+{
+    if (nObj_ >= maxObj_)
+    {
+        return;
+    }
+
+    // Find vector from host to object
+    double xo = obj->pos_.GetX() - pos_.x_global;
+    double yo = obj->pos_.GetY() - pos_.y_global;
+
+    double xon, yon;
+    NormalizeVec2D(xo, yo, xon, yon);
+
+    // Find angle between heading vector and line to object
+    double angle     = acos(GetDotProduct2D(hx, hy, xon, yon));
+    double rel_angle = GetAbsAngleDifference(angle, pos_.h);
+    if (rel_angle < fovH_ / 2)
+    {
+        hitList_[nObj_].obj_ = obj;
+
+        // Calculate hit object position in sensor local coordinates
+        double xl, yl;
+        RotateVec2D(xo, yo, -GetAngleSum(host_->pos_.GetH(), pos_.h), xl, yl);
+
+        hitList_[nObj_].x_ = xl;
+        hitList_[nObj_].y_ = yl;
+        hitList_[nObj_].z_ = obj->pos_.GetZ() - pos_.z_global + 0.7;
+
+        // Calculate hit object velocity in sensor local coordinates
+        double xVelTarget = obj->pos_.GetVelX();
+        double yVelTarget = obj->pos_.GetVelY();
+        double xVelHost   = host_->pos_.GetVelX();
+        double yVelHost   = host_->pos_.GetVelY();
+        double angleHost  = -GetAngleSum(host_->pos_.GetH(), pos_.h);
+        double targetVelXforHost, targetVelYforHost;
+        Global2LocalCoordinates(xVelTarget, yVelTarget, xVelHost, yVelHost, angleHost, targetVelXforHost, targetVelYforHost);
+        hitList_[nObj_].velX_ = targetVelXforHost;
+        hitList_[nObj_].velY_ = targetVelYforHost;
+        hitList_[nObj_].velZ_ = 0.0;
+
+        // Calculate hit object acceleration in sensor local coordinates
+        double xAccTarget = obj->pos_.GetAccX();
+        double yAccTarget = obj->pos_.GetAccY();
+        double xAccHost   = host_->pos_.GetAccX();
+        double yAccHost   = host_->pos_.GetAccY();
+        double targetAccXforHost, targetAccYforHost;
+        Global2LocalCoordinates(xAccTarget, yAccTarget, xAccHost, yAccHost, angleHost, targetAccXforHost, targetAccYforHost);
+        hitList_[nObj_].accX_ = targetAccXforHost;
+        hitList_[nObj_].accY_ = targetAccYforHost;
+        hitList_[nObj_].accZ_ = 0.0;
+
+        // Calculate hit object yaw, yaw rate and yaw acceleration in sensor local coordinates
+        double yawTarget     = obj->pos_.GetH();
+        double yawHost       = GetAngleSum(host_->pos_.GetH(), pos_.h);
+        hitList_[nObj_].yaw_ = GetAngleDifference(yawTarget, yawHost);
+
+        double yawRateTarget     = obj->pos_.GetHRate();
+        double yawRateHost       = host_->pos_.GetHRate();
+        hitList_[nObj_].yawRate_ = GetAngleDifference(yawRateTarget, yawRateHost);
+
+        double yawAccTarget     = obj->pos_.GetHAcc();
+        double yawAccHost       = host_->pos_.GetHAcc();
+        hitList_[nObj_].yawAcc_ = GetAngleDifference(yawAccTarget, yawAccHost);
+
+        nObj_++;
+    }
+}
+
 void ObjectSensor::Update()
 {
+    double hx, hy;
+
     nObj_ = 0;
+    UpdatePosition(hx, hy);
 
     for (size_t i = 0; i < entities_->object_.size(); i++)
     {
@@ -76,25 +162,9 @@ void ObjectSensor::Update()
             continue;
         }
 
-        // Check whether object is within field of view
-
-        // find out angle between heading vector and line to object
-        double hx = 1.0;
-        double hy = 0.0;
-        double hx2, hy2;
-        RotateVec2D(hx, hy, host_->pos_.GetH(), hx2, hy2);
-
-        double sensor_pos_x, sensor_pos_y;
-        RotateVec2D(pos_.x, pos_.y, host_->pos_.GetH(), sensor_pos_x, sensor_pos_y);
-        pos_.x_global = host_->pos_.GetX() + sensor_pos_x;
-        pos_.y_global = host_->pos_.GetY() + sensor_pos_y;
-        pos_.z_global = host_->pos_.GetZ() + pos_.z;
-
-        // Find vector from host to object
-        double xo = obj->pos_.GetX() - pos_.x_global;
-        double yo = obj->pos_.GetY() - pos_.y_global;
-
         // First check distance
+        double xo      = obj->pos_.GetX() - pos_.x_global;
+        double yo      = obj->pos_.GetY() - pos_.y_global;
         double dist_sq = (xo * xo + yo * yo);
         if (dist_sq < near_sq_ || dist_sq > far_sq_)
         {
@@ -102,59 +172,149 @@ void ObjectSensor::Update()
             continue;
         }
 
-        double xon, yon;
-        NormalizeVec2D(xo, yo, xon, yon);
+        AddHitIfInView(obj, hx, hy);
+    }
+}
+
+void ObjectSensor::Update(std::vector<ObjectSensor *> &sensors, SensorObjectGrid &grid)
+{
+    if (sensors.empty())
+    {
+        return;
+    }
+
+    // cell size of the longest range makes the range of any sensor cover at most 3 x 3 cells
+    double cell_size = 0.0;
+    for (auto sensor : sensors)
+    {
+        cell_size = MAX(cell_size, sensor->far_);
+    }
+    grid.Update(sensors[0]->entities_, cell_size);
+
+    for (auto sensor : sensors)
+    {
+        double hx, hy;
+
+        sensor->nObj_ = 0;
+        sensor->UpdatePosition(hx, hy);
+        grid.Query(sensor->pos_.x_global, sensor->pos_.y_global, sensor->near_sq_, sensor->far_sq_, sensor->candidates_);
+
+        for (auto index : sensor->candidates_)
+        {
+            Object *obj = sensor->entities_->object_[static_cast<unsigned int>(index)];
+            if (obj != sensor->host_)
+            {
+                sensor->AddHitIfInView(obj, hx, hy);
+            }
+        }
+    }
+}
+
+void SensorObjectGrid::Update(Entities *entities, double cell_size)
+{
+    gathered_.clear();
+    min_x_ = LARGE_NUMBER;
+    min_y_ = LARGE_NUMBER;
+
+    double max_x = -LARGE_NUMBER;
+    double max_y = -LARGE_NUMBER;
+    for (size_t i = 0; i < entities->object_.size(); i++)
+    {
+        Object *obj = entities->object_[i];
+        if (!obj->IsGhost() && (obj->visibilityMask_ & Object::Visibility::SENSORS))
+        {
+            gathered_.push_back(static_cast<int>(i));
+            min_x_ = MIN(min_x_, obj->pos_.GetX());
+            min_y_ = MIN(min_y_, obj->pos_.GetY());
+            max_x  = MAX(max_x, obj->pos_.GetX());
+            max_y  = MAX(max_y, obj->pos_.GetY());
+        }
+    }
+
+    size_t n = gathered_.size();
+    if (n == 0)
+    {
+        nx_ = ny_ = 0;
+        cell_start_.assign(1, 0);
+        return;
+    }
+
+    // limit number of cells, in case objects are spread out far compared to the cell size
+    double max_cells = static_cast<double>(MAX(static_cast<size_t>(16), 4 * n));
+    cell_size_       = MAX(cell_size, SMALL_NUMBER);
+    cell_size_       = MAX(cell_size_, sqrt((max_x - min_x_ + cell_size_) * (max_y - min_y_ + cell_size_) / max_cells));
+    nx_              = static_cast<int>((max_x - min_x_) / cell_size_) + 1;
+    ny_              = static_cast<int>((max_y - min_y_) / cell_size_) + 1;
+
+    // counting sort of objects into cells, keeping object order within each cell
+    cell_start_.assign(static_cast<size_t>(nx_ * ny_) + 1, 0);
+    cell_.resize(n);
+    for (size_t i = 0; i < n; i++)
+    {
+        Object *obj = entities->object_[static_cast<unsigned int>(gathered_[i])];
+        int     cx  = MIN(nx_ - 1, static_cast<int>((obj->pos_.GetX() - min_x_) / cell_size_));
+        int     cy  = MIN(ny_ - 1, static_cast<int>((obj->pos_.GetY() - min_y_) / cell_size_));
+        cell_[i]    = cy * nx_ + cx;
+        cell_start_[static_cast<unsigned int>(cell_[i] + 1)]++;
+    }
+    for (size_t i = 1; i < cell_start_.size(); i++)
+    {
+        cell_start_[i] += cell_start_[i - 1];
+    }
+
+    index_.resize(n);
+    x_.resize(n);
+    y_.resize(n);
+    std::vector<int> &pos = cell_;  // reuse as insert position, cell is not needed after this pass
+    for (size_t i = 0; i < n; i++)
+    {
+        Object      *obj = entities->object_[static_cast<unsigned int>(gathered_[i])];
+        unsigned int k   = static_cast<unsigned int>(cell_start_[static_cast<unsigned int>(pos[i])]++);
+        index_[k]        = gathered_[i];
+        x_[k]            = obj->pos_.GetX();
+        y_[k]            = obj->pos_.GetY();
+    }
+
+    // restore cell start positions, shifted by the insertion above
+    for (size_t i = cell_start_.size() - 1; i > 0; i--)
+    {
+        cell_start_[i] = cell_start_[i - 1];
+    }
+    cell_start_[0] = 0;
+}
 
-        // Find angle to object
-        double angle     = acos(GetDotProduct2D(hx2, hy2, xon, yon));
-        double rel_angle = GetAbsAngleDifference(angle, pos_.h);
-        if (rel_angle < fovH_ / 2)
+void SensorObjectGrid::Query(double x, double y, double near_sq, double far_sq, std::vector<int> &result)
+{
+    result.clear();
+
+    if (nx_ == 0)
+    {
+        return;
+    }
+
+    double far = sqrt(far_sq);
+    int    cx0 = static_cast<int>(CLAMP(floor((x - far - min_x_) / cell_size_), 0.0, nx_ - 1.0));
+    int    cx1 = static_cast<int>(CLAMP(floor((x + far - min_x_) / cell_size_), 0.0, nx_ - 1.0));
+    int    cy0 = static_cast<int>(CLAMP(floor((y - far - min_y_) / cell_size_), 0.0, ny_ - 1.0));
+    int    cy1 = static_cast<int>(CLAMP(floor((y + far - min_y_) / cell_size_), 0.0, ny_ - 1.0));
+
+    for (int cy = cy0; cy <= cy1; cy++)
+    {
+        // cells of a row are adjacent in the sorted arrays, test them as one contiguous range
+        int k0 = cell_start_[static_cast<unsigned int>(cy * nx_ + cx0)];
+        int k1 = cell_start_[static_cast<unsigned int>(cy * nx_ + cx1 + 1)];
+        for (int k = k0; k < k1; k++)
         {
-            hitList_[nObj_].obj_ = obj;
-
-            // Calculate hit object position in sensor local coordinates
-            double xl, yl;
-            RotateVec2D(xo, yo, -GetAngleSum(host_->pos_.GetH(), pos_.h), xl, yl);
-
-            hitList_[nObj_].x_ = xl;
-            hitList_[nObj_].y_ = yl;
-            hitList_[nObj_].z_ = obj->pos_.GetZ() - pos_.z_global + 0.7;
-
-            // Calculate hit object velocity in sensor local coordinates
-            double xVelTarget = obj->pos_.GetVelX();
-            double yVelTarget = obj->pos_.GetVelY();
-            double xVelHost   = host_->pos_.GetVelX();
-            double yVelHost   = host_->pos_.GetVelY();
-            double angleHost  = -GetAngleSum(host_->pos_.GetH(), pos_.h);
-            double targetVelXforHost, targetVelYforHost;
-            Global2LocalCoordinates(xVelTarget, yVelTarget, xVelHost, yVelHost, angleHost, targetVelXforHost, targetVelYforHost);
-            hitList_[nObj_].velX_ = targetVelXforHost;
-            hitList_[nObj_].velY_ = targetVelYforHost;
-
-            // Calculate hit object acceleration in sensor local coordinates
-            double xAccTarget = obj->pos_.GetAccX();
-            double yAccTarget = obj->pos_.GetAccY();
-            double xAccHost   = host_->pos_.GetAccX();
-            double yAccHost   = host_->pos_.GetAccY();
-            double targetAccXforHost, targetAccYforHost;
-            Global2LocalCoordinates(xAccTarget, yAccTarget, xAccHost, yAccHost, angleHost, targetAccXforHost, targetAccYforHost);
-            hitList_[nObj_].accX_ = targetAccXforHost;
-            hitList_[nObj_].accY_ = targetAccYforHost;
-
-            // Calculate hit object yaw, yaw rate and yaw acceleration in sensor local coordinates
-            double yawTarget     = obj->pos_.GetH();
-            double yawHost       = GetAngleSum(host_->pos_.GetH(), pos_.h);
-            hitList_[nObj_].yaw_ = GetAngleDifference(yawTarget, yawHost);
-
-            double yawRateTarget     = obj->pos_.GetHRate();
-            double yawRateHost       = host_->pos_.GetHRate();
-            hitList_[nObj_].yawRate_ = GetAngleDifference(yawRateTarget, yawRateHost);
-
-            double yawAccTarget     = obj->pos_.GetHAcc();
-            double yawAccHost       = host_->pos_.GetHAcc();
-            hitList_[nObj_].yawAcc_ = GetAngleDifference(yawAccTarget, yawAccHost);
-
-            nObj_++;
+            double xo      = x_[static_cast<unsigned int>(k)] - x;
+            double yo      = y_[static_cast<unsigned int>(k)] - y;
+            double dist_sq = (xo * xo + yo * yo);
+            if (!(dist_sq < near_sq || dist_sq > far_sq))
+            {
+                result.push_back(index_[static_cast<unsigned int>(k)]);
+            }
         }
     }
-}
\ No newline at end of file
+
+    // report in object order, as when looping over all objects
+    std::sort(result.begin(), result.end());
+}
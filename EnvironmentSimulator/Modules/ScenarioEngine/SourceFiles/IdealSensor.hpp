@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include <vector>
 #include "ScenarioEngine.hpp"
 
 namespace scenarioengine
@@ -50,6 +51,44 @@ namespace scenarioengine
         };
     };
 
+    /**
+            Positions of the objects visible to sensors, gathered once per frame and bucketed into a uniform grid.
+            Lets all object sensors cull candidates without looping over every object.
+    */
+    class SensorObjectGrid
+    {
+    public:
+        /**
+                Gather object positions and sort them into grid cells
+                @param entities Collection of objects
+                @param cell_size Preferred cell size, e.g. longest sensor range. Might be increased to limit number of cells.
+        */
+        void Update(Entities *entities, double cell_size);
+
+        /**
+                Find objects within a distance range from a point
+                @param x X coordinate of point
+                @param y Y coordinate of point
+                @param near_sq Near limit, squared distance
+                @param far_sq Far limit, squared distance
+                @param result Indices, into the object list of the entities, of objects within range. Ascending order.
+        */
+        void Query(double x, double y, double near_sq, double far_sq, std::vector<int> &result);
+
+    private:
+        double              min_x_     = 0.0;
+        double              min_y_     = 0.0;
+        double              cell_size_ = 1.0;
+        int                 nx_        = 0;
+        int                 ny_        = 0;
+        std::vector<int>    cell_start_;  // first position in sorted arrays per cell, nx_ * ny_ + 1 entries
+        std::vector<int>    cell_;        // cell of each gathered object
+        std::vector<int>    index_;       // object index, sorted by cell
+        std::vector<double> x_;           // object x coordinate, sorted by cell
+        std::vector<double> y_;           // object y coordinate, sorted by cell
+        std::vector<int>    gathered_;    // indices of gathered objects, in object order
+    };
+
     class ObjectSensor : public BaseSensor
     {
     public:
@@ -94,8 +133,19 @@ namespace scenarioengine
         ~ObjectSensor();
         void Update();
 
+        /**
+                Update a set of sensors in one pass, culling candidate objects by a common grid. Same result as Update() of each sensor.
+                @param sensors Sensors to update, all referring to the same entities
+                @param grid Grid to use, updated by this function
+        */
+        static void Update(std::vector<ObjectSensor *> &sensors, SensorObjectGrid &grid);
+
     private:
-        Entities *entities_;  // Reference to the global collection of objects within the scenario
+        Entities        *entities_;  // Reference to the global collection of objects within the scenario
+        std::vector<int> candidates_;
+
+        void UpdatePosition(double &hx, double &hy);
+        void AddHitIfInView(Object *obj, double hx, double hy);
     };
 
 }  // namespace scenarioengine
@@ -0,0 +1,406 @@
+/*
+ * esmini - Environment Simulator Minimalistic
+ * https://github.com/esmini/esmini
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) partners of Simulation Scenarios
+ * https://sites.google.com/view/simulationscenarios
+ */
+
+#include <algorithm>
+#include <queue>
+#include "LaneOccupancy.hpp"
+#include "Entities.hpp"
+
+using namespace scenarioengine;
+
+const double LaneOccupancy::cell_size_ = 25.0;
+
+// Added to all distance limits, making sure to include objects at the limit regardless of rounding
+#define LANE_OCCUPANCY_MARGIN 0.01
+
+void LaneOccupancy::Build()
+{
+    Clear();
+
+    entries_.reserve(entities_->object_.size());
+    for (size_t i = 0; i < entities_->object_.size(); i++)
+    {
+        entries_.push_back(CreateEntry(entities_->object_[i], static_cast<int>(i)));
+        idx_[entries_.back().obj] = static_cast<int>(i);
+        Insert(entries_.back());
+
+        if (i == 0 || entries_.back().obj->GetSpeed() < min_speed_)
+        {
+            min_speed_ = entries_.back().obj->GetSpeed();
+        }
+    }
+
+    built_ = true;
+}
+
+void LaneOccupancy::Update(Object* obj)
+{
+    if (!built_ || obj == nullptr)
+    {
+        return;
+    }
+
+    auto it = idx_.find(obj);
+    if (it == idx_.end())
+    {
+        // new object, affects order
+        Build();
+        return;
+    }
+
+    Remove(entries_[static_cast<size_t>(it->second)]);
+    entries_[static_cast<size_t>(it->second)] = CreateEntry(obj, it->second);
+    Insert(entries_[static_cast<size_t>(it->second)]);
+    min_speed_ = MIN(min_speed_, obj->GetSpeed());
+}
+
+void LaneOccupancy::Clear()
+{
+    built_ = false;
+    entries_.clear();
+    idx_.clear();
+    roads_.clear();
+    cells_.clear();
+    max_extent_ = 0.0;
+    min_speed_  = 0.0;
+}
+
+LaneOccupancy::CellKey LaneOccupancy::GetCellKey(double x, double y) const
+{
+    unsigned int cx = static_cast<unsigned int>(static_cast<int>(floor(x / cell_size_)));
+    unsigned int cy = static_cast<unsigned int>(static_cast<int>(floor(y / cell_size_)));
+
+    return (static_cast<CellKey>(cx) << 32) | cy;
+}
+
+LaneOccupancy::Entry LaneOccupancy::CreateEntry(Object* obj, int idx)
+{
+    Entry entry;
+    entry.obj     = obj;
+    entry.idx     = idx;
+    entry.road_id = roadmanager::Position::GetOpenDrive()->GetRoadById(obj->pos_.GetTrackId()) != nullptr ? obj->pos_.GetTrackId() : ID_UNDEFINED;
+    entry.lane_id = obj->pos_.GetLaneId();
+    entry.s       = obj->pos_.GetS();
+    entry.x       = obj->pos_.GetX();
+    entry.y       = obj->pos_.GetY();
+
+    double extent =
+        sqrt(pow(fabs(static_cast<double>(obj->boundingbox_.center_.x_)) + static_cast<double>(obj->boundingbox_.dimensions_.length_) / 2.0, 2) +
+             pow(fabs(static_cast<double>(obj->boundingbox_.center_.y_)) + static_cast<double>(obj->boundingbox_.dimensions_.width_) / 2.0, 2));
+    max_extent_ = MAX(max_extent_, extent);
+
+    return entry;
+}
+
+void LaneOccupancy::Insert(const Entry& entry)
+{
+    if (entry.road_id != ID_UNDEFINED)
+    {
+        std::vector<Entry>& road = roads_[entry.road_id];
+        road.insert(std::upper_bound(road.begin(), road.end(), entry.s, [](double s, const Entry& e) { return s < e.s; }), entry);
+    }
+
+    cells_[GetCellKey(entry.x, entry.y)].push_back(entry.idx);
+}
+
+void LaneOccupancy::Remove(const Entry& entry)
+{
+    if (entry.road_id != ID_UNDEFINED)
+    {
+        std::vector<Entry>& road = roads_[entry.road_id];
+        for (auto it = std::lower_bound(road.begin(), road.end(), entry.s, [](const Entry& e, double s) { return e.s < s; }); it != road.end(); it++)
+        {
+            if (it->obj == entry.obj)
+            {
+                road.erase(it);
+                break;
+            }
+        }
+    }
+
+    std::vector<int>& cell = cells_[GetCellKey(entry.x, entry.y)];
+    cell.erase(std::remove(cell.begin(), cell.end(), entry.idx), cell.end());
+}
+
+void LaneOccupancy::AddInRange(id_t road_id, double s_min, double s_max)
+{
+    auto it = roads_.find(road_id);
+    if (it == roads_.end())
+    {
+        return;
+    }
+
+    const std::vector<Entry>& road = it->second;
+    for (auto e = std::lower_bound(road.begin(), road.end(), s_min, [](const Entry& en, double s) { return en.s < s; });
+         e != road.end() && e->s <= s_max;
+         e++)
+    {
+        found_.push_back(e->idx);
+    }
+}
+
+void LaneOccupancy::GetAll(std::vector<Object*>& result) const
+{
+    result = entities_->object_;
+}
+
+void LaneOccupancy::GetFound(std::vector<Object*>& result)
+{
+    std::sort(found_.begin(), found_.end());
+    found_.erase(std::unique(found_.begin(), found_.end()), found_.end());
+
+    result.clear();
+    for (int idx : found_)
+    {
+        result.push_back(entries_[static_cast<size_t>(idx)].obj);
+    }
+}
+
+void LaneOccupancy::FindAlongRoad(const roadmanager::Position& pos, double dist)
+{
+    roadmanager::OpenDrive* odr        = roadmanager::Position::GetOpenDrive();
+    roadmanager::Road*      start_road = odr->GetRoadById(pos.GetTrackId());
+
+    if (start_road == nullptr)
+    {
+        // no path can be found from outside the road network
+        return;
+    }
+
+    double max_dist = dist + LANE_OCCUPANCY_MARGIN;
+
+    // On same road the distance is simply delta s, see RoadPath::Calculate()
+    AddInRange(start_road->GetId(), pos.GetS() - max_dist, pos.GetS() + max_dist);
+
+    // Other roads: Find shortest distance to each road within range. Each road is connected in both ends to all roads
+    // of its links, giving a lower bound of the path length found by RoadPath::Calculate().
+    typedef std::pair<double, roadmanager::Road*> QueueEntry;
+    std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> queue;
+    bool                                                                                unresolved = false;
+
+    road_dist_.clear();
+    queue.push({0.0, start_road});
+
+    while (!queue.empty() && !unresolved)
+    {
+        QueueEntry entry = queue.top();
+        queue.pop();
+
+        if (entry.second != start_road && entry.first > road_dist_[entry.second])
+        {
+            // stale entry
+            continue;
+        }
+
+        for (roadmanager::LinkType link_type : {roadmanager::LinkType::PREDECESSOR, roadmanager::LinkType::SUCCESSOR})
+        {
+            roadmanager::RoadLink* link = entry.second->GetLink(link_type);
+            if (link == nullptr)
+            {
+                continue;
+            }
+
+            double link_dist = entry.first + entry.second->GetLength();
+            if (entry.second == start_road)
+            {
+                link_dist = link_type == roadmanager::LinkType::PREDECESSOR ? pos.GetS() : start_road->GetLength() - pos.GetS();
+            }
+
+            odr->GetLinkedRoads(entry.second, link, linked_roads_);
+            for (roadmanager::Road* road : linked_roads_)
+            {
+                if (road == nullptr)
+                {
+                    // path search gives up and reports success, see RoadPath::Calculate(). Since it might inspect one
+                    // link beyond max distance, check regardless of distance.
+                    if (link->GetElementType() == roadmanager::RoadLink::ElementType::ELEMENT_TYPE_JUNCTION)
+                    {
+                        unresolved = true;
+                    }
+                }
+                else if (road != start_road && link_dist <= max_dist)
+                {
+                    auto it = road_dist_.find(road);
+                    if (it == road_dist_.end() || link_dist < it->second)
+                    {
+                        road_dist_[road] = link_dist;
+                        queue.push({link_dist, road});
+                    }
+                }
+            }
+        }
+    }
+
+    if (unresolved)
+    {
+        for (auto& road : roads_)
+        {
+            for (auto& entry : road.second)
+            {
+                found_.push_back(entry.idx);
+            }
+        }
+    }
+    else
+    {
+        for (auto& road : road_dist_)
+        {
+            // objects close enough to either end of the road
+            double remaining = max_dist - road.second;
+            AddInRange(road.first->GetId(), -LARGE_NUMBER, remaining);
+            AddInRange(road.first->GetId(), road.first->GetLength() - remaining, LARGE_NUMBER);
+        }
+    }
+}
+
+void LaneOccupancy::FindInRadius(double x, double y, double radius)
+{
+    double max_dist = radius + LANE_OCCUPANCY_MARGIN;
+    int    cx_min   = static_cast<int>(floor((x - max_dist) / cell_size_));
+    int    cx_max   = static_cast<int>(floor((x + max_dist) / cell_size_));
+    int    cy_min   = static_cast<int>(floor((y - max_dist) / cell_size_));
+    int    cy_max   = static_cast<int>(floor((y + max_dist) / cell_size_));
+
+    for (int cx = cx_min; cx <= cx_max; cx++)
+    {
+        for (int cy = cy_min; cy <= cy_max; cy++)
+        {
+            auto it = cells_.find((static_cast<CellKey>(static_cast<unsigned int>(cx)) << 32) | static_cast<unsigned int>(cy));
+            if (it == cells_.end())
+            {
+                continue;
+            }
+
+            for (int idx : it->second)
+            {
+                const Entry& e = entries_[static_cast<size_t>(idx)];
+                if ((e.x - x) * (e.x - x) + (e.y - y) * (e.y - y) <= max_dist * max_dist)
+                {
+                    found_.push_back(idx);
+                }
+            }
+        }
+    }
+}
+
+void LaneOccupancy::GetObjectsAlongRoad(const roadmanager::Position& pos, double dist, std::vector<Object*>& result)
+{
+    if (!built_)
+    {
+        GetAll(result);
+        return;
+    }
+
+    found_.clear();
+    FindAlongRoad(pos, dist);
+    GetFound(result);
+}
+
+void LaneOccupancy::GetObjectsInRadius(double x, double y, double radius, std::vector<Object*>& result)
+{
+    if (!built_)
+    {
+        GetAll(result);
+        return;
+    }
+
+    found_.clear();
+    FindInRadius(x, y, radius);
+    GetFound(result);
+}
+
+void LaneOccupancy::GetObjectsNearby(const roadmanager::Position& pos, double dist, double radius, std::vector<Object*>& result)
+{
+    if (!built_)
+    {
+        GetAll(result);
+        return;
+    }
+
+    found_.clear();
+    FindAlongRoad(pos, dist);
+    FindInRadius(pos.GetX(), pos.GetY(), radius);
+    GetFound(result);
+}
+
+void LaneOccupancy::GetObjectsInLane(id_t road_id, int lane_id, double s_min, double s_max, std::vector<Object*>& result) const
+{
+    result.clear();
+
+    auto it = roads_.find(road_id);
+    if (it == roads_.end())
+    {
+        return;
+    }
+
+    const std::vector<Entry>& road = it->second;
+    for (auto e = std::lower_bound(road.begin(), road.end(), s_min, [](const Entry& en, double s) { return en.s < s; });
+         e != road.end() && e->s <= s_max;
+         e++)
+    {
+        if (e->lane_id == lane_id)
+        {
+            result.push_back(e->obj);
+        }
+    }
+}
+
+Object* LaneOccupancy::GetNearestInLane(Object* obj, int lane_offset, bool ahead, double dist) const
+{
+    auto it_idx = idx_.find(obj);
+    if (it_idx == idx_.end())
+    {
+        return nullptr;
+    }
+
+    const Entry& entry = entries_[static_cast<size_t>(it_idx->second)];
+    auto         it    = roads_.find(entry.road_id);
+    if (it == roads_.end())
+    {
+        return nullptr;
+    }
+
+    // Lane IDs increase to the left along the road direction, skipping the center lane 0
+    bool forward = IsAngleForward(obj->pos_.GetHRelative());
+    int  delta   = forward ? lane_offset : -lane_offset;
+    int  lane_id = entry.lane_id + delta;
+    if (entry.lane_id != 0 && SIGN(lane_id) != SIGN(entry.lane_id))
+    {
+        lane_id += SIGN(delta);
+    }
+
+    // Step in increasing s when looking ahead along road direction or behind against it
+    const std::vector<Entry>& road       = it->second;
+    bool                      increasing = (forward == ahead);
+    Object*                   nearest    = nullptr;
+
+    if (increasing)
+    {
+        for (auto e = std::upper_bound(road.begin(), road.end(), entry.s, [](double s, const Entry& en) { return s < en.s; });
+             e != road.end() && e->s <= entry.s + dist && nearest == nullptr;
+             e++)
+        {
+            nearest = e->lane_id == lane_id ? e->obj : nullptr;
+        }
+    }
+    else
+    {
+        for (auto e = std::lower_bound(road.begin(), road.end(), entry.s, [](const Entry& en, double s) { return en.s < s; });
+             e != road.begin() && (e - 1)->s >= entry.s - dist && nearest == nullptr;
+             e--)
+        {
+            nearest = (e - 1)->lane_id == lane_id ? (e - 1)->obj : nullptr;
+        }
+    }
+
+    return nearest;
+}
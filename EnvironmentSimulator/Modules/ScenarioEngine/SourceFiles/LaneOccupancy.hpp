@@ -0,0 +1,164 @@
+/*
+ * esmini - Environment Simulator Minimalistic
+ * https://github.com/esmini/esmini
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) partners of Simulation Scenarios
+ * https://sites.google.com/view/simulationscenarios
+ */
+
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+#include "RoadManager.hpp"
+
+namespace scenarioengine
+{
+    class Object;
+    class Entities;
+
+    /**
+            Index of the active objects per road, sorted by s, and per cell of a uniform grid.
+            Built by the scenario engine once per frame before stepping controllers, letting controllers find lead vehicles
+            and neighbours without measuring the distance to every object. Objects moved while controllers step are updated
+            by the scenario engine. When not built, distance queries return all active objects and lane queries nothing.
+
+            Results are ordered as the objects in Entities::object_, so that picking e.g. the closest object gives the same
+            result as looping over all objects.
+    */
+    class LaneOccupancy
+    {
+    public:
+        explicit LaneOccupancy(Entities* entities) : entities_(entities)
+        {
+        }
+
+        struct Entry
+        {
+            Object* obj;
+            int     idx;      // index in Entities::object_
+            id_t    road_id;  // ID_UNDEFINED if not on any road
+            int     lane_id;
+            double  s;
+            double  x;
+            double  y;
+        };
+
+        /**
+                Index all active objects, any previous content is discarded
+        */
+        void Build();
+
+        /**
+                Update index of an object after it has been moved. An object not yet indexed is added.
+                @param obj Object to update
+        */
+        void Update(Object* obj);
+
+        /**
+                Discard the index, following queries will return all objects
+        */
+        void Clear();
+
+        bool IsBuilt() const
+        {
+            return built_;
+        }
+
+        /**
+                Find objects possibly within a distance along the road network, i.e. all objects for which
+                Position::Delta(pos, object position, maxDist) might succeed. Objects not on any road are excluded.
+                @param pos Position to measure from
+                @param dist Max distance along roads
+                @param result Found objects, any previous content is discarded
+        */
+        void GetObjectsAlongRoad(const roadmanager::Position& pos, double dist, std::vector<Object*>& result);
+
+        /**
+                Find objects with reference point possibly within a radius. Includes objects not on any road.
+                @param x X coordinate of center
+                @param y Y coordinate of center
+                @param radius Max distance from center
+                @param result Found objects, any previous content is discarded
+        */
+        void GetObjectsInRadius(double x, double y, double radius, std::vector<Object*>& result);
+
+        /**
+                Find objects possibly within a distance along the road network or within a radius, see GetObjectsAlongRoad()
+                and GetObjectsInRadius()
+                @param pos Position to measure from
+                @param dist Max distance along roads
+                @param radius Max distance from position
+                @param result Found objects, any previous content is discarded
+        */
+        void GetObjectsNearby(const roadmanager::Position& pos, double dist, double radius, std::vector<Object*>& result);
+
+        /**
+                Find objects in a lane of a road segment, within an s range
+                @param road_id Road ID
+                @param lane_id Lane ID
+                @param s_min Start of range
+                @param s_max End of range
+                @param result Found objects, sorted by s, any previous content is discarded
+        */
+        void GetObjectsInLane(id_t road_id, int lane_id, double s_min, double s_max, std::vector<Object*>& result) const;
+
+        /**
+                Find nearest object in own or adjacent lane, ahead or behind in driving direction, on the same road segment
+                @param obj Object to measure from
+                @param lane_offset Relative lane, 0 = own, 1 = next lane to the left, -1 = next lane to the right
+                @param ahead Look ahead if true, else behind
+                @param dist Max distance, measured along s
+                @return Nearest object, nullptr if none found
+        */
+        Object* GetNearestInLane(Object* obj, int lane_offset, bool ahead, double dist) const;
+
+        /**
+                Max distance from reference point to any bounding box corner of indexed objects
+        */
+        double GetMaxExtent() const
+        {
+            return max_extent_;
+        }
+
+        /**
+                Lowest speed of indexed objects, possibly lower if objects have been updated
+        */
+        double GetMinSpeed() const
+        {
+            return min_speed_;
+        }
+
+    private:
+        typedef unsigned long long CellKey;
+
+        Entities*                                      entities_;
+        bool                                           built_ = false;
+        std::vector<Entry>                             entries_;  // entry of each object, in object order
+        std::unordered_map<const Object*, int>         idx_;      // object to index in entries_
+        std::unordered_map<id_t, std::vector<Entry>>   roads_;    // entries per road, sorted by s
+        std::unordered_map<CellKey, std::vector<int>>  cells_;    // object indices per grid cell
+        std::unordered_map<roadmanager::Road*, double> road_dist_;
+        std::vector<roadmanager::Road*>                linked_roads_;
+        std::vector<int>                               found_;
+        double                                         max_extent_ = 0.0;
+        double                                         min_speed_  = 0.0;
+
+        static const double cell_size_;
+
+        CellKey GetCellKey(double x, double y) const;
+        Entry   CreateEntry(Object* obj, int idx);
+        void    Insert(const Entry& entry);
+        void    Remove(const Entry& entry);
+        void    AddInRange(id_t road_id, double s_min, double s_max);
+        void    FindAlongRoad(const roadmanager::Position& pos, double dist);
+        void    FindInRadius(double x, double y, double radius);
+        void    GetAll(std::vector<Object*>& result) const;
+        void    GetFound(std::vector<Object*>& result);
+    };
+
+}  // namespace scenarioengine
@@ -13,6 +13,7 @@
 #include "CommonMini.hpp"
 #include "OSIReporter.hpp"
 #include "OSITrafficCommand.hpp"
+#include <google/protobuf/io/coded_stream.h>
 #include <cmath>
 #include <string>
 #include <utility>
@@ -31,64 +32,36 @@
 
 #define OSI_OUT_PORT          48198
 #define OSI_MAX_UDP_DATA_SIZE 8192
+#define OSI_OUTPUT_FILE       0  // async output channels
+#define OSI_OUTPUT_UDP        1
 
 // Large OSI messages needs to be split for UDP transmission
 // This struct must be mached on receiver side
-static struct
+static thread_local struct
 {
     int          counter;
     unsigned int datasize;
     char         data[OSI_MAX_UDP_DATA_SIZE];
 } osi_udp_buf;
 
-typedef struct
-{
-    std::string  ground_truth;
-    unsigned int size;
-} OSIGroundTruth;
-
-typedef struct
-{
-    std::string  osi_lane_info;
-    unsigned int size;
-} OSIRoadLane;
 
-typedef struct
-{
-    std::string  osi_lane_boundary_info;
-    unsigned int size;
-} OSIRoadLaneBoundary;
+using namespace scenarioengine;
 
-typedef struct
+// Append message as a length delimited field, encoded exactly as when serializing the parent message
+static void AppendOSIMessageField(std::string &buf, unsigned int field_number, const google::protobuf::MessageLite &msg)
 {
-    std::string  traffic_command;
-    unsigned int size;
-} OSITrafficCommand;
+    using google::protobuf::io::CodedOutputStream;
 
-static struct
-{
-    osi3::SensorData                 *sd;
-    osi3::GroundTruth                *gt;
-    osi3::StationaryObject           *sobj;
-    osi3::TrafficSign                *ts;
-    osi3::MovingObject               *mobj;
-    std::vector<osi3::Lane *>         ln;
-    std::vector<osi3::LaneBoundary *> lnb;
-} obj_osi_internal;
-
-static struct
-{
-    osi3::GroundTruth    *gt;
-    osi3::SensorView     *sv;
-    osi3::TrafficCommand *tc;
-} obj_osi_external;
+    uint32_t tag  = (field_number << 3) | 2;  // wire type 2 = length delimited
+    uint32_t size = static_cast<uint32_t>(msg.ByteSizeLong());
+    size_t   pos  = buf.size();
 
-using namespace scenarioengine;
-
-static OSIGroundTruth      osiGroundTruth;
-static OSIRoadLane         osiRoadLane;
-static OSIRoadLaneBoundary osiRoadLaneBoundary;
-static OSITrafficCommand   osiTrafficCommand;
+    buf.resize(pos + CodedOutputStream::VarintSize32(tag) + CodedOutputStream::VarintSize32(size) + size);
+    uint8_t *target = reinterpret_cast<uint8_t *>(&buf[pos]);
+    target          = CodedOutputStream::WriteVarint32ToArray(tag, target);
+    target          = CodedOutputStream::WriteVarint32ToArray(size, target);
+    msg.SerializeWithCachedSizesToArray(target);
+}
 
 // ScenarioGateway
 
@@ -126,6 +99,9 @@ OSIReporter::OSIReporter(ScenarioEngine *scenarioengine)
 
 OSIReporter::~OSIReporter()
 {
+    // write any queued messages before closing file and socket
+    SetAsyncOutput(0);
+
     if (obj_osi_internal.gt)
     {
         obj_osi_internal.gt->Clear();
@@ -163,6 +139,11 @@ OSIReporter::~OSIReporter()
     osiRoadLane.size       = 0;
     osiTrafficCommand.size = 0;
 
+    osiStaticGroundTruth.version.clear();
+    osiStaticGroundTruth.stationary_objects.clear();
+    osiStaticGroundTruth.tail.clear();
+    osiStaticGroundTruth.valid = false;
+
     delete udp_client_;
 
     if (osi_file.is_open())
@@ -227,6 +208,7 @@ void OSIReporter::ReportSensors(std::vector<ObjectSensor *> sensor)
 
 bool OSIReporter::OpenOSIFile(const char *filename)
 {
+    DrainAsyncOutput();
     osi_file.open(filename, std::ios_base::binary);
     if (!osi_file.good())
     {
@@ -239,10 +221,22 @@ bool OSIReporter::OpenOSIFile(const char *filename)
 
 void OSIReporter::CloseOSIFile()
 {
+    DrainAsyncOutput();
     osi_file.close();
 }
 
 bool OSIReporter::WriteOSIFile()
+{
+    if (writer_ != nullptr)
+    {
+        writer_->Push(osiGroundTruth.ground_truth.c_str(), osiGroundTruth.size, OSI_OUTPUT_FILE);
+        return true;
+    }
+
+    return WriteOSIFileData(osiGroundTruth.ground_truth.c_str(), osiGroundTruth.size);
+}
+
+bool OSIReporter::WriteOSIFileData(const char *data, unsigned int size)
 {
     if (!osi_file.good())
     {
@@ -250,10 +244,10 @@ bool OSIReporter::WriteOSIFile()
     }
 
     // write to file, first size of message
-    osi_file.write(reinterpret_cast<char *>(&osiGroundTruth.size), sizeof(osiGroundTruth.size));
+    osi_file.write(reinterpret_cast<char *>(&size), sizeof(size));
 
     // write to file, actual message - the groundtruth object including timestamp and moving objects
-    osi_file.write(osiGroundTruth.ground_truth.c_str(), osiGroundTruth.size);
+    osi_file.write(data, size);
 
     // write to file, first size of message
     // osi_file.write(reinterpret_cast<char *>(&osiTrafficCommand.size), sizeof(osiTrafficCommand.size));
@@ -271,6 +265,7 @@ bool OSIReporter::WriteOSIFile()
 
 void OSIReporter::FlushOSIFile()
 {
+    DrainAsyncOutput();
     if (osi_file.good())
     {
         osi_file.flush();
@@ -295,6 +290,8 @@ int OSIReporter::SetOSIStaticExternalData()
     obj_osi_external.gt->set_map_reference(*obj_osi_internal.gt->mutable_map_reference());
     obj_osi_external.gt->set_proj_string(*obj_osi_internal.gt->mutable_proj_string());
 
+    osiStaticGroundTruth.valid = false;
+
     return 0;
 }
 
@@ -312,9 +309,70 @@ int OSIReporter::ClearOSIGroundTruth()
     obj_osi_external.gt->clear_model_reference();
     obj_osi_external.gt->clear_version();
 
+    osiStaticGroundTruth.valid = false;
+
     return 0;
 }
 
+void OSIReporter::SerializeOSIGroundTruth()
+{
+    SE_ProfileScope profile("OSI serialize");
+
+    if (!incremental_serialization_)
+    {
+        obj_osi_external.gt->SerializeToString(&osiGroundTruth.ground_truth);
+        osiGroundTruth.size = static_cast<unsigned int>(obj_osi_external.gt->ByteSizeLong());
+        return;
+    }
+
+    const osi3::GroundTruth *gt = obj_osi_external.gt;
+
+    if (!osiStaticGroundTruth.valid)
+    {
+        // Serialize static content, fields before, between and after the dynamic ones separately
+        osi3::GroundTruth static_gt(*gt);
+        osi3::GroundTruth part;
+
+        static_gt.clear_timestamp();
+        static_gt.clear_host_vehicle_id();
+        static_gt.clear_moving_object();
+
+        if (static_gt.has_version())
+        {
+            part.mutable_version()->Swap(static_gt.mutable_version());
+            static_gt.clear_version();
+        }
+        part.SerializeToString(&osiStaticGroundTruth.version);
+
+        part.Clear();
+        part.mutable_stationary_object()->Swap(static_gt.mutable_stationary_object());
+        part.SerializeToString(&osiStaticGroundTruth.stationary_objects);
+
+        static_gt.SerializeToString(&osiStaticGroundTruth.tail);
+        osiStaticGroundTruth.valid = true;
+    }
+
+    // Concatenate static content and dynamic fields, reusing the buffer
+    std::string &buf = osiGroundTruth.ground_truth;
+    buf.assign(osiStaticGroundTruth.version);
+    if (gt->has_timestamp())
+    {
+        AppendOSIMessageField(buf, osi3::GroundTruth::kTimestampFieldNumber, gt->timestamp());
+    }
+    if (gt->has_host_vehicle_id())
+    {
+        AppendOSIMessageField(buf, osi3::GroundTruth::kHostVehicleIdFieldNumber, gt->host_vehicle_id());
+    }
+    buf.append(osiStaticGroundTruth.stationary_objects);
+    for (int i = 0; i < gt->moving_object_size(); i++)
+    {
+        AppendOSIMessageField(buf, osi3::GroundTruth::kMovingObjectFieldNumber, gt->moving_object(i));
+    }
+    buf.append(osiStaticGroundTruth.tail);
+
+    osiGroundTruth.size = static_cast<unsigned int>(buf.size());
+}
+
 int OSIReporter::UpdateOSIGroundTruth(const std::vector<std::unique_ptr<ObjectState>> &objectState, bool refetchStaticGt)
 {
     // osi_static_gt_loaded == 0 means its loaded, then static_gt_set == true as it is already set
@@ -353,8 +411,7 @@ int OSIReporter::UpdateOSIGroundTruth(const std::vector<std::unique_ptr<ObjectSt
 
         if ((GetUDPClientStatus() == 0 || IsFileOpen()))
         {
-            obj_osi_external.gt->SerializeToString(&osiGroundTruth.ground_truth);
-            osiGroundTruth.size = static_cast<unsigned int>(obj_osi_external.gt->ByteSizeLong());
+            SerializeOSIGroundTruth();
         }
 
         if (IsFileOpen())
@@ -373,56 +430,106 @@ int OSIReporter::UpdateOSIGroundTruth(const std::vector<std::unique_ptr<ObjectSt
         // Clear the static data now when it has been reported once
         if (GetUDPClientStatus() == 0)
         {
-            obj_osi_external.gt->SerializeToString(&osiGroundTruth.ground_truth);
-            osiGroundTruth.size = static_cast<unsigned int>(obj_osi_external.gt->ByteSizeLong());
+            SerializeOSIGroundTruth();
         }
     }
 
     if (GetUDPClientStatus() == 0)
     {
-        // send over udp - split large OSI messages in multiple transmissions
-        unsigned int sentDataBytes = 0;
-
-        for (osi_udp_buf.counter = 1; sentDataBytes < osiGroundTruth.size; osi_udp_buf.counter++)
+        if (writer_ != nullptr)
         {
-            osi_udp_buf.datasize = MIN(osiGroundTruth.size - sentDataBytes, OSI_MAX_UDP_DATA_SIZE);
-            memcpy(osi_udp_buf.data, &osiGroundTruth.ground_truth.c_str()[sentDataBytes], osi_udp_buf.datasize);
-            int packSize = static_cast<int>(sizeof(osi_udp_buf)) - static_cast<int>((OSI_MAX_UDP_DATA_SIZE - osi_udp_buf.datasize));
+            writer_->Push(osiGroundTruth.ground_truth.c_str(), osiGroundTruth.size, OSI_OUTPUT_UDP);
+        }
+        else
+        {
+            SendOSIUDP(osiGroundTruth.ground_truth.c_str(), osiGroundTruth.size);
+        }
+    }
 
-            if (sentDataBytes + osi_udp_buf.datasize >= osiGroundTruth.size)
-            {
-                // Last package indicated by negative counter number
-                osi_udp_buf.counter = -osi_udp_buf.counter;
-            }
+    IncrementCounter();
+    SetUpdated(true);
+
+    return 0;
+}
 
-            int sendResult = udp_client_->Send(reinterpret_cast<char *>(&osi_udp_buf), static_cast<unsigned int>(packSize));  // TODO: @Emil
+void OSIReporter::SendOSIUDP(const char *data, unsigned int size)
+{
+    // send over udp - split large OSI messages in multiple transmissions
+    unsigned int sentDataBytes = 0;
 
-            if (sendResult != packSize)
-            {
-                LOG_ERROR("Failed send osi package over UDP");
+    for (osi_udp_buf.counter = 1; sentDataBytes < size; osi_udp_buf.counter++)
+    {
+        osi_udp_buf.datasize = MIN(size - sentDataBytes, OSI_MAX_UDP_DATA_SIZE);
+        memcpy(osi_udp_buf.data, &data[sentDataBytes], osi_udp_buf.datasize);
+        int packSize = static_cast<int>(sizeof(osi_udp_buf)) - static_cast<int>((OSI_MAX_UDP_DATA_SIZE - osi_udp_buf.datasize));
+
+        if (sentDataBytes + osi_udp_buf.datasize >= size)
+        {
+            // Last package indicated by negative counter number
+            osi_udp_buf.counter = -osi_udp_buf.counter;
+        }
+
+        int sendResult = udp_client_->Send(reinterpret_cast<char *>(&osi_udp_buf), static_cast<unsigned int>(packSize));  // TODO: @Emil
+
+        if (sendResult != packSize)
+        {
+            LOG_ERROR("Failed send osi package over UDP");
 #ifdef _WIN32
-                wprintf(L"send failed with error: %d\n", WSAGetLastError());
+            wprintf(L"send failed with error: %d\n", WSAGetLastError());
 #endif
-                // Give up
-                sentDataBytes = osiGroundTruth.size;
-            }
-            else
-            {
-                sentDataBytes += osi_udp_buf.datasize;
-            }
+            // Give up
+            sentDataBytes = size;
+        }
+        else
+        {
+            sentDataBytes += osi_udp_buf.datasize;
         }
     }
+}
 
-    IncrementCounter();
-    SetUpdated(true);
+void OSIReporter::SetAsyncOutput(unsigned int queue_depth, OSIWriter::Policy policy)
+{
+    if (writer_ != nullptr)
+    {
+        writer_->Drain();
+        LOG_INFO("Async OSI output: {} messages written, {} dropped, {} late",
+                 writer_->GetNumWritten(),
+                 writer_->GetNumDropped(),
+                 writer_->GetNumLate());
+        delete writer_;
+        writer_ = nullptr;
+    }
 
-    return 0;
+    if (queue_depth > 0)
+    {
+        writer_ = new OSIWriter(queue_depth,
+                                policy,
+                                [this](const char *data, unsigned int size, int channel)
+                                {
+                                    if (channel == OSI_OUTPUT_FILE)
+                                    {
+                                        WriteOSIFileData(data, size);
+                                    }
+                                    else
+                                    {
+                                        SendOSIUDP(data, size);
+                                    }
+                                });
+    }
+}
+
+void OSIReporter::DrainAsyncOutput()
+{
+    if (writer_ != nullptr)
+    {
+        writer_->Drain();
+    }
 }
 
 int OSIReporter::UpdateOSIStaticGroundTruth(const std::vector<std::unique_ptr<ObjectState>> &objectState)
 {
     // First pick objects from the OpenSCENARIO description
-    static roadmanager::OpenDrive *opendrive = roadmanager::Position::GetOpenDrive();
+    roadmanager::OpenDrive *opendrive = roadmanager::Position::GetOpenDrive();
     for (unsigned i = 0; i < opendrive->GetNumOfRoads(); i++)
     {
         roadmanager::Road *road = opendrive->GetRoadByIdx(i);
@@ -1033,7 +1140,7 @@ int OSIReporter::UpdateOSIIntersection()
     idx_t                   g_id;
     roadmanager::OSIPoints *osipoints;
 
-    static roadmanager::OpenDrive *opendrive = roadmanager::Position::GetOpenDrive();
+    roadmanager::OpenDrive *opendrive = roadmanager::Position::GetOpenDrive();
     osi3::Lane                    *osi_lane  = nullptr;
     for (unsigned int i = 0; i < opendrive->GetNumOfJunctions(); i++)
     {
@@ -1521,7 +1628,7 @@ int OSIReporter::UpdateOSIIntersection()
 int OSIReporter::UpdateOSILaneBoundary()
 {
     // Retrieve opendrive class from RoadManager
-    static roadmanager::OpenDrive *opendrive = roadmanager::Position::GetOpenDrive();
+    roadmanager::OpenDrive *opendrive = roadmanager::Position::GetOpenDrive();
 
     // Loop over all roads
     for (unsigned int i = 0; i < opendrive->GetNumOfRoads(); i++)
@@ -1788,7 +1895,7 @@ int OSIReporter::UpdateOSIRoadLane()
     }
 
     // Retrieve opendrive class from RoadManager
-    static roadmanager::OpenDrive *opendrive = roadmanager::Position::GetOpenDrive();
+    roadmanager::OpenDrive *opendrive = roadmanager::Position::GetOpenDrive();
 
     // Loop over all roads
     for (unsigned int i = 0; i < opendrive->GetNumOfRoads(); i++)
@@ -2412,7 +2519,7 @@ int OSIReporter::UpdateTrafficSignals()
     // obj_osi_internal.ts = obj_osi_internal.gt->add_traffic_sign();
 
     // Retrieve opendrive class from RoadManager
-    static roadmanager::OpenDrive *opendrive = roadmanager::Position::GetOpenDrive();
+    roadmanager::OpenDrive *opendrive = roadmanager::Position::GetOpenDrive();
 
     // Loop over all roads
     for (unsigned int i = 0; i < opendrive->GetNumOfRoads(); i++)
@@ -2647,8 +2754,7 @@ const char *OSIReporter::GetOSIGroundTruth(int *size)
     if (!(GetUDPClientStatus() == 0 || IsFileOpen()))
     {
         // Data has not been serialized
-        obj_osi_external.gt->SerializeToString(&osiGroundTruth.ground_truth);
-        osiGroundTruth.size = static_cast<unsigned int>(obj_osi_external.gt->ByteSizeLong());
+        SerializeOSIGroundTruth();
     }
     *size = static_cast<int>(osiGroundTruth.size);
     return osiGroundTruth.ground_truth.data();
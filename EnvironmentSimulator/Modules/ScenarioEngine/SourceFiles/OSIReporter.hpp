@@ -16,6 +16,7 @@
 #include "IdealSensor.hpp"
 #include "ScenarioGateway.hpp"
 #include "ScenarioEngine.hpp"
+#include "OSIWriter.hpp"
 #include "osi_sensordata.pb.h"
 #include "osi_object.pb.h"
 #include "osi_groundtruth.pb.h"
@@ -67,6 +68,16 @@ public:
     */
     void FlushOSIFile();
     /**
+    Write and send OSI messages from a background thread, so that slow disk or network does not stall the simulation
+    @param queue_depth Max number of messages waiting for output. Set 0 to disable, writing from the calling thread.
+    @param policy What to do when the queue is full, wait or skip the message
+    */
+    void SetAsyncOutput(unsigned int queue_depth, OSIWriter::Policy policy = OSIWriter::Policy::BLOCK);
+    OSIWriter* GetAsyncOutput()
+    {
+        return writer_;
+    }
+    /**
     Clears groundtruth osi
     */
     int ClearOSIGroundTruth();
@@ -75,6 +86,18 @@ public:
      */
     int SetOSIStaticExternalData();
     /**
+    Serializes the GroundTruth, e.g. for file or UDP. In incremental mode static content is serialized once and reused.
+    */
+    void SerializeOSIGroundTruth();
+    /**
+    Serialize static GroundTruth (lanes, boundaries, signs etc) only once, and per frame encode only timestamp and moving objects.
+    Output is identical to regular serialization. Static content must only be modified via OSIReporter, not via the raw GroundTruth pointer.
+    */
+    void SetIncrementalSerialization(bool value)
+    {
+        incremental_serialization_ = value;
+    }
+    /**
     Calls UpdateOSIStaticGroundTruth and UpdateOSIDynamicGroundTruth
     */
     int UpdateOSIGroundTruth(const std::vector<std::unique_ptr<ObjectState>>& objectState, bool refetchStaticGt = false);
@@ -194,6 +217,64 @@ public:
     }
 
 private:
+    typedef struct
+    {
+        std::string  ground_truth;
+        unsigned int size = 0;
+    } OSIGroundTruth;
+
+    typedef struct
+    {
+        std::string  osi_lane_info;
+        unsigned int size = 0;
+    } OSIRoadLane;
+
+    typedef struct
+    {
+        std::string  osi_lane_boundary_info;
+        unsigned int size = 0;
+    } OSIRoadLaneBoundary;
+
+    typedef struct
+    {
+        std::string  traffic_command;
+        unsigned int size = 0;
+    } OSITrafficCommand;
+
+    // OSI messages and serialized data are owned per reporter, so that several players can run in the same process
+    struct
+    {
+        osi3::SensorData*                sd   = nullptr;
+        osi3::GroundTruth*               gt   = nullptr;
+        osi3::StationaryObject*          sobj = nullptr;
+        osi3::TrafficSign*               ts   = nullptr;
+        osi3::MovingObject*              mobj = nullptr;
+        std::vector<osi3::Lane*>         ln;
+        std::vector<osi3::LaneBoundary*> lnb;
+    } obj_osi_internal;
+
+    struct
+    {
+        osi3::GroundTruth*    gt = nullptr;
+        osi3::SensorView*     sv = nullptr;
+        osi3::TrafficCommand* tc = nullptr;
+    } obj_osi_external;
+
+    OSIGroundTruth      osiGroundTruth;
+    OSIRoadLane         osiRoadLane;
+    OSIRoadLaneBoundary osiRoadLaneBoundary;
+    OSITrafficCommand   osiTrafficCommand;
+
+    // Static ground truth serialized once, for incremental serialization. Split in the parts going before, between and after the
+    // dynamic fields (timestamp, host vehicle id and moving objects), since fields are serialized in field number order.
+    struct
+    {
+        std::string version;
+        std::string stationary_objects;
+        std::string tail;  // traffic signs and lights, road markings, lanes, lane boundaries, references etc
+        bool        valid = false;
+    } osiStaticGroundTruth;
+
     UDPClient*             udp_client_;
     ScenarioEngine*        scenario_engine_;
     unsigned long long int nanosec_;
@@ -202,8 +283,13 @@ private:
     std::string            stationary_model_reference;
     void                   CreateMovingObjectFromSensorData(const osi3::SensorData& sd, int obj_nr);
     void                   CreateLaneBoundaryFromSensordata(const osi3::SensorData& sd, int lane_boundary_nr);
-    bool                   osi_updated_           = false;
-    bool                   osi_file_written_      = false;
-    int                    osi_static_gt_loaded_  = -1;
-    int                    osi_dynamic_gt_loaded_ = -1;
+    bool                   WriteOSIFileData(const char* data, unsigned int size);
+    void                   SendOSIUDP(const char* data, unsigned int size);
+    void                   DrainAsyncOutput();
+    bool                   osi_updated_               = false;
+    bool                   osi_file_written_          = false;
+    int                    osi_static_gt_loaded_      = -1;
+    int                    osi_dynamic_gt_loaded_     = -1;
+    bool                   incremental_serialization_ = false;
+    OSIWriter*             writer_                    = nullptr;  // set when output is asynchronous
 };
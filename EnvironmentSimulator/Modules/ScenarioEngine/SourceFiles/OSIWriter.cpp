@@ -0,0 +1,109 @@
+/*
+ * esmini - Environment Simulator Minimalistic
+ * https://github.com/esmini/esmini
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) partners of Simulation Scenarios
+ * https://sites.google.com/view/simulationscenarios
+ */
+
+#include "OSIWriter.hpp"
+
+using namespace scenarioengine;
+
+OSIWriter::OSIWriter(unsigned int queue_depth, Policy policy, OutputFunc output)
+    : slots_(queue_depth > 0 ? queue_depth : 1),
+      policy_(policy),
+      output_(output)
+{
+    thread_ = std::thread(&OSIWriter::Worker, this);
+}
+
+OSIWriter::~OSIWriter()
+{
+    quit_ = true;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        cv_.notify_all();
+    }
+    thread_.join();
+}
+
+bool OSIWriter::Push(const char* data, unsigned int size, int channel)
+{
+    unsigned long long head = head_;
+
+    if (head - tail_ >= slots_.size())
+    {
+        if (policy_ == Policy::DROP)
+        {
+            n_dropped_++;
+            return false;
+        }
+
+        n_late_++;
+        Wait([&]() { return head - tail_ < slots_.size(); });
+    }
+
+    Slot& slot = slots_[head % slots_.size()];
+    slot.data.assign(data, size);
+    slot.channel = channel;
+    head_        = head + 1;
+
+    Signal();
+
+    return true;
+}
+
+void OSIWriter::Drain()
+{
+    Wait([&]() { return tail_ == head_; });
+}
+
+void OSIWriter::Wait(const std::function<bool()>& ready)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    // Register before checking condition, so that any following change of head or tail will notify (all atomics are sequentially consistent)
+    n_waiting_++;
+    cv_.wait(lock, ready);
+    n_waiting_--;
+}
+
+void OSIWriter::Signal()
+{
+    if (n_waiting_ > 0)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        cv_.notify_all();
+    }
+}
+
+void OSIWriter::Worker()
+{
+    while (true)
+    {
+        unsigned long long tail = tail_;
+
+        if (tail == head_)
+        {
+            if (quit_)
+            {
+                // all queued messages written
+                break;
+            }
+            Wait([&]() { return tail != head_ || quit_; });
+            continue;
+        }
+
+        Slot& slot = slots_[tail % slots_.size()];
+        output_(slot.data.data(), static_cast<unsigned int>(slot.data.size()), slot.channel);
+        n_written_++;
+        tail_ = tail + 1;
+
+        Signal();
+    }
+}
@@ -0,0 +1,120 @@
+/*
+ * esmini - Environment Simulator Minimalistic
+ * https://github.com/esmini/esmini
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) partners of Simulation Scenarios
+ * https://sites.google.com/view/simulationscenarios
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace scenarioengine
+{
+
+    /**
+    Asynchronous output of serialized messages, e.g. OSI ground truth to file and UDP. The simulation thread queues a copy of
+    the data in a ring of reused buffers and returns, while a background thread calls the output function for each message in order.
+    One producing thread only. The ring itself is lock-free, the mutex is only used for sleeping when the queue is empty or full.
+    */
+    class OSIWriter
+    {
+    public:
+        typedef std::function<void(const char* data, unsigned int size, int channel)> OutputFunc;
+
+        enum class Policy
+        {
+            BLOCK,  // wait for a free buffer when queue is full
+            DROP    // skip the message when queue is full
+        };
+
+        /**
+        Create writer and start background thread
+        @param queue_depth Number of buffered messages
+        @param policy What to do when the queue is full
+        @param output Function called from the background thread for each message
+        */
+        OSIWriter(unsigned int queue_depth, Policy policy, OutputFunc output);
+
+        /**
+        Write all queued messages, then stop background thread
+        */
+        ~OSIWriter();
+
+        /**
+        Queue a copy of the message for output
+        @param data Serialized message
+        @param size Size of message in bytes
+        @param channel Forwarded to output function, e.g. to specify destination
+        @return true if queued, false if dropped
+        */
+        bool Push(const char* data, unsigned int size, int channel);
+
+        /**
+        Wait until all queued messages have been written
+        */
+        void Drain();
+
+        unsigned int GetQueueDepth() const
+        {
+            return static_cast<unsigned int>(slots_.size());
+        }
+        Policy GetPolicy() const
+        {
+            return policy_;
+        }
+        unsigned long long GetNumWritten() const
+        {
+            return n_written_;
+        }
+        unsigned long long GetNumDropped() const
+        {
+            return n_dropped_;
+        }
+
+        /**
+        Number of messages queued first after waiting for a free buffer, i.e. late frames stalling the simulation
+        */
+        unsigned long long GetNumLate() const
+        {
+            return n_late_;
+        }
+
+    private:
+        struct Slot
+        {
+            std::string data;  // capacity kept between messages, so no allocations once sizes settle
+            int         channel = 0;
+        };
+
+        void Worker();
+        void Wait(const std::function<bool()>& ready);
+        void Signal();
+
+        std::vector<Slot>               slots_;
+        Policy                          policy_;
+        OutputFunc                      output_;
+        std::atomic<unsigned long long> head_{0};  // next slot to fill, written by producer only
+        std::atomic<unsigned long long> tail_{0};  // next slot to output, written by worker only
+        std::atomic<int>                n_waiting_{0};
+        std::atomic<bool>               quit_{false};
+        std::atomic<unsigned long long> n_written_{0};
+        std::atomic<unsigned long long> n_dropped_{0};
+        std::atomic<unsigned long long> n_late_{0};
+        std::mutex                      mutex_;
+        std::condition_variable         cv_;
+        std::thread                     thread_;
+    };
+
+}  // namespace scenarioengine
@@ -10,8 +10,9 @@
  * https://sites.google.com/view/simulationscenarios
  */
 
+#include <algorithm>
+#include <cstdint>
 #include "Parameters.hpp"
-#include "ScenarioReader.hpp"
 #include "simple_expr.h"
 #include "logger.hpp"
 
@@ -42,9 +43,26 @@ void Parameters::RestoreParameterDeclarations()
 {
     if (!paramDeclarationsSize_.empty())
     {
-        parameterDeclarations_.Parameter.erase(
-            parameterDeclarations_.Parameter.begin(),
-            parameterDeclarations_.Parameter.begin() + static_cast<int>(parameterDeclarations_.Parameter.size()) - paramDeclarationsSize_.top());
+        std::vector<OSCParameterDeclarations::ParameterStruct>& list     = parameterDeclarations_.Parameter;
+        size_t                                                  n_remove = list.size() - static_cast<size_t>(paramDeclarationsSize_.top());
+
+        if (indexed_size_ == list.size())
+        {
+            // Removed declarations are the most recent ones, i.e. last in index of respective name
+            for (size_t i = 0; i < n_remove; i++)
+            {
+                auto it = symbols_.find(list[i].name);
+                it->second.pop_back();
+                if (it->second.empty())
+                {
+                    symbols_.erase(it);
+                }
+            }
+            indexed_size_ -= n_remove;
+        }
+
+        list.erase(list.begin(), list.begin() + static_cast<int>(n_remove));
+        generation_++;
         paramDeclarationsSize_.pop();
         catalog_param_assignments.clear();
     }
@@ -54,51 +72,108 @@ void Parameters::RestoreParameterDeclarations()
     }
 }
 
-int Parameters::setParameter(std::string name, std::string value)
+void Parameters::IndexParameters()
 {
-    // If string already present in parameterDeclaration
-    for (size_t i = 0; i < parameterDeclarations_.Parameter.size(); i++)
+    const std::vector<OSCParameterDeclarations::ParameterStruct>& list = parameterDeclarations_.Parameter;
+
+    symbols_.clear();
+    for (size_t i = list.size(); i > 0; i--)
     {
-        if (PARAMETER_PREFIX + parameterDeclarations_.Parameter[i].name == name ||  // parameter names should not include prefix
-            parameterDeclarations_.Parameter[i].name == name)                       // But support also parameter name including prefix
+        symbols_[list[i - 1].name].push_back(list.size() - i);
+    }
+    indexed_size_ = list.size();
+    generation_++;
+}
+
+size_t Parameters::FindParameterIdx(const std::string& name)
+{
+    const std::vector<OSCParameterDeclarations::ParameterStruct>& list = parameterDeclarations_.Parameter;
+
+    for (int attempt = 0; attempt < 2; attempt++)
+    {
+        if (indexed_size_ != list.size())
+        {
+            // list modified from outside
+            IndexParameters();
+        }
+
+        // Parameter names should not include prefix, but support also name including prefix. Most recent declaration wins.
+        size_t pos  = 0;
+        bool   hit  = false;
+        auto   iter = symbols_.find(name);
+        if (iter != symbols_.end())
+        {
+            pos = iter->second.back();
+            hit = true;
+        }
+        if (name.size() > 1 && name[0] == PARAMETER_PREFIX && (iter = symbols_.find(name.substr(1))) != symbols_.end())
+        {
+            pos = hit ? std::max(pos, iter->second.back()) : iter->second.back();
+            hit = true;
+        }
+
+        if (!hit)
         {
-            parameterDeclarations_.Parameter[i].value._string = value;
-            return 0;
+            return SIZE_MAX;
         }
+
+        size_t idx = list.size() - 1 - pos;
+        if (list[idx].name == name || PARAMETER_PREFIX + list[idx].name == name)
+        {
+            return idx;
+        }
+
+        // list modified from outside without changing size, rebuild index and try again
+        indexed_size_ = SIZE_MAX;
+    }
+
+    return SIZE_MAX;
+}
+
+int Parameters::setParameter(std::string name, std::string value)
+{
+    OSCParameterDeclarations::ParameterStruct* ps = getParameterEntry(name);
+
+    if (ps == nullptr)
+    {
+        return -1;
     }
 
-    return -1;
+    ps->value._string = value;
+    value_version_++;
+
+    return 0;
 }
 
 std::string Parameters::getParameter(std::string name)
 {
-    // If string already present in parameterDeclaration
-    const std::vector<OSCParameterDeclarations::ParameterStruct>& parameters = ScenarioReader::parameters.parameterDeclarations_.Parameter;
-    for (size_t i = 0; i < parameters.size(); i++)
+    OSCParameterDeclarations::ParameterStruct* ps = (resolve_parameters_ != nullptr ? resolve_parameters_ : this)->getParameterEntry(name);
+
+    if (ps != nullptr)
     {
-        if (PARAMETER_PREFIX + parameters[i].name == name ||  // parameter names should not include prefix
-            parameters[i].name == name)                       // But support also parameter name including prefix
-        {
-            return parameters[i].value._string;
-        }
+        return ps->value._string;
     }
+
     LOG_ERROR("Failed to resolve parameter {}", name);
     throw std::runtime_error("Failed to resolve parameter");
 }
 
-OSCParameterDeclarations::ParameterStruct* Parameters::getParameterEntry(std::string name)
+OSCParameterDeclarations::ParameterStruct* Parameters::getParameterEntry(const std::string& name)
 {
-    // If string already present in parameterDeclaration
-    for (size_t i = 0; i < parameterDeclarations_.Parameter.size(); i++)
+    size_t idx = FindParameterIdx(name);
+
+    return idx != SIZE_MAX ? &parameterDeclarations_.Parameter[idx] : nullptr;
+}
+
+OSCParameterDeclarations::ParameterStruct* Parameters::getParameterEntry(const std::string& name, ParameterSlot& slot)
+{
+    if (slot.entry == nullptr || slot.generation != generation_ || indexed_size_ != parameterDeclarations_.Parameter.size())
     {
-        if (PARAMETER_PREFIX + parameterDeclarations_.Parameter[i].name == name ||  // parameter names should not include prefix
-            parameterDeclarations_.Parameter[i].name == name)                       // But support also parameter name including prefix
-        {
-            return &parameterDeclarations_.Parameter[i];
-        }
+        slot.entry      = getParameterEntry(name);
+        slot.generation = generation_;
     }
 
-    return 0;
+    return slot.entry;
 }
 
 int Parameters::GetNumberOfParameters()
@@ -154,6 +229,7 @@ int Parameters::setParameterValue(std::string name, const void* value)
     }
 
     ps->dirty = true;
+    value_version_++;
 
     return 0;
 }
@@ -310,6 +386,7 @@ int Parameters::setParameterValueByString(std::string name, std::string value)
     }
 
     ps->dirty = true;
+    value_version_++;
 
     return 0;
 }
@@ -326,6 +403,7 @@ int Parameters::setParameterValue(std::string name, int value)
     ps->value._int    = value;
     ps->value._string = std::to_string(ps->value._int);
     ps->dirty         = true;
+    value_version_++;
 
     return 0;
 }
@@ -342,6 +420,7 @@ int Parameters::setParameterValue(std::string name, double value)
     ps->value._double = value;
     ps->value._string = std::to_string(ps->value._double);
     ps->dirty         = true;
+    value_version_++;
 
     return 0;
 }
@@ -357,6 +436,7 @@ int Parameters::setParameterValue(std::string name, const char* value)
 
     ps->value._string = value;
     ps->dirty         = true;
+    value_version_++;
 
     return 0;
 }
@@ -373,6 +453,7 @@ int Parameters::setParameterValue(std::string name, bool value)
     ps->value._bool   = value;
     ps->value._string = ps->value._bool == true ? "true" : "false";
     ps->dirty         = true;
+    value_version_++;
 
     return 0;
 }
@@ -564,7 +645,19 @@ void Parameters::parseParameterDeclarations(pugi::xml_node declarationsNode, OSC
             LOG_ERROR_AND_QUIT("Unexpected Type: {}", type_str);
         }
 
-        auto pos = std::find_if(pd->Parameter.begin(), pd->Parameter.end(), [&param](const auto& p) { return p.name == param.name; });
+        auto pos = pd->Parameter.end();
+        if (pd == &parameterDeclarations_)
+        {
+            size_t idx = FindParameterIdx(param.name);
+            if (idx != SIZE_MAX && pd->Parameter[idx].name == param.name)
+            {
+                pos = pd->Parameter.begin() + static_cast<int>(idx);
+            }
+        }
+        else
+        {
+            pos = std::find_if(pd->Parameter.begin(), pd->Parameter.end(), [&param](const auto& p) { return p.name == param.name; });
+        }
         if (pos != pd->Parameter.end())
         {
             if (pos->dirty)
@@ -579,12 +672,24 @@ void Parameters::parseParameterDeclarations(pugi::xml_node declarationsNode, OSC
         }
 
         pd->Parameter.insert(pd->Parameter.begin(), param);
+
+        if (pd == &parameterDeclarations_)
+        {
+            if (indexed_size_ == pd->Parameter.size() - 1)
+            {
+                symbols_[param.name].push_back(indexed_size_++);
+            }
+            generation_++;
+        }
     }
 }
 
 void Parameters::Clear()
 {
     parameterDeclarations_.Parameter.clear();
+    symbols_.clear();
+    indexed_size_ = 0;
+    generation_++;
     while (!paramDeclarationsSize_.empty())
     {
         paramDeclarationsSize_.pop();
@@ -592,6 +697,24 @@ void Parameters::Clear()
     catalog_param_assignments.clear();
 }
 
+void Parameters::SyncState(SE_StateBuffer& buf)
+{
+    // values only, declarations are assumed to be the same as when state was saved
+    buf.Expect(parameterDeclarations_.Parameter.size());
+    if (!buf.IsOK())
+    {
+        return;
+    }
+
+    // same size, so elements are assigned in place keeping any resolved parameter slots valid
+    buf.Sync(parameterDeclarations_.Parameter);
+
+    if (buf.IsRestoring())
+    {
+        value_version_++;
+    }
+}
+
 void Parameters::Print(std::string typestr)
 {
     LOG_INFO("{} {}{}", parameterDeclarations_.Parameter.size(), typestr, parameterDeclarations_.Parameter.size() > 0 ? ":" : "");
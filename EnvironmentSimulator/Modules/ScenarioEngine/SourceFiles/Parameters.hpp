@@ -17,6 +17,7 @@
 #include "OSCParameterDeclarations.hpp"
 #include <vector>
 #include <stack>
+#include <unordered_map>
 
 namespace scenarioengine
 {
@@ -31,13 +32,39 @@ namespace scenarioengine
         std::stack<int> paramDeclarationsSize_;  // original size first, then additional layered parameter declarations
         std::vector<OSCParameterDeclarations::ParameterStruct> catalog_param_assignments;
         OSCParameterDeclarations                               parameterDeclarations_;
+        Parameters*                                            resolve_parameters_ = nullptr;  // to resolve references against, nullptr = this
 
         // ParameterDeclarations
         void        parseGlobalParameterDeclarations(pugi::xml_node osc_root_);
         void        parseParameterDeclarations(pugi::xml_node xml_node, OSCParameterDeclarations* pd);
         std::string getParameter(std::string name);
 
-        OSCParameterDeclarations::ParameterStruct* getParameterEntry(std::string name);
+        /**
+                Reference to a parameter entry, resolved once and then reused until parameter declarations are added or removed
+        */
+        struct ParameterSlot
+        {
+            OSCParameterDeclarations::ParameterStruct* entry      = nullptr;
+            unsigned int                               generation = 0;
+        };
+
+        OSCParameterDeclarations::ParameterStruct* getParameterEntry(const std::string& name);
+
+        /**
+                Find parameter entry, looking it up only if the slot is not resolved or outdated
+                @param name Name of parameter, with or without prefix
+                @param slot Slot to resolve, typically a member of the referring object
+                @return Parameter entry, nullptr if not found
+        */
+        OSCParameterDeclarations::ParameterStruct* getParameterEntry(const std::string& name, ParameterSlot& slot);
+
+        /**
+                Get number of changes of declarations and values, for users to detect any change since last check
+        */
+        unsigned int GetVersion() const
+        {
+            return generation_ + value_version_;
+        }
         int                                        setParameter(std::string name, std::string value);
         void                                       addParameterDeclarations(pugi::xml_node xml_node);
         void                                       CreateRestorePoint();
@@ -68,7 +95,20 @@ namespace scenarioengine
         // Will clear all parameter declarations and assignements
         void Clear();
 
+        // Save or restore parameter values, see SE_StateBuffer
+        void SyncState(SE_StateBuffer& buf);
+
         // Log current set of parameter names and values
         void Print(std::string type);
+
+    private:
+        // Declarations per name, as position counted from end of list since new declarations are inserted first. Oldest first.
+        std::unordered_map<std::string, std::vector<size_t>> symbols_;
+        size_t                                               indexed_size_  = 0;  // list size when index was updated
+        unsigned int                                         generation_    = 0;  // increased when declarations are added or removed
+        unsigned int                                         value_version_ = 0;  // increased when any value is set
+
+        void   IndexParameters();
+        size_t FindParameterIdx(const std::string& name);
     };
 }  // namespace scenarioengine
\ No newline at end of file
@@ -24,14 +24,31 @@
 
 using namespace scenarioengine;
 
-static CallBack paramDeclCallback = {0, 0};
+static CallBack                     paramDeclCallback       = {0, 0};
+static thread_local CallBack*       threadParamDeclCallback = nullptr;
+static thread_local ScenarioEngine* paramDeclCallbackEngine = nullptr;
+
+static CallBack& GetParamDeclCallback()
+{
+    return threadParamDeclCallback != nullptr ? *threadParamDeclCallback : paramDeclCallback;
+}
 
 namespace scenarioengine
 {
     void RegisterParameterDeclarationCallback(ParamDeclCallbackFunc func, void* data)
     {
-        paramDeclCallback.func = func;
-        paramDeclCallback.data = data;
+        GetParamDeclCallback().func = func;
+        GetParamDeclCallback().data = data;
+    }
+
+    void SetThreadParameterDeclarationCallback(CallBack* callback)
+    {
+        threadParamDeclCallback = callback;
+    }
+
+    ScenarioEngine* GetParameterDeclarationCallbackEngine()
+    {
+        return paramDeclCallbackEngine;
     }
 }  // namespace scenarioengine
 
@@ -126,6 +143,8 @@ ScenarioEngine::~ScenarioEngine()
     scenarioReader->UnloadControllers();
     delete scenarioReader;
     scenarioReader = 0;
+    delete step_pool_;
+    step_pool_ = nullptr;
     LOG_INFO("Closing");
     TxtLogger::Inst().Stop();
 }
@@ -148,6 +167,11 @@ void ScenarioEngine::UpdateGhostMode()
 
 int ScenarioEngine::step(double deltaSimTime)
 {
+#ifdef _USE_OSI
+    // Storyboard elements report to the OSI reporter of the scenario being stepped, which may vary between calls from the same thread
+    StoryBoardElement::SetOSIReporter(osi_reporter_);
+#endif  // _USE_OSI
+
     UpdateGhostMode();
 
     if (frame_nr_ == 0)
@@ -253,7 +277,9 @@ int ScenarioEngine::step(double deltaSimTime)
         }
     }
 
+    SE_ProfileScope profile_storyboard("storyboard");
     storyBoard.Step(simulationTime_, deltaSimTime);
+    profile_storyboard.End();
 
     if (storyBoard.GetCurrentState() == StoryBoardElement::State::RUNNING)
     {
@@ -303,52 +329,41 @@ int ScenarioEngine::step(double deltaSimTime)
         trueTime_ = simulationTime_;
     }
 
+    // Fetch states from gateway (if available), indicated by dirty bits
     for (size_t i = 0; i < entities_.object_.size(); i++)
     {
-        Object* obj = entities_.object_[i];
+        FetchObjectState(entities_.object_[i]);
+    }
 
-        // Fetch states from gateway (if available), indicated by dirty bits
-        ObjectState* o = scenarioGateway.getObjectStatePtrById(obj->id_);
-        if (o != nullptr)
-        {
-            if (o->dirty_ & (Object::DirtyBit::LATERAL | Object::DirtyBit::LONGITUDINAL))
-            {
-                obj->pos_.Duplicate(o->state_.pos);
-                if (obj->pos_.route_ != nullptr)
-                {
-                    // update assigned route info
-                    obj->pos_.CalcRoutePosition();
-                }
-            }
-            if (o->dirty_ & Object::DirtyBit::SPEED)
-            {
-                obj->speed_ = o->state_.info.speed;
-            }
+    // Objects moving within current road are independent of each other and moved in parallel, if enabled. Remaining
+    // ones might pick a random junction connection and are moved below in object order, keeping the random sequence.
+    SE_ProfileScope profile_default_controller("default controller");
+    step_moved_.assign(entities_.object_.size(), 0);
+    if (step_pool_ != nullptr)
+    {
+        SE_Env*                 env = &SE_Env::Inst();
+        roadmanager::OpenDrive* odr = roadmanager::Position::GetOpenDrive();
 
-            // Update wheel info, assuming first wheel is steering wheel on front axle
-            if (o->dirty_ & Object::DirtyBit::WHEEL_ANGLE)
-            {
-                if (o->state_.info.wheel_data.size() > 0)
-                {
-                    obj->wheel_angle_ = o->state_.info.wheel_data[0].h;
-                }
-            }
-            if (o->dirty_ & Object::DirtyBit::WHEEL_ROTATION)
-            {
-                if (o->state_.info.wheel_data.size() > 0)
-                {
-                    obj->wheel_rot_ = o->state_.info.wheel_data[0].p;
-                }
-            }
-            o->clearDirtyBits();
-        }
+        step_pool_->Run(entities_.object_.size(),
+                        [&](size_t i)
+                        {
+                            SE_Env::SetThreadInst(env);
+                            roadmanager::Position::SetThreadOpenDrive(odr);
+
+                            Object* obj = entities_.object_[i];
+                            if (IsMovedByDefaultController(obj) && IsMoveWithinRoad(obj, deltaSimTime))
+                            {
+                                defaultController(obj, deltaSimTime);
+                                step_moved_[i] = 1;
+                            }
+                        });
+    }
 
-        // Do not move objects when speed is zero,
-        // and only ghosts allowed to execute during ghost restart
-        if (!(obj->IsControllerModeOnDomains(ControlOperationMode::MODE_OVERRIDE, static_cast<unsigned int>(ControlDomains::DOMAIN_LAT_AND_LONG))) &&
-            fabs(obj->speed_) > SMALL_NUMBER &&
-            // Skip update for non ghost objects during ghost restart
-            !(!obj->IsGhost() && SE_Env::Inst().GetGhostMode() == GhostMode::RESTARTING) && !obj->TowVehicle())  // update trailers later
+    for (size_t i = 0; i < entities_.object_.size(); i++)
+    {
+        Object* obj = entities_.object_[i];
+
+        if (!step_moved_[i] && IsMovedByDefaultController(obj))
         {
             defaultController(obj, deltaSimTime);
         }
@@ -447,17 +462,37 @@ int ScenarioEngine::step(double deltaSimTime)
         }
     }
 
+    profile_default_controller.End();
+
+    // Index object positions for controllers looking for nearby objects, keep it updated as controllers move objects
+    entities_.lane_occupancy_.Build();
+
     for (size_t i = 0; i < scenarioReader->controller_.size(); i++)
     {
         if (scenarioReader->controller_[i]->Active())
         {
             if (SE_Env::Inst().GetGhostMode() != GhostMode::RESTARTING)
             {
+                SE_ProfileScope profile_controller(SE_Profiler::Inst().IsEnabled() ? scenarioReader->controller_[i]->GetProfilePhaseId() : -1);
                 scenarioReader->controller_[i]->Step(deltaSimTime);
+                profile_controller.End();
+
+                if (scenarioReader->controller_[i]->GetType() == Controller::Type::CONTROLLER_TYPE_SUMO ||
+                    scenarioReader->controller_[i]->GetType() == Controller::Type::CONTROLLER_TYPE_REL2ABS)
+                {
+                    // these might move any object
+                    entities_.lane_occupancy_.Build();
+                }
+                else
+                {
+                    entities_.lane_occupancy_.Update(scenarioReader->controller_[i]->GetRoadObject());
+                }
             }
         }
     }
 
+    entities_.lane_occupancy_.Clear();
+
     // Update any trailers now that tow vehicles have been updated by Default or custom controllers
     for (size_t i = 0; i < entities_.object_.size(); i++)
     {
@@ -601,9 +636,12 @@ int ScenarioEngine::parseScenario()
     ParseGlobalDeclarations();
 
     // Now that parameter and variable declarations has been parsed, call any registered callbacks
-    if (paramDeclCallback.func != nullptr)
+    CallBack& callback = GetParamDeclCallback();
+    if (callback.func != nullptr)
     {
-        paramDeclCallback.func(paramDeclCallback.data);
+        paramDeclCallbackEngine = this;
+        callback.func(callback.data);
+        paramDeclCallbackEngine = nullptr;
         // Remove all parameters and variables not modified by callback, then re-evaluate all parameters and variables in case any values has been
         // modified
         EraseCleanParams();
@@ -674,7 +712,7 @@ int ScenarioEngine::parseScenario()
     scenarioReader->parseStoryBoard(storyBoard);
     storyBoard.entities_ = &entities_;
 #ifdef _USE_OSI
-    storyBoard.SetOSIReporter(nullptr);
+    SetOSIReporter(nullptr);
 #endif  // _USE_OSI
 
     // Now when all entities have been loaded, initialize the controllers
@@ -729,6 +767,101 @@ int ScenarioEngine::parseScenario()
     return 0;
 }
 
+void ScenarioEngine::FetchObjectState(Object* obj)
+{
+    ObjectState* o = scenarioGateway.getObjectStatePtrById(obj->id_);
+    if (o != nullptr)
+    {
+        if (o->dirty_ & (Object::DirtyBit::LATERAL | Object::DirtyBit::LONGITUDINAL))
+        {
+            obj->pos_.Duplicate(o->state_.pos);
+            if (obj->pos_.route_ != nullptr)
+            {
+                // update assigned route info
+                obj->pos_.CalcRoutePosition();
+            }
+        }
+        if (o->dirty_ & Object::DirtyBit::SPEED)
+        {
+            obj->speed_ = o->state_.info.speed;
+        }
+
+        // Update wheel info, assuming first wheel is steering wheel on front axle
+        if (o->dirty_ & Object::DirtyBit::WHEEL_ANGLE)
+        {
+            if (o->state_.info.wheel_data.size() > 0)
+            {
+                obj->wheel_angle_ = o->state_.info.wheel_data[0].h;
+            }
+        }
+        if (o->dirty_ & Object::DirtyBit::WHEEL_ROTATION)
+        {
+            if (o->state_.info.wheel_data.size() > 0)
+            {
+                obj->wheel_rot_ = o->state_.info.wheel_data[0].p;
+            }
+        }
+        o->clearDirtyBits();
+    }
+}
+
+bool ScenarioEngine::IsMovedByDefaultController(Object* obj)
+{
+    // Do not move objects when speed is zero,
+    // and only ghosts allowed to execute during ghost restart
+    return !(obj->IsControllerModeOnDomains(ControlOperationMode::MODE_OVERRIDE, static_cast<unsigned int>(ControlDomains::DOMAIN_LAT_AND_LONG))) &&
+           fabs(obj->speed_) > SMALL_NUMBER &&
+           // Skip update for non ghost objects during ghost restart
+           !(!obj->IsGhost() && SE_Env::Inst().GetGhostMode() == GhostMode::RESTARTING) && !obj->TowVehicle();  // update trailers later
+}
+
+bool ScenarioEngine::IsMoveWithinRoad(Object* obj, double dt)
+{
+    // Same step along s as in Position::MoveAlongS(), but without modifying the position. Routes might be shared between
+    // objects, so those are not considered independent.
+    roadmanager::Position& pos  = obj->pos_;
+    roadmanager::Road*     road = roadmanager::Position::GetOpenDrive()->GetRoadById(pos.GetTrackId());
+
+    if (road == nullptr || pos.GetRoute() != nullptr)
+    {
+        return false;
+    }
+
+    double ds_road   = obj->speed_ * dt;
+    double curvature = pos.GetCurvature();
+    double offset    = pos.GetT();
+
+    if (fabs(curvature) > SMALL_NUMBER)
+    {
+        if (curvature * offset > 1.0 - SMALL_NUMBER)
+        {
+            // position would be re-evaluated, see Position::DistanceToDS()
+            return false;
+        }
+        ds_road *= 1.0 / (1.0 - curvature * offset);
+    }
+    ds_road *= IsAngleForward(pos.GetHRelative()) ? 1 : -1;
+
+    // some margin, since step length might still differ slightly
+    return pos.GetS() + ds_road > 1.0 && pos.GetS() + ds_road < road->GetLength() - 1.0;
+}
+
+void ScenarioEngine::SetStepThreads(unsigned int n_threads)
+{
+    delete step_pool_;
+    step_pool_ = nullptr;
+
+    if (n_threads == 0)
+    {
+        n_threads = MAX(1U, std::thread::hardware_concurrency());
+    }
+
+    if (n_threads > 1)
+    {
+        step_pool_ = new SE_ThreadPool(n_threads);
+    }
+}
+
 int ScenarioEngine::defaultController(Object* obj, double dt)
 {
     int    retval  = 0;
@@ -759,6 +892,8 @@ int ScenarioEngine::defaultController(Object* obj, double dt)
 
 void ScenarioEngine::prepareGroundTruth(double dt)
 {
+    SE_ProfileScope profile("prepare ground truth");
+
     for (size_t i = 0; i < entities_.object_.size(); i++)
     {
         // Fetch external states from gateway
@@ -1200,6 +1335,33 @@ void ScenarioEngine::SetupGhost(Object* object)
         }
     }
 }
+void ScenarioEngine::SyncState(SE_StateBuffer& buf)
+{
+    buf.Sync(simulationTime_, trueTime_, frame_nr_, doOnce, ghost_, collision_pair_, collision_keys_prev_);
+
+    // global simulation state, e.g. random number generator used by controllers and swarm traffic
+    GhostMode ghost_mode      = SE_Env::Inst().GetGhostMode();
+    double    ghost_headstart = SE_Env::Inst().GetGhostHeadstart();
+    buf.Sync(SE_Env::Inst().GetRand(), ghost_mode, ghost_headstart);
+    if (buf.IsRestoring() && buf.IsOK())
+    {
+        SE_Env::Inst().SetGhostMode(ghost_mode);
+        SE_Env::Inst().SetGhostHeadstart(ghost_headstart);
+    }
+
+    scenarioReader->parameters.SyncState(buf);
+    scenarioReader->variables.SyncState(buf);
+    entities_.SyncState(buf);
+    scenarioGateway.SyncState(buf);
+    storyBoard.SyncState(buf);
+
+    buf.Expect(scenarioReader->controller_.size());
+    for (size_t i = 0; i < scenarioReader->controller_.size() && buf.IsOK(); i++)
+    {
+        scenarioReader->controller_[i]->SyncState(buf);
+    }
+}
+
 // Reset events ongoing or finished by ghost
 void ScenarioEngine::ResetEvents()
 {
@@ -1273,52 +1435,106 @@ void ScenarioEngine::ResetEvents()
 
 int ScenarioEngine::DetectCollisions()
 {
+    SE_ProfileScope profile("collision detection");
+
     collision_pair_.clear();
+
+    // Broad phase: Sweep and prune on world aligned bounding boxes, enclosing the oriented ones
+    collision_box_.resize(entities_.object_.size());
     for (size_t i = 0; i < entities_.object_.size(); i++)
     {
-        Object* obj0 = entities_.object_[i];
-        for (size_t j = i + 1; j < entities_.object_.size(); j++)
+        Object*         obj = entities_.object_[i];
+        OSCBoundingBox& bb  = obj->boundingbox_;
+        double          c   = cos(obj->pos_.GetH());
+        double          s   = sin(obj->pos_.GetH());
+        double          l2  = static_cast<double>(bb.dimensions_.length_) / 2.0;
+        double          w2  = static_cast<double>(bb.dimensions_.width_) / 2.0;
+        double          cx  = 0.0;
+        double          cy  = 0.0;
+
+        RotateVec2D(static_cast<double>(bb.center_.x_), static_cast<double>(bb.center_.y_), obj->pos_.GetH(), cx, cy);
+        cx += obj->pos_.GetX();
+        cy += obj->pos_.GetY();
+
+        // extents of rotated box, add a small margin so that the exact check decides on touching boxes
+        double ex = fabs(c) * l2 + fabs(s) * w2 + SMALL_NUMBER;
+        double ey = fabs(s) * l2 + fabs(c) * w2 + SMALL_NUMBER;
+
+        collision_box_[i] = {cx - ex, cx + ex, cy - ey, cy + ey, i};
+    }
+
+    std::sort(collision_box_.begin(), collision_box_.end(), [](const CollisionBox& a, const CollisionBox& b) { return a.x_min < b.x_min; });
+
+    collision_candidate_.clear();
+    for (size_t i = 0; i < collision_box_.size(); i++)
+    {
+        for (size_t j = i + 1; j < collision_box_.size() && collision_box_[j].x_min <= collision_box_[i].x_max; j++)
         {
-            Object* obj1 = entities_.object_[j];
-            if (obj0->Collision(obj1))
+            if (collision_box_[j].y_min <= collision_box_[i].y_max && collision_box_[i].y_min <= collision_box_[j].y_max)
             {
-                collision_pair_.push_back({obj0, obj1});
-                if (std::find(obj0->collisions_.begin(), obj0->collisions_.end(), obj1) == obj0->collisions_.end())
-                {
-                    // was not overlapping last timestep, but are now
-                    LOG_WARN("Collision between {} and {}", obj0->GetName(), obj1->GetName());
-                    obj0->collisions_.push_back(obj1);
-                    obj1->collisions_.push_back(obj0);
-                }
+                collision_candidate_.push_back(
+                    {MIN(collision_box_[i].idx, collision_box_[j].idx), MAX(collision_box_[i].idx, collision_box_[j].idx)});
             }
-            else
+        }
+    }
+
+    // Evaluate candidates in entity order, for deterministic registration order
+    std::sort(collision_candidate_.begin(), collision_candidate_.end());
+
+    // Narrow phase: Exact check of oriented bounding boxes
+    collision_keys_prev_.swap(entities_.collision_keys_);
+    entities_.collision_keys_.clear();
+    for (auto& candidate : collision_candidate_)
+    {
+        Object* obj0 = entities_.object_[candidate.first];
+        Object* obj1 = entities_.object_[candidate.second];
+        if (obj0->Collision(obj1))
+        {
+            uint64_t key = Entities::GetCollisionKey(obj0->GetId(), obj1->GetId());
+
+            collision_pair_.push_back({obj0, obj1});
+            entities_.collision_keys_.insert(key);
+            if (collision_keys_prev_.erase(key) == 0)
             {
-                if (std::find(obj0->collisions_.begin(), obj0->collisions_.end(), obj1) != obj0->collisions_.end())
-                {
-                    // was overlapping last frame, but not anymore
-                    LOG_WARN("Collision between {} and {} dissolved", obj0->GetName(), obj1->GetName());
-                    obj0->collisions_.erase(std::remove(obj0->collisions_.begin(), obj0->collisions_.end(), obj1), obj0->collisions_.end());
-                    obj1->collisions_.erase(std::remove(obj1->collisions_.begin(), obj1->collisions_.end(), obj0), obj1->collisions_.end());
-                }
+                // was not overlapping last timestep, but are now
+                LOG_WARN("Collision between {} and {}", obj0->GetName(), obj1->GetName());
+                obj0->collisions_.push_back(obj1);
+                obj1->collisions_.push_back(obj0);
             }
         }
     }
 
-    // Check for and clear any vanished objects from collision lists
-    for (size_t i = 0; i < entities_.object_.size(); i++)
+    // Any remaining previous pair has been dissolved, or one of the objects has vanished from the set of entities
+    for (auto key : collision_keys_prev_)
     {
-        for (size_t j = 0; j < entities_.object_[i]->collisions_.size(); j++)
+        int     idx0 = entities_.GetObjectIdxById(static_cast<int>(key & 0xffffffff));
+        int     idx1 = entities_.GetObjectIdxById(static_cast<int>(key >> 32));
+        Object* obj0 = idx0 < 0 ? nullptr : entities_.object_[static_cast<unsigned int>(idx0)];
+        Object* obj1 = idx1 < 0 ? nullptr : entities_.object_[static_cast<unsigned int>(idx1)];
+
+        if (obj0 && obj1)
         {
-            Object* obj = entities_.object_[i];
-            if (std::find(entities_.object_.begin(), entities_.object_.end(), obj->collisions_[j]) == entities_.object_.end())
+            // was overlapping last frame, but not anymore
+            LOG_WARN("Collision between {} and {} dissolved", obj0->GetName(), obj1->GetName());
+            obj0->collisions_.erase(std::remove(obj0->collisions_.begin(), obj0->collisions_.end(), obj1), obj0->collisions_.end());
+            obj1->collisions_.erase(std::remove(obj1->collisions_.begin(), obj1->collisions_.end(), obj0), obj1->collisions_.end());
+        }
+        else
+        {
+            // object previously collided with remaining object has vanished, remove it from collision list
+            Object* obj = obj0 ? obj0 : obj1;
+            if (obj != nullptr)
             {
-                // object previously collided with pivot object has vanished from the set of entities, remove it from collision list
                 LOG_ERROR("Unregister collision between {} and vanished entity", obj->GetName());
-                obj->collisions_.erase(obj->collisions_.begin() + static_cast<int>(j));
-                j--;
+                obj->collisions_.erase(std::remove_if(obj->collisions_.begin(),
+                                                      obj->collisions_.end(),
+                                                      [&](Object* o)
+                                                      { return std::find(entities_.object_.begin(), entities_.object_.end(), o) == entities_.object_.end(); }),
+                                       obj->collisions_.end());
             }
         }
     }
+    collision_keys_prev_.clear();
 
     return 0;
 }
@@ -15,6 +15,7 @@
 #include <iostream>
 #include <string>
 #include <vector>
+#include <unordered_set>
 #include <math.h>
 
 #include "Catalogs.hpp"
@@ -36,12 +37,36 @@ namespace scenarioengine
 
     void RegisterParameterDeclarationCallback(ParamDeclCallbackFunc func, void *data);
 
+    /**
+        Let RegisterParameterDeclarationCallback() and scenarios initialized by the calling thread use given callback
+        instead of the process wide one, e.g. to run several scenarios in parallel threads. Set nullptr to restore.
+        @param callback Callback storage, owned by caller
+    */
+    void SetThreadParameterDeclarationCallback(CallBack *callback);
+
+    class ScenarioEngine;
+
+    /**
+        Get scenario engine invoking the parameter declaration callback in the calling thread, i.e. the one being initialized
+        @return Pointer to the engine, or nullptr if not within the callback
+    */
+    ScenarioEngine *GetParameterDeclarationCallbackEngine();
+
     typedef struct
     {
         Object *object0;
         Object *object1;
     } CollisionPair;
 
+    typedef struct
+    {
+        double x_min;
+        double x_max;
+        double y_min;
+        double y_max;
+        size_t idx;  // index of object in entity list
+    } CollisionBox;  // world aligned bounding box of an entity, used for collision broad phase
+
     class ScenarioEngine
     {
     public:
@@ -71,10 +96,28 @@ namespace scenarioengine
         void prepareGroundTruth(double dt);
         int  defaultController(Object *obj, double dt);
 
+        /**
+        Set number of threads moving objects by the default controller in step(). Result is identical to a single thread.
+        @param n_threads Number of threads, 0 = one per CPU core, 1 = no extra threads
+        */
+        void         SetStepThreads(unsigned int n_threads);
+        unsigned int GetStepThreads() const
+        {
+            return step_pool_ != nullptr ? step_pool_->GetNumThreads() : 1;
+        }
+
         void ReplaceObjectInTrigger(Trigger *trigger, Object *obj1, Object *obj2, double timeOffset, Event *event = 0);
         void SetupGhost(Object *object);
         void ResetEvents();
         int  DetectCollisions();
+
+        /**
+        Save, verify or restore the simulation state, see SE_StateBuffer
+        Entities, storyboard and controllers need to be the same as when the state was saved
+        */
+        void SyncState(SE_StateBuffer &buf);
+
+
         void ParseGlobalDeclarations();
         void EraseCleanParams();
         void EraseCleanVariables();
@@ -145,6 +188,7 @@ namespace scenarioengine
 #ifdef _USE_OSI
         void SetOSIReporter(OSIReporter *osi_reporter)
         {
+            osi_reporter_ = osi_reporter;
             storyBoard.SetOSIReporter(osi_reporter);
         }
 #endif  // _USE_OSI
@@ -172,7 +216,23 @@ namespace scenarioengine
         unsigned int frame_nr_;
         int          init_status_;
 
-        int parseScenario();
+        // collision detection work buffers, kept between frames to avoid reallocation
+        std::vector<CollisionBox>              collision_box_;
+        std::vector<std::pair<size_t, size_t>> collision_candidate_;
+        std::unordered_set<uint64_t>           collision_keys_prev_;
+
+        // parallel step, see SetStepThreads()
+        SE_ThreadPool             *step_pool_ = nullptr;
+        std::vector<unsigned char> step_moved_;  // per object, set if moved by the default controller in parallel
+
+#ifdef _USE_OSI
+        OSIReporter *osi_reporter_ = nullptr;
+#endif  // _USE_OSI
+
+        int  parseScenario();
+        void FetchObjectState(Object *obj);
+        bool IsMovedByDefaultController(Object *obj);
+        bool IsMoveWithinRoad(Object *obj, double dt);
     };
 
 }  // namespace scenarioengine
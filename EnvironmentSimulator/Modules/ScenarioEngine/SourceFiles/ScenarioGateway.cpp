@@ -260,39 +260,54 @@ ScenarioGateway::ScenarioGateway()
 ScenarioGateway::~ScenarioGateway()
 {
     objectState_.clear();
+    objectIdx_.clear();
 
-    data_file_.flush();
-    data_file_.close();
+    dat_writer_.Close();
+}
+
+int ScenarioGateway::getObjectIdxById(int id)
+{
+    auto it = objectIdx_.find(id);
+
+    return it != objectIdx_.end() ? it->second : -1;
 }
 
 ObjectState* ScenarioGateway::getObjectStatePtrById(int id)
 {
-    for (size_t i = 0; i < objectState_.size(); i++)
-    {
-        if (objectState_[i]->state_.info.id == id)
-        {
-            return objectState_[i].get();
-        }
-    }
+    int idx = getObjectIdxById(id);
 
-    return 0;
+    return idx != -1 ? objectState_[static_cast<unsigned int>(idx)].get() : 0;
 }
 
 int ScenarioGateway::getObjectStateById(int id, ObjectState& objectState)
 {
-    for (size_t i = 0; i < objectState_.size(); i++)
+    ObjectState* obj_state = getObjectStatePtrById(id);
+
+    if (obj_state != nullptr)
     {
-        if (objectState_[i]->state_.info.id == id)
-        {
-            objectState = *objectState_[i];
-            return 0;
-        }
+        objectState = *obj_state;
+        return 0;
     }
 
     // Indicate not found by returning non zero
     return -1;
 }
 
+void ScenarioGateway::addObjectState(ObjectState* obj_state)
+{
+    objectIdx_[obj_state->state_.info.id] = static_cast<int>(objectState_.size());
+    objectState_.push_back(std::unique_ptr<ObjectState>{obj_state});
+}
+
+void ScenarioGateway::updateObjectIdx()
+{
+    objectIdx_.clear();
+    for (size_t i = 0; i < objectState_.size(); i++)
+    {
+        objectIdx_[objectState_[i]->state_.info.id] = static_cast<int>(i);
+    }
+}
+
 int ScenarioGateway::updateObjectInfo(ObjectState* obj_state,
                                       double       timestamp,
                                       int          visibilityMask,
@@ -381,7 +396,7 @@ int ScenarioGateway::reportObject(int                    id,
                                     pos);
 
         // Add object to collection
-        objectState_.push_back(std::unique_ptr<ObjectState>{obj_state});
+        addObjectState(obj_state);
     }
     else
     {
@@ -446,7 +461,7 @@ int ScenarioGateway::reportObject(int            id,
                                     r);
 
         // Add object to collection
-        objectState_.push_back(std::unique_ptr<ObjectState>{obj_state});
+        addObjectState(obj_state);
     }
     else
     {
@@ -508,7 +523,7 @@ int ScenarioGateway::reportObject(int            id,
                                     0);
 
         // Add object to collection
-        objectState_.push_back(std::unique_ptr<ObjectState>{obj_state});
+        addObjectState(obj_state);
     }
     else
     {
@@ -569,7 +584,7 @@ int ScenarioGateway::reportObject(int            id,
                                     s);
 
         // Add object to collection
-        objectState_.push_back(std::unique_ptr<ObjectState>{obj_state});
+        addObjectState(obj_state);
     }
     else
     {
@@ -628,7 +643,7 @@ int ScenarioGateway::reportObject(int            id,
                                     s);
 
         // Add object to collection
-        objectState_.push_back(std::unique_ptr<ObjectState>{obj_state});
+        addObjectState(obj_state);
     }
     else
     {
@@ -1072,6 +1087,7 @@ void ScenarioGateway::removeObject(int id)
             ++objectIt;
         }
     }
+    updateObjectIdx();
 }
 
 void ScenarioGateway::removeObject(std::string name)
@@ -1087,11 +1103,45 @@ void ScenarioGateway::removeObject(std::string name)
             ++objectIt;
         }
     }
+    updateObjectIdx();
+}
+
+void ScenarioGateway::SyncState(SE_StateBuffer& buf)
+{
+    std::vector<ObjectState> states;
+
+    if (buf.IsSaving())
+    {
+        states.reserve(objectState_.size());
+        for (size_t i = 0; i < objectState_.size(); i++)
+        {
+            states.push_back(*objectState_[i]);
+        }
+    }
+
+    buf.Sync(states);
+
+    if (buf.IsRestoring() && buf.IsOK())
+    {
+        objectState_.resize(states.size());
+        for (size_t i = 0; i < states.size(); i++)
+        {
+            if (objectState_[i])
+            {
+                *objectState_[i] = states[i];
+            }
+            else
+            {
+                objectState_[i] = std::make_unique<ObjectState>(states[i]);
+            }
+        }
+        updateObjectIdx();
+    }
 }
 
 void ScenarioGateway::WriteStatesToFile()
 {
-    if (data_file_.is_open())
+    if (dat_writer_.IsOpen())
     {
         // Write status to file - for later replay
         for (size_t i = 0; i < objectState_.size(); i++)
@@ -1128,8 +1178,9 @@ void ScenarioGateway::WriteStatesToFile()
             datState.pos.offset = static_cast<float>(objectState_[i]->state_.pos.GetOffset());
             datState.pos.t      = static_cast<float>(objectState_[i]->state_.pos.GetT());
             datState.pos.s      = static_cast<float>(objectState_[i]->state_.pos.GetS());
-            data_file_.write(reinterpret_cast<char*>(&datState), sizeof(datState));
+            dat_writer_.Write(datState);
         }
+        dat_writer_.EndFrame();
     }
 }
 
@@ -1137,18 +1188,7 @@ int ScenarioGateway::RecordToFile(std::string filename, std::string odr_filename
 {
     if (!filename.empty())
     {
-        data_file_.open(filename, std::ofstream::binary);
-        if (data_file_.fail())
-        {
-            LOG_ERROR("Cannot open file: {}", filename);
-            return -1;
-        }
-        DatHeader header;
-        header.version = DAT_FILE_FORMAT_VERSION;
-        StrCopy(header.odr_filename, odr_filename.c_str(), MIN(odr_filename.length() + 1, DAT_FILENAME_SIZE));
-        StrCopy(header.model_filename, model_filename.c_str(), MIN(model_filename.length() + 1, DAT_FILENAME_SIZE));
-
-        data_file_.write(reinterpret_cast<char*>(&header), sizeof(header));
+        return dat_writer_.Open(filename, odr_filename, model_filename);
     }
 
     return 0;
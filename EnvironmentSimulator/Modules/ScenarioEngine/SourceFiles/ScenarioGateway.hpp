@@ -11,18 +11,15 @@
  */
 
 #pragma once
+#include <unordered_map>
 #include "RoadManager.hpp"
 #include "OSCBoundingBox.hpp"
 #include "Entities.hpp"
-
-#define DAT_FILE_FORMAT_VERSION 2
-#define DAT_FILENAME_SIZE       512
+#include "DatFile.hpp"
 
 namespace scenarioengine
 {
 
-#define NAME_LEN 32
-
     struct ObjectInfoStruct
     {
         int                    id;
@@ -50,51 +47,6 @@ namespace scenarioengine
         roadmanager::Position   pos;
     };
 
-    struct ObjectInfoStructDat
-    {
-        int            id;
-        int            model_id;
-        int            obj_type;      // 0=None, 1=Vehicle, 2=Pedestrian, 3=MiscObj (see Object::Type enum)
-        int            obj_category;  // sub type for vehicle, pedestrian and miscobj
-        int            ctrl_type;     // See Controller::Type enum
-        float          timeStamp;
-        char           name[NAME_LEN];
-        float          speed;
-        float          wheel_angle;  // Only used for vehicle
-        float          wheel_rot;    // Only used for vehicle
-        OSCBoundingBox boundingbox;
-        int            scaleMode;       // 0=None, 1=BoundingBoxToModel, 2=ModelToBoundingBox (see enum EntityScaleMode)
-        int            visibilityMask;  // bitmask according to Object::Visibility (1 = Graphics, 2 = Traffic, 4 = Sensors)
-    };
-
-    struct ObjectPositionStructDat
-    {
-        float x;
-        float y;
-        float z;
-        float h;
-        float p;
-        float r;
-        id_t  roadId;
-        int   laneId;
-        float offset;
-        float t;
-        float s;
-    };
-
-    struct ObjectStateStructDat
-    {
-        struct ObjectInfoStructDat     info;
-        struct ObjectPositionStructDat pos;
-    };
-
-    typedef struct
-    {
-        int  version;
-        char odr_filename[DAT_FILENAME_SIZE];
-        char model_filename[DAT_FILENAME_SIZE];
-    } DatHeader;
-
     class ObjectState
     {
     public:
@@ -363,14 +315,30 @@ namespace scenarioengine
         }
         ObjectState *getObjectStatePtrById(int id);
         int          getObjectStateById(int idx, ObjectState &objState);
-        void         WriteStatesToFile();
-        int          RecordToFile(std::string filename, std::string odr_filename, std::string model_filename);
+
+        /**
+        Get index of object in objectState_, constant time lookup
+        @param id Id of the object
+        @return index, or -1 if not found
+        */
+        int  getObjectIdxById(int id);
+        void WriteStatesToFile();
+        int  RecordToFile(std::string filename, std::string odr_filename, std::string model_filename);
+
+        /**
+        Save or restore reported object states, see SE_StateBuffer. Any recording is not rewound.
+        */
+        void SyncState(SE_StateBuffer &buf);
 
         std::vector<std::unique_ptr<ObjectState>> objectState_;
 
     private:
-        int updateObjectInfo(ObjectState *obj_state, double timestamp, int visibilityMask, double speed, double wheel_angle, double wheel_rot);
-        std::ofstream data_file_;
+        int  updateObjectInfo(ObjectState *obj_state, double timestamp, int visibilityMask, double speed, double wheel_angle, double wheel_rot);
+        void addObjectState(ObjectState *obj_state);
+        void updateObjectIdx();
+
+        DatWriter                    dat_writer_;
+        std::unordered_map<int, int> objectIdx_;  // object id to index in objectState_
     };
 
 }  // namespace scenarioengine
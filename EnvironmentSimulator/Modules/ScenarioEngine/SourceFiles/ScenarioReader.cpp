@@ -35,15 +35,6 @@
 
 using namespace scenarioengine;
 
-namespace scenarioengine
-{
-    static ControllerPool controllerPoolStatic;
-    ControllerPool        ScenarioReader::controllerPool_ = controllerPoolStatic;
-
-    Parameters ScenarioReader::parameters;
-    Parameters ScenarioReader::variables;
-}  // namespace scenarioengine
-
 typedef struct
 {
     std::string                    element_name;
@@ -53,7 +44,8 @@ typedef struct
     TrigByState                   *condition;
 } StoryBoardElementTriggerInfo;
 
-static std::vector<StoryBoardElementTriggerInfo> storyboard_element_triggers;
+// Collected and resolved while parsing the storyboard, within the same call
+static thread_local std::vector<StoryBoardElementTriggerInfo> storyboard_element_triggers;
 
 ScenarioReader::ScenarioReader(Entities *entities, Catalogs *catalogs, bool disable_controllers)
     : entities_(entities),
@@ -62,6 +54,7 @@ ScenarioReader::ScenarioReader(Entities *entities, Catalogs *catalogs, bool disa
       story_board_(nullptr)
 {
     parameters.Clear();
+    variables.resolve_parameters_ = &parameters;
 }
 
 ScenarioReader::~ScenarioReader()
@@ -99,7 +92,7 @@ void ScenarioReader::LoadControllers()
 
 void ScenarioReader::UnloadControllers()
 {
-    ScenarioReader::controllerPool_.Clear();
+    controllerPool_.Clear();
 }
 
 int ScenarioReader::RemoveController(Controller *controller)
@@ -278,9 +271,9 @@ Catalog *ScenarioReader::LoadCatalog(std::string name)
     }
 
     // Not found, try to locate it in one the registered catalog directories
-    pugi::xml_document       catalog_doc;
-    pugi::xml_parse_result   result;
-    std::vector<std::string> file_name_candidates;
+    std::shared_ptr<const pugi::xml_document> catalog_doc;
+    pugi::xml_parse_result                    result;
+    std::vector<std::string>                  file_name_candidates;
     for (size_t i = 0; i < catalogs_->catalog_dirs_.size() && !result; i++)
     {
         file_name_candidates.clear();
@@ -300,8 +293,8 @@ Catalog *ScenarioReader::LoadCatalog(std::string name)
         {
             if (FileExists(file_name_candidates[j].c_str()))
             {
-                // Load it
-                result = catalog_doc.load_file(file_name_candidates[j].c_str());
+                // Load it, or pick already parsed document from the cache
+                catalog_doc = CatalogCache::Inst().Load(file_name_candidates[j], result);
             }
         }
     }
@@ -310,10 +303,10 @@ Catalog *ScenarioReader::LoadCatalog(std::string name)
         throw std::runtime_error("Couldn't locate catalog file: " + name + ". " + result.description());
     }
 
-    pugi::xml_node osc_node_ = catalog_doc.child("OpenSCENARIO");
+    pugi::xml_node osc_node_ = catalog_doc->child("OpenSCENARIO");
     if (!osc_node_)
     {
-        osc_node_ = catalog_doc.child("OpenScenario");
+        osc_node_ = catalog_doc->child("OpenScenario");
         if (!osc_node_)
         {
             throw std::runtime_error("Couldn't find Catalog OpenSCENARIO or OpenScenario element - check XML!");
@@ -1019,7 +1012,7 @@ Controller *ScenarioReader::parseOSCObjectController(pugi::xml_node controllerNo
         ctrlType = name;
     }
 
-    ControllerPool::ControllerEntry *ctrl_entry = ScenarioReader::controllerPool_.GetControllerByType(ctrlType);
+    ControllerPool::ControllerEntry *ctrl_entry = controllerPool_.GetControllerByType(ctrlType);
     if (ctrl_entry)
     {
         Controller::InitArgs args;
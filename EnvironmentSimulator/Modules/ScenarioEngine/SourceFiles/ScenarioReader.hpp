@@ -149,9 +149,9 @@ namespace scenarioengine
             return !osc_root_.empty();
         }
 
-        static void RegisterController(std::string type_name, ControllerInstantiateFunction function)
+        void RegisterController(std::string type_name, ControllerInstantiateFunction function)
         {
-            ScenarioReader::controllerPool_.AddController(type_name, function);
+            controllerPool_.AddController(type_name, function);
         }
 
         void LoadControllers();
@@ -182,8 +182,9 @@ namespace scenarioengine
 
         std::vector<Controller*> controller_;
 
-        static Parameters parameters;  // static to enable set via callback during creation of object
-        static Parameters variables;
+        // Owned per scenario. During the parameter declaration callback reach them via GetParameterDeclarationCallbackEngine().
+        Parameters parameters;
+        Parameters variables;
 
     private:
         pugi::xml_document    doc_;
@@ -194,7 +195,7 @@ namespace scenarioengine
         ScenarioGateway*      gateway_;
         ScenarioEngine*       scenarioEngine_;
         bool                  disable_controllers_;
-        static ControllerPool controllerPool_;
+        ControllerPool        controllerPool_;
         int                   versionMajor_;
         int                   versionMinor_;
         std::string           description_;
@@ -129,6 +129,32 @@ void StoryBoard::Step(double simTime, double dt)
     StoryBoardElement::Step(simTime, dt);
 }
 
+void StoryBoard::SyncState(SE_StateBuffer& buf)
+{
+    buf.Expect(init_.global_action_.size() + init_.user_defined_action_.size() + init_.private_action_.size());
+    if (!buf.IsOK())
+    {
+        return;
+    }
+
+    for (auto action : init_.global_action_)
+    {
+        action->SyncState(buf);
+    }
+
+    for (auto action : init_.user_defined_action_)
+    {
+        action->SyncState(buf);
+    }
+
+    for (auto action : init_.private_action_)
+    {
+        action->SyncState(buf);
+    }
+
+    StoryBoardElement::SyncState(buf);
+}
+
 void Event::Start(double simTime)
 {
     double adjustedTime = simTime;
@@ -253,6 +253,7 @@ namespace scenarioengine
         void      Print();
         void      Start(double simTime) override;
         void      Step(double simTime, double dt) override;
+        void      SyncState(SE_StateBuffer& buf) override;
 
         std::vector<StoryBoardElement*>* GetChildren() override
         {
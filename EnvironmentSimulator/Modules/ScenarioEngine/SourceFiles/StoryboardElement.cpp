@@ -25,7 +25,7 @@ using namespace scenarioengine;
 void (*StoryBoardElement::stateChangeCallback)(const char* name, int type, int state, const char* full_path) = nullptr;
 
 #ifdef _USE_OSI
-OSIReporter* StoryBoardElement::osi_reporter_ = nullptr;
+thread_local OSIReporter* StoryBoardElement::osi_reporter_ = nullptr;
 #endif  // _USE_OSI
 
 std::string StoryBoardElement::state2str(StoryBoardElement::State state)
@@ -379,6 +379,26 @@ void StoryBoardElement::Reset(State state)
     }
 }
 
+void StoryBoardElement::SyncState(SE_StateBuffer& buf)
+{
+    buf.Sync(num_executions_, state_, transition_);
+
+    for (Trigger* trigger : {start_trigger_, stop_trigger_})
+    {
+        if (trigger != nullptr)
+        {
+            trigger->SyncState(buf);
+        }
+    }
+
+    std::vector<StoryBoardElement*>* children = GetChildren();
+    buf.Expect(children->size());
+    for (size_t i = 0; i < children->size() && buf.IsOK(); i++)
+    {
+        (*children)[i]->SyncState(buf);
+    }
+}
+
 void StoryBoardElement::SetName(std::string name)
 {
     name_ = name;
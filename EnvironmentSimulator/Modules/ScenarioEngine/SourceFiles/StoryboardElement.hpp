@@ -80,8 +80,9 @@ namespace scenarioengine
         Trigger* stop_trigger_;
 
 #ifdef _USE_OSI
-        static OSIReporter* osi_reporter_;
-        static void         SetOSIReporter(OSIReporter* osi_reporter)
+        // Reporter of the scenario being stepped by current thread, see ScenarioEngine::SetOSIReporter()
+        static thread_local OSIReporter* osi_reporter_;
+        static void                      SetOSIReporter(OSIReporter* osi_reporter)
         {
             osi_reporter_ = osi_reporter;
         };
@@ -181,6 +182,11 @@ namespace scenarioengine
 
         virtual void Reset(State state = State::INIT);
 
+        /**
+         * Save or restore state of this element, its triggers and all child elements, see SE_StateBuffer
+         */
+        virtual void SyncState(SE_StateBuffer& buf);
+
         void SetName(std::string name);
 
         const std::string GetName() const
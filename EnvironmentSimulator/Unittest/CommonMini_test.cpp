@@ -2,6 +2,10 @@
 
 #include "CommonMini.hpp"
 #include "esminiLib.hpp"
+#include <atomic>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
 
 struct Coordinate2D
 {
@@ -389,6 +393,199 @@ TEST(LinearAlgebra, TestAngleBetweenVectors)
     EXPECT_NEAR(GetAngleBetweenVectors(v1[0], v1[1], v2[0], v2[1]), 2.798, 1E-3);
 }
 
+TEST(ThreadPoolTest, TestRunAndException)
+{
+    SE_ThreadPool       pool(3);
+    std::vector<int>    result(100, 0);
+    std::atomic<size_t> calls(0);
+
+    pool.Run(result.size(), [&](size_t i) { result[i] = static_cast<int>(i) * 2; });
+    for (size_t i = 0; i < result.size(); i++)
+    {
+        EXPECT_EQ(result[i], static_cast<int>(i) * 2);
+    }
+
+    // exception in a worker is passed on to the caller instead of terminating the process
+    EXPECT_THROW(pool.Run(result.size(),
+                          [&](size_t i)
+                          {
+                              if (i == 10)
+                              {
+                                  throw std::runtime_error("failed step");
+                              }
+                          }),
+                 std::runtime_error);
+
+    // pool still usable
+    pool.Run(result.size(), [&](size_t) { calls++; });
+    EXPECT_EQ(calls, result.size());
+}
+
+TEST(ProfilerTest, TestMeasureAndTrace)
+{
+    SE_Profiler& profiler = SE_Profiler::Inst();
+
+    // disabled, nothing measured
+    profiler.Reset();
+    {
+        SE_ProfileScope scope("test phase");
+    }
+    for (auto& phase : profiler.GetPhases())
+    {
+        EXPECT_EQ(phase.count, 0);
+    }
+
+    profiler.Enable(true, true);
+    int id = profiler.GetPhaseId("test phase");
+    EXPECT_EQ(profiler.GetPhaseId("test phase"), id);
+
+    int inner_id = profiler.GetPhaseId("test inner");
+    for (int i = 0; i < 3; i++)
+    {
+        SE_ProfileScope scope("test phase");
+        SE_ProfileScope inner(inner_id);
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        inner.End();
+    }
+    profiler.Enable(false);
+
+    std::vector<SE_Profiler::Phase> phases = profiler.GetPhases();
+    SE_Profiler::Phase&             phase  = phases[static_cast<unsigned int>(id)];
+    EXPECT_EQ(phase.count, 3);
+    EXPECT_GE(phase.min_us, 2000.0);
+    EXPECT_GE(phase.max_us, phase.min_us);
+    EXPECT_GE(phase.total_us, 3 * phase.min_us);
+    EXPECT_EQ(phase.histogram[0] + phase.histogram[1], 0);  // none below 2 us
+    unsigned int n = 0;
+    for (int i = 0; i < SE_PROFILE_NUM_BUCKETS; i++)
+    {
+        n += phase.histogram[i];
+    }
+    EXPECT_EQ(n, 3);
+    EXPECT_EQ(phases[static_cast<unsigned int>(inner_id)].count, 3);
+
+    ASSERT_EQ(profiler.SaveTrace("profile_test.json"), 0);
+    std::ifstream     file("profile_test.json");
+    std::stringstream buf;
+    buf << file.rdbuf();
+    std::string trace = buf.str();
+    EXPECT_EQ(trace.rfind("{\"traceEvents\":[", 0), 0);
+    EXPECT_NE(trace.find("\"name\":\"test inner\",\"ph\":\"X\""), std::string::npos);
+
+    profiler.Reset();
+    EXPECT_EQ(profiler.GetPhases()[static_cast<unsigned int>(id)].count, 0);
+}
+
+TEST(StateBufferTest, TestSaveVerifyRestore)
+{
+    SE_StateBuffer           buf;
+    double                   x      = 1.5;
+    int                      n      = 3;
+    std::vector<std::string> names  = {"a", "b"};
+    bool                     option = true;
+
+    buf.Begin(SE_StateBuffer::Mode::SAVE);
+    buf.Sync(x, n, names);
+    buf.Expect(names.size());
+    buf.SyncLayout(option);
+    EXPECT_TRUE(buf.End());
+    EXPECT_EQ(buf.GetNumberOfValues(), 5);
+
+    x      = 2.5;
+    n      = 4;
+    option = false;
+    names.push_back("c");
+
+    // verify does not change any value
+    buf.Begin(SE_StateBuffer::Mode::VERIFY);
+    buf.Sync(x, n, names);
+    buf.Expect(static_cast<size_t>(2));
+    buf.SyncLayout(option);
+    EXPECT_TRUE(buf.End());
+    EXPECT_EQ(x, 2.5);
+    EXPECT_EQ(names.size(), 3);
+
+    // structure values are read in verify mode as well
+    EXPECT_TRUE(option);
+
+    buf.Begin(SE_StateBuffer::Mode::RESTORE);
+    buf.Sync(x, n, names);
+    EXPECT_TRUE(buf.IsOK());
+    EXPECT_EQ(x, 1.5);
+    EXPECT_EQ(n, 3);
+    EXPECT_EQ(names.size(), 2);
+
+    // remaining values not read
+    EXPECT_FALSE(buf.End());
+
+    // wrong order of types
+    buf.Begin(SE_StateBuffer::Mode::RESTORE);
+    buf.Sync(n);
+    EXPECT_FALSE(buf.IsOK());
+    EXPECT_EQ(buf.GetError(), "State structure changed, value 0 type mismatch");
+
+    // changed structure
+    buf.Begin(SE_StateBuffer::Mode::VERIFY);
+    buf.Sync(x, n, names);
+    buf.Expect(names.size() + 1);
+    EXPECT_FALSE(buf.End());
+    EXPECT_EQ(buf.GetError(), "State structure changed, value 3 differs");
+}
+
+class StateTestObject : public SE_StateRegistered<StateTestObject>
+{
+public:
+    int value = 0;
+};
+
+TEST(StateBufferTest, TestSyncRef)
+{
+    SE_StateBuffer   buf;
+    StateTestObject  a;
+    StateTestObject* b   = new StateTestObject;
+    StateTestObject* ref = b;
+
+    // copies get their own id
+    StateTestObject copy = a;
+    EXPECT_NE(copy.GetStateId(), a.GetStateId());
+    copy = a;
+    EXPECT_NE(copy.GetStateId(), a.GetStateId());
+    EXPECT_EQ(StateTestObject::FindByStateId(a.GetStateId()), &a);
+
+    buf.Begin(SE_StateBuffer::Mode::SAVE);
+    buf.SyncRef(ref);
+    EXPECT_TRUE(buf.End());
+
+    ref = &a;
+    buf.Begin(SE_StateBuffer::Mode::RESTORE);
+    buf.SyncRef(ref);
+    EXPECT_TRUE(buf.End());
+    EXPECT_EQ(ref, b);
+
+    // referred object deleted after save, never restore the stale pointer
+    ref = &a;
+    delete b;
+    buf.Begin(SE_StateBuffer::Mode::VERIFY);
+    buf.SyncRef(ref);
+    EXPECT_FALSE(buf.End());
+    EXPECT_EQ(buf.GetError(), "Object referred to by saved state has been deleted");
+
+    buf.Begin(SE_StateBuffer::Mode::RESTORE);
+    buf.SyncRef(ref);
+    EXPECT_FALSE(buf.End());
+    EXPECT_EQ(ref, &a);
+
+    // no reference
+    ref = nullptr;
+    buf.Begin(SE_StateBuffer::Mode::SAVE);
+    buf.SyncRef(ref);
+    ref = &a;
+    buf.Begin(SE_StateBuffer::Mode::RESTORE);
+    buf.SyncRef(ref);
+    EXPECT_TRUE(buf.End());
+    EXPECT_EQ(ref, nullptr);
+}
+
 int main(int argc, char** argv)
 {
     // testing::GTEST_FLAG(filter) = "*TestIsPointWithinSectorBetweenTwoLines*";
@@ -487,6 +487,80 @@ TEST(TestSetMethods, TestSetH)
     RM_Close();
 }
 
+TEST(TestBatch, TestLaneAndWorldPosBatch)
+{
+    const char* odr_file = "../../../resources/xodr/e6mini.xodr";
+
+    ASSERT_EQ(RM_Init(odr_file), 0);
+
+    // points along the driving lanes of all roads, more than fits in one batch range
+    std::vector<RM_LanePosition> lane_pos;
+    for (int i = 0; i < RM_GetNumberOfRoads(); i++)
+    {
+        id_t road_id = RM_GetIdOfRoadFromIndex(static_cast<unsigned int>(i));
+        for (int lane_id : {-3, -2, -1, 1, 2, 3})
+        {
+            for (float s = 0.5f; s < RM_GetRoadLength(road_id); s += 2.0f)
+            {
+                if (RM_GetLaneTypeByRoadId(road_id, lane_id, s) == 2)  // driving lane
+                {
+                    lane_pos.push_back({road_id, lane_id, 0.3f, s});
+                }
+            }
+        }
+    }
+    ASSERT_GT(lane_pos.size(), 2000);
+    lane_pos.push_back({12345, -1, 0.0f, 10.0f});  // no such road
+
+    std::vector<RM_PositionData> data(lane_pos.size());
+    std::vector<int>             status(lane_pos.size());
+    EXPECT_EQ(RM_LanePosToWorldBatch(lane_pos.data(), static_cast<int>(lane_pos.size()), data.data(), status.data()), 1);
+    EXPECT_LT(status.back(), 0);
+
+    // same result as one position at a time
+    int pos_handle = RM_CreatePosition();
+    for (size_t i = 0; i < lane_pos.size() - 1; i += 97)
+    {
+        RM_PositionData pos_data;
+        EXPECT_EQ(RM_SetLanePosition(pos_handle, lane_pos[i].roadId, lane_pos[i].laneId, lane_pos[i].laneOffset, lane_pos[i].s, false), status[i]);
+        RM_GetPositionData(pos_handle, &pos_data);
+        EXPECT_EQ(pos_data.x, data[i].x);
+        EXPECT_EQ(pos_data.y, data[i].y);
+        EXPECT_EQ(pos_data.h, data[i].h);
+        EXPECT_EQ(pos_data.laneId, lane_pos[i].laneId);
+    }
+
+    // back to road coordinates, expecting same result regardless of number of threads
+    std::vector<RM_PositionXYZ> world_pos;
+    for (size_t i = 0; i < data.size() - 1; i++)
+    {
+        world_pos.push_back({data[i].x, data[i].y, std::nanf("")});
+    }
+    std::vector<RM_PositionData> data1(world_pos.size());
+    std::vector<RM_PositionData> data4(world_pos.size());
+    EXPECT_EQ(RM_WorldToLanePosBatch(world_pos.data(), static_cast<int>(world_pos.size()), data1.data(), nullptr), 0);
+    RM_SetBatchThreads(4);
+    EXPECT_EQ(RM_WorldToLanePosBatch(world_pos.data(), static_cast<int>(world_pos.size()), data4.data(), nullptr), 0);
+
+    for (size_t i = 0; i < world_pos.size(); i++)
+    {
+        EXPECT_EQ(data1[i].roadId, data4[i].roadId);
+        EXPECT_EQ(data1[i].laneId, data4[i].laneId);
+        EXPECT_EQ(data1[i].s, data4[i].s);
+        EXPECT_EQ(data1[i].laneOffset, data4[i].laneOffset);
+        if (data1[i].roadId == lane_pos[i].roadId)
+        {
+            EXPECT_EQ(data1[i].laneId, lane_pos[i].laneId);
+            EXPECT_NEAR(data1[i].s, lane_pos[i].s, 1e-2);
+            EXPECT_NEAR(data1[i].laneOffset, lane_pos[i].laneOffset, 1e-2);
+        }
+    }
+
+    EXPECT_EQ(RM_WorldToLanePosBatch(nullptr, 1, data1.data(), nullptr), -1);
+
+    RM_Close();
+}
+
 int main(int argc, char** argv)
 {
     testing::InitGoogleTest(&argc, argv);
@@ -3,6 +3,9 @@
 #include <gmock/gmock.h>
 #include <vector>
 #include <stdexcept>
+#include <cinttypes>
+#include <fstream>
+#include <set>
 
 #include "RoadManager.hpp"
 
@@ -688,6 +691,37 @@ TEST_F(SpiralGeomTestFixture, TestEvaluateCurvatureDS)
     ASSERT_EQ(spiral_second.EvaluateCurvatureDS(1000), 2002.0);
 }
 
+TEST_F(SpiralGeomTestFixture, TestEvaluateDSTable)
+{
+    // s, x, y, hdg, length, curv_start, curv_end
+    double params[][7] = {{0.0, 0.0, 0.0, 0.0, 100.0, 0.0, 0.02},
+                          {10.0, 5.0, -3.0, 1.2, 50.0, 0.01, -0.05},
+                          {0.0, -100.0, 200.0, -2.5, 200.0, -0.002, -0.001},
+                          {0.0, 0.0, 0.0, 3.0, 20.0, 0.2, 0.0}};
+
+    for (auto &p : params)
+    {
+        SE_Env::Inst().GetOptions().SetOptionValue("spiral_exact", "");
+        Spiral exact(p[0], p[1], p[2], p[3], p[4], p[5], p[6]);
+        SE_Env::Inst().GetOptions().UnsetOption("spiral_exact");
+        Spiral table(p[0], p[1], p[2], p[3], p[4], p[5], p[6]);
+
+        EXPECT_FALSE(exact.HasTable());
+        ASSERT_TRUE(table.HasTable());
+
+        for (int i = 0; i <= 1000; i++)
+        {
+            double ds = p[4] * i / 1000.0;
+            double x0, y0, h0, x1, y1, h1;
+            exact.EvaluateDS(ds, &x0, &y0, &h0);
+            table.EvaluateDS(ds, &x1, &y1, &h1);
+            EXPECT_NEAR(x1, x0, 1e-9);
+            EXPECT_NEAR(y1, y0, 1e-9);
+            EXPECT_NEAR(h1, h0, 1e-9);
+        }
+    }
+}
+
 /*
 TODO: Remaining Test for this class is to test EvaluateDs function which inclides odrSpiral function
 as extern void -> Check this later.
@@ -4260,6 +4294,56 @@ TEST(RoadId, TestStringRoadId)
     odr->Clear();
 }
 
+TEST(RoadId, TestLookupIndex)
+{
+    ASSERT_EQ(roadmanager::Position::LoadOpenDrive("../../../EnvironmentSimulator/Unittest/xodr/fabriksgatan_mixed_id_types.xodr"), true);
+    roadmanager::OpenDrive *odr = Position::GetOpenDrive();
+    ASSERT_NE(odr, nullptr);
+
+    // each road and junction is found by its id, index and id string
+    for (unsigned int i = 0; i < odr->GetNumOfRoads(); i++)
+    {
+        Road *road = odr->GetRoadByIdx(i);
+        EXPECT_EQ(odr->GetRoadById(road->GetId()), road);
+        EXPECT_EQ(odr->GetTrackIdxById(road->GetId()), i);
+        EXPECT_EQ(odr->GetRoadByIdStr(road->GetIdStr()), road);
+
+        for (unsigned int j = 0; j < road->GetNumberOfLaneSections(); j++)
+        {
+            LaneSection *ls = road->GetLaneSectionByIdx(j);
+            for (unsigned int k = 0; k < ls->GetNumberOfLanes(); k++)
+            {
+                EXPECT_EQ(ls->GetLaneIdxById(ls->GetLaneIdByIdx(k)), k);
+                EXPECT_EQ(ls->GetLaneById(ls->GetLaneIdByIdx(k)), ls->GetLaneByIdx(k));
+            }
+            EXPECT_EQ(ls->GetLaneById(100), nullptr);
+            EXPECT_EQ(ls->GetLaneIdxById(-100), IDX_UNDEFINED);
+        }
+    }
+    for (unsigned int i = 0; i < odr->GetNumOfJunctions(); i++)
+    {
+        Junction *junction = odr->GetJunctionByIdx(i);
+        EXPECT_EQ(odr->GetJunctionById(junction->GetId()), junction);
+        EXPECT_EQ(odr->GetJunctionByIdStr(junction->GetIdStr()), junction);
+    }
+    EXPECT_EQ(odr->GetRoadById(1000), nullptr);
+    EXPECT_EQ(odr->GetRoadByIdStr("Nisse"), nullptr);
+    EXPECT_EQ(odr->GetJunctionById(1000), nullptr);
+
+    // lookups follow a reload of another road network
+    ASSERT_EQ(roadmanager::Position::LoadOpenDrive("../../../resources/xodr/straight_500m.xodr"), true);
+    odr = Position::GetOpenDrive();
+    EXPECT_EQ(odr->GetNumOfRoads(), 1);
+    EXPECT_EQ(odr->GetRoadByIdStr("Kalle"), nullptr);
+    EXPECT_EQ(odr->GetRoadById(3), nullptr);
+    ASSERT_NE(odr->GetRoadById(odr->GetRoadByIdx(0)->GetId()), nullptr);
+    EXPECT_EQ(odr->GetRoadById(odr->GetRoadByIdx(0)->GetId()), odr->GetRoadByIdx(0));
+
+    odr->Clear();
+    EXPECT_EQ(odr->GetRoadById(0), nullptr);
+    EXPECT_EQ(odr->GetRoadById(1), nullptr);
+}
+
 // Verify correct mapping of XY positions to road coordinates
 // For visual inspection, see scenario file with same name
 // is should include same positions as in this test
@@ -4291,6 +4375,501 @@ TEST(PositionTest, TestClosestRoadPosFromXY)
     EXPECT_NEAR(pos.GetS(), 171.34, 1e-2);
 }
 
+TEST(RoadGridTest, TestCandidateRoads)
+{
+    Position::GetOpenDrive()->LoadOpenDriveFile("../../../resources/xodr/fabriksgatan.xodr");
+    OpenDrive *odr = Position::GetOpenDrive();
+    ASSERT_NE(odr, nullptr);
+
+    const RoadGrid &grid = odr->GetRoadGrid();
+    ASSERT_FALSE(grid.IsEmpty());
+    EXPECT_GE(grid.GetCellSize(), 10.0);
+
+    Position pos;
+    pos.SetLanePos(2, 1, 50.0, 0.5);
+
+    // road should be registered in the cell containing the point
+    std::vector<idx_t> roads;
+    grid.GetRoadsInRing(pos.GetX(), pos.GetY(), 0, roads);
+    EXPECT_NE(std::find(roads.begin(), roads.end(), odr->GetTrackIdxById(2)), roads.end());
+
+    // all roads found when visiting all rings
+    roads.clear();
+    EXPECT_EQ(grid.GetFirstRing(pos.GetX(), pos.GetY()), 0);
+    for (int i = 0; i <= grid.GetLastRing(pos.GetX(), pos.GetY()); i++)
+    {
+        grid.GetRoadsInRing(pos.GetX(), pos.GetY(), i, roads);
+    }
+    std::sort(roads.begin(), roads.end());
+    roads.erase(std::unique(roads.begin(), roads.end()), roads.end());
+    EXPECT_EQ(roads.size(), odr->GetNumOfRoads());
+
+    // point outside grid, expect closest road to be found anyway
+    EXPECT_GT(grid.GetFirstRing(5000.0, 5000.0), 0);
+    Position pos2;
+    pos2.XYZ2TrackPos(pos.GetX(), pos.GetY(), 0.0);
+    EXPECT_EQ(pos2.GetTrackId(), 2);
+    EXPECT_NEAR(pos2.GetS(), 50.0, 1e-2);
+    EXPECT_EQ(pos2.XYZ2TrackPos(5000.0, 5000.0, 0.0), Position::ReturnCode::OK);
+    EXPECT_NE(pos2.GetTrackId(), ID_UNDEFINED);
+
+    // index is cleared along with the road network
+    odr->Clear();
+    EXPECT_TRUE(odr->GetRoadGrid().IsEmpty());
+}
+
+TEST(RoadGridTest, TestSearchMatchesExhaustive)
+{
+    for (std::string filename : {"fabriksgatan.xodr", "multi_intersections.xodr"})
+    {
+        ASSERT_TRUE(Position::GetOpenDrive()->LoadOpenDriveFile(("../../../resources/xodr/" + filename).c_str()));
+        OpenDrive *odr = Position::GetOpenDrive();
+
+        // points covering the road network with some margin, on and off the roads
+        double x_min = LARGE_NUMBER, y_min = LARGE_NUMBER, x_max = -LARGE_NUMBER, y_max = -LARGE_NUMBER;
+        for (unsigned int i = 0; i < odr->GetNumOfRoads(); i++)
+        {
+            Road *road = odr->GetRoadByIdx(i);
+            for (unsigned int j = 0; j < road->GetNumberOfLaneSections(); j++)
+            {
+                OSIPoints *points = road->GetLaneSectionByIdx(j)->GetLaneById(0)->GetOSIPoints();
+                for (unsigned int k = 0; k < points->GetNumOfOSIPoints(); k++)
+                {
+                    x_min = MIN(x_min, points->GetPoint(k).x);
+                    y_min = MIN(y_min, points->GetPoint(k).y);
+                    x_max = MAX(x_max, points->GetPoint(k).x);
+                    y_max = MAX(y_max, points->GetPoint(k).y);
+                }
+            }
+        }
+        std::vector<std::pair<double, double>> xy;
+        double                                 step = sqrt((x_max - x_min + 60.0) * (y_max - y_min + 60.0) / 1500.0);
+        for (double x = x_min - 30.0; x < x_max + 30.0; x += step)
+        {
+            for (double y = y_min - 30.0; y < y_max + 30.0; y += step)
+            {
+                xy.push_back({x, y});
+            }
+        }
+        ASSERT_GT(xy.size(), 1000);
+
+        // search each point with a new position, and with one position following all points in sequence, which also
+        // makes use of the last known road
+        std::vector<Position> result[2][2];
+        for (int k = 0; k < 2; k++)
+        {
+            if (k == 0)
+            {
+                // reference, iterating over all roads
+                odr->GetRoadGrid().Clear();
+            }
+            else
+            {
+                ASSERT_TRUE(Position::GetOpenDrive()->LoadOpenDriveFile(("../../../resources/xodr/" + filename).c_str()));
+                ASSERT_FALSE(Position::GetOpenDrive()->GetRoadGrid().IsEmpty());
+            }
+
+            Position reused;
+            for (auto &p : xy)
+            {
+                Position pos;
+                pos.XYZ2TrackPos(p.first, p.second, 0.0);
+                result[k][0].push_back(pos);
+                reused.XYZ2TrackPos(p.first, p.second, 0.0);
+                result[k][1].push_back(reused);
+            }
+        }
+
+        for (int j = 0; j < 2; j++)
+        {
+            for (size_t i = 0; i < xy.size(); i++)
+            {
+                const Position &ref = result[0][j][i];
+                const Position &pos = result[1][j][i];
+                ASSERT_EQ(pos.GetTrackId(), ref.GetTrackId()) << filename << " x " << xy[i].first << " y " << xy[i].second;
+                EXPECT_EQ(pos.GetLaneId(), ref.GetLaneId()) << filename << " x " << xy[i].first << " y " << xy[i].second;
+                EXPECT_NEAR(pos.GetS(), ref.GetS(), 1e-6) << filename << " x " << xy[i].first << " y " << xy[i].second;
+                EXPECT_NEAR(pos.GetT(), ref.GetT(), 1e-6) << filename << " x " << xy[i].first << " y " << xy[i].second;
+            }
+        }
+    }
+
+    Position::GetOpenDrive()->Clear();
+}
+
+TEST(RoadPathTest, TestPathCache)
+{
+    Position::GetOpenDrive()->LoadOpenDriveFile("../../../resources/xodr/fabriksgatan.xodr");
+    OpenDrive *odr = Position::GetOpenDrive();
+    ASSERT_NE(odr, nullptr);
+    EXPECT_EQ(odr->GetRoadPathCache().GetSize(), 0);
+
+    // road graph resolves connecting roads of junction links
+    Road *road0 = odr->GetRoadById(0);
+    ASSERT_NE(road0, nullptr);
+    ASSERT_NE(road0->GetLink(LinkType::PREDECESSOR), nullptr);
+    std::vector<Road *> linked_roads;
+    odr->GetLinkedRoads(road0, road0->GetLink(LinkType::PREDECESSOR), linked_roads);
+    EXPECT_GT(linked_roads.size(), 1);
+
+    // heading towards start of road 0, i.e. the junction
+    Position pos0;
+    Position pos1;
+    pos0.SetLanePos(0, -1, 20.0, 0.0);
+    pos0.SetHeadingRelative(M_PI);
+    pos1.SetLanePos(2, -1, 30.0, 0.0);
+
+    double dist0 = 0.0;
+    double dist1 = 0.0;
+    double dist2 = 0.0;
+    {
+        RoadPath path(&pos0, &pos1);
+        ASSERT_EQ(path.Calculate(dist0, false), 0);
+    }
+    EXPECT_EQ(odr->GetRoadPathCache().GetSize(), 1);
+
+    // same query reuses cached path, and from another start position along the same road
+    size_t n_nodes = 0;
+    {
+        RoadPath path(&pos0, &pos1);
+        ASSERT_EQ(path.Calculate(dist1, false), 0);
+        n_nodes = path.visited_.size();
+        EXPECT_EQ(path.firstNode_, path.visited_[0]);
+    }
+    EXPECT_NEAR(dist1, dist0, 1e-10);
+    EXPECT_GT(n_nodes, 1);
+
+    pos0.SetLanePos(0, -1, 30.0, 0.0);
+    pos0.SetHeadingRelative(M_PI);
+    {
+        RoadPath path(&pos0, &pos1);
+        ASSERT_EQ(path.Calculate(dist2, false), 0);
+    }
+    EXPECT_NEAR(fabs(dist2), fabs(dist0) + 10.0, 1e-10);
+    EXPECT_EQ(odr->GetRoadPathCache().GetSize(), 1);
+
+    // max distance shorter than path should still fail
+    {
+        RoadPath path(&pos0, &pos1);
+        EXPECT_EQ(path.Calculate(dist2, false, 1.0), -1);
+    }
+
+    // same result as when searching both directions, which is not cached
+    {
+        RoadPath path(&pos0, &pos1);
+        ASSERT_EQ(path.Calculate(dist2, true), 0);
+    }
+    EXPECT_NEAR(fabs(dist2), fabs(dist0) + 10.0, 1e-10);
+    EXPECT_EQ(odr->GetRoadPathCache().GetSize(), 1);
+
+    odr->Clear();
+    EXPECT_EQ(odr->GetRoadPathCache().GetSize(), 0);
+}
+
+TEST(RoadPathTest, TestPathCacheMatchesSearch)
+{
+    // network with several alternative paths between roads, through junctions
+    ASSERT_TRUE(Position::GetOpenDrive()->LoadOpenDriveFile("../../../resources/xodr/fabriksgatan.xodr"));
+    OpenDrive *odr = Position::GetOpenDrive();
+
+    // positions in all driving lanes outside junctions, facing both directions
+    std::vector<Position> positions;
+    for (unsigned int i = 0; i < odr->GetNumOfRoads(); i++)
+    {
+        Road *road = odr->GetRoadByIdx(i);
+        if (road->GetJunction() != ID_UNDEFINED)
+        {
+            continue;
+        }
+        LaneSection *lsec = road->GetLaneSectionByIdx(0);
+        for (unsigned int j = 0; j < lsec->GetNumberOfLanes(); j++)
+        {
+            Lane *lane = lsec->GetLaneByIdx(j);
+            if (!lane->IsDriving())
+            {
+                continue;
+            }
+            for (double s : {0.2, 0.8})
+            {
+                for (double h : {0.0, M_PI})
+                {
+                    Position pos;
+                    pos.SetLanePos(road->GetId(), lane->GetId(), s * road->GetLength(), 0.0);
+                    pos.SetHeadingRelative(h);
+                    positions.push_back(pos);
+                }
+            }
+        }
+    }
+    ASSERT_GT(positions.size(), 20);
+
+    // reference, searching every pair from scratch
+    std::vector<PositionDiff> ref(positions.size() * positions.size());
+    std::vector<bool>         ref_found(ref.size());
+    for (size_t i = 0; i < positions.size(); i++)
+    {
+        for (size_t j = 0; j < positions.size(); j++)
+        {
+            odr->GetRoadPathCache().Clear();
+            ref_found[i * positions.size() + j] = positions[i].Delta(&positions[j], ref[i * positions.size() + j], false, 500.0);
+
+            // each node of the shortest path is reached via its predecessor, also when a shorter path replaced a longer one
+            odr->GetRoadPathCache().Clear();
+            RoadPath path(&positions[i], &positions[j]);
+            double   dist = 0.0;
+            if (path.Calculate(dist, false, 500.0) == 0 && !path.visited_.empty())
+            {
+                for (RoadPath::PathNode *node = path.visited_.back(); node->previous != nullptr; node = node->previous)
+                {
+                    EXPECT_NEAR(node->dist, node->previous->dist + node->fromRoad->GetLength(), 1e-6) << "from " << i << " to " << j;
+                }
+            }
+        }
+    }
+
+    // same queries again, now reusing cached paths between different start positions
+    int n_found = 0;
+    for (size_t i = 0; i < positions.size(); i++)
+    {
+        for (size_t j = 0; j < positions.size(); j++)
+        {
+            PositionDiff diff;
+            size_t       k = i * positions.size() + j;
+            ASSERT_EQ(positions[i].Delta(&positions[j], diff, false, 500.0), ref_found[k]) << "from " << i << " to " << j;
+            if (ref_found[k])
+            {
+                EXPECT_NEAR(diff.ds, ref[k].ds, 1e-6) << "from " << i << " to " << j;
+                EXPECT_NEAR(diff.dt, ref[k].dt, 1e-6) << "from " << i << " to " << j;
+                EXPECT_EQ(diff.dLaneId, ref[k].dLaneId) << "from " << i << " to " << j;
+                n_found++;
+            }
+        }
+    }
+    EXPECT_GT(odr->GetRoadPathCache().GetSize(), 1);
+    EXPECT_GT(n_found, static_cast<int>(positions.size()));
+
+    odr->Clear();
+}
+
+TEST(OSIPointsCacheTest, TestSaveLoad)
+{
+    // first load generates points and saves them in the cache
+    SE_Env::Inst().SetOSIPointsCacheDir(".");
+    ASSERT_TRUE(Position::GetOpenDrive()->LoadOpenDriveFile("../../../resources/xodr/fabriksgatan.xodr"));
+    OpenDrive* odr = Position::GetOpenDrive();
+
+    uint64_t key = odr->GetOSIPointsCacheKey();
+    ASSERT_NE(key, 0);
+
+    char cache_file[64];
+    snprintf(cache_file, sizeof(cache_file), "fabriksgatan_%016" PRIx64 ".osip", key);
+    ASSERT_TRUE(FileExists(cache_file));
+
+    std::vector<std::vector<PointStruct>> generated;
+    std::vector<id_t>                     generated_boundary_ids;
+    for (unsigned int i = 0; i < odr->GetNumOfRoads(); i++)
+    {
+        LaneSection* lsec = odr->GetRoadByIdx(i)->GetLaneSectionByIdx(0);
+        for (unsigned int j = 0; j < lsec->GetNumberOfLanes(); j++)
+        {
+            generated.push_back(lsec->GetLaneByIdx(j)->GetOSIPoints()->GetPoints());
+            if (lsec->GetLaneByIdx(j)->GetLaneBoundary() != nullptr)
+            {
+                generated.push_back(lsec->GetLaneByIdx(j)->GetLaneBoundary()->osi_points_.GetPoints());
+                generated_boundary_ids.push_back(lsec->GetLaneByIdx(j)->GetLaneBoundary()->GetGlobalId());
+            }
+        }
+    }
+
+    // wrong key or missing file, nothing loaded
+    EXPECT_EQ(odr->LoadOSIPoints(cache_file, key + 1), -1);
+    EXPECT_EQ(odr->LoadOSIPoints("missing_file.osip", key), -1);
+
+    // second load picks points from the cache
+    ASSERT_TRUE(Position::GetOpenDrive()->LoadOpenDriveFile("../../../resources/xodr/fabriksgatan.xodr"));
+    odr = Position::GetOpenDrive();
+    EXPECT_EQ(odr->GetOSIPointsCacheKey(), key);
+
+    size_t k = 0;
+    size_t l = 0;
+    for (unsigned int i = 0; i < odr->GetNumOfRoads(); i++)
+    {
+        LaneSection* lsec = odr->GetRoadByIdx(i)->GetLaneSectionByIdx(0);
+        for (unsigned int j = 0; j < lsec->GetNumberOfLanes(); j++)
+        {
+            std::vector<PointStruct>& points = lsec->GetLaneByIdx(j)->GetOSIPoints()->GetPoints();
+            ASSERT_EQ(points.size(), generated[k].size());
+            for (size_t m = 0; m < points.size(); m++)
+            {
+                EXPECT_DOUBLE_EQ(points[m].x, generated[k][m].x);
+                EXPECT_DOUBLE_EQ(points[m].y, generated[k][m].y);
+                EXPECT_DOUBLE_EQ(points[m].h, generated[k][m].h);
+                EXPECT_EQ(points[m].endpoint, generated[k][m].endpoint);
+            }
+            k++;
+
+            if (lsec->GetLaneByIdx(j)->GetLaneBoundary() != nullptr)
+            {
+                EXPECT_EQ(lsec->GetLaneByIdx(j)->GetLaneBoundary()->osi_points_.GetPoints().size(), generated[k++].size());
+                EXPECT_EQ(lsec->GetLaneByIdx(j)->GetLaneBoundary()->GetGlobalId(), generated_boundary_ids[l++]);
+            }
+        }
+    }
+    EXPECT_EQ(k, generated.size());
+
+    SE_Env::Inst().SetOSIPointsCacheDir("");
+    std::remove(cache_file);
+}
+
+TEST(OSIPointsCacheTest, TestTruncatedFile)
+{
+    ASSERT_TRUE(Position::GetOpenDrive()->LoadOpenDriveFile("../../../resources/xodr/fabriksgatan.xodr"));
+    OpenDrive* odr = Position::GetOpenDrive();
+    uint64_t   key = odr->GetOSIPointsCacheKey();
+    ASSERT_EQ(odr->SaveOSIPoints("truncated_test.osip", key), 0);
+
+    // tag first and last point of the network, to find out whether anything is modified by a failed load
+    Road*                     last_road   = odr->GetRoadByIdx(odr->GetNumOfRoads() - 1);
+    LaneSection*              last_lsec   = last_road->GetLaneSectionByIdx(last_road->GetNumberOfLaneSections() - 1);
+    std::vector<PointStruct>& first_lane  = odr->GetRoadByIdx(0)->GetLaneSectionByIdx(0)->GetLaneByIdx(0)->GetOSIPoints()->GetPoints();
+    std::vector<PointStruct>& last_points = last_lsec->GetRefLineOSIPoints().GetPoints();
+    ASSERT_GT(first_lane.size(), 0);
+    ASSERT_GT(last_points.size(), 0);
+    first_lane[0].x += 1000.0;
+    last_points[0].x += 1000.0;
+    double first_x = first_lane[0].x;
+    double last_x  = last_points[0].x;
+
+    std::vector<char> content;
+    {
+        std::ifstream src("truncated_test.osip", std::ios::binary | std::ios::ate);
+        content.resize(static_cast<size_t>(src.tellg()));
+        src.seekg(0);
+        src.read(content.data(), static_cast<std::streamsize>(content.size()));
+    }
+    ASSERT_GT(content.size(), 100);
+
+    // cut the file at a few places, from just the header to just the end marker missing
+    for (size_t size : {content.size() / 4, content.size() / 2, content.size() - sizeof(uint64_t)})
+    {
+        {
+            std::ofstream dst("truncated_test.osip", std::ios::binary | std::ios::trunc);
+            dst.write(content.data(), static_cast<std::streamsize>(size));
+        }
+        EXPECT_EQ(odr->LoadOSIPoints("truncated_test.osip", key), -1) << "size " << size;
+        EXPECT_DOUBLE_EQ(odr->GetRoadByIdx(0)->GetLaneSectionByIdx(0)->GetLaneByIdx(0)->GetOSIPoints()->GetPoints()[0].x, first_x);
+        EXPECT_DOUBLE_EQ(last_lsec->GetRefLineOSIPoints().GetPoints()[0].x, last_x);
+    }
+
+    // complete file is loaded, replacing the tagged points
+    {
+        std::ofstream dst("truncated_test.osip", std::ios::binary | std::ios::trunc);
+        dst.write(content.data(), static_cast<std::streamsize>(content.size()));
+    }
+    EXPECT_EQ(odr->LoadOSIPoints("truncated_test.osip", key), 0);
+    EXPECT_NEAR(odr->GetRoadByIdx(0)->GetLaneSectionByIdx(0)->GetLaneByIdx(0)->GetOSIPoints()->GetPoints()[0].x, first_x - 1000.0, 1e-10);
+    EXPECT_NEAR(last_lsec->GetRefLineOSIPoints().GetPoints()[0].x, last_x - 1000.0, 1e-10);
+
+    std::remove("truncated_test.osip");
+}
+
+TEST(OSIPointsCacheTest, TestRegenerate)
+{
+    // points generated and loaded again on top of existing ones, each time replacing the lane boundaries
+    ASSERT_TRUE(Position::GetOpenDrive()->LoadOpenDriveFile("../../../resources/xodr/fabriksgatan.xodr"));
+    OpenDrive* odr = Position::GetOpenDrive();
+    uint64_t   key = odr->GetOSIPointsCacheKey();
+    ASSERT_EQ(odr->SaveOSIPoints("regenerate_test.osip", key), 0);
+
+    std::vector<Lane*>  lanes;
+    std::vector<size_t> n_points;
+    for (unsigned int i = 0; i < odr->GetNumOfRoads(); i++)
+    {
+        Road* road = odr->GetRoadByIdx(i);
+        for (unsigned int j = 0; j < road->GetNumberOfLaneSections(); j++)
+        {
+            LaneSection* lsec = road->GetLaneSectionByIdx(j);
+            for (unsigned int k = 0; k < lsec->GetNumberOfLanes(); k++)
+            {
+                if (lsec->GetLaneByIdx(k)->GetLaneBoundary() != nullptr)
+                {
+                    lanes.push_back(lsec->GetLaneByIdx(k));
+                    n_points.push_back(lsec->GetLaneByIdx(k)->GetLaneBoundary()->osi_points_.GetPoints().size());
+                }
+            }
+        }
+    }
+    ASSERT_GT(lanes.size(), 0);
+
+    for (int i = 0; i < 4; i++)
+    {
+        if (i % 2 == 0)
+        {
+            odr->GenerateOSIPoints();
+        }
+        else
+        {
+            ASSERT_EQ(odr->LoadOSIPoints("regenerate_test.osip", key), 0);
+        }
+
+        std::set<id_t> ids;
+        for (size_t j = 0; j < lanes.size(); j++)
+        {
+            LaneBoundaryOSI* lane_boundary = lanes[j]->GetLaneBoundary();
+            ASSERT_NE(lane_boundary, nullptr);
+            EXPECT_EQ(lane_boundary->osi_points_.GetPoints().size(), n_points[j]) << "iteration " << i;
+            EXPECT_EQ(lanes[j]->GetLaneBoundaryGlobalId(), lane_boundary->GetGlobalId());
+            ids.insert(lane_boundary->GetGlobalId());
+        }
+        EXPECT_EQ(ids.size(), lanes.size()) << "iteration " << i;
+    }
+
+    // setting the current boundary again keeps it
+    LaneBoundaryOSI* lane_boundary = lanes[0]->GetLaneBoundary();
+    lanes[0]->SetLaneBoundary(lane_boundary);
+    EXPECT_EQ(lanes[0]->GetLaneBoundary(), lane_boundary);
+    EXPECT_EQ(lanes[0]->GetLaneBoundary()->osi_points_.GetPoints().size(), n_points[0]);
+
+    std::remove("regenerate_test.osip");
+}
+
+TEST(OSIPointsCacheTest, TestPrecompiledFile)
+{
+    // work on a copy of the road network, since the precompiled file is stored next to it
+    {
+        std::ifstream src("../../../resources/xodr/fabriksgatan.xodr", std::ios::binary);
+        std::ofstream dst("odrbin_test.xodr", std::ios::binary);
+        dst << src.rdbuf();
+    }
+    ASSERT_EQ(OpenDrive::GetPrecompiledFilename("odrbin_test.xodr"), "odrbin_test.odrbin");
+
+    ASSERT_TRUE(Position::GetOpenDrive()->LoadOpenDriveFile("odrbin_test.xodr"));
+    OpenDrive* odr = Position::GetOpenDrive();
+
+    // tag a point, to find out whether points are loaded or generated
+    std::vector<PointStruct>& points = odr->GetRoadByIdx(0)->GetLaneSectionByIdx(0)->GetLaneByIdx(0)->GetOSIPoints()->GetPoints();
+    ASSERT_GT(points.size(), 0);
+    double x = points[0].x;
+    points[0].x += 1000.0;
+    ASSERT_EQ(odr->SaveOSIPoints("odrbin_test.odrbin", odr->GetOSIPointsCacheKey()), 0);
+
+    ASSERT_TRUE(Position::GetOpenDrive()->LoadOpenDriveFile("odrbin_test.xodr"));
+    odr = Position::GetOpenDrive();
+    EXPECT_NEAR(odr->GetRoadByIdx(0)->GetLaneSectionByIdx(0)->GetLaneByIdx(0)->GetOSIPoints()->GetPoints()[0].x, x + 1000.0, 1e-10);
+
+    // modified road network, precompiled file ignored
+    {
+        std::ofstream dst("odrbin_test.xodr", std::ios::binary | std::ios::app);
+        dst << "\n";
+    }
+    ASSERT_TRUE(Position::GetOpenDrive()->LoadOpenDriveFile("odrbin_test.xodr"));
+    odr = Position::GetOpenDrive();
+    EXPECT_NEAR(odr->GetRoadByIdx(0)->GetLaneSectionByIdx(0)->GetLaneByIdx(0)->GetOSIPoints()->GetPoints()[0].x, x, 1e-10);
+
+    std::remove("odrbin_test.xodr");
+    std::remove("odrbin_test.odrbin");
+}
+
 int main(int argc, char **argv)
 {
     // testing::GTEST_FLAG(filter) = "*RoadWidthAllLanes*";
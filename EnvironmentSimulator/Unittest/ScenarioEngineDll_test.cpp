@@ -14,6 +14,7 @@
 #include <vector>
 #include <stdexcept>
 #include <fstream>
+#include <thread>
 
 #define _USE_MATH_DEFINES
 #include <math.h>
@@ -1353,6 +1354,41 @@ TEST(GroundTruthTests, check_update_osi_ground_truth_no_osi_file)
     SE_Close();
 }
 
+TEST(GroundTruthTests, check_incremental_serialization)
+{
+    std::vector<std::string> frames[2];
+
+    // run same scenario with regular and incremental serialization
+    for (int k = 0; k < 2; k++)
+    {
+        if (k == 1)
+        {
+            SE_SetOption("osi_incremental");
+        }
+        SE_EnableOSIFile("gt_incremental.osi");
+        ASSERT_EQ(SE_Init("../../../resources/xosc/cut-in_simple.xosc", 0, 0, 0, 0), 0);
+
+        for (int i = 0; i < 20; i++)
+        {
+            // request static content now and then
+            SE_UpdateOSIGroundTruth(i % 5 == 0);
+
+            int         size = 0;
+            const char* gt   = SE_GetOSIGroundTruth(&size);
+            frames[k].push_back(std::string(gt, static_cast<size_t>(size)));
+            SE_StepDT(0.01f);
+        }
+        SE_Close();
+    }
+
+    ASSERT_EQ(frames[0].size(), frames[1].size());
+    for (size_t i = 0; i < frames[0].size(); i++)
+    {
+        EXPECT_EQ(frames[1][i], frames[0][i]);
+    }
+    EXPECT_GT(frames[1][0].size(), frames[1][1].size());  // static content included in first frame only
+}
+
 TEST(GetMiscObjFromGroundTruth, receive_miscobj)
 {
     int               sv_size = 0;
@@ -2467,26 +2503,18 @@ TEST(OSILaneParing, Signs)
 
 static void ReadDat(std::string filename, std::vector<scenarioengine::ReplayEntry>& entries)
 {
-    std::ifstream             file;
-    scenarioengine::DatHeader header;
+    scenarioengine::DatReader reader;
 
-    file.open(filename, std::ofstream::binary);
-    ASSERT_EQ(file.fail(), false);
-
-    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    ASSERT_EQ(reader.Open(filename), 0);
 
     scenarioengine::ReplayEntry entry;
+    entry.odometer = 0.0;
 
-    while (!file.eof())
+    while (reader.ReadNext(entry.state) == 0)
     {
-        file.read(reinterpret_cast<char*>(&entry.state), sizeof(entry.state));
-
-        if (!file.eof())
-        {
-            entries.push_back(entry);
-        }
+        entries.push_back(entry);
     }
-    file.close();
+    reader.Close();
 }
 
 TEST(ExternalControlTest, TestTimings)
@@ -4219,6 +4247,67 @@ TEST(ReplayTest, TestMultiReplayDifferentTimeSteps)
     }
 }
 
+TEST(ReplayTest, TestStreamingReplay)
+{
+    // three objects for a while, enough for several chunks
+    scenarioengine::DatWriter writer;
+    ASSERT_EQ(writer.Open("stream_test.dat", "odr_file", "model_file"), 0);
+    for (int i = 0; i < 20000; i++)
+    {
+        for (int j = 0; j < 3; j++)
+        {
+            scenarioengine::ObjectStateStructDat state;
+            memset(&state, 0, sizeof(state));
+            state.info.id        = j;
+            state.info.timeStamp = static_cast<float>(i) * 0.01f;
+            state.pos.x          = static_cast<float>(i) * 0.1f * static_cast<float>(j + 1);
+            state.pos.y          = static_cast<float>(j) * 3.5f + static_cast<float>(sin(0.01 * i));
+            StrCopy(state.info.name, "obj", NAME_LEN);
+            writer.Write(state);
+        }
+        writer.EndFrame();
+    }
+    writer.Close();
+
+    scenarioengine::Replay replay("stream_test.dat", true);
+    scenarioengine::Replay stream("stream_test.dat", true, scenarioengine::Replay::LoadMode::STREAMING);
+    EXPECT_FALSE(replay.IsStreaming());
+    ASSERT_TRUE(stream.IsStreaming());
+    ASSERT_EQ(stream.GetNumberOfEntries(), 60000);
+    ASSERT_EQ(stream.GetNumberOfEntries(), replay.GetNumberOfEntries());
+    EXPECT_DOUBLE_EQ(stream.GetStopTime(), replay.GetStopTime());
+
+    // entries and odometers are the same, accessed in any order
+    for (unsigned int i = 0; i < replay.GetNumberOfEntries(); i += 7)
+    {
+        unsigned int idx = i % 2 == 0 ? i : replay.GetNumberOfEntries() - 1 - i;
+        ASSERT_EQ(memcmp(&stream.GetEntryByIdx(idx)->state, &replay.GetEntryByIdx(idx)->state, sizeof(scenarioengine::ObjectStateStructDat)), 0);
+        ASSERT_DOUBLE_EQ(stream.GetEntryByIdx(idx)->odometer, replay.GetEntryByIdx(idx)->odometer);
+    }
+    EXPECT_GT(stream.GetEntryByIdx(stream.GetNumberOfEntries() - 1)->odometer, 5999.0);
+
+    // seeking lands on same frame
+    const double times[] = {50.0, 3.333, 199.99, 120.005, 0.0, 75.5};
+    for (double t : times)
+    {
+        replay.GoToTime(t);
+        stream.GoToTime(t);
+        EXPECT_EQ(stream.GetIndex(), replay.GetIndex());
+        ASSERT_NE(stream.GetState(1), nullptr);
+        EXPECT_EQ(stream.GetState(1)->pos.x, replay.GetState(1)->pos.x);
+    }
+
+    for (int i = 0; i < 10; i++)
+    {
+        replay.GoToPreviousFrame();
+        stream.GoToPreviousFrame();
+    }
+    EXPECT_EQ(stream.GetIndex(), replay.GetIndex());
+    EXPECT_EQ(stream.GoToNextFrame(), replay.GoToNextFrame());
+
+    std::remove("stream_test.dat");
+}
+
 void ConditionCallbackInstance1(const char* element_name, double timestamp)
 {
     EXPECT_STREQ(element_name, "act_start_condition");
@@ -4618,6 +4707,64 @@ TEST(GetFunctionsTest, TestGetAccelerations)
     SE_Close();
 }
 
+TEST(GetFunctionsTest, TestGetObjectStates)
+{
+    std::string scenario_file = "../../../EnvironmentSimulator/Unittest/xosc/add_delete_entity.xosc";
+
+    ASSERT_EQ(SE_Init(scenario_file.c_str(), 0, 0, 0, 0), 0);
+
+    SE_ScenarioObjectState states[4];
+    SE_ScenarioObjectState state;
+    int                    id[4];
+    float                  x[4];
+    float                  speed[4];
+    int                    max_n = 0;
+
+    // entities are added and deleted during the scenario, check that bulk and individual states agree all the way
+    for (int i = 0; i < 800; i++)
+    {
+        int n   = SE_GetNumberOfObjects();
+        int n_a = 4;
+        int n_b = 4;
+        max_n   = MAX(max_n, n);
+        ASSERT_EQ(SE_GetObjectStates(&n_a, states), 0);
+        ASSERT_EQ(SE_GetObjectStatesSoA(&n_b, id, x, nullptr, nullptr, nullptr, nullptr, nullptr, speed), 0);
+        ASSERT_EQ(n_a, n);
+        ASSERT_EQ(n_b, n);
+        for (int j = 0; j < n; j++)
+        {
+            ASSERT_EQ(SE_GetObjectState(SE_GetId(j), &state), 0);
+            EXPECT_EQ(states[j].id, state.id);
+            EXPECT_EQ(states[j].x, state.x);
+            EXPECT_EQ(states[j].y, state.y);
+            EXPECT_EQ(states[j].h, state.h);
+            EXPECT_EQ(states[j].s, state.s);
+            EXPECT_EQ(states[j].laneId, state.laneId);
+            EXPECT_EQ(states[j].speed, state.speed);
+            EXPECT_EQ(id[j], state.id);
+            EXPECT_EQ(x[j], state.x);
+            EXPECT_EQ(speed[j], state.speed);
+        }
+        SE_StepDT(0.01f);
+    }
+    EXPECT_EQ(max_n, 2);
+
+    // capacity limits number of states
+    int n = 1;
+    EXPECT_EQ(SE_GetObjectStates(&n, states), 0);
+    EXPECT_EQ(n, 1);
+
+    // missing output arguments
+    EXPECT_EQ(SE_GetObjectStates(&n, nullptr), -1);
+    EXPECT_EQ(SE_GetObjectStates(nullptr, states), -1);
+    EXPECT_EQ(SE_GetObjectStatesSoA(nullptr, id, x, nullptr, nullptr, nullptr, nullptr, nullptr, speed), -1);
+    EXPECT_EQ(n, 1);
+
+    SE_Close();
+
+    EXPECT_EQ(SE_GetObjectStates(&n, states), -1);
+}
+
 TEST(StringIds, TestRoadStringIds)
 {
     std::string scenario_file = "../../../EnvironmentSimulator/Unittest/xosc/test_string_ids.xosc";
@@ -4855,6 +5002,183 @@ TEST(RoutingTest, TestRoutePointsWithGhost)
     SE_Close();
 }
 
+TEST(APITest, TestProfiling)
+{
+    SE_EnableProfiling(true);
+    ASSERT_EQ(SE_Init("../../../resources/xosc/acc-test.xosc", 0, 0, 0, 0), 0);
+    for (int i = 0; i < 10; i++)
+    {
+        SE_StepDT(0.05f);
+    }
+    SE_Close();
+    SE_EnableProfiling(false);
+
+    std::map<std::string, SE_ProfilePhase> phases;
+    for (int i = 0; i < SE_GetNumberOfProfilePhases(); i++)
+    {
+        SE_ProfilePhase phase;
+        ASSERT_EQ(SE_GetProfilePhase(i, &phase), 0);
+        phases[phase.name] = phase;
+    }
+    EXPECT_EQ(SE_GetProfilePhase(SE_GetNumberOfProfilePhases(), nullptr), -1);
+
+    ASSERT_EQ(phases.count("frame"), 1);
+    ASSERT_EQ(phases.count("storyboard"), 1);
+    ASSERT_EQ(phases.count("controller ACCController"), 1);
+    EXPECT_EQ(phases["frame"].count, 11);  // including initial frame of SE_Init
+    EXPECT_EQ(phases["storyboard"].count, 11);
+    EXPECT_GT(phases["frame"].total, phases["storyboard"].total);
+    EXPECT_LE(phases["frame"].min, phases["frame"].max);
+
+    int n = 0;
+    for (int i = 0; i < SE_PROFILE_NUM_BUCKETS; i++)
+    {
+        n += phases["frame"].histogram[i];
+    }
+    EXPECT_EQ(n, 11);
+}
+
+static std::vector<SE_ScenarioObjectState> StepAndGetStates(int n_steps, float dt)
+{
+    std::vector<SE_ScenarioObjectState> states;
+    for (int i = 0; i < n_steps; i++)
+    {
+        SE_StepDT(dt);
+        for (int j = 0; j < SE_GetNumberOfObjects(); j++)
+        {
+            states.push_back(SE_ScenarioObjectState());
+            SE_GetObjectState(SE_GetId(j), &states.back());
+        }
+    }
+    return states;
+}
+
+TEST(APITest, TestSaveRestoreState)
+{
+    const char* scenarios[] = {"../../../resources/xosc/cut-in.xosc", "../../../resources/xosc/acc-test.xosc"};
+    const float dt          = 0.05f;
+
+    for (int i = 0; i < 2; i++)
+    {
+        ASSERT_EQ(SE_Init(scenarios[i], 0, 0, 0, 0), 0);
+        for (int j = 0; j < 40; j++)
+        {
+            SE_StepDT(dt);
+        }
+
+        void* state = SE_SaveState();
+        ASSERT_NE(state, nullptr);
+        std::vector<SE_ScenarioObjectState> ref = StepAndGetStates(200, dt);
+
+        // continue from the saved state twice, expecting identical result each time
+        for (int k = 0; k < 2; k++)
+        {
+            ASSERT_EQ(SE_RestoreState(state), 0);
+            EXPECT_NEAR(SE_GetSimulationTime(), 40 * dt, 1e-3);
+            std::vector<SE_ScenarioObjectState> states = StepAndGetStates(200, dt);
+            ASSERT_EQ(states.size(), ref.size());
+            for (size_t j = 0; j < ref.size(); j++)
+            {
+                EXPECT_EQ(states[j].x, ref[j].x);
+                EXPECT_EQ(states[j].y, ref[j].y);
+                EXPECT_EQ(states[j].h, ref[j].h);
+                EXPECT_EQ(states[j].speed, ref[j].speed);
+                EXPECT_EQ(states[j].laneId, ref[j].laneId);
+            }
+        }
+
+        SE_DeleteState(state);
+        SE_Close();
+    }
+
+    EXPECT_EQ(SE_SaveState(), nullptr);
+    EXPECT_EQ(SE_RestoreState(nullptr), -1);
+}
+
+TEST(InstanceTest, TestParallelInstances)
+{
+    const char* scenarios[] = {"../../../resources/xosc/cut-in.xosc", "../../../resources/xosc/ltap-od.xosc"};
+    const int   n_steps     = 300;
+    const float dt          = 0.05f;
+
+    // reference, run each scenario in the default instance
+    std::vector<SE_ScenarioObjectState> ref_states;
+    std::vector<std::string>            ref_odr_files;
+    for (int i = 0; i < 2; i++)
+    {
+        ASSERT_EQ(SE_Init(scenarios[i], 0, 0, 0, 0), 0);
+        for (int j = 0; j < n_steps; j++)
+        {
+            SE_StepDT(dt);
+        }
+        ref_states.push_back(SE_ScenarioObjectState());
+        ASSERT_EQ(SE_GetObjectState(SE_GetId(0), &ref_states.back()), 0);
+        ref_odr_files.push_back(SE_GetODRFilename());
+        SE_Close();
+    }
+
+    // run four instances, two of each scenario, in parallel
+    void*                               handles[4];
+    std::vector<SE_ScenarioObjectState> states(4);
+    std::vector<std::string>            odr_files(4);
+    std::vector<std::thread>            threads;
+    for (int i = 0; i < 4; i++)
+    {
+        handles[i] = SE_CreateInstance();
+        ASSERT_NE(handles[i], nullptr);
+        ASSERT_EQ(SE_InitInstance(handles[i], scenarios[i % 2], 0, 0), 0);
+    }
+
+    for (int i = 0; i < 4; i++)
+    {
+        threads.emplace_back(
+            [&, i]()
+            {
+                for (int j = 0; j < n_steps; j++)
+                {
+                    SE_StepInstance(handles[i], dt);
+                }
+                SE_GetObjectStateInstance(handles[i], 0, &states[static_cast<unsigned int>(i)]);
+
+                // returned strings are stored per instance, not shared between threads
+                SE_SelectInstance(handles[i]);
+                std::string& odr_file = odr_files[static_cast<unsigned int>(i)];
+                odr_file              = SE_GetODRFilename();
+                for (int j = 0; j < 1000; j++)
+                {
+                    if (odr_file != SE_GetODRFilename())
+                    {
+                        odr_file = "changed by other instance";
+                        break;
+                    }
+                }
+                SE_SelectInstance(nullptr);
+            });
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    for (int i = 0; i < 4; i++)
+    {
+        const SE_ScenarioObjectState& ref = ref_states[static_cast<unsigned int>(i % 2)];
+        EXPECT_NEAR(SE_GetSimulationTimeInstance(handles[i]), n_steps * static_cast<double>(dt), 1e-3);
+        EXPECT_EQ(states[static_cast<unsigned int>(i)].x, ref.x);
+        EXPECT_EQ(states[static_cast<unsigned int>(i)].y, ref.y);
+        EXPECT_EQ(states[static_cast<unsigned int>(i)].h, ref.h);
+        EXPECT_EQ(states[static_cast<unsigned int>(i)].speed, ref.speed);
+        EXPECT_EQ(odr_files[static_cast<unsigned int>(i)], ref_odr_files[static_cast<unsigned int>(i % 2)]);
+        SE_DestroyInstance(handles[i]);
+    }
+
+    // default instance still functional
+    ASSERT_EQ(SE_Init(scenarios[0], 0, 0, 0, 0), 0);
+    EXPECT_EQ(SE_GetNumberOfObjects(), 2);
+    SE_Close();
+}
+
 int main(int argc, char** argv)
 {
     testing::InitGoogleTest(&argc, argv);
@@ -4,6 +4,7 @@
 #include <vector>
 #include <stdexcept>
 #include <array>
+#include <fstream>
 
 #include "CommonMini.hpp"
 #include "ScenarioEngine.hpp"
@@ -15,6 +16,11 @@
 #include "OSCParameterDistribution.hpp"
 #include "pugixml.hpp"
 #include "simple_expr.h"
+#include "OSIWriter.hpp"
+#ifdef _USE_OSI
+#include "OSIReporter.hpp"
+#include <google/protobuf/util/message_differencer.h>
+#endif  // _USE_OSI
 
 using namespace roadmanager;
 using namespace scenarioengine;
@@ -979,7 +985,7 @@ TEST(OptionsTest, TestOptionHandling)
 
 TEST(ParameterTest, ResolveParameterTest)
 {
-    Parameters& params = ScenarioReader::parameters;
+    Parameters params;
 
     params.parameterDeclarations_.Parameter.push_back({"speed", OSCParameterDeclarations::ParameterType::PARAM_TYPE_DOUBLE, {0, 5.0, "5.0", false}});
     params.parameterDeclarations_.Parameter.push_back({"acc", OSCParameterDeclarations::ParameterType::PARAM_TYPE_DOUBLE, {0, 3.0, "3.0", false}});
@@ -994,6 +1000,123 @@ TEST(ParameterTest, ResolveParameterTest)
     ASSERT_EQ(params.ResolveParametersInString(" $turnsignal "), " true ");
 }
 
+TEST(ParameterTest, ScopedDeclarationsAndSlots)
+{
+    Parameters         params;
+    pugi::xml_document doc;
+
+    ASSERT_TRUE(doc.load_string(
+        "<ParameterDeclarations>"
+        "<ParameterDeclaration name=\"speed\" parameterType=\"double\" value=\"5.0\"/>"
+        "<ParameterDeclaration name=\"lane\" parameterType=\"integer\" value=\"-1\"/>"
+        "</ParameterDeclarations>"));
+    params.parseGlobalParameterDeclarations(doc.first_child());
+
+    ASSERT_EQ(params.GetNumberOfParameters(), 2);
+    EXPECT_EQ(params.getParameter("$speed"), "5.0");
+    EXPECT_EQ(params.getParameter("lane"), "-1");
+    EXPECT_EQ(params.getParameterEntry("missing"), nullptr);
+
+    Parameters::ParameterSlot                  slot;
+    OSCParameterDeclarations::ParameterStruct* entry = params.getParameterEntry("speed", slot);
+    ASSERT_NE(entry, nullptr);
+    EXPECT_EQ(params.getParameterEntry("speed", slot), entry);
+
+    // local declaration shadows the global one until restored
+    ASSERT_TRUE(doc.load_string(
+        "<ParameterDeclarations>"
+        "<ParameterDeclaration name=\"speed\" parameterType=\"double\" value=\"10.0\"/>"
+        "</ParameterDeclarations>"));
+    params.CreateRestorePoint();
+    params.parseParameterDeclarations(doc.first_child(), &params.parameterDeclarations_);
+    EXPECT_EQ(params.GetNumberOfParameters(), 3);
+    EXPECT_EQ(params.getParameter("$speed"), "10.0");
+    EXPECT_NEAR(params.getParameterEntry("speed", slot)->value._double, 10.0, 1e-10);
+
+    params.RestoreParameterDeclarations();
+    EXPECT_EQ(params.GetNumberOfParameters(), 2);
+    EXPECT_NEAR(params.getParameterEntry("speed", slot)->value._double, 5.0, 1e-10);
+    EXPECT_EQ(params.setParameterValue("speed", 7.0), 0);
+    EXPECT_NEAR(params.getParameterEntry("speed", slot)->value._double, 7.0, 1e-10);
+
+    // declarations modified directly in the list are found as well
+    params.parameterDeclarations_.Parameter.push_back({"acc", OSCParameterDeclarations::ParameterType::PARAM_TYPE_DOUBLE, {0, 3.0, "3.0", false}});
+    EXPECT_EQ(params.getParameter("$acc"), "3.0");
+    EXPECT_NEAR(params.getParameterEntry("speed", slot)->value._double, 7.0, 1e-10);
+    params.parameterDeclarations_.Parameter.erase(params.parameterDeclarations_.Parameter.begin() + 1);  // most recent declaration first
+    EXPECT_EQ(params.getParameterEntry("speed", slot), nullptr);
+    EXPECT_EQ(params.getParameter("lane"), "-1");
+
+    params.Clear();
+    EXPECT_EQ(params.getParameterEntry("lane"), nullptr);
+}
+
+class CountingSimulationTimeCondition : public TrigBySimulationTime
+{
+public:
+    int n_checks = 0;
+
+    bool CheckCondition(double sim_time) override
+    {
+        n_checks++;
+        return TrigBySimulationTime::CheckCondition(sim_time);
+    }
+};
+
+class CountingParameterCondition : public TrigByParameter
+{
+public:
+    int n_checks = 0;
+
+    bool CheckCondition(double sim_time) override
+    {
+        n_checks++;
+        return TrigByParameter::CheckCondition(sim_time);
+    }
+};
+
+TEST(ConditionTest, SkipUnchangedInputs)
+{
+    CountingSimulationTimeCondition time_cond;
+    time_cond.value_ = 5.0;
+    time_cond.rule_  = Rule::GREATER_THAN;
+    time_cond.edge_  = OSCCondition::ConditionEdge::RISING;
+
+    int n_true = 0;
+    for (int i = 0; i <= 200; i++)
+    {
+        n_true += time_cond.Evaluate(i * 0.05) ? 1 : 0;
+    }
+    EXPECT_EQ(n_true, 1);              // rising edge at 5.05 s
+    EXPECT_LT(time_cond.n_checks, 5);  // checked only first time and around threshold
+    EXPECT_NEAR(time_cond.sim_time_, 10.0, 1e-10);
+
+    Parameters params;
+    params.parameterDeclarations_.Parameter.push_back({"counter", OSCParameterDeclarations::ParameterType::PARAM_TYPE_INTEGER, {0, 0.0, "0", false}});
+
+    CountingParameterCondition param_cond;
+    param_cond.name_       = "counter";
+    param_cond.value_      = "3";
+    param_cond.rule_       = Rule::EQUAL_TO;
+    param_cond.parameters_ = &params;
+    param_cond.edge_       = OSCCondition::ConditionEdge::NONE;
+
+    for (int i = 0; i < 10; i++)
+    {
+        EXPECT_FALSE(param_cond.Evaluate(i * 0.05));
+    }
+    EXPECT_EQ(param_cond.n_checks, 1);
+
+    params.setParameterValue("counter", 3);
+    EXPECT_TRUE(param_cond.Evaluate(0.5));
+    EXPECT_TRUE(param_cond.Evaluate(0.55));
+    EXPECT_EQ(param_cond.n_checks, 2);
+
+    params.setParameterValue("counter", 4);
+    EXPECT_FALSE(param_cond.Evaluate(0.6));
+    EXPECT_EQ(param_cond.n_checks, 3);
+}
+
 TEST(ParameterTest, ParseParameterTest)
 {
     // Create parameter declarations
@@ -1010,7 +1133,7 @@ TEST(ParameterTest, ParseParameterTest)
     paramDeclNode1.append_attribute("parameterType") = "boolean";
     paramDeclNode1.append_attribute("value")         = "true";
 
-    Parameters& params = ScenarioReader::parameters;
+    Parameters params;
     params.addParameterDeclarations(paramDeclsNode);
 
     // Create an XML element with attributes referring to parameters
@@ -1187,6 +1310,10 @@ TEST(ConditionTest, CollisionTest)
     EXPECT_EQ(se->entities_.object_[1]->collisions_[0], se->entities_.object_[0]);
     EXPECT_EQ(se->entities_.object_[2]->collisions_.size(), 1);
     EXPECT_EQ(se->entities_.object_[2]->collisions_[0], se->entities_.object_[0]);
+    EXPECT_EQ(se->entities_.collision_keys_.size(), 2);
+    EXPECT_EQ(se->entities_.IsColliding(se->entities_.object_[1], se->entities_.object_[0]), true);
+    EXPECT_EQ(se->entities_.IsColliding(se->entities_.object_[0], se->entities_.object_[2]), true);
+    EXPECT_EQ(se->entities_.IsColliding(se->entities_.object_[1], se->entities_.object_[2]), false);
 
     while (se->getSimulationTime() < timestamps[4] - SMALL_NUMBER && se->GetQuitFlag() != true)
     {
@@ -1211,10 +1338,32 @@ TEST(ConditionTest, CollisionTest)
     EXPECT_EQ(se->entities_.object_[0]->collisions_.size(), 0);
     EXPECT_EQ(se->entities_.object_[1]->collisions_.size(), 0);
     EXPECT_EQ(se->entities_.object_[2]->collisions_.size(), 0);
+    EXPECT_EQ(se->entities_.collision_keys_.size(), 0);
 
     delete se;
 }
 
+TEST(ConditionTest, CollisionAtInitTest)
+{
+    SE_Env::Inst().SetCollisionDetection(true);
+
+    // Ego and Target overlap from start, condition on specific entity to trigger already in first frame
+    ScenarioEngine* se = new ScenarioEngine("../../../EnvironmentSimulator/Unittest/xosc/collision_at_init.xosc");
+    ASSERT_NE(se, nullptr);
+    ASSERT_EQ(se->entities_.object_.size(), 2);
+    StoryBoardElement* event = se->storyBoard.FindChildByTypeAndName(StoryBoardElement::ElementType::EVENT, "CollisionEvent")[0];
+    ASSERT_NE(event, nullptr);
+    EXPECT_EQ(se->entities_.object_[0]->Collision(se->entities_.object_[1]), true);
+
+    se->step(0.0);
+    se->prepareGroundTruth(0.0);
+    EXPECT_NE(event->GetCurrentState(), StoryBoardElement::State::STANDBY);
+    EXPECT_NEAR(se->entities_.object_[0]->GetSpeed(), 10.0, 1e-5);
+
+    delete se;
+    SE_Env::Inst().SetCollisionDetection(false);
+}
+
 TEST(ControllerTest, UDPDriverModelTestAsynchronous)
 {
     double dt = 0.01;
@@ -2189,7 +2338,7 @@ static void alksRefDriverParamDeclCallback(void* arg)
 {
     bool aeb_available = *(static_cast<bool*>(arg));
 
-    ScenarioReader::parameters.setParameterValue("AEBAvailableInEgo", aeb_available);
+    GetParameterDeclarationCallbackEngine()->GetScenarioReader()->parameters.setParameterValue("AEBAvailableInEgo", aeb_available);
 }
 
 TEST(ControllerTest, ALKS_R157_TestR157RefDriverBrakeRate)
@@ -2608,7 +2757,7 @@ static void clearanceFreeSpaceParamDeclCallback(void*)
 
     if (counter < 2)
     {
-        ScenarioReader::parameters.setParameterValue("FreeSpace", value[counter]);
+        GetParameterDeclarationCallbackEngine()->GetScenarioReader()->parameters.setParameterValue("FreeSpace", value[counter]);
     }
 
     counter++;
@@ -2696,7 +2845,7 @@ static void clearanceParamDeclCallback(void*)
 
     if (counter < 2)
     {
-        ScenarioReader::parameters.setParameterValue("OppositeLanes", value[counter]);
+        GetParameterDeclarationCallbackEngine()->GetScenarioReader()->parameters.setParameterValue("OppositeLanes", value[counter]);
     }
 
     counter++;
@@ -2977,7 +3126,7 @@ static void TTCAndLateralDistParamDeclCallback(void*)
 
     if (counter < 2)
     {
-        ScenarioReader::parameters.setParameterValue("LateralDist", value[counter]);
+        GetParameterDeclarationCallbackEngine()->GetScenarioReader()->parameters.setParameterValue("LateralDist", value[counter]);
     }
 
     counter++;
@@ -4753,6 +4902,70 @@ TEST(PositioningTest, TestElevationMapping)
     delete se;
 }
 
+TEST(DatFileTest, TestEncodeDecode)
+{
+    std::vector<ObjectStateStructDat> states;
+
+    // two objects moving for a while, one changing properties on the way
+    for (int i = 0; i < 20000; i++)
+    {
+        for (int j = 0; j < 2; j++)
+        {
+            ObjectStateStructDat state;
+            memset(&state, 0, sizeof(state));
+            state.info.id             = j;
+            state.info.timeStamp      = static_cast<float>(i) * 0.01f;
+            state.info.speed          = 10.0f + static_cast<float>(j);
+            state.info.visibilityMask = i < 12500 ? 7 : 1;
+            state.pos.x               = static_cast<float>(i) * 0.1f;
+            state.pos.y               = static_cast<float>(j) * 3.5f - 0.1f * static_cast<float>(i);
+            state.pos.h               = static_cast<float>(fmod(0.001 * i, 2 * M_PI));
+            state.pos.roadId          = i < 1000 ? 1 : 2;
+            state.pos.laneId          = -1 - j;
+            StrCopy(state.info.name, j == 0 ? "Ego" : "Target", NAME_LEN);
+            states.push_back(state);
+        }
+    }
+
+    DatWriter writer;
+    ASSERT_EQ(writer.Open("dat_test.dat", "odr_file", "model_file"), 0);
+    for (size_t i = 0; i < states.size(); i++)
+    {
+        writer.Write(states[i]);
+        if (i % 2 == 1)
+        {
+            writer.EndFrame();
+        }
+    }
+    writer.Close();
+
+    DatReader reader;
+    ASSERT_EQ(reader.Open("dat_test.dat"), 0);
+    EXPECT_EQ(reader.header_.version, DAT_FILE_FORMAT_VERSION);
+    EXPECT_STREQ(reader.header_.odr_filename, "odr_file");
+    ASSERT_GT(reader.GetIndex().size(), 1);
+    EXPECT_NEAR(static_cast<double>(reader.GetIndex()[0].t_start), 0.0, 1e-5);
+    EXPECT_NEAR(static_cast<double>(reader.GetIndex().back().t_end), 199.99, 1e-3);
+
+    // values are restored exactly
+    ObjectStateStructDat state;
+    size_t               n = 0;
+    for (; reader.ReadNext(state) == 0; n++)
+    {
+        ASSERT_LT(n, states.size());
+        ASSERT_EQ(memcmp(&state, &states[n], sizeof(state)), 0);
+    }
+    EXPECT_EQ(n, states.size());
+    reader.Close();
+
+    // compressed to less than a fifth of the raw format
+    std::ifstream file("dat_test.dat", std::ifstream::binary | std::ifstream::ate);
+    EXPECT_LT(static_cast<size_t>(file.tellg()), states.size() * sizeof(ObjectStateStructDat) / 5);
+    file.close();
+
+    std::remove("dat_test.dat");
+}
+
 TEST(StringIds, TestRoadStringIdsEdgeCases)
 {
     pugi::xml_document  doc;
@@ -4864,6 +5077,341 @@ TEST(StringIds, TestRoadStringIdsEdgeCases)
     EXPECT_EQ(ids[2].first, 3);
 }
 
+TEST(EntitiesTest, TestObjectLookup)
+{
+    Entities entities;
+
+    Vehicle* v0 = new Vehicle();
+    Vehicle* v1 = new Vehicle();
+    Vehicle* v2 = new Vehicle();
+    v0->name_   = "v0";
+    v1->name_   = "v1";
+
+    EXPECT_EQ(entities.addObject(v0, true), 0);
+    EXPECT_EQ(entities.addObject(v1, false), 1);
+    EXPECT_EQ(entities.addObject(v2, true), 2);
+    v2->name_ = "v2";  // named after being added, like objects created via esminiLib
+
+    EXPECT_EQ(entities.GetObjectById(0), v0);
+    EXPECT_EQ(entities.GetObjectById(1), v1);
+    EXPECT_EQ(entities.GetObjectByName("v0"), v0);
+    EXPECT_EQ(entities.GetObjectByName("v1"), v1);
+    EXPECT_EQ(entities.GetObjectByName("v2"), v2);
+
+    // activation moves objects between lists, lookup not affected
+    EXPECT_EQ(entities.activateObject(v1), 0);
+    EXPECT_EQ(entities.deactivateObject(v0), 0);
+    EXPECT_EQ(entities.GetObjectById(0), v0);
+    EXPECT_EQ(entities.GetObjectByName("v1"), v1);
+
+    // renamed object found by new name only
+    v1->name_ = "v1_renamed";
+    EXPECT_EQ(entities.GetObjectByName("v1"), nullptr);
+    EXPECT_EQ(entities.GetObjectByName("v1_renamed"), v1);
+
+    entities.removeObject(1);
+    EXPECT_EQ(entities.GetObjectById(1), nullptr);
+    EXPECT_EQ(entities.GetObjectByName("v1_renamed"), nullptr);
+
+    // inactive objects are not removed by id
+    entities.removeObject(0);
+    EXPECT_EQ(entities.GetObjectById(0), v0);
+
+    entities.removeObject(v2);
+    EXPECT_EQ(entities.GetObjectById(2), nullptr);
+    EXPECT_EQ(entities.GetObjectByName("v2"), nullptr);
+    EXPECT_EQ(entities.object_.size(), 0);
+    EXPECT_EQ(entities.object_pool_.size(), 1);
+}
+
+TEST(LaneOccupancyTest, TestQueries)
+{
+    Position::GetOpenDrive()->LoadOpenDriveFile("../../../resources/xodr/straight_500m.xodr");
+
+    Entities entities;
+    Vehicle* v[5];
+    for (int i = 0; i < 5; i++)
+    {
+        v[i] = new Vehicle();
+        entities.addObject(v[i], true);
+    }
+    v[0]->pos_.SetLanePos(1, -1, 100.0, 0.0);
+    v[1]->pos_.SetLanePos(1, -1, 150.0, 0.0);
+    v[2]->pos_.SetLanePos(1, 1, 130.0, 0.0);
+    v[3]->pos_.SetLanePos(1, -1, 400.0, 0.0);
+    v[4]->pos_.SetLanePos(1, -1, 60.0, 0.0);
+
+    std::vector<Object*> result;
+
+    // not built, all objects returned from distance queries
+    entities.lane_occupancy_.GetObjectsAlongRoad(v[0]->pos_, 10.0, result);
+    EXPECT_EQ(result.size(), 5);
+    EXPECT_EQ(entities.lane_occupancy_.GetNearestInLane(v[0], 0, true, 100.0), nullptr);
+
+    entities.lane_occupancy_.Build();
+    ASSERT_TRUE(entities.lane_occupancy_.IsBuilt());
+
+    entities.lane_occupancy_.GetObjectsInLane(1, -1, 0.0, 200.0, result);
+    ASSERT_EQ(result.size(), 3);
+    EXPECT_EQ(result[0], v[4]);
+    EXPECT_EQ(result[1], v[0]);
+    EXPECT_EQ(result[2], v[1]);
+
+    // v0 drives along road direction in lane -1, v2 in opposite direction in lane 1
+    EXPECT_EQ(entities.lane_occupancy_.GetNearestInLane(v[0], 0, true, 100.0), v[1]);
+    EXPECT_EQ(entities.lane_occupancy_.GetNearestInLane(v[0], 0, true, 40.0), nullptr);
+    EXPECT_EQ(entities.lane_occupancy_.GetNearestInLane(v[0], 0, false, 100.0), v[4]);
+    EXPECT_EQ(entities.lane_occupancy_.GetNearestInLane(v[0], 1, true, 100.0), v[2]);
+    EXPECT_EQ(entities.lane_occupancy_.GetNearestInLane(v[0], -1, true, 100.0), nullptr);
+
+    // results in object order, superset of objects within range
+    entities.lane_occupancy_.GetObjectsAlongRoad(v[0]->pos_, 50.0, result);
+    ASSERT_EQ(result.size(), 4);
+    EXPECT_EQ(result[0], v[0]);
+    EXPECT_EQ(result[1], v[1]);
+    EXPECT_EQ(result[2], v[2]);
+    EXPECT_EQ(result[3], v[4]);
+
+    entities.lane_occupancy_.GetObjectsInRadius(v[0]->pos_.GetX(), v[0]->pos_.GetY(), 35.0, result);
+    ASSERT_EQ(result.size(), 2);
+    EXPECT_EQ(result[0], v[0]);
+    EXPECT_EQ(result[1], v[2]);
+
+    // moved object is updated
+    v[3]->pos_.SetLanePos(1, -1, 120.0, 0.0);
+    entities.lane_occupancy_.Update(v[3]);
+    EXPECT_EQ(entities.lane_occupancy_.GetNearestInLane(v[0], 0, true, 100.0), v[3]);
+
+    entities.lane_occupancy_.Clear();
+    EXPECT_FALSE(entities.lane_occupancy_.IsBuilt());
+}
+
+TEST(StepTest, TestParallelStepIdenticalToSerial)
+{
+    double              dt = 0.05;
+    std::vector<double> states[2];
+
+    for (unsigned int run = 0; run < 2; run++)
+    {
+        SE_Env::Inst().GetRand().SetSeed(12345);
+        ScenarioEngine* se = new ScenarioEngine("../../../resources/xosc/swarm.xosc");
+        ASSERT_NE(se, nullptr);
+
+        se->SetStepThreads(run == 0 ? 1 : 4);
+        EXPECT_EQ(se->GetStepThreads(), run == 0 ? 1 : 4);
+
+        se->step(0.0);
+        se->prepareGroundTruth(0.0);
+
+        for (int i = 0; i < 400; i++)
+        {
+            se->step(dt);
+            se->prepareGroundTruth(dt);
+
+            for (auto obj : se->entities_.object_)
+            {
+                states[run].insert(states[run].end(),
+                                   {static_cast<double>(obj->GetId()), obj->pos_.GetX(), obj->pos_.GetY(), obj->pos_.GetH(), obj->GetSpeed()});
+            }
+        }
+
+        delete se;
+    }
+
+    EXPECT_GT(states[0].size(), 400 * 5 * 10);
+    EXPECT_TRUE(states[0] == states[1]);  // bitwise identical
+}
+
+TEST(CatalogCacheTest, TestReuseParsedCatalogs)
+{
+    CatalogCache::Inst().Clear();
+
+    ScenarioEngine* se = new ScenarioEngine("../../../resources/xosc/cut-in.xosc");
+    ASSERT_NE(se, nullptr);
+    size_t n_files = CatalogCache::Inst().GetNumberOfFiles();
+    EXPECT_GT(n_files, 0);
+    Entry* entry = se->scenarioReader->GetCatalogs()->FindCatalogEntry("VehicleCatalog", "car_white");
+    ASSERT_NE(entry, nullptr);
+    delete se;
+
+    // same catalogs again, picked from the cache
+    pugi::xml_parse_result                    result;
+    std::shared_ptr<const pugi::xml_document> doc1 =
+        CatalogCache::Inst().Load("../../../resources/xosc/Catalogs/Vehicles/VehicleCatalog.xosc", result);
+    ASSERT_NE(doc1, nullptr);
+    EXPECT_EQ(CatalogCache::Inst().GetNumberOfFiles(), n_files);
+
+    se = new ScenarioEngine("../../../resources/xosc/cut-in.xosc");
+    EXPECT_EQ(CatalogCache::Inst().GetNumberOfFiles(), n_files);
+    EXPECT_NE(se->scenarioReader->GetCatalogs()->FindCatalogEntry("VehicleCatalog", "car_white"), nullptr);
+    delete se;
+
+    // path given in other way refers to same file
+    std::shared_ptr<const pugi::xml_document> doc2 =
+        CatalogCache::Inst().Load("../../../resources/xosc/Catalogs/../Catalogs/Vehicles/VehicleCatalog.xosc", result);
+    EXPECT_EQ(doc1, doc2);
+
+    // modified file is parsed again
+    {
+        std::ofstream file("catalog_cache_test.xosc");
+        file << "<OpenSCENARIO><Catalog name=\"test\"/></OpenSCENARIO>";
+    }
+    doc1 = CatalogCache::Inst().Load("catalog_cache_test.xosc", result);
+    ASSERT_NE(doc1, nullptr);
+    EXPECT_EQ(CatalogCache::Inst().Load("catalog_cache_test.xosc", result), doc1);
+    {
+        std::ofstream file("catalog_cache_test.xosc", std::ios::app);
+        file << "\n";
+    }
+    doc2 = CatalogCache::Inst().Load("catalog_cache_test.xosc", result);
+    ASSERT_NE(doc2, nullptr);
+    EXPECT_NE(doc1, doc2);
+    std::remove("catalog_cache_test.xosc");
+
+    EXPECT_EQ(CatalogCache::Inst().Load("missing_file.xosc", result), nullptr);
+    EXPECT_EQ(CatalogCache::Inst().Preload("../../../resources/xosc/Catalogs/Routes"), 2);
+    EXPECT_EQ(CatalogCache::Inst().Preload("missing_dir"), -1);
+
+    CatalogCache::Inst().Clear();
+    EXPECT_EQ(CatalogCache::Inst().GetNumberOfFiles(), 0);
+}
+
+TEST(OSIWriterTest, TestQueuePolicies)
+{
+    std::vector<std::string> out;
+
+    // Slow output, producer waits for free buffers and all messages are written in order
+    {
+        OSIWriter writer(2,
+                         OSIWriter::Policy::BLOCK,
+                         [&out](const char* data, unsigned int size, int channel)
+                         {
+                             std::this_thread::sleep_for(std::chrono::milliseconds(5));
+                             out.push_back(std::to_string(channel) + ":" + std::string(data, size));
+                         });
+        for (int i = 0; i < 10; i++)
+        {
+            std::string msg = "msg" + std::to_string(i);
+            EXPECT_TRUE(writer.Push(msg.c_str(), static_cast<unsigned int>(msg.size()), i % 2));
+        }
+        writer.Drain();
+        EXPECT_EQ(writer.GetNumWritten(), 10);
+        EXPECT_EQ(writer.GetNumDropped(), 0);
+        EXPECT_GT(writer.GetNumLate(), 0);
+    }
+    ASSERT_EQ(out.size(), 10);
+    EXPECT_EQ(out[0], "0:msg0");
+    EXPECT_EQ(out[9], "1:msg9");
+
+    // Stalled output, messages exceeding queue depth are dropped
+    out.clear();
+    std::atomic<bool> stalled{true};
+    {
+        OSIWriter writer(2,
+                         OSIWriter::Policy::DROP,
+                         [&out, &stalled](const char* data, unsigned int size, int)
+                         {
+                             while (stalled)
+                             {
+                                 std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                             }
+                             out.push_back(std::string(data, size));
+                         });
+        EXPECT_TRUE(writer.Push("a", 1, 0));
+        EXPECT_TRUE(writer.Push("b", 1, 0));
+        EXPECT_FALSE(writer.Push("c", 1, 0));
+        EXPECT_FALSE(writer.Push("d", 1, 0));
+        stalled = false;
+        writer.Drain();
+        EXPECT_TRUE(writer.Push("e", 1, 0));
+        EXPECT_EQ(writer.GetNumDropped(), 2);
+        EXPECT_EQ(writer.GetNumLate(), 0);
+    }
+    // queued messages written also at destruction
+    EXPECT_EQ(out, std::vector<std::string>({"a", "b", "e"}));
+}
+
+#ifdef _USE_OSI
+TEST(OSIReporterTest, TestIncrementalSerialization)
+{
+    ScenarioEngine* se = new ScenarioEngine("../../../resources/xosc/cut-in_simple.xosc");
+    ASSERT_NE(se, nullptr);
+    se->step(0.0);
+    se->prepareGroundTruth(0.0);
+
+    OSIReporter* reporter = new OSIReporter(se);
+    reporter->SetIncrementalSerialization(true);
+
+    for (int i = 0; i < 20; i++)
+    {
+        // refetch static content now and then, replacing the serialized static part
+        reporter->SetUpdated(false);
+        reporter->UpdateOSIGroundTruth(se->getScenarioGateway()->objectState_, i % 5 == 0);
+
+        // spliced output must be identical to regular serialization of the same ground truth
+        int         size = 0;
+        const char* data = reporter->GetOSIGroundTruth(&size);
+        std::string reference;
+        reinterpret_cast<const osi3::GroundTruth*>(reporter->GetOSIGroundTruthRaw())->SerializeToString(&reference);
+        ASSERT_EQ(static_cast<size_t>(size), reference.size()) << "frame " << i;
+        EXPECT_EQ(std::string(data, static_cast<size_t>(size)), reference) << "frame " << i;
+
+        se->step(0.05);
+        se->prepareGroundTruth(0.05);
+    }
+
+    delete reporter;
+    delete se;
+}
+
+TEST(OSIReporterTest, TestIncrementalSerializationParse)
+{
+    // entities are added and deleted during the scenario
+    ScenarioEngine* se = new ScenarioEngine("../../../EnvironmentSimulator/Unittest/xosc/add_delete_entity.xosc");
+    ASSERT_NE(se, nullptr);
+    se->step(0.0);
+    se->prepareGroundTruth(0.0);
+
+    OSIReporter* reporter = new OSIReporter(se);
+    reporter->SetIncrementalSerialization(true);
+
+    int min_n_objects = 100;
+    int max_n_objects = 0;
+
+    for (int i = 0; i < 130; i++)
+    {
+        reporter->SetUpdated(false);
+        reporter->UpdateOSIGroundTruth(se->getScenarioGateway()->objectState_, i % 40 == 0);
+
+        // spliced output parsed back must equal the full ground truth, including the set of moving objects
+        int                      size = 0;
+        const char*              data = reporter->GetOSIGroundTruth(&size);
+        const osi3::GroundTruth* full = reinterpret_cast<const osi3::GroundTruth*>(reporter->GetOSIGroundTruthRaw());
+        osi3::GroundTruth        parsed;
+        ASSERT_TRUE(parsed.ParseFromArray(data, size)) << "frame " << i;
+        EXPECT_TRUE(google::protobuf::util::MessageDifferencer::Equals(parsed, *full)) << "frame " << i;
+        ASSERT_EQ(parsed.moving_object_size(), static_cast<int>(se->entities_.object_.size())) << "frame " << i;
+        for (int j = 0; j < parsed.moving_object_size(); j++)
+        {
+            EXPECT_EQ(parsed.moving_object(j).id().value(), full->moving_object(j).id().value()) << "frame " << i;
+            EXPECT_EQ(parsed.moving_object(j).base().position().x(), full->moving_object(j).base().position().x()) << "frame " << i;
+        }
+        min_n_objects = MIN(min_n_objects, parsed.moving_object_size());
+        max_n_objects = MAX(max_n_objects, parsed.moving_object_size());
+
+        se->step(0.1);
+        se->prepareGroundTruth(0.1);
+    }
+
+    // make sure objects did appear and disappear
+    EXPECT_EQ(min_n_objects, 0);
+    EXPECT_EQ(max_n_objects, 2);
+
+    delete reporter;
+    delete se;
+}
+#endif  // _USE_OSI
+
 int main(int argc, char** argv)
 {
 #if 0  // set to 1 and modify filter to run one single test
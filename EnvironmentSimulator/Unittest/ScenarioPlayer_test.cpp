@@ -224,6 +224,50 @@ TEST(SensorTest, TestSensorFunctionsReturnValuesAndCounters)
     delete player;
 }
 
+TEST(SensorTest, TestBatchedSensorUpdate)
+{
+    const char*     args[] = {"esmini", "--osc", "../../../resources/xosc/swarm.xosc", "--headless", "--disable_stdout"};
+    int             argc   = sizeof(args) / sizeof(char*);
+    ScenarioPlayer* player = new ScenarioPlayer(argc, const_cast<char**>(args));
+
+    ASSERT_NE(player, nullptr);
+    ASSERT_EQ(player->Init(), 0);
+
+    // sensors looking in different directions, with various ranges and limits of the hit list
+    Object* ego = player->scenarioEngine->entities_.object_[0];
+    EXPECT_EQ(player->AddObjectSensor(ego, 2.0, 0.0, 1.0, 0.0, 1.0, 200.0, 0.7, 50), 0);
+    EXPECT_EQ(player->AddObjectSensor(ego, 2.0, 0.5, 1.0, 0.5, 0.5, 30.0, 1.5, 50), 1);
+    EXPECT_EQ(player->AddObjectSensor(ego, -1.0, 0.0, 1.0, M_PI, 0.0, 80.0, 2.0, 50), 2);
+    EXPECT_EQ(player->AddObjectSensor(ego, 0.0, 0.0, 1.0, 0.0, 10.0, 300.0, 2 * M_PI, 3), 3);
+
+    int n_hits = 0;
+    for (int i = 0; i < 200; i++)
+    {
+        player->Frame(0.05);
+
+        // Frame() updates sensors in a batch, compare to individual update
+        for (auto sensor : player->sensor)
+        {
+            std::vector<ObjectSensor::ObjectHit> hits(sensor->hitList_, sensor->hitList_ + sensor->nObj_);
+            sensor->Update();
+            ASSERT_EQ(sensor->nObj_, static_cast<int>(hits.size()));
+            ASSERT_LE(sensor->nObj_, sensor->maxObj_);
+            for (size_t j = 0; j < hits.size(); j++)
+            {
+                EXPECT_EQ(sensor->hitList_[j].obj_, hits[j].obj_);
+                EXPECT_EQ(sensor->hitList_[j].x_, hits[j].x_);
+                EXPECT_EQ(sensor->hitList_[j].y_, hits[j].y_);
+                EXPECT_EQ(sensor->hitList_[j].velX_, hits[j].velX_);
+                EXPECT_EQ(sensor->hitList_[j].yaw_, hits[j].yaw_);
+            }
+            n_hits += sensor->nObj_;
+        }
+    }
+    EXPECT_GT(n_hits, 0);
+
+    delete player;
+}
+
 TEST(AlignmentTest, TestPosMode)
 {
     const char* args[] = {"esmini", "--headless", "--osc", "../../../EnvironmentSimulator/Unittest/xosc/curve_slope_simple.xosc", "--disable_stdout"};
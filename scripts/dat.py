@@ -1,10 +1,15 @@
 import argparse
 import ctypes
 import os
+import struct
 
-VERSION = 2
+VERSION = 3
+VERSION_RAW = 2  # uncompressed object states
 REPLAY_FILENAME_SIZE = 512
 NAME_LEN = 32
+INDEX_TAG = 0x58444e49
+RECORD_OBJECT_INFO = 0
+RECORD_OBJECT_STATE = 1
 
 
 class ObjectStateStructDat(ctypes.Structure):
@@ -52,6 +57,111 @@ class DATHeader(ctypes.Structure):
         ('model_filename', ctypes.c_char * REPLAY_FILENAME_SIZE),
     ]
 
+
+class DATObjectInfo(ctypes.Structure):
+    _fields_ = [
+        ("id", ctypes.c_int),
+        ("model_id", ctypes.c_int),
+        ("obj_type", ctypes.c_int),
+        ("obj_category", ctypes.c_int),
+        ("ctrl_type", ctypes.c_int),
+        ('name', ctypes.c_char * NAME_LEN),
+        ("centerOffsetX", ctypes.c_float),
+        ("centerOffsetY", ctypes.c_float),
+        ("centerOffsetZ", ctypes.c_float),
+        ("width", ctypes.c_float),
+        ("length", ctypes.c_float),
+        ("height", ctypes.c_float),
+        ("scaleMode", ctypes.c_int),
+        ("visibilityMask", ctypes.c_int),
+    ]
+
+
+class DATChunkHeader(ctypes.Structure):
+    _fields_ = [
+        ('size', ctypes.c_uint),
+        ('n_records', ctypes.c_uint),
+        ('t_start', ctypes.c_float),
+        ('t_end', ctypes.c_float),
+    ]
+
+
+class DATIndexEntry(ctypes.Structure):
+    _fields_ = [
+        ('t_start', ctypes.c_float),
+        ('t_end', ctypes.c_float),
+        ('offset', ctypes.c_ulonglong),
+    ]
+
+
+class DATIndexFooter(ctypes.Structure):
+    _fields_ = [
+        ('offset', ctypes.c_ulonglong),
+        ('n_entries', ctypes.c_uint),
+        ('tag', ctypes.c_uint),
+    ]
+
+
+# Encoded fields of object state records (version 3), in order. Values are 32 bit patterns.
+STATE_FIELDS = [('time', 'f'), ('speed', 'f'), ('wheel_angle', 'f'), ('wheel_rot', 'f'),
+                ('x', 'f'), ('y', 'f'), ('z', 'f'), ('h', 'f'), ('p', 'f'), ('r', 'f'),
+                ('roadId', 'i'), ('laneId', 'i'), ('offset', 'f'), ('t', 'f'), ('s', 'f')]
+
+
+def get_varint(buf, pos):
+    value = 0
+    shift = 0
+    while True:
+        byte = buf[pos]
+        pos += 1
+        value |= (byte & 0x7f) << shift
+        if not byte & 0x80:
+            return value, pos
+        shift += 7
+
+
+def decode_chunk(buf, n_records):
+    # See DatFile.hpp for format description
+    objects = {}
+    states = []
+    pos = 0
+    for _ in range(n_records):
+        while buf[pos] == RECORD_OBJECT_INFO:
+            info = DATObjectInfo.from_buffer_copy(buf, pos + 1)
+            pos += 1 + ctypes.sizeof(DATObjectInfo)
+            objects.setdefault(info.id, {'values': []})['info'] = info
+        pos += 1  # RECORD_OBJECT_STATE
+        id, pos = get_varint(buf, pos)
+        mask, pos = get_varint(buf, pos)
+        obj = objects[(id >> 1) ^ -(id & 1)]
+        history = obj['values']
+        values = []
+        for i in range(len(STATE_FIELDS)):
+            if len(history) == 0:
+                predicted = 0
+            elif len(history) == 1 or STATE_FIELDS[i][1] == 'i':
+                predicted = history[-1][i]
+            else:
+                predicted = 2 * history[-1][i] - history[-2][i]
+            residual = 0
+            if mask & (1 << i):
+                residual, pos = get_varint(buf, pos)
+                residual = (residual >> 1) ^ -(residual & 1)
+            values.append(((predicted + residual + 0x80000000) & 0xffffffff) - 0x80000000)  # wrap to int32
+        obj['values'] = [history[-1], values] if len(history) > 0 else [values]
+
+        state = ObjectStateStructDat()
+        for field in DATObjectInfo._fields_:
+            setattr(state, field[0], getattr(obj['info'], field[0]))
+        for i, (name, kind) in enumerate(STATE_FIELDS):
+            if kind == 'i':
+                setattr(state, name, values[i])
+            else:
+                setattr(state, name, struct.unpack('<f', struct.pack('<i', values[i]))[0])
+        states.append(state)
+
+    return states
+
 class DATFile():
     def __init__(self, filename):
         if not os.path.isfile(filename):
@@ -71,19 +181,36 @@ class DATFile():
         self.labels = [field[0] for field in ObjectStateStructDat._fields_]
         self.data = []
 
-        if (self.version != VERSION):
-            print('Version mismatch. {} is version {} while supported version is: {}'.format(
-                filename, self.version, VERSION)
+        if (self.version == VERSION_RAW):
+            # Read all rows of data
+            while (True):
+                buffer = self.file.read(ctypes.sizeof(ObjectStateStructDat))
+                if len(buffer) < ctypes.sizeof(ObjectStateStructDat):
+                    break
+                self.data.append(ObjectStateStructDat.from_buffer_copy(buffer))
+        elif (self.version == VERSION):
+            # Chunks end where index starts, or at end of file if file was not properly closed
+            content = self.file.read()
+            data_end = len(content)
+            if len(content) >= ctypes.sizeof(DATIndexFooter):
+                footer = DATIndexFooter.from_buffer_copy(content, len(content) - ctypes.sizeof(DATIndexFooter))
+                index_start = footer.offset - ctypes.sizeof(DATHeader)
+                if footer.tag == INDEX_TAG and index_start + footer.n_entries * ctypes.sizeof(DATIndexEntry) + ctypes.sizeof(DATIndexFooter) == len(content):
+                    data_end = index_start
+            pos = 0
+            while pos + ctypes.sizeof(DATChunkHeader) <= data_end:
+                chunk = DATChunkHeader.from_buffer_copy(content, pos)
+                pos += ctypes.sizeof(DATChunkHeader)
+                if pos + chunk.size > data_end:
+                    break
+                self.data.extend(decode_chunk(content[pos:pos + chunk.size], chunk.n_records))
+                pos += chunk.size
+        else:
+            print('Version mismatch. {} is version {} while supported versions are: {} and {}'.format(
+                filename, self.version, VERSION_RAW, VERSION)
             )
             exit(-1)
 
-        # Read and print all rows of data
-        while (True):
-            buffer = self.file.read(ctypes.sizeof(ObjectStateStructDat))
-            if len(buffer) < ctypes.sizeof(ObjectStateStructDat):
-                break
-            self.data.append(ObjectStateStructDat.from_buffer_copy(buffer))
-
     def get_header_line(self):
         return 'Version: {}, OpenDRIVE: {}, 3DModel: {}'.format(
                 self.version,
@@ -252,7 +379,10 @@ class DATFile():
             print('ERROR: Could not open file {} for writing'.format(filename))
             raise
 
-        fdat.write(self.header)
+        # save in uncompressed format
+        header = DATHeader.from_buffer_copy(self.header)
+        header.version = VERSION_RAW
+        fdat.write(header)
 
         for d in self.data:
             fdat.write(d)
@@ -2105,6 +2105,31 @@ class TestSuite(unittest.TestCase):
         self.assertTrue(re.search('8.000, 0, car_white, -17.070, 2.532, 0.000, 1.571, 0.000, 0.000, 0.000, 0.000, 3.484', csv, re.MULTILINE))
         self.assertTrue(re.search('8.000, 1, car_red, -29.070, 17.530, 0.000, 1.570, 0.000, 0.000, 0.000, 0.000, 5.703', csv, re.MULTILINE))
 
+    def test_param_dist_parallel(self):
+        summary_filename = 'param_dist_summary.csv'
+        if os.path.exists(summary_filename):
+            os.remove(summary_filename)
+
+        log = run_scenario(os.path.join(ESMINI_PATH, 'resources/xosc/cut-in_parameter_set.xosc'), '--fixed_timestep 0.05 --param_dist_parallel 3')
+
+        self.assertTrue(re.search('Running 12 permutations in 3 threads', log)  is not None)
+
+        with open(summary_filename, 'r', newline='') as f:
+            lines = f.read().split('\r\n')
+
+        # header plus one line per object (2) and permutation (12), each terminated by CRLF
+        self.assertEqual(len(lines), 26)
+        self.assertEqual(lines[25], '')
+        self.assertEqual(lines[0], 'permutation,status,sim_time,wall_time,parameters,object_id,object_name,x,y,h,speed,collision')
+        for i in range(12):
+            for j in range(2):
+                values = lines[1 + 2 * i + j].split(',')
+                self.assertEqual(len(values), 12)
+                self.assertEqual(int(values[0]), i)
+                self.assertEqual(int(values[1]), 0)
+                self.assertEqual(values[6], ['Ego', 'OverTaker'][j])
+        self.assertTrue(re.search('^0,0,30.900,.*,HostVehicle=car_blue TargetVehicle=car_yellow EgoSpeed=70.0 TargetSpeedFactor=1.100000,0,Ego,28.119,650.215,1.471,19.444,true$', lines[1])  is not None)
+
     def test_scenario_not_found(self):
         # This test case checks handling of missing scenario file
         log = run_scenario(os.path.join(ESMINI_PATH, 'dummy_folder/dummy_filename.xosc'), COMMON_ESMINI_ARGS + "--fixed_timestep 0.1", ignoreReturnCode = True)